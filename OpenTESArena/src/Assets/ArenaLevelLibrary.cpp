@@ -1,12 +1,21 @@
 #include <algorithm>
+#include <chrono>
 #include <cstdio>
 #include <vector>
 
 #include "ArenaLevelLibrary.h"
+#include "AssetCache.h"
 #include "MIFUtils.h"
 
 #include "components/debug/Debug.h"
 #include "components/dos/DOSUtils.h"
+#include "components/utilities/String.h"
+#include "components/vfs/manager.hpp"
+
+namespace
+{
+	constexpr char CITY_BLOCK_MIFS_CACHE_NAME[] = "CityBlocks.mifs";
+}
 
 bool ArenaLevelLibrary::init()
 {
@@ -47,14 +56,58 @@ bool ArenaLevelLibrary::initCityBlockMifs()
 		}
 	}
 
+	// Decompressing every block's voxel maps is most of this library's load time, so the decoded .MIFs
+	// are cached on disk and keyed by the contents of all of them.
+	const auto startTime = std::chrono::steady_clock::now();
+	auto getElapsedMillisecondsString = [&startTime]()
+	{
+		const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - startTime;
+		return String::fixedPrecision(elapsed.count(), 1);
+	};
+
 	const int mifCount = static_cast<int>(mifNames.size());
+	Buffer<Buffer<std::byte>> mifSrcs(mifCount);
+	Buffer<uint64_t> mifHashes(mifCount);
+	for (int i = 0; i < mifCount; i++)
+	{
+		const std::string &mifName = mifNames[i];
+		Buffer<std::byte> &mifSrc = mifSrcs[i];
+		if (!VFS::Manager::get().read(mifName.c_str(), &mifSrc))
+		{
+			DebugLogError("Could not read \"" + mifName + "\".");
+			success = false;
+		}
+
+		mifHashes.set(i, AssetCache::hashBytes(mifSrc));
+	}
+
+	const uint64_t sourceHash = AssetCache::hashBytes(BufferView<const std::byte>(
+		reinterpret_cast<const std::byte*>(mifHashes.begin()), mifCount * static_cast<int>(sizeof(uint64_t))));
+
+	Buffer<uint8_t> cacheData;
+	if (success && AssetCache::tryRead(CITY_BLOCK_MIFS_CACHE_NAME, sourceHash, &cacheData))
+	{
+		if (this->tryInitCityBlockMifsFromCache(cacheData, mifCount))
+		{
+			DebugLog("Loaded " + std::to_string(mifCount) + " city block .MIFs from cache in " + getElapsedMillisecondsString() + "ms.");
+			return true;
+		}
+
+		DebugLogWarning("Ignoring unreadable city block .MIF cache.");
+	}
+
 	this->cityBlockMifs.init(mifCount);
 	for (int i = 0; i < mifCount; i++)
 	{
 		const std::string &mifName = mifNames[i];
+		const Buffer<std::byte> &mifSrc = mifSrcs[i];
+		if (!mifSrc.isValid())
+		{
+			continue;
+		}
 
 		MIFFile mif;
-		if (mif.init(mifName.c_str()))
+		if (mif.init(mifName.c_str(), mifSrc))
 		{
 			this->cityBlockMifs.set(i, std::move(mif));
 		}
@@ -65,9 +118,38 @@ bool ArenaLevelLibrary::initCityBlockMifs()
 		}
 	}
 
+	if (success)
+	{
+		std::vector<uint8_t> newCacheData;
+		for (const MIFFile &mif : this->cityBlockMifs)
+		{
+			mif.writeCacheData(newCacheData);
+		}
+
+		AssetCache::write(CITY_BLOCK_MIFS_CACHE_NAME, sourceHash, newCacheData);
+	}
+
+	DebugLog("Decoded " + std::to_string(mifCount) + " city block .MIFs in " + getElapsedMillisecondsString() + "ms (not cached).");
 	return success;
 }
 
+bool ArenaLevelLibrary::tryInitCityBlockMifsFromCache(BufferView<const uint8_t> cacheData, int mifCount)
+{
+	const uint8_t *dataPtr = cacheData.begin();
+	const uint8_t *dataEnd = cacheData.end();
+
+	this->cityBlockMifs.init(mifCount);
+	for (MIFFile &mif : this->cityBlockMifs)
+	{
+		if (!mif.initFromCacheData(&dataPtr, dataEnd))
+		{
+			return false;
+		}
+	}
+
+	return dataPtr == dataEnd;
+}
+
 bool ArenaLevelLibrary::initWildernessChunks()
 {
 	// The first four wilderness files are city blocks but they can be loaded anyway.
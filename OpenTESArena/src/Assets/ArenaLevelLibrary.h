@@ -15,6 +15,7 @@ private:
 	Buffer<RMDFile> wildernessChunks; // WILD001 to WILD070.
 
 	bool initCityBlockMifs();
+	bool tryInitCityBlockMifsFromCache(BufferView<const uint8_t> cacheData, int mifCount);
 	bool initWildernessChunks();
 public:
 	bool init();
@@ -0,0 +1,167 @@
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#include "AssetCache.h"
+
+#include "components/debug/Debug.h"
+#include "components/utilities/Directory.h"
+#include "components/utilities/String.h"
+
+namespace
+{
+	// Bump when the header layout or any cached payload format changes.
+	constexpr uint32_t CACHE_VERSION = 1;
+
+	constexpr char CACHE_MAGIC[8] = { 'O', 'T', 'A', 'C', 'A', 'C', 'H', 'E' };
+
+	// Empty until initialized, which disables the cache.
+	std::string CacheFolderPath;
+
+	// Native layout since a cache is only ever read by the machine that wrote it.
+	struct CacheHeader
+	{
+		char magic[8];
+		uint32_t version;
+		uint32_t reserved;
+		uint64_t sourceHash;
+		uint64_t payloadSize;
+		uint64_t payloadHash;
+	};
+
+	static_assert(sizeof(CacheHeader) == 40);
+
+	// 64-bit FNV-1a.
+	uint64_t HashRange(const uint8_t *begin, const uint8_t *end)
+	{
+		uint64_t hash = 0xCBF29CE484222325;
+		for (const uint8_t *ptr = begin; ptr != end; ptr++)
+		{
+			hash ^= *ptr;
+			hash *= 0x100000001B3;
+		}
+
+		return hash;
+	}
+}
+
+void AssetCache::init(const std::string &folderPath)
+{
+	CacheFolderPath = !folderPath.empty() ? String::addTrailingSlashIfMissing(folderPath) : std::string();
+}
+
+uint64_t AssetCache::hashBytes(BufferView<const std::byte> bytes)
+{
+	const uint8_t *begin = reinterpret_cast<const uint8_t*>(bytes.begin());
+	return HashRange(begin, begin + bytes.getCount());
+}
+
+bool AssetCache::tryRead(const char *name, uint64_t sourceHash, Buffer<uint8_t> *outData)
+{
+	if (CacheFolderPath.empty())
+	{
+		return false;
+	}
+
+	const std::string path = CacheFolderPath + name;
+	std::ifstream ifs(path, std::ios::binary);
+	if (!ifs.is_open())
+	{
+		return false;
+	}
+
+	CacheHeader header;
+	if (!ifs.read(reinterpret_cast<char*>(&header), sizeof(header)))
+	{
+		DebugLogWarning("Ignoring truncated asset cache \"" + path + "\".");
+		return false;
+	}
+
+	if ((std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0) || (header.version != CACHE_VERSION))
+	{
+		DebugLog("Ignoring asset cache \"" + path + "\" from a different version.");
+		return false;
+	}
+
+	if (header.sourceHash != sourceHash)
+	{
+		DebugLog("Ignoring stale asset cache \"" + path + "\".");
+		return false;
+	}
+
+	constexpr uint64_t maxPayloadSize = 1 << 30;
+	if (header.payloadSize > maxPayloadSize)
+	{
+		DebugLogWarning("Ignoring asset cache \"" + path + "\" with invalid size.");
+		return false;
+	}
+
+	const int payloadSize = static_cast<int>(header.payloadSize);
+	Buffer<uint8_t> payload(payloadSize);
+	if (!ifs.read(reinterpret_cast<char*>(payload.begin()), payloadSize))
+	{
+		DebugLogWarning("Ignoring truncated asset cache \"" + path + "\".");
+		return false;
+	}
+
+	if (HashRange(payload.begin(), payload.end()) != header.payloadHash)
+	{
+		DebugLogWarning("Ignoring corrupt asset cache \"" + path + "\".");
+		return false;
+	}
+
+	*outData = std::move(payload);
+	return true;
+}
+
+void AssetCache::write(const char *name, uint64_t sourceHash, BufferView<const uint8_t> data)
+{
+	if (CacheFolderPath.empty())
+	{
+		return;
+	}
+
+	const std::string &folderPath = CacheFolderPath;
+	if (!Directory::exists(folderPath.c_str()))
+	{
+		Directory::createRecursively(folderPath.c_str());
+	}
+
+	CacheHeader header;
+	std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+	header.version = CACHE_VERSION;
+	header.reserved = 0;
+	header.sourceHash = sourceHash;
+	header.payloadSize = static_cast<uint64_t>(data.getCount());
+	header.payloadHash = HashRange(data.begin(), data.end());
+
+	// Write to a temporary file first so a reader never sees a partial entry.
+	const std::string path = folderPath + name;
+	const std::string tempPath = path + ".tmp";
+	{
+		std::ofstream ofs(tempPath, std::ios::binary | std::ios::trunc);
+		if (!ofs.is_open())
+		{
+			DebugLogWarning("Couldn't open asset cache \"" + tempPath + "\" for writing.");
+			return;
+		}
+
+		ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		ofs.write(reinterpret_cast<const char*>(data.begin()), data.getCount());
+		if (!ofs.good())
+		{
+			DebugLogWarning("Couldn't write asset cache \"" + tempPath + "\".");
+			ofs.close();
+			std::remove(tempPath.c_str());
+			return;
+		}
+	}
+
+	std::remove(path.c_str());
+	if (std::rename(tempPath.c_str(), path.c_str()) != 0)
+	{
+		DebugLogWarning("Couldn't replace asset cache \"" + path + "\".");
+		std::remove(tempPath.c_str());
+	}
+}
@@ -0,0 +1,32 @@
+#ifndef ASSET_CACHE_H
+#define ASSET_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "components/utilities/Buffer.h"
+#include "components/utilities/BufferView.h"
+
+// On-disk cache for data derived from the original game files, so later launches can skip re-deriving it.
+// Each entry is one flat binary file in the options folder: a fixed header (format version, hash of the
+// source file contents, payload size and checksum) followed by the raw payload, so it can be read or mapped
+// in a single pass. Entries that are stale, truncated, or fail the checksum are ignored and the caller falls
+// back to deriving the data itself.
+
+namespace AssetCache
+{
+	// Sets the folder entries are kept in. Until then or if it's empty, nothing is read or written.
+	void init(const std::string &folderPath);
+
+	// Hash of source file contents used to key cache entries.
+	uint64_t hashBytes(BufferView<const std::byte> bytes);
+
+	// Reads the named cache entry if it was written from source data with the given hash.
+	bool tryRead(const char *name, uint64_t sourceHash, Buffer<uint8_t> *outData);
+
+	// Writes the named cache entry, replacing any existing one. Failing to write is not an error.
+	void write(const char *name, uint64_t sourceHash, BufferView<const uint8_t> data);
+}
+
+#endif
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "Compression.h"
 
 #include "components/debug/Debug.h"
@@ -24,11 +26,8 @@ void Compression::decodeRLE(const uint8_t *src, int stopCount, BufferView<uint8_
 
 			DebugAssert(o >= 0);
 			DebugAssert((o + static_cast<int>(count)) <= dst.getCount());
-			for (uint32_t j = 0; j < count; j++)
-			{
-				dst[o] = value;
-				o++;
-			}
+			std::fill(dst.begin() + o, dst.begin() + o + count, value);
+			o += static_cast<int>(count);
 		}
 		else
 		{
@@ -36,12 +35,9 @@ void Compression::decodeRLE(const uint8_t *src, int stopCount, BufferView<uint8_
 
 			DebugAssert(o >= 0);
 			DebugAssert((o + static_cast<int>(count)) <= dst.getCount());
-			for (uint32_t j = 0; j < count; j++)
-			{
-				dst[o] = src[i];
-				o++;
-				i++;
-			}
+			std::copy(src + i, src + i + count, dst.begin() + o);
+			o += static_cast<int>(count);
+			i += static_cast<int>(count);
 		}
 	}
 }
@@ -15,6 +15,35 @@
 
 namespace Compression
 {
+	// Size of the sliding window used by the LZ-style decoders.
+	constexpr int HISTORY_SIZE = 4096;
+	constexpr int HISTORY_MASK = HISTORY_SIZE - 1;
+
+	// Copies a run of previous output from the history window to the output and back into the window at the
+	// current position. Runs that don't wrap around the window or overlap themselves are moved as blocks.
+	inline void copyFromHistory(std::array<uint8_t, HISTORY_SIZE> &history, int &historypos, int copypos, int count, uint8_t *dst)
+	{
+		const int srcStart = copypos & HISTORY_MASK;
+		const int dstStart = historypos & HISTORY_MASK;
+		const bool isContiguous = ((srcStart + count) <= HISTORY_SIZE) && ((dstStart + count) <= HISTORY_SIZE);
+		const bool isOverlapping = (dstStart < (srcStart + count)) && (srcStart < (dstStart + count));
+		if (isContiguous && !isOverlapping)
+		{
+			const uint8_t *srcBegin = history.data() + srcStart;
+			std::copy(srcBegin, srcBegin + count, dst);
+			std::copy(dst, dst + count, history.data() + dstStart);
+			historypos += count;
+			return;
+		}
+
+		// Runs that repeat bytes they just wrote have to go one byte at a time.
+		for (int i = 0; i < count; i++)
+		{
+			dst[i] = history[copypos++ & HISTORY_MASK];
+			history[historypos++ & HISTORY_MASK] = dst[i];
+		}
+	}
+
 	// Uncompresses an RLE run of bytes.
 	void decodeRLE(const uint8_t *src, int stopCount, BufferView<uint8_t> dst);
 
@@ -27,7 +56,7 @@ namespace Compression
 	{
 		auto dst = out.begin();
 
-		std::array<uint8_t, 4096> history;
+		std::array<uint8_t, HISTORY_SIZE> history;
 		history.fill(0x20);
 		int historypos = 0;
 
@@ -55,7 +84,7 @@ namespace Compression
 				DebugAssertMsg(src != srcend, "Unexpected end of image.");
 				DebugAssertMsg(dst != out.end(), "Decoded image overflow.");
 
-				history[historypos++ & 0x0FFF] = *src;
+				history[historypos++ & HISTORY_MASK] = *src;
 				*(dst++) = *(src++);
 			}
 			else
@@ -69,11 +98,8 @@ namespace Compression
 
 				DebugAssertMsg(std::distance(dst, out.end()) >= tocopy, "Decoded image overflow.");
 
-				for (int i = 0; i < tocopy; i++)
-				{
-					*dst = history[copypos++ & 0x0FFF];
-					history[historypos++ & 0x0FFF] = *(dst++);
-				}
+				copyFromHistory(history, historypos, copypos, tocopy, dst);
+				dst += tocopy;
 			}
 
 			bitcount--;
@@ -126,7 +152,7 @@ namespace Compression
 			0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08
 		};
 
-		std::array<uint8_t, 4096> history;
+		std::array<uint8_t, HISTORY_SIZE> history;
 		history.fill(0x20);
 		int historypos = 0;
 
@@ -158,11 +184,37 @@ namespace Compression
 			});
 		}
 
-		uint16_t bitmask = 0;
-		uint8_t validbits = 0;
+		// Input bits are buffered most-significant first and refilled a few bytes at a time, so most reads
+		// don't touch the input. Past the end of input, zeroes are read.
+		uint32_t bitbuffer = 0;
+		int validbits = 0;
+		auto refillBits = [&src, &srcend, &bitbuffer, &validbits]()
+		{
+			while (validbits <= 24)
+			{
+				const uint32_t byte = (src != srcend) ? *(src++) : 0;
+				bitbuffer |= byte << (24 - validbits);
+				validbits += 8;
+			}
+		};
+
+		auto readBits = [&bitbuffer, &validbits, &refillBits](int count)
+		{
+			if (validbits < count)
+			{
+				refillBits();
+			}
+
+			const uint32_t value = bitbuffer >> (32 - count);
+			bitbuffer <<= count;
+			validbits -= count;
+			return value;
+		};
 
 		// This feels like some form of adaptive Huffman coding, with a form of LZ
-		// compression. DEFLATE?
+		// compression. DEFLATE? The tree changes after every symbol, so codes can't
+		// be decoded through a fixed lookup table; instead each step of the walk is
+		// a single shift out of the bit buffer.
 		auto dst = out.begin();
 		while (dst != out.end())
 		{
@@ -171,26 +223,21 @@ namespace Compression
 			uint16_t node = NodeTree[626];
 			while (node < 627)
 			{
-				while (validbits < 9)
+				if (validbits == 0)
 				{
-					if (src != srcend)
-					{
-						bitmask |= *(src++) << (8 - validbits);
-					}
-
-					validbits += 8;
+					refillBits();
 				}
 
-				node = NodeTree.at(node + ((bitmask >> 15) & 1));
-				bitmask <<= 1;
+				node = NodeTree[node + (bitbuffer >> 31)];
+				bitbuffer <<= 1;
 				validbits--;
 			}
 
 			// Increment the use count (frequency) of this node, and ensure the
 			// tree remains sorted.
-			uint16_t freqidx = NodeIdxMap.at(node);
+			uint16_t freqidx = NodeIdxMap[node];
 			do {
-				NodeFreq.at(freqidx) += 1;
+				NodeFreq[freqidx] += 1;
 				uint16_t freq = NodeFreq[freqidx];
 				uint16_t nextidx = freqidx + 1;
 				if (nextidx < NodeFreq.size() && NodeFreq[nextidx] < freq)
@@ -211,14 +258,14 @@ namespace Compression
 
 					// Update the index mappings
 					uint16_t mapidx = NodeTree[nextidx];
-					NodeIdxMap.at(mapidx) = nextidx;
+					NodeIdxMap[mapidx] = nextidx;
 					if (mapidx < 627)
 					{
 						NodeIdxMap[mapidx + 1] = nextidx;
 					}
 
 					mapidx = NodeTree[freqidx];
-					NodeIdxMap.at(mapidx) = freqidx;
+					NodeIdxMap[mapidx] = freqidx;
 					if (mapidx < 627)
 					{
 						NodeIdxMap[mapidx + 1] = freqidx;
@@ -235,55 +282,24 @@ namespace Compression
 			if (codeword < 256)
 			{
 				uint8_t codewordByte = static_cast<uint8_t>(codeword);
-				history[historypos++ & 0x0FFF] = codewordByte;
+				history[historypos++ & HISTORY_MASK] = codewordByte;
 				*(dst++) = codewordByte;
 			}
 			else
 			{
 				// Otherwise, get the next 8 bits from input to construct the
 				// offset to previous pixels to repeat, with the count being
-				// derived from the node's value.
-				while (validbits < 9)
-				{
-					if (src != srcend)
-					{
-						bitmask |= *(src++) << (8 - validbits);
-					}
-
-					validbits += 8;
-				}
-
-				uint8_t tableidx = bitmask >> 8;
-				bitmask <<= 8;
-				validbits -= 8;
-
-				uint16_t offsetHigh = highOffsetBits[tableidx] << 6;
-				uint16_t bitcount = lowOffsetBitCount[tableidx] - 2;
-				uint16_t offsetLow = tableidx;
-				for (uint16_t i = 0; i < bitcount; i++)
-				{
-					while (validbits < 9)
-					{
-						if (src != srcend)
-						{
-							bitmask |= *(src++) << (8 - validbits);
-						}
-
-						validbits += 8;
-					}
-
-					offsetLow = (offsetLow << 1) | ((bitmask >> 15) & 1);
-					bitmask <<= 1;
-					validbits--;
-				}
-
-				uint16_t copypos = historypos - (offsetHigh | (offsetLow & 0x003F)) - 1;
-				uint16_t tocopy = codeword - 256 + 3;
-				for (uint16_t i = 0; i < tocopy; i++)
-				{
-					*dst = history[copypos++ & 0x0FFF];
-					history[historypos++ & 0x0FFF] = *(dst++);
-				}
+				// derived from the node's value. The table gives the high bits
+				// and how many more low bits follow, which are read at once.
+				const uint8_t tableidx = static_cast<uint8_t>(readBits(8));
+				const uint16_t offsetHigh = highOffsetBits[tableidx] << 6;
+				const int bitcount = lowOffsetBitCount[tableidx] - 2;
+				const uint16_t offsetLow = static_cast<uint16_t>((tableidx << bitcount) | readBits(bitcount));
+
+				const int copypos = historypos - (offsetHigh | (offsetLow & 0x003F)) - 1;
+				const int tocopy = std::min(codeword - 256 + 3, static_cast<int>(std::distance(dst, out.end())));
+				copyFromHistory(history, historypos, copypos, tocopy, dst);
+				dst += tocopy;
 			}
 		}
 	}
@@ -1,8 +1,10 @@
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <memory>
 #include <string>
 
+#include "AssetCache.h"
 #include "ExeUnpacker.h"
 
 #include "components/debug/Debug.h"
@@ -214,6 +216,22 @@ bool ExeUnpacker::init(const char *filename)
 		return false;
 	}
 
+	// Unpacking is slow, so the result is cached on disk and keyed by the packed file's contents.
+	const auto startTime = std::chrono::steady_clock::now();
+	const std::string cacheName = std::string(filename) + ".unpacked";
+	const uint64_t sourceHash = AssetCache::hashBytes(src);
+	auto getElapsedMillisecondsString = [&startTime]()
+	{
+		const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - startTime;
+		return String::fixedPrecision(elapsed.count(), 1);
+	};
+
+	if (AssetCache::tryRead(cacheName.c_str(), sourceHash, &this->exeData))
+	{
+		DebugLog("Loaded unpacked \"" + std::string(filename) + "\" from cache in " + getElapsedMillisecondsString() + "ms.");
+		return true;
+	}
+
 	const uint8_t *srcPtr = reinterpret_cast<const uint8_t*>(src.begin());
 
 	// Generate the bit trees for "duplication mode". Since the Duplication1 table has 
@@ -439,6 +457,8 @@ bool ExeUnpacker::init(const char *filename)
 		}
 	}
 
+	AssetCache::write(cacheName.c_str(), sourceHash, this->exeData);
+	DebugLog("Unpacked \"" + std::string(filename) + "\" in " + getElapsedMillisecondsString() + "ms (not cached).");
 	return true;
 }
 
@@ -89,17 +89,32 @@ struct ChunkHeader
 	}
 };
 
+FLCFile::ImageChunk::ImageChunk(int offset, int size, bool isDelta, int paletteIndex)
+{
+	this->offset = offset;
+	this->size = size;
+	this->isDelta = isDelta;
+	this->paletteIndex = paletteIndex;
+}
+
+FLCFile::FLCFile()
+{
+	this->decodedFrameIndex = -1;
+	this->secondsPerFrame = 0.0;
+	this->width = 0;
+	this->height = 0;
+}
+
 bool FLCFile::init(const char *filename)
 {
-	Buffer<std::byte> src;
-	if (!VFS::Manager::get().read(filename, &src))
+	if (!VFS::Manager::get().read(filename, &this->data))
 	{
 		DebugLogError("Could not read \"" + std::string(filename) + "\".");
 		return false;
 	}
 
-	const uint8_t *srcPtr = reinterpret_cast<const uint8_t*>(src.begin());
-	const uint8_t *srcEnd = reinterpret_cast<const uint8_t*>(src.end());
+	const uint8_t *srcPtr = reinterpret_cast<const uint8_t*>(this->data.begin());
+	const uint8_t *srcEnd = reinterpret_cast<const uint8_t*>(this->data.end());
 
 	// Get the header data. Some of it is just miscellaneous (last updated, etc.),
 	// or only used in later versions with the EGI modifications.
@@ -126,10 +141,11 @@ bool FLCFile::init(const char *filename)
 
 	// Current state of the frame's palette indices. Completely updated by byte runs
 	// and partially updated by delta frames.
-	Buffer2D<uint8_t> framePixels(this->width, this->height);
-	framePixels.fill(0);
+	this->framePixels.init(this->width, this->height);
+	this->framePixels.fill(0);
+	this->decodedFrameIndex = -1;
 
-	// Start decoding frames. The data starts after the header.
+	// Find the image chunks. The data starts after the header.
 	uint32_t dataOffset = sizeof(FLICHeader);
 	while ((srcPtr + dataOffset) < srcEnd)
 	{
@@ -139,7 +155,7 @@ bool FLCFile::init(const char *filename)
 
 		if (frameHeader.type == FrameType::FRAME_TYPE)
 		{
-			// Check each chunk's type and decode its data if relevant.
+			// Check each chunk's type and remember it if relevant.
 			uint32_t chunkOffset = sizeof(FrameHeader);
 			for (uint16_t i = 0; i < frameHeader.chunkCount; i++)
 			{
@@ -152,11 +168,12 @@ bool FLCFile::init(const char *filename)
 				// The struct alignment of 8 means sizeof(ChunkHeader) wouldn't
 				// be accurate here, so 6 is used instead.
 				const uint8_t *chunkData = chunkPtr + 6;
+				const int chunkDataOffset = static_cast<int>(chunkData - srcPtr);
 
 				// Just concerned with palettes, full frames, and delta frames.
 				if (chunkHeader.type == ChunkType::COLOR_256)
 				{
-					// Palette.
+					// Palettes are small so they're read right away.
 					Palette palette;
 					if (!FLCFile::readPalette(chunkData, &palette))
 					{
@@ -166,21 +183,12 @@ bool FLCFile::init(const char *filename)
 
 					this->palettes.emplace_back(std::move(palette));
 				}
-				else if (chunkHeader.type == ChunkType::FLI_BRUN)
-				{
-					// Full frame chunk.
-					Buffer2D<uint8_t> frame = this->decodeFullFrame(
-						chunkData, chunkHeader.size, framePixels);
-					const int paletteIndex = static_cast<int>(this->palettes.size()) - 1;
-					this->images.emplace_back(std::make_pair(paletteIndex, std::move(frame)));
-				}
-				else if (chunkHeader.type == ChunkType::FLI_SS2)
+				else if ((chunkHeader.type == ChunkType::FLI_BRUN) || (chunkHeader.type == ChunkType::FLI_SS2))
 				{
-					// Delta frame chunk.
-					Buffer2D<uint8_t> frame = this->decodeDeltaFrame(
-						chunkData, chunkHeader.size, framePixels);
+					// Full frame or delta frame chunk.
+					const bool isDelta = chunkHeader.type == ChunkType::FLI_SS2;
 					const int paletteIndex = static_cast<int>(this->palettes.size()) - 1;
-					this->images.emplace_back(std::make_pair(paletteIndex, std::move(frame)));
+					this->imageChunks.emplace_back(ImageChunk(chunkDataOffset, chunkHeader.size, isDelta, paletteIndex));
 				}
 				else
 				{
@@ -208,7 +216,11 @@ bool FLCFile::init(const char *filename)
 
 	// Pop the last frame off, since they all seem to loop around to the beginning
 	// at the end.
-	this->images.pop_back();
+	if (!this->imageChunks.empty())
+	{
+		this->imageChunks.pop_back();
+	}
+
 	return true;
 }
 
@@ -241,11 +253,10 @@ bool FLCFile::readPalette(const uint8_t *chunkData, Palette *dst)
 	return true;
 }
 
-Buffer2D<uint8_t> FLCFile::decodeFullFrame(const uint8_t *chunkData,
-	int chunkSize, Buffer2D<uint8_t> &initialFrame)
+void FLCFile::decodeFullFrame(const uint8_t *chunkData, int chunkSize)
 {
 	// Decode a fullscreen image chunk. Most likely the first image in the FLIC.
-	Buffer<uint8_t> decomp(this->width * this->height);
+	uint8_t *decomp = this->framePixels.begin();
 
 	// The chunk data is organized in rows, and each row has packets of compressed
 	// pixels. The number of lines is the height of the FLIC.
@@ -301,18 +312,9 @@ Buffer2D<uint8_t> FLCFile::decodeFullFrame(const uint8_t *chunkData,
 			}
 		}
 	}
-
-	// Write the decoded frame to the initial (scratch) frame.
-	std::copy(decomp.begin(), decomp.end(), initialFrame.begin());
-
-	// Return a copy of the decoded frame.
-	Buffer2D<uint8_t> image(this->width, this->height);
-	std::copy(decomp.begin(), decomp.end(), image.begin());
-	return image;
 }
 
-Buffer2D<uint8_t> FLCFile::decodeDeltaFrame(const uint8_t *chunkData,
-	int chunkSize, Buffer2D<uint8_t> &initialFrame)
+void FLCFile::decodeDeltaFrame(const uint8_t *chunkData, int chunkSize)
 {
 	// Decode a delta frame chunk. The majority of FLIC frames are this format.
 
@@ -332,7 +334,7 @@ Buffer2D<uint8_t> FLCFile::decodeDeltaFrame(const uint8_t *chunkData,
 		int packetCount = 0;
 
 		// Walk through the data until a non-negative packet is found.
-		uint8_t *initialFramePtr = initialFrame.begin();
+		uint8_t *initialFramePtr = this->framePixels.begin();
 		while (offset < chunkSize)
 		{
 			const int16_t packet = Bytes::getLE16(chunkData + offset);
@@ -434,18 +436,11 @@ Buffer2D<uint8_t> FLCFile::decodeDeltaFrame(const uint8_t *chunkData,
 			}
 		}
 	}
-
-	// Use the modified initial frame as the source instead of a separate
-	// decompressed buffer.
-	const uint8_t *srcPixels = initialFrame.begin();
-	Buffer2D<uint8_t> image(this->width, this->height);
-	std::copy(srcPixels, srcPixels + (initialFrame.getWidth() * initialFrame.getHeight()), image.begin());
-	return std::move(image);
 }
 
 int FLCFile::getFrameCount() const
 {
-	return static_cast<int>(this->images.size());
+	return static_cast<int>(this->imageChunks.size());
 }
 
 double FLCFile::getSecondsPerFrame() const
@@ -465,16 +460,41 @@ int FLCFile::getHeight() const
 
 const Palette &FLCFile::getFramePalette(int index) const
 {
-	DebugAssertIndex(this->images, index);
-	const int paletteIndex = this->images[index].first;
+	DebugAssertIndex(this->imageChunks, index);
+	const int paletteIndex = this->imageChunks[index].paletteIndex;
 
 	DebugAssertIndex(this->palettes, paletteIndex);
 	return this->palettes[paletteIndex];
 }
 
-const uint8_t *FLCFile::getPixels(int index) const
+const uint8_t *FLCFile::decodeFrame(int index)
 {
-	DebugAssertIndex(this->images, index);
-	const Buffer2D<uint8_t> &image = this->images[index].second;
-	return image.begin();
+	DebugAssertIndex(this->imageChunks, index);
+
+	// Delta frames can't be undone, so start over when going backwards.
+	if (index < this->decodedFrameIndex)
+	{
+		this->framePixels.fill(0);
+		this->decodedFrameIndex = -1;
+	}
+
+	const uint8_t *srcPtr = reinterpret_cast<const uint8_t*>(this->data.begin());
+	while (this->decodedFrameIndex < index)
+	{
+		const int nextFrameIndex = this->decodedFrameIndex + 1;
+		const ImageChunk &imageChunk = this->imageChunks[nextFrameIndex];
+		const uint8_t *chunkData = srcPtr + imageChunk.offset;
+		if (imageChunk.isDelta)
+		{
+			this->decodeDeltaFrame(chunkData, imageChunk.size);
+		}
+		else
+		{
+			this->decodeFullFrame(chunkData, imageChunk.size);
+		}
+
+		this->decodedFrameIndex = nextFrameIndex;
+	}
+
+	return this->framePixels.begin();
 }
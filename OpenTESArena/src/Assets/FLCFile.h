@@ -2,12 +2,13 @@
 #define FLC_FILE_H
 
 #include <cstdint>
-#include <memory>
+#include <cstddef>
 #include <string>
 #include <vector>
 
 #include "../Utilities/Palette.h"
 
+#include "components/utilities/Buffer.h"
 #include "components/utilities/Buffer2D.h"
 
 // An .FLC file is a video file. .CEL files are nearly identical to .FLCs, though with 
@@ -29,9 +30,23 @@
 class FLCFile
 {
 private:
-	// One buffer for each frame. Each integer points into that frame's palette.
-	std::vector<std::pair<int, Buffer2D<uint8_t>>> images;
+	// Location of an image chunk in the file data. Frames are decoded on demand from these since
+	// delta frames only store changes from the previous frame.
+	struct ImageChunk
+	{
+		int offset; // Byte offset of the chunk data in the file.
+		int size;
+		bool isDelta;
+		int paletteIndex;
+
+		ImageChunk(int offset, int size, bool isDelta, int paletteIndex);
+	};
+
+	Buffer<std::byte> data; // Compressed file contents.
+	std::vector<ImageChunk> imageChunks;
 	std::vector<Palette> palettes;
+	Buffer2D<uint8_t> framePixels; // Palette indices of the most recently decoded frame.
+	int decodedFrameIndex;
 	double secondsPerFrame;
 	int width;
 	int height;
@@ -39,16 +54,15 @@ private:
 	// Reads a palette chunk and writes out the results to the reference parameter.
 	static bool readPalette(const uint8_t *chunkData, Palette *dst);
 
-	// Decodes a fullscreen FLC chunk by updating the initial frame indices and
-	// returning a complete frame.
-	Buffer2D<uint8_t> decodeFullFrame(const uint8_t *chunkData, int chunkSize,
-		Buffer2D<uint8_t> &initialFrame);
+	// Decodes a fullscreen FLC chunk by overwriting the current frame.
+	void decodeFullFrame(const uint8_t *chunkData, int chunkSize);
 
-	// Decodes a delta FLC chunk by partially updating the initial frame indices and
-	// returning a complete frame.
-	Buffer2D<uint8_t> decodeDeltaFrame(const uint8_t *chunkData, int chunkSize,
-		Buffer2D<uint8_t> &initialFrame);
+	// Decodes a delta FLC chunk by partially updating the current frame.
+	void decodeDeltaFrame(const uint8_t *chunkData, int chunkSize);
 public:
+	FLCFile();
+
+	// Reads the file and finds its frames and palettes without decoding any frames.
 	bool init(const char *filename);
 
 	int getFrameCount() const;
@@ -59,8 +73,9 @@ public:
 	// Gets the palette associated with the given frame index.
 	const Palette &getFramePalette(int index) const;
 
-	// Gets the pixel data for some frame.
-	const uint8_t *getPixels(int index) const;
+	// Decodes frames up to the given index and returns its pixel data, which is valid until the next
+	// decode. Playing forward only decodes one frame at a time; going backwards restarts from the first.
+	const uint8_t *decodeFrame(int index);
 };
 
 #endif
@@ -1,5 +1,7 @@
 #include <algorithm>
+#include <cstring>
 #include <tuple>
+#include <type_traits>
 #include <unordered_map>
 
 #include "Compression.h"
@@ -51,6 +53,120 @@ namespace
 		{ Tag_MAP1, MIFLevel::loadMAP1 },
 		{ Tag_MAP2, MIFLevel::loadMAP2 }
 	};
+
+	// Native-layout writers and readers for the cache form of decoded .MIF data. Counts are
+	// written before variable-length data.
+	template<typename T>
+	void WriteCacheValues(const T *values, int count, std::vector<uint8_t> &outData)
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+		const uint8_t *bytes = reinterpret_cast<const uint8_t*>(values);
+		outData.insert(outData.end(), bytes, bytes + (count * sizeof(T)));
+	}
+
+	template<typename T>
+	void WriteCacheValue(const T &value, std::vector<uint8_t> &outData)
+	{
+		WriteCacheValues(&value, 1, outData);
+	}
+
+	template<typename T>
+	void WriteCacheVector(const std::vector<T> &values, std::vector<uint8_t> &outData)
+	{
+		const int count = static_cast<int>(values.size());
+		WriteCacheValue(count, outData);
+		WriteCacheValues(values.data(), count, outData);
+	}
+
+	void WriteCacheString(const std::string &str, std::vector<uint8_t> &outData)
+	{
+		const int count = static_cast<int>(str.size());
+		WriteCacheValue(count, outData);
+		WriteCacheValues(str.data(), count, outData);
+	}
+
+	void WriteCacheVoxels(const Buffer2D<ArenaTypes::VoxelID> &voxels, std::vector<uint8_t> &outData)
+	{
+		// Missing tags keep an invalid buffer, written as 0x0.
+		const int width = voxels.isValid() ? voxels.getWidth() : 0;
+		const int height = voxels.isValid() ? voxels.getHeight() : 0;
+		WriteCacheValue(width, outData);
+		WriteCacheValue(height, outData);
+		WriteCacheValues(voxels.begin(), width * height, outData);
+	}
+
+	template<typename T>
+	bool TryReadCacheValues(const uint8_t **dataPtr, const uint8_t *dataEnd, int count, T *outValues)
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+		if (count < 0)
+		{
+			return false;
+		}
+
+		const size_t byteCount = count * sizeof(T);
+		if (static_cast<size_t>(dataEnd - *dataPtr) < byteCount)
+		{
+			return false;
+		}
+
+		if (byteCount > 0)
+		{
+			std::memcpy(outValues, *dataPtr, byteCount);
+		}
+
+		*dataPtr += byteCount;
+		return true;
+	}
+
+	template<typename T>
+	bool TryReadCacheValue(const uint8_t **dataPtr, const uint8_t *dataEnd, T *outValue)
+	{
+		return TryReadCacheValues(dataPtr, dataEnd, 1, outValue);
+	}
+
+	template<typename T>
+	bool TryReadCacheVector(const uint8_t **dataPtr, const uint8_t *dataEnd, std::vector<T> *outValues)
+	{
+		int count;
+		if (!TryReadCacheValue(dataPtr, dataEnd, &count) || (count < 0))
+		{
+			return false;
+		}
+
+		outValues->resize(count);
+		return TryReadCacheValues(dataPtr, dataEnd, count, outValues->data());
+	}
+
+	bool TryReadCacheString(const uint8_t **dataPtr, const uint8_t *dataEnd, std::string *outStr)
+	{
+		int count;
+		if (!TryReadCacheValue(dataPtr, dataEnd, &count) || (count < 0))
+		{
+			return false;
+		}
+
+		outStr->resize(count);
+		return TryReadCacheValues(dataPtr, dataEnd, count, outStr->data());
+	}
+
+	bool TryReadCacheVoxels(const uint8_t **dataPtr, const uint8_t *dataEnd, Buffer2D<ArenaTypes::VoxelID> *outVoxels)
+	{
+		int width, height;
+		if (!TryReadCacheValue(dataPtr, dataEnd, &width) || !TryReadCacheValue(dataPtr, dataEnd, &height) ||
+			(width < 0) || (height < 0))
+		{
+			return false;
+		}
+
+		if ((width == 0) || (height == 0))
+		{
+			return true;
+		}
+
+		outVoxels->init(width, height);
+		return TryReadCacheValues(dataPtr, dataEnd, width * height, outVoxels->begin());
+	}
 }
 
 MIFLevel::MIFLevel()
@@ -342,6 +458,40 @@ int MIFLevel::loadTRIG(MIFLevel &level, const uint8_t *tagStart)
 	return size + 6;
 }
 
+void MIFLevel::writeCacheData(std::vector<uint8_t> &outData) const
+{
+	WriteCacheString(this->name, outData);
+	WriteCacheString(this->info, outData);
+	WriteCacheValue(this->numf, outData);
+	WriteCacheVoxels(this->flor, outData);
+	WriteCacheVoxels(this->map1, outData);
+	WriteCacheVoxels(this->map2, outData);
+	WriteCacheVector(this->flat, outData);
+	WriteCacheVector(this->inns, outData);
+	WriteCacheVector(this->loot, outData);
+	WriteCacheVector(this->stor, outData);
+	WriteCacheVector(this->targ, outData);
+	WriteCacheVector(this->lock, outData);
+	WriteCacheVector(this->trig, outData);
+}
+
+bool MIFLevel::initFromCacheData(const uint8_t **dataPtr, const uint8_t *dataEnd)
+{
+	return TryReadCacheString(dataPtr, dataEnd, &this->name) &&
+		TryReadCacheString(dataPtr, dataEnd, &this->info) &&
+		TryReadCacheValue(dataPtr, dataEnd, &this->numf) &&
+		TryReadCacheVoxels(dataPtr, dataEnd, &this->flor) &&
+		TryReadCacheVoxels(dataPtr, dataEnd, &this->map1) &&
+		TryReadCacheVoxels(dataPtr, dataEnd, &this->map2) &&
+		TryReadCacheVector(dataPtr, dataEnd, &this->flat) &&
+		TryReadCacheVector(dataPtr, dataEnd, &this->inns) &&
+		TryReadCacheVector(dataPtr, dataEnd, &this->loot) &&
+		TryReadCacheVector(dataPtr, dataEnd, &this->stor) &&
+		TryReadCacheVector(dataPtr, dataEnd, &this->targ) &&
+		TryReadCacheVector(dataPtr, dataEnd, &this->lock) &&
+		TryReadCacheVector(dataPtr, dataEnd, &this->trig);
+}
+
 const std::string &MIFLevel::getName() const
 {
 	return this->name;
@@ -416,6 +566,11 @@ bool MIFFile::init(const char *filename)
 		return false;
 	}
 
+	return this->init(filename, src);
+}
+
+bool MIFFile::init(const char *filename, BufferView<const std::byte> src)
+{
 	this->filename = filename;
 	const uint8_t *srcPtr = reinterpret_cast<const uint8_t*>(src.begin());
 	const uint16_t headerSize = Bytes::getLE16(srcPtr + 4);
@@ -462,6 +617,51 @@ bool MIFFile::init(const char *filename)
 	return true;
 }
 
+void MIFFile::writeCacheData(std::vector<uint8_t> &outData) const
+{
+	WriteCacheString(this->filename, outData);
+	WriteCacheValue(this->width, outData);
+	WriteCacheValue(this->depth, outData);
+	WriteCacheValue(this->startingLevelIndex, outData);
+	WriteCacheValues(this->startPoints.data(), static_cast<int>(this->startPoints.size()), outData);
+
+	const int levelCount = static_cast<int>(this->levels.size());
+	WriteCacheValue(levelCount, outData);
+	for (const MIFLevel &level : this->levels)
+	{
+		level.writeCacheData(outData);
+	}
+}
+
+bool MIFFile::initFromCacheData(const uint8_t **dataPtr, const uint8_t *dataEnd)
+{
+	int levelCount;
+	if (!TryReadCacheString(dataPtr, dataEnd, &this->filename) ||
+		!TryReadCacheValue(dataPtr, dataEnd, &this->width) ||
+		!TryReadCacheValue(dataPtr, dataEnd, &this->depth) ||
+		!TryReadCacheValue(dataPtr, dataEnd, &this->startingLevelIndex) ||
+		!TryReadCacheValues(dataPtr, dataEnd, static_cast<int>(this->startPoints.size()), this->startPoints.data()) ||
+		!TryReadCacheValue(dataPtr, dataEnd, &levelCount) ||
+		(levelCount < 0))
+	{
+		return false;
+	}
+
+	this->levels.clear();
+	for (int i = 0; i < levelCount; i++)
+	{
+		MIFLevel level;
+		if (!level.initFromCacheData(dataPtr, dataEnd))
+		{
+			return false;
+		}
+
+		this->levels.emplace_back(std::move(level));
+	}
+
+	return true;
+}
+
 const std::string &MIFFile::getFilename() const
 {
 	return this->filename;
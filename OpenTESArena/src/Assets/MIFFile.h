@@ -2,6 +2,7 @@
 #define MIF_FILE_H
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -56,6 +57,10 @@ public:
 	static int loadTARG(MIFLevel &level, const uint8_t *tagStart);
 	static int loadTRIG(MIFLevel &level, const uint8_t *tagStart);
 
+	// Flat form of the decoded level for AssetCache. Reading advances the data pointer.
+	void writeCacheData(std::vector<uint8_t> &outData) const;
+	bool initFromCacheData(const uint8_t **dataPtr, const uint8_t *dataEnd);
+
 	const std::string &getName() const;
 	const std::string &getInfo() const;
 	int getNumf() const;
@@ -85,6 +90,12 @@ private:
 	std::vector<MIFLevel> levels;
 public:
 	bool init(const char *filename);
+	bool init(const char *filename, BufferView<const std::byte> src); // For when the file was already read.
+
+	// Flat form of the decoded file for AssetCache, so loading it skips type 8 decompression. Reading
+	// advances the data pointer.
+	void writeCacheData(std::vector<uint8_t> &outData) const;
+	bool initFromCacheData(const uint8_t **dataPtr, const uint8_t *dataEnd);
 
 	const std::string &getFilename() const;
 
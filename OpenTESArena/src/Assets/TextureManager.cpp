@@ -250,7 +250,7 @@ bool TextureManager::tryLoadTextureData(const char *filename, Buffer<TextureBuil
 			outTextures->init(flc.getFrameCount());
 			for (int i = 0; i < flc.getFrameCount(); i++)
 			{
-				TextureBuilder textureBuilder = makePaletted(flc.getWidth(), flc.getHeight(), flc.getPixels(i));
+				TextureBuilder textureBuilder = makePaletted(flc.getWidth(), flc.getHeight(), flc.decodeFrame(i));
 				outTextures->set(i, std::move(textureBuilder));
 			}
 		}
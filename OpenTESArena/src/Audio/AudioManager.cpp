@@ -1,9 +1,13 @@
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <functional>
+#include <mutex>
 #include <optional>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -13,6 +17,7 @@
 #include "alext.h" // Using local copy (+ "efx.h") to guarantee existence on system.
 #include "AudioManager.h"
 #include "MusicDefinition.h"
+#include "MusicStream.h"
 #include "WildMidi.h"
 #include "../Assets/VOCFile.h"
 #include "../Game/Options.h"
@@ -29,287 +34,261 @@
 
 std::unique_ptr<MidiDevice> MidiDevice::sInstance;
 
-class OpenALStream
+/* Plays music stream buffers through an OpenAL source. Only used by the
+ * music stream's background thread, except for the volume.
+ */
+class OpenALMusicOutput final : public MusicStreamOutput
 {
 private:
 	std::deque<ALuint> *mFreeSourcesPtr; // Free sources owned by audio manager.
-	MidiSong *mSong;
-	bool mLoop;
-
-	/* Background thread and control. */
-	std::atomic<bool> mQuit;
-	std::thread mThread;
-
-	/* Playback source and buffer queue. */
-	static constexpr int sBufferFrames = 16384;
 	ALuint mSource;
-	std::array<ALuint, 4> mBuffers;
+	std::array<ALuint, MusicStream::BUFFER_COUNT> mBuffers;
 	ALuint mBufferIdx;
-
-	/* Stream format. */
-	ALenum mFormat;
-	ALuint mSampleRate;
-	ALuint mFrameSize;
-
-	bool threadIsValid() const
+public:
+	OpenALMusicOutput(std::deque<ALuint> *freeSources)
 	{
-		return mThread.get_id() != std::thread::id();
+		mFreeSourcesPtr = freeSources;
+		mSource = 0;
+		mBuffers.fill(0);
+		mBufferIdx = 0;
 	}
 
-	/* Read samples from the song and fill the given OpenAL buffer ID (buffer
-	 * vector is for temporary storage). Returns true if the buffer was filled.
-	 */
-	bool fillBuffer(ALuint bufid, BufferView<char> buffer)
+	~OpenALMusicOutput() override
 	{
-		size_t totalSize = 0;
-		while (totalSize < buffer.getCount())
+		if (mSource)
 		{
-			const size_t framesToGet = (buffer.getCount() - totalSize) / mFrameSize;
-			const size_t framesReceived = mSong->read(buffer.begin() + totalSize, framesToGet);
+			/* Stop the source, remove the buffers, then put it back so it can
+			 * be used again.
+			 */
+			alSourceRewind(mSource);
+			alSourcei(mSource, AL_BUFFER, 0);
+			mFreeSourcesPtr->push_front(mSource);
+		}
+		/* Delete the buffers used for the queue. */
+		alDeleteBuffers(static_cast<ALsizei>(mBuffers.size()), mBuffers.data());
+	}
 
-			bool shouldBreak = false;
-			if (framesReceived < framesToGet)
-			{
-				if (mLoop)
-				{
-					/* End of song, rewind to loop. */
-					const size_t beginOffset = 0;
-					const bool success = mSong->seek(beginOffset);
-					if (!success)
-					{
-						break;
-					}
-				}
-				else
-				{
-					/* Don't receive more song data. */
-					shouldBreak = true;
-				}
-			}
+	bool init(ALuint source, float volume)
+	{
+		DebugAssert(mSource == 0);
 
-			totalSize += framesReceived * mFrameSize;
+		/* Clear existing errors */
+		alGetError();
 
-			if (shouldBreak)
-			{
-				break;
-			}
+		alGenBuffers(static_cast<ALsizei>(mBuffers.size()), mBuffers.data());
+		if (alGetError() != AL_NO_ERROR)
+		{
+			mBuffers.fill(0);
+			return false;
 		}
 
-		if (totalSize == 0)
+		/* Set the default properties for localized playback */
+		alSource3f(source, AL_DIRECTION, 0.0f, 0.0f, 0.0f);
+		alSource3f(source, AL_VELOCITY, 0.0f, 0.0f, 0.0f);
+		alSource3f(source, AL_POSITION, 0.0f, 0.0f, 0.0f);
+		alSourcef(source, AL_GAIN, volume);
+		alSourcef(source, AL_PITCH, 1.0f);
+		alSourcef(source, AL_ROLLOFF_FACTOR, 0.0f);
+		alSourcef(source, AL_SEC_OFFSET, 0.0f);
+		alSourcei(source, AL_SOURCE_RELATIVE, AL_TRUE);
+		alSourcei(source, AL_LOOPING, AL_FALSE);
+
+		if (alGetError() != AL_NO_ERROR)
 			return false;
 
-		std::fill(buffer.begin() + totalSize, buffer.end(), 0);
-		alBufferData(bufid, mFormat, buffer.begin(), static_cast<ALsizei>(buffer.getCount()), mSampleRate);
+		mSource = source;
 		return true;
 	}
 
-	/* Fill buffers to fill up the source queue. Returns the number of buffers
-	 * queued.
-	 */
-	ALint fillBufferQueue(BufferView<char> buffer)
+	void setVolume(float volume)
+	{
+		DebugAssert(mSource != 0);
+		alSourcef(mSource, AL_GAIN, volume);
+	}
+
+	int getQueuedBufferCount() override
 	{
 		ALint queued;
 		alGetSourcei(mSource, AL_BUFFERS_QUEUED, &queued);
-		while (queued < mBuffers.size())
-		{
-			ALuint bufid = mBuffers[mBufferIdx];
-			if (!fillBuffer(bufid, buffer))
-				break;
-			mBufferIdx = (mBufferIdx + 1) % mBuffers.size();
-			alSourceQueueBuffers(mSource, 1, &bufid);
-			queued++;
-		}
 		return queued;
 	}
 
-	/* A method run in a backround thread, to keep filling the queue with new
-	 * audio over time.
-	 */
-	void backgroundProc()
+	int getProcessedBufferCount() override
 	{
-		/* Temporary storage to read samples into, before passing to OpenAL.
-		 * Kept here to avoid reallocating it during playback.
-		 */
-		Buffer<char> buffer(sBufferFrames * mFrameSize);
+		ALint processed;
+		alGetSourcei(mSource, AL_BUFFERS_PROCESSED, &processed);
+		return processed;
+	}
+
+	int getPlayedFrameCount() override
+	{
+		ALint offset;
+		alGetSourcei(mSource, AL_SAMPLE_OFFSET, &offset);
+		return offset;
+	}
 
-		while (!mQuit.load())
+	bool isPlaying() override
+	{
+		ALint state;
+		alGetSourcei(mSource, AL_SOURCE_STATE, &state);
+		return (state == AL_PLAYING) || (state == AL_PAUSED);
+	}
+
+	void queueBuffer(BufferView<const char> pcm, int sampleRate) override
+	{
+		const ALuint bufid = mBuffers[mBufferIdx];
+		alBufferData(bufid, AL_FORMAT_STEREO16, pcm.begin(), static_cast<ALsizei>(pcm.getCount()), sampleRate);
+		alSourceQueueBuffers(mSource, 1, &bufid);
+		mBufferIdx = (mBufferIdx + 1) % mBuffers.size();
+	}
+
+	void unqueueProcessedBuffers() override
+	{
+		ALint processed;
+		alGetSourcei(mSource, AL_BUFFERS_PROCESSED, &processed);
+		while (processed > 0)
 		{
-			/* First, make sure the buffer queue is filled. */
-			fillBufferQueue(buffer);
+			ALuint bufid;
+			alSourceUnqueueBuffers(mSource, 1, &bufid);
+			processed--;
+		}
+	}
+
+	void play() override
+	{
+		alSourcePlay(mSource);
+	}
+
+	void stop() override
+	{
+		alSourceRewind(mSource);
+		alSourcei(mSource, AL_BUFFER, 0);
+		mBufferIdx = 0;
+	}
+};
 
-			ALint state;
-			alGetSourcei(mSource, AL_SOURCE_STATE, &state);
-			if (state != AL_PLAYING && state != AL_PAUSED)
+/* Decodes .VOC files on a background thread so sound playback never waits on
+ * disk. Decoded PCM data is handed back to the audio manager, which uploads it
+ * to OpenAL on the main thread.
+ */
+class SoundDecoder
+{
+public:
+	struct Result
+	{
+		std::string filename;
+		std::vector<uint8_t> audioData;
+		int sampleRate;
+		bool success;
+	};
+private:
+	std::mutex mMutex;
+	std::condition_variable mRequestCondition; // Signaled when a request is queued or on quit.
+	std::condition_variable mIdleCondition; // Signaled when a request finishes.
+	std::deque<std::string> mRequests;
+	std::vector<Result> mResults;
+	int mDecodingCount; // Requests taken off the queue but not finished yet.
+	bool mQuit;
+	std::thread mThread;
+
+	void backgroundProc()
+	{
+		while (true)
+		{
+			std::string filename;
 			{
-				/* If the source is not playing or paused, it either underrun
-				 * or hasn't started at all yet. So remove any buffers that
-				 * have been played (will be 0 when first starting).
-				 */
-				ALint processed;
-				alGetSourcei(mSource, AL_BUFFERS_PROCESSED, &processed);
-				while (processed > 0)
-				{
-					ALuint bufid;
-					alSourceUnqueueBuffers(mSource, 1, &bufid);
-					processed--;
-				}
-
-				/* Make sure the buffer queue is still filled, in case another
-				 * buffer had finished before checking the state and after the
-				 * last fill. If the queue is empty, playback is over.
-				 */
-				if (fillBufferQueue(buffer) == 0)
-				{
-					mQuit.store(true);
+				std::unique_lock<std::mutex> lock(mMutex);
+				mRequestCondition.wait(lock, [this]() { return mQuit || !mRequests.empty(); });
+				if (mQuit)
 					return;
-				}
 
-				/* Now start the sound source. */
-				alSourcePlay(mSource);
+				filename = std::move(mRequests.front());
+				mRequests.pop_front();
+				mDecodingCount++;
 			}
 
-			ALint processed;
-			alGetSourcei(mSource, AL_BUFFERS_PROCESSED, &processed);
-			if (processed == 0)
+			/* Read and decode outside the lock so new requests can be queued
+			 * meanwhile.
+			 */
+			Result result;
+			result.filename = std::move(filename);
+			result.sampleRate = 0;
+
+			VOCFile voc;
+			result.success = voc.init(result.filename.c_str());
+			if (result.success)
 			{
-				/* Wait until a buffer in the queue has been processed. */
-				do {
-					std::this_thread::sleep_for(std::chrono::milliseconds(50));
-					if (mQuit.load()) break;
-					alGetSourcei(mSource, AL_BUFFERS_PROCESSED, &processed);
-				} while (processed == 0);
+				const BufferView<const uint8_t> audioData = voc.getAudioData();
+				result.audioData.assign(audioData.begin(), audioData.end());
+				result.sampleRate = voc.getSampleRate();
 			}
-			/* Remove processed buffers, then restart the loop to keep the
-			 * queue filled.
-			 */
-			while (processed > 0)
+
 			{
-				ALuint bufid;
-				alSourceUnqueueBuffers(mSource, 1, &bufid);
-				processed--;
+				std::lock_guard<std::mutex> lock(mMutex);
+				mResults.emplace_back(std::move(result));
+				mDecodingCount--;
 			}
+
+			mIdleCondition.notify_all();
 		}
 	}
-
 public:
-	OpenALStream(std::deque<ALuint> *freeSources, MidiSong *song)
-		: mQuit(false)
+	SoundDecoder()
 	{
-		mFreeSourcesPtr = freeSources;
-		mSong = song;
-		mSource = 0;
-		mBuffers.fill(0);
-		mBufferIdx = 0;
-		mSampleRate = 0;
-		mLoop = false;
+		mDecodingCount = 0;
+		mQuit = false;
 	}
 
-	~OpenALStream()
+	~SoundDecoder()
 	{
-		if (threadIsValid())
 		{
-			/* Tell the thread to quit and wait for it to stop. */
-			mQuit.store(true);
-			mThread.join();
-		}
-		if (mSource)
-		{
-			/* Stop the source, remove the buffers, then put it back so it can
-			 * be used again.
-			 */
-			alSourceRewind(mSource);
-			alSourcei(mSource, AL_BUFFER, 0);
-			mFreeSourcesPtr->push_front(mSource);
+			std::lock_guard<std::mutex> lock(mMutex);
+			mQuit = true;
 		}
-		/* Delete the buffers used for the queue. */
-		alDeleteBuffers(static_cast<ALsizei>(mBuffers.size()), mBuffers.data());
-	}
 
-	bool isPlaying() const
-	{
-		return threadIsValid() && !mQuit.load();
-	}
+		mRequestCondition.notify_all();
 
-	void play()
-	{
-		/* If the source is already playing (thread exists and isn't stopped),
-		 * don't do anything.
-		 */
-		if (threadIsValid())
-		{
-			if (!mQuit.load())
-				return;
+		if (mThread.joinable())
 			mThread.join();
-		}
-
-		/* Reset the source and clear any buffers that may be on it. */
-		alSourceRewind(mSource);
-		alSourcei(mSource, AL_BUFFER, 0);
-		mBufferIdx = 0;
-		mQuit.store(false);
+	}
 
-		/* Start the background thread processing. */
-		mThread = std::thread(std::mem_fn(&OpenALStream::backgroundProc), this);
+	void start()
+	{
+		DebugAssert(!mThread.joinable());
+		mThread = std::thread(std::mem_fn(&SoundDecoder::backgroundProc), this);
 	}
 
-	void stop()
+	void queue(const std::string &filename)
 	{
-		if (threadIsValid())
 		{
-			mQuit.store(true);
-			mThread.join();
+			std::lock_guard<std::mutex> lock(mMutex);
+			mRequests.emplace_back(filename);
 		}
 
-		alSourceRewind(mSource);
-		alSourcei(mSource, AL_BUFFER, 0);
-		mBufferIdx = 0;
+		mRequestCondition.notify_one();
 	}
 
-	void setVolume(float volume)
+	/* Blocks until every queued request has been decoded. Only meant for load
+	 * screens and scene changes, never during gameplay frames.
+	 */
+	void waitUntilIdle()
 	{
-		DebugAssert(mSource != 0);
-		alSourcef(mSource, AL_GAIN, volume);
+		std::unique_lock<std::mutex> lock(mMutex);
+		mIdleCondition.wait(lock, [this]() { return mRequests.empty() && (mDecodingCount == 0); });
 	}
 
-	bool init(ALuint source, float volume, bool loop)
+	/* Moves any finished results into the output parameter. Never blocks on
+	 * decoding.
+	 */
+	void takeResults(std::vector<Result> &outResults)
 	{
-		DebugAssert(mSource == 0);
-
-		/* Clear existing errors */
-		alGetError();
-
-		alGenBuffers(static_cast<ALsizei>(mBuffers.size()), mBuffers.data());
-		if (alGetError() != AL_NO_ERROR)
+		std::lock_guard<std::mutex> lock(mMutex);
+		for (Result &result : mResults)
 		{
-			mBuffers.fill(0);
-			return false;
+			outResults.emplace_back(std::move(result));
 		}
 
-		/* Set the default properties for localized playback */
-		alSource3f(source, AL_DIRECTION, 0.0f, 0.0f, 0.0f);
-		alSource3f(source, AL_VELOCITY, 0.0f, 0.0f, 0.0f);
-		alSource3f(source, AL_POSITION, 0.0f, 0.0f, 0.0f);
-		alSourcef(source, AL_GAIN, volume);
-		alSourcef(source, AL_PITCH, 1.0f);
-		alSourcef(source, AL_ROLLOFF_FACTOR, 0.0f);
-		alSourcef(source, AL_SEC_OFFSET, 0.0f);
-		alSourcei(source, AL_SOURCE_RELATIVE, AL_TRUE);
-		alSourcei(source, AL_LOOPING, AL_FALSE);
-
-		if (alGetError() != AL_NO_ERROR)
-			return false;
-
-		int srate;
-		mSong->getFormat(&srate);
-
-		/* Currently hard-coded to 16-bit stereo. */
-		mFormat = AL_FORMAT_STEREO16;
-		mFrameSize = 4;
-		mSampleRate = srate;
-
-		mSource = source;
-		mLoop = loop;
-		return true;
+		mResults.clear();
 	}
 };
 
@@ -333,11 +312,17 @@ AudioManager::AudioManager()
 	mHasResamplerExtension = false;
 	mResampler = -1;
 	mIs3D = false;
+	mListenerPosition = Double3::Zero;
 }
 
 AudioManager::~AudioManager()
 {
-	this->stopMusic();
+	// Stop decoding before any buffers are deleted. The music stream's thread is joined before its output
+	// returns the music source.
+	mSoundDecoder = nullptr;
+	mMusicStream = nullptr;
+	mMusicOutput = nullptr;
+
 	this->stopSound();
 
 	MidiDevice::shutdown();
@@ -355,13 +340,16 @@ AudioManager::~AudioManager()
 
 	mFreeSources.clear();
 
-	for (auto &pair : mSoundBuffers)
+	for (const SoundEntry &sound : mSounds)
 	{
-		ALuint buffer = pair.second;
-		alDeleteBuffers(1, &buffer);
+		if (sound.buffer != 0)
+		{
+			alDeleteBuffers(1, &sound.buffer);
+		}
 	}
 
-	mSoundBuffers.clear();
+	mSounds.clear();
+	mSoundIDs.clear();
 
 	ALCdevice *device = alcGetContextsDevice(context);
 	alcMakeContextCurrent(nullptr);
@@ -435,6 +423,24 @@ void AudioManager::init(double musicVolume, double soundVolume, int maxChannels,
 		mFreeSources.emplace_back(source);
 	}
 
+	// One source is kept for music for the whole session so track changes never wait on setting it up.
+	if (MidiDevice::isInited() && !mFreeSources.empty())
+	{
+		mMusicOutput = std::make_unique<OpenALMusicOutput>(&mFreeSources);
+		if (mMusicOutput->init(mFreeSources.front(), static_cast<float>(musicVolume)))
+		{
+			mFreeSources.pop_front();
+			mMusicStream = std::make_unique<MusicStream>(*mMusicOutput,
+				[](const std::string &filename) { return MidiDevice::get().open(filename); });
+			mMusicStream->start();
+		}
+		else
+		{
+			DebugLogWarning("Failed to init music stream output.");
+			mMusicOutput = nullptr;
+		}
+	}
+
 	this->setMusicVolume(musicVolume);
 	this->setSoundVolume(soundVolume);
 	this->setListenerPosition(Double3::Zero);
@@ -448,14 +454,19 @@ void AudioManager::init(double musicVolume, double soundVolume, int maxChannels,
 	{
 		for (int i = 0; i < singleInstanceSoundsFile.getLineCount(); i++)
 		{
-			std::string soundFilename = singleInstanceSoundsFile.getLine(i);
-			mSingleInstanceSounds.emplace_back(std::move(soundFilename));
+			const std::string &soundFilename = singleInstanceSoundsFile.getLine(i);
+			const SoundID soundID = this->getSoundID(soundFilename);
+			mSounds[soundID].isSingleInstance = true;
 		}
 	}
 	else
 	{
 		DebugLogWarning("Missing single instance sounds file at \"" + singleInstanceSoundsPath + "\".");
 	}
+
+	// Sounds are decoded off the main thread from here on.
+	mSoundDecoder = std::make_unique<SoundDecoder>();
+	mSoundDecoder->start();
 }
 
 double AudioManager::getMusicVolume() const
@@ -473,16 +484,48 @@ bool AudioManager::hasResamplerExtension() const
 	return mHasResamplerExtension;
 }
 
+SoundID AudioManager::getSoundID(const std::string &filename)
+{
+	const auto iter = mSoundIDs.find(filename);
+	if (iter != mSoundIDs.end())
+	{
+		return iter->second;
+	}
+
+	const SoundID soundID = static_cast<SoundID>(mSounds.size());
+
+	SoundEntry sound;
+	sound.filename = filename;
+	sound.buffer = 0;
+	sound.instanceCount = 0;
+	sound.deferredCount = 0;
+	sound.isPending = false;
+	sound.isMissing = false;
+	sound.isSingleInstance = false;
+	mSounds.emplace_back(std::move(sound));
+
+	mSoundIDs.emplace(filename, soundID);
+	return soundID;
+}
+
+bool AudioManager::isPlayingSound(SoundID soundID) const
+{
+	DebugAssertIndex(mSounds, soundID);
+	const SoundEntry &sound = mSounds[soundID];
+
+	// A sound waiting on decoding counts as playing so callers don't start something over it.
+	return (sound.instanceCount > 0) || (sound.deferredCount > 0);
+}
+
 bool AudioManager::isPlayingSound(const std::string &filename) const
 {
-	// Check through used sources' filenames.
-	const auto iter = std::find_if(mUsedSources.begin(), mUsedSources.end(),
-		[&filename](const std::pair<std::string, ALuint> &pair)
+	const auto iter = mSoundIDs.find(filename);
+	if (iter == mSoundIDs.end())
 	{
-		return pair.first == filename;
-	});
+		return false;
+	}
 
-	return iter != mUsedSources.end();
+	return this->isPlayingSound(iter->second);
 }
 
 bool AudioManager::soundExists(const std::string &filename) const
@@ -527,17 +570,13 @@ ALint AudioManager::getResamplingIndex(int resamplingOption)
 	}
 }
 
-bool AudioManager::hasNextMusic() const
-{
-	return !this->mNextSong.empty();
-}
-
 void AudioManager::setListenerPosition(const Double3 &position)
 {
 	const ALfloat posX = static_cast<ALfloat>(position.x);
 	const ALfloat posY = static_cast<ALfloat>(position.y);
 	const ALfloat posZ = static_cast<ALfloat>(position.z);
 	alListener3f(AL_POSITION, posX, posY, posZ);
+	mListenerPosition = position;
 }
 
 void AudioManager::setListenerOrientation(const Double3 &direction)
@@ -560,112 +599,270 @@ void AudioManager::setListenerOrientation(const Double3 &direction)
 	alListenerfv(AL_ORIENTATION, orientation.data());
 }
 
-void AudioManager::playSound(const std::string &filename, const std::optional<Double3> &position)
+void AudioManager::uploadDecodedSounds()
 {
-	// Certain sounds should only have one live instance at a time. This is purely an arbitrary
-	// rule to avoid having long sounds overlap each other which would be very annoying and/or
-	// distracting for the player.
-	const bool isSingleInstance = std::find(mSingleInstanceSounds.begin(),
-		mSingleInstanceSounds.end(), filename) != mSingleInstanceSounds.end();
-	const bool allowedToPlay = !isSingleInstance ||
-		(isSingleInstance && !this->isPlayingSound(filename));
+	if (mSoundDecoder == nullptr)
+	{
+		return;
+	}
 
-	if (!mFreeSources.empty() && allowedToPlay)
+	std::vector<SoundDecoder::Result> results;
+	mSoundDecoder->takeResults(results);
+
+	for (const SoundDecoder::Result &result : results)
 	{
-		auto vocIter = mSoundBuffers.find(filename);
+		const auto iter = mSoundIDs.find(result.filename);
+		DebugAssert(iter != mSoundIDs.end());
+		SoundEntry &sound = mSounds[iter->second];
+		sound.isPending = false;
 
-		if (vocIter == mSoundBuffers.end())
+		if (!result.success)
 		{
-			// Load the .VOC file and give its PCM data to a new OpenAL buffer.
-			VOCFile voc;
-			if (!voc.init(filename.c_str()))
-			{
-				DebugCrash("Could not init .VOC file \"" + filename + "\".");
-			}
+			DebugLogWarning("Could not init .VOC file \"" + result.filename + "\".");
+			sound.isMissing = true;
+			continue;
+		}
 
-			// Clear OpenAL error.
-			alGetError();
+		// Clear OpenAL error.
+		alGetError();
 
-			ALuint bufferID;
-			alGenBuffers(1, &bufferID);
+		ALuint bufferID;
+		alGenBuffers(1, &bufferID);
 
-			const ALenum status = alGetError();
-			if (status != AL_NO_ERROR)
-			{
-				DebugLogWarning("alGenBuffers() error 0x" + String::toHexString(status));
-			}
+		const ALenum status = alGetError();
+		if (status != AL_NO_ERROR)
+		{
+			DebugLogWarning("alGenBuffers() error 0x" + String::toHexString(status));
+		}
 
-			const BufferView<const uint8_t> audioData = voc.getAudioData();
+		alBufferData(bufferID, AL_FORMAT_MONO8,
+			static_cast<const ALvoid*>(result.audioData.data()),
+			static_cast<ALsizei>(result.audioData.size()),
+			static_cast<ALsizei>(result.sampleRate));
 
-			alBufferData(bufferID, AL_FORMAT_MONO8,
-				static_cast<const ALvoid*>(audioData.begin()),
-				static_cast<ALsizei>(audioData.getCount()),
-				static_cast<ALsizei>(voc.getSampleRate()));
+		sound.buffer = bufferID;
+	}
+}
 
-			vocIter = mSoundBuffers.emplace(filename, bufferID).first;
-		}
+void AudioManager::queueSoundDecode(SoundID soundID)
+{
+	DebugAssert(mSoundDecoder != nullptr);
+	DebugAssertIndex(mSounds, soundID);
 
-		// Set up the sound source.
-		const ALuint source = mFreeSources.front();
-		alSourcei(source, AL_BUFFER, vocIter->second);
+	SoundEntry &sound = mSounds[soundID];
+	if ((sound.buffer == 0) && !sound.isPending && !sound.isMissing)
+	{
+		mSoundDecoder->queue(sound.filename);
+		sound.isPending = true;
+	}
+}
 
-		// Play the sound in 3D if it has a position and we are set to 3D mode.
-		// Otherwise, play it in 2D centered on the listener.
-		if (position.has_value() && mIs3D)
-		{
-			alSourcei(source, AL_SOURCE_RELATIVE, AL_FALSE);
-			const Double3 &positionValue = *position;
-			const ALfloat posX = static_cast<ALfloat>(positionValue.x);
-			const ALfloat posY = static_cast<ALfloat>(positionValue.y);
-			const ALfloat posZ = static_cast<ALfloat>(positionValue.z);
-			alSource3f(source, AL_POSITION, posX, posY, posZ);
-		}
-		else
+void AudioManager::preloadSounds(BufferView<const std::string> filenames)
+{
+	if (mSoundDecoder == nullptr)
+	{
+		return;
+	}
+
+	for (const std::string &filename : filenames)
+	{
+		if (!filename.empty())
 		{
-			alSourcei(source, AL_SOURCE_RELATIVE, AL_TRUE);
-			alSource3f(source, AL_POSITION, 0.0f, 0.0f, 0.0f);
+			const SoundID soundID = this->getSoundID(filename);
+			this->queueSoundDecode(soundID);
 		}
+	}
+}
 
-		// Set resampling if the extension is supported.
-		if (mHasResamplerExtension)
+void AudioManager::waitForPreloadedSounds()
+{
+	if (mSoundDecoder == nullptr)
+	{
+		return;
+	}
+
+	mSoundDecoder->waitUntilIdle();
+	this->uploadDecodedSounds();
+}
+
+double AudioManager::getVoiceDistanceSqr(const std::optional<Double3> &position) const
+{
+	// Global sounds are centered on the listener.
+	if (!position.has_value() || !mIs3D)
+	{
+		return 0.0;
+	}
+
+	const Double3 diff = *position - mListenerPosition;
+	return diff.lengthSquared();
+}
+
+std::optional<int> AudioManager::tryGetStealableVoiceIndex(SoundPriority priority, const std::optional<Double3> &position) const
+{
+	// Pick the least important voice: lowest priority, then farthest away.
+	std::optional<int> bestIndex;
+	SoundPriority bestPriority = SoundPriority::High;
+	double bestDistanceSqr = 0.0;
+	for (int i = 0; i < static_cast<int>(mActiveVoices.size()); i++)
+	{
+		const ActiveVoice &voice = mActiveVoices[i];
+		const double distanceSqr = this->getVoiceDistanceSqr(voice.position);
+		const bool isBetter = !bestIndex.has_value() || (voice.priority < bestPriority) ||
+			((voice.priority == bestPriority) && (distanceSqr > bestDistanceSqr));
+		if (isBetter)
 		{
-			alSourcei(source, AL_SOURCE_RESAMPLER_SOFT, mResampler);
+			bestIndex = i;
+			bestPriority = voice.priority;
+			bestDistanceSqr = distanceSqr;
 		}
+	}
 
-		// Play the sound.
-		alSourcePlay(source);
+	if (!bestIndex.has_value())
+	{
+		return std::nullopt;
+	}
 
-		mUsedSources.push_front(std::make_pair(filename, source));
-		mFreeSources.pop_front();
+	// Only take over a voice the new sound is more important than, otherwise a burst of sounds
+	// would keep cutting each other off.
+	const double newDistanceSqr = this->getVoiceDistanceSqr(position);
+	const bool canSteal = (priority > bestPriority) ||
+		((priority == bestPriority) && (newDistanceSqr < bestDistanceSqr));
+	if (!canSteal)
+	{
+		return std::nullopt;
 	}
+
+	return bestIndex;
 }
 
-void AudioManager::playMusic(const std::string &filename, bool loop)
+void AudioManager::releaseVoice(int index)
 {
-	stopMusic();
+	DebugAssertIndex(mActiveVoices, index);
+	const ActiveVoice &voice = mActiveVoices[index];
+	const ALuint source = voice.source;
+	alSourceStop(source);
+	alSourceRewind(source);
+	alSourcei(source, AL_BUFFER, 0);
+
+	if (mHasResamplerExtension)
+	{
+		const ALint defaultResampler = AudioManager::getDefaultResampler();
+		alSourcei(source, AL_SOURCE_RESAMPLER_SOFT, defaultResampler);
+	}
+
+	DebugAssertIndex(mSounds, voice.soundID);
+	SoundEntry &sound = mSounds[voice.soundID];
+	DebugAssert(sound.instanceCount > 0);
+	sound.instanceCount--;
+
+	mFreeSources.push_front(source);
+
+	// Order of active voices doesn't matter.
+	mActiveVoices[index] = mActiveVoices.back();
+	mActiveVoices.pop_back();
+}
+
+void AudioManager::playSound(SoundID soundID, const std::optional<Double3> &position, SoundPriority priority)
+{
+	DebugAssertIndex(mSounds, soundID);
+	SoundEntry &sound = mSounds[soundID];
+
+	// Certain sounds should only have one live instance at a time. This is purely an arbitrary
+	// rule to avoid having long sounds overlap each other which would be very annoying and/or
+	// distracting for the player.
+	const bool allowedToPlay = !sound.isSingleInstance || (sound.instanceCount == 0);
+	if (!allowedToPlay || sound.isMissing)
+	{
+		return;
+	}
 
-	if (!mFreeSources.empty())
+	if (sound.buffer == 0)
 	{
-		if (MidiDevice::isInited())
-			mCurrentSong = MidiDevice::get().open(filename);
-		if (!mCurrentSong)
+		if (mSoundDecoder == nullptr)
 		{
-			DebugLogWarning("Failed to play " + filename + ".");
 			return;
 		}
 
-		mSongStream = std::make_unique<OpenALStream>(&mFreeSources, mCurrentSong.get());
-		if (mSongStream->init(mFreeSources.front(), mMusicVolume, loop))
-		{
-			mFreeSources.pop_front();
-			mSongStream->play();
-			DebugLog("Playing music " + filename + ".");
-		}
-		else
+		// Not loaded yet. Decode it in the background and start playing once it's uploaded instead of
+		// stalling this frame on disk.
+		this->queueSoundDecode(soundID);
+
+		DeferredSound deferredSound;
+		deferredSound.soundID = soundID;
+		deferredSound.position = position;
+		deferredSound.priority = priority;
+		mDeferredSounds.emplace_back(std::move(deferredSound));
+		sound.deferredCount++;
+		return;
+	}
+
+	if (mFreeSources.empty())
+	{
+		const std::optional<int> stealIndex = this->tryGetStealableVoiceIndex(priority, position);
+		if (!stealIndex.has_value())
 		{
-			DebugLogWarning("Failed to init " + filename + " stream.");
+			return;
 		}
+
+		this->releaseVoice(*stealIndex);
+	}
+
+	// Set up the sound source.
+	const ALuint source = mFreeSources.front();
+	alSourcei(source, AL_BUFFER, sound.buffer);
+
+	// Play the sound in 3D if it has a position and we are set to 3D mode.
+	// Otherwise, play it in 2D centered on the listener.
+	if (position.has_value() && mIs3D)
+	{
+		alSourcei(source, AL_SOURCE_RELATIVE, AL_FALSE);
+		const Double3 &positionValue = *position;
+		const ALfloat posX = static_cast<ALfloat>(positionValue.x);
+		const ALfloat posY = static_cast<ALfloat>(positionValue.y);
+		const ALfloat posZ = static_cast<ALfloat>(positionValue.z);
+		alSource3f(source, AL_POSITION, posX, posY, posZ);
+	}
+	else
+	{
+		alSourcei(source, AL_SOURCE_RELATIVE, AL_TRUE);
+		alSource3f(source, AL_POSITION, 0.0f, 0.0f, 0.0f);
+	}
+
+	// Set resampling if the extension is supported.
+	if (mHasResamplerExtension)
+	{
+		alSourcei(source, AL_SOURCE_RESAMPLER_SOFT, mResampler);
 	}
+
+	// Play the sound.
+	alSourcePlay(source);
+
+	ActiveVoice voice;
+	voice.source = source;
+	voice.soundID = soundID;
+	voice.priority = priority;
+	voice.position = position;
+	mActiveVoices.emplace_back(std::move(voice));
+	mFreeSources.pop_front();
+	sound.instanceCount++;
+}
+
+void AudioManager::playSound(const std::string &filename, const std::optional<Double3> &position, SoundPriority priority)
+{
+	const SoundID soundID = this->getSoundID(filename);
+	this->playSound(soundID, position, priority);
+}
+
+void AudioManager::playMusic(const std::string &filename, bool loop)
+{
+	if (mMusicStream == nullptr)
+	{
+		DebugLogWarning("Failed to play " + filename + ", no music stream.");
+		return;
+	}
+
+	const bool replaceCurrent = true;
+	mMusicStream->setNextSong(filename, loop, replaceCurrent);
 }
 
 void AudioManager::setMusic(const MusicDefinition *musicDef, const MusicDefinition *optMusicDef)
@@ -678,7 +875,16 @@ void AudioManager::setMusic(const MusicDefinition *musicDef, const MusicDefiniti
 		this->playMusic(optFilename, loop);
 
 		DebugAssert(musicDef != nullptr);
-		mNextSong = musicDef->getFilename();
+		const std::string &filename = musicDef->getFilename();
+
+		// Assume that the next music always loops. The stream decodes the start of it while the optional
+		// music plays and continues into it without restarting the source.
+		const bool nextLoop = true;
+		if (mMusicStream != nullptr)
+		{
+			const bool replaceCurrent = false;
+			mMusicStream->setNextSong(filename, nextLoop, replaceCurrent);
+		}
 	}
 	else if (musicDef != nullptr)
 	{
@@ -696,44 +902,35 @@ void AudioManager::setMusic(const MusicDefinition *musicDef, const MusicDefiniti
 
 void AudioManager::stopMusic()
 {
-	if (mSongStream != nullptr)
+	if (mMusicStream != nullptr)
 	{
-		mSongStream->stop();
+		mMusicStream->stopSong();
 	}
-
-	mSongStream = nullptr;
-	mCurrentSong = nullptr;
 }
 
 void AudioManager::stopSound()
 {
 	// Reset all used sources and return them to the free sources.
-	for (const auto &pair : mUsedSources)
+	while (!mActiveVoices.empty())
 	{
-		const ALuint source = pair.second;
-		alSourceStop(source);
-		alSourceRewind(source);
-		alSourcei(source, AL_BUFFER, 0);
-
-		if (mHasResamplerExtension)
-		{
-			const ALint defaultResampler = AudioManager::getDefaultResampler();
-			alSourcei(source, AL_SOURCE_RESAMPLER_SOFT, defaultResampler);
-		}
+		this->releaseVoice(static_cast<int>(mActiveVoices.size()) - 1);
+	}
 
-		mFreeSources.push_front(source);
+	for (const DeferredSound &deferredSound : mDeferredSounds)
+	{
+		mSounds[deferredSound.soundID].deferredCount--;
 	}
 
-	mUsedSources.clear();
+	mDeferredSounds.clear();
 }
 
 void AudioManager::setMusicVolume(double percent)
 {
 	mMusicVolume = static_cast<float>(percent);
 
-	if (mSongStream != nullptr)
+	if (mMusicOutput != nullptr)
 	{
-		mSongStream->setVolume(mMusicVolume);
+		mMusicOutput->setVolume(mMusicVolume);
 	}
 }
 
@@ -747,10 +944,9 @@ void AudioManager::setSoundVolume(double percent)
 		alSourcef(source, AL_GAIN, mSfxVolume);
 	}
 
-	for (const auto &pair : mUsedSources)
+	for (const ActiveVoice &voice : mActiveVoices)
 	{
-		const ALuint source = pair.second;
-		alSourcef(source, AL_GAIN, mSfxVolume);
+		alSourcef(voice.source, AL_GAIN, mSfxVolume);
 	}
 }
 
@@ -768,10 +964,9 @@ void AudioManager::setResamplingOption(int resamplingOption)
 		alSourcei(source, AL_SOURCE_RESAMPLER_SOFT, mResampler);
 	}
 
-	for (const auto &pair : mUsedSources)
+	for (const ActiveVoice &voice : mActiveVoices)
 	{
-		const ALuint source = pair.second;
-		alSourcei(source, AL_SOURCE_RESAMPLER_SOFT, mResampler);
+		alSourcei(voice.source, AL_SOURCE_RESAMPLER_SOFT, mResampler);
 	}
 }
 
@@ -783,9 +978,9 @@ void AudioManager::set3D(bool is3D)
 
 void AudioManager::updateSources()
 {
-	for (size_t i = 0; i < mUsedSources.size(); i++)
+	for (int i = static_cast<int>(mActiveVoices.size()) - 1; i >= 0; i--)
 	{
-		const ALuint source = mUsedSources[i].second;
+		const ALuint source = mActiveVoices[i].source;
 
 		ALint state;
 		alGetSourcei(source, AL_SOURCE_STATE, &state);
@@ -793,30 +988,30 @@ void AudioManager::updateSources()
 		// If a sound source is done, reset it and return the ID to the free sources.
 		if (state == AL_STOPPED)
 		{
-			alSourceRewind(source);
-			alSourcei(source, AL_BUFFER, 0);
-
-			if (mHasResamplerExtension)
-			{
-				const ALint defaultResampler = AudioManager::getDefaultResampler();
-				alSourcei(source, AL_SOURCE_RESAMPLER_SOFT, defaultResampler);
-			}
-
-			mFreeSources.push_front(source);
-			mUsedSources.erase(mUsedSources.begin() + i);
+			this->releaseVoice(i);
 		}
 	}
 
-	// Check if another music is staged and should start when the current one is done.
-	if (this->hasNextMusic())
+	// Start any sounds that were waiting on background decoding.
+	this->uploadDecodedSounds();
+
+	if (!mDeferredSounds.empty())
 	{
-		const bool canChangeToNextMusic = (mSongStream == nullptr) || !mSongStream->isPlaying();
-		if (canChangeToNextMusic)
+		std::vector<DeferredSound> deferredSounds = std::move(mDeferredSounds);
+		mDeferredSounds.clear();
+
+		for (DeferredSound &deferredSound : deferredSounds)
 		{
-			// Assume that the next music always loops.
-			const bool loop = true;
-			this->playMusic(mNextSong, loop);
-			mNextSong.clear();
+			SoundEntry &sound = mSounds[deferredSound.soundID];
+			if (sound.isPending)
+			{
+				mDeferredSounds.emplace_back(std::move(deferredSound));
+			}
+			else
+			{
+				sound.deferredCount--;
+				this->playSound(deferredSound.soundID, deferredSound.position, deferredSound.priority);
+			}
 		}
 	}
 }
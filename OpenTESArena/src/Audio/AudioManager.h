@@ -11,14 +11,19 @@
 #include "al.h"
 
 #include "Midi.h"
+#include "SoundUtils.h"
 
 #include "../Math/Vector3.h"
 
+#include "components/utilities/BufferView.h"
+
 // This class manages what sounds and music are played by OpenAL Soft.
 
 class MusicDefinition;
-class OpenALStream;
+class MusicStream;
+class OpenALMusicOutput;
 class Options;
+class SoundDecoder;
 
 class AudioManager
 {
@@ -36,6 +41,39 @@ public:
 		const Double3 &getDirection() const;
 	};
 private:
+	// Per-sound state, indexed by sound ID.
+	struct SoundEntry
+	{
+		std::string filename;
+		ALuint buffer; // Zero if not uploaded yet.
+		int instanceCount; // Number of voices currently playing this sound.
+		int deferredCount; // Number of requests waiting on decoding before they can play.
+		bool isPending; // Queued for background decoding.
+		bool isMissing; // Failed to decode, never played.
+
+		// Sounds which are allowed only one active instance at a time, otherwise they would
+		// sound a bit obnoxious. This functionality is added here because the original game
+		// can only play one sound at a time, so it doesn't have this problem.
+		bool isSingleInstance;
+	};
+
+	// A source currently playing a sound (the music source is owned by OpenALMusicOutput).
+	struct ActiveVoice
+	{
+		ALuint source;
+		SoundID soundID;
+		SoundPriority priority;
+		std::optional<Double3> position; // Empty if played globally.
+	};
+
+	// A sound requested before its buffer was decoded. It starts once the buffer is uploaded.
+	struct DeferredSound
+	{
+		SoundID soundID;
+		std::optional<Double3> position;
+		SoundPriority priority;
+	};
+
 	static constexpr ALint UNSUPPORTED_EXTENSION = -1;
 
 	float mMusicVolume;
@@ -44,28 +82,26 @@ private:
 
 	ALint mResampler;
 	bool mIs3D;
-	std::string mNextSong;
+	Double3 mListenerPosition;
 
-	// Sounds which are allowed only one active instance at a time, otherwise they would
-	// sound a bit obnoxious. This functionality is added here because the original game
-	// can only play one sound at a time, so it doesn't have this problem.
-	std::vector<std::string> mSingleInstanceSounds;
+	// Music playback. The stream's thread lives until shutdown and owns the current song and any song queued
+	// after it. Null if there's no MIDI device or no source for music.
+	std::unique_ptr<OpenALMusicOutput> mMusicOutput;
+	std::unique_ptr<MusicStream> mMusicStream;
 
-	// Currently active song and playback stream.
-	MidiSongPtr mCurrentSong;
-	std::unique_ptr<OpenALStream> mSongStream;
+	// Interned sounds. Filenames are only looked up when interning.
+	std::vector<SoundEntry> mSounds;
+	std::unordered_map<std::string, SoundID> mSoundIDs;
 
-	// Loaded sound buffers from .VOC files.
-	std::unordered_map<std::string, ALuint> mSoundBuffers;
+	// Background .VOC decoding.
+	std::unique_ptr<SoundDecoder> mSoundDecoder;
+	std::vector<DeferredSound> mDeferredSounds;
 
 	// A deque of available sources to play sounds and streams with.
 	std::deque<ALuint> mFreeSources;
 
-	// A deque of currently used sources for sounds (the music source is owned
-	// by OpenALStream). The string is the filename and the integer is the ID.
-	// The filename is required for some sounds that can only have one instance
-	// active at a time.
-	std::deque<std::pair<std::string, ALuint>> mUsedSources;
+	// Sources currently playing sounds.
+	std::vector<ActiveVoice> mActiveVoices;
 
 	// Use this when resetting sound sources back to their default resampling. This uses
 	// whatever setting is the default within OpenAL.
@@ -76,13 +112,26 @@ private:
 	// if the resampling extension is unsupported.
 	static ALint getResamplingIndex(int value);
 
-	// Whether there is a music queued after the current one.
-	bool hasNextMusic() const;
-
 	void setListenerPosition(const Double3 &position);
 	void setListenerOrientation(const Double3 &direction);
 
 	void playMusic(const std::string &filename, bool loop);
+
+	// Queues a sound for background decoding if it isn't loaded or already queued.
+	void queueSoundDecode(SoundID soundID);
+
+	// Gives any sounds finished decoding to OpenAL. Does not block on decoding.
+	void uploadDecodedSounds();
+
+	// Squared distance from the listener to a voice, for deciding which voice is least audible.
+	double getVoiceDistanceSqr(const std::optional<Double3> &position) const;
+
+	// Finds the index of the voice a new sound with the given priority and position may take over when
+	// no sources are free, if any. Lower priority voices go first, then the farthest from the listener.
+	std::optional<int> tryGetStealableVoiceIndex(SoundPriority priority, const std::optional<Double3> &position) const;
+
+	// Stops a voice's source and returns it to the free sources.
+	void releaseVoice(int index);
 public:
 	AudioManager();
 	~AudioManager();
@@ -99,16 +148,31 @@ public:
 	// Returns whether the implementation supports resampling options.
 	bool hasResamplerExtension() const;
 
-	// Returns whether the given filename is playing in any sound handle.
+	// Gets the interned handle for a sound filename, adding it if needed. Callers that play the same
+	// sound repeatedly should keep the handle instead of the filename.
+	SoundID getSoundID(const std::string &filename);
+
+	// Returns whether the given sound is playing in any sound handle.
+	bool isPlayingSound(SoundID soundID) const;
 	bool isPlayingSound(const std::string &filename) const;
 
 	// Returns whether the given filename references an actual sound.
 	bool soundExists(const std::string &filename) const;
 
 	// Plays a sound file. All sounds should play once. If 'position' is empty then the sound
-	// is played globally.
-	void playSound(const std::string &filename,
-		const std::optional<Double3> &position = std::nullopt);
+	// is played globally. If no sources are free, the sound takes over a less important one
+	// or is dropped.
+	void playSound(SoundID soundID, const std::optional<Double3> &position = std::nullopt,
+		SoundPriority priority = SoundPriority::Normal);
+	void playSound(const std::string &filename, const std::optional<Double3> &position = std::nullopt,
+		SoundPriority priority = SoundPriority::Normal);
+
+	// Queues sounds for background decoding so they're ready before they're first played.
+	void preloadSounds(BufferView<const std::string> filenames);
+
+	// Blocks until all queued sounds are decoded and uploaded. Intended for scene changes so a level's
+	// sounds are ready before its first frame.
+	void waitForPreloadedSounds();
 
 	// Sets the music to the given music definition, with an optional music to play first as a
 	// lead-in to the actual music. If no music definition is given, the current music is stopped.
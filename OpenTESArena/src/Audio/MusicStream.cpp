@@ -0,0 +1,368 @@
+#include <algorithm>
+
+#include "MusicStream.h"
+
+#include "components/debug/Debug.h"
+
+MusicStream::MusicStream(MusicStreamOutput &output, SongOpenFunc &&openFunc)
+	: mOpenFunc(std::move(openFunc)), mBuffer(BUFFER_FRAMES * FRAME_SIZE), mUnderrunCount(0)
+{
+	mOutput = &output;
+	mSampleRate = 0;
+	mLoop = false;
+	mSongPcmOffset = 0;
+	mNextSampleRate = 0;
+	mNextSongLoop = false;
+	mHasStarted = false;
+	mStopRequested = false;
+	mQuit = false;
+}
+
+MusicStream::~MusicStream()
+{
+	if (mThread.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mQuit = true;
+		}
+
+		mWakeCondition.notify_all();
+		mThread.join();
+	}
+}
+
+MidiSongPtr MusicStream::openSong(const std::string &filename, int *outSampleRate)
+{
+	MidiSongPtr song = mOpenFunc(filename);
+	if (!song)
+	{
+		DebugLogWarning("Failed to open music " + filename + ".");
+		return nullptr;
+	}
+
+	song->getFormat(outSampleRate);
+	return song;
+}
+
+size_t MusicStream::readFrames(char *buffer, size_t count, bool *outIsSongEnd)
+{
+	size_t framesRead = 0;
+	const size_t pcmFramesLeft = (mSongPcm.size() - mSongPcmOffset) / FRAME_SIZE;
+	if (pcmFramesLeft > 0)
+	{
+		framesRead = std::min(count, pcmFramesLeft);
+		const size_t bytesToCopy = framesRead * FRAME_SIZE;
+		std::copy(mSongPcm.begin() + mSongPcmOffset, mSongPcm.begin() + mSongPcmOffset + bytesToCopy, buffer);
+		mSongPcmOffset += bytesToCopy;
+	}
+
+	// Running out of pre-decoded frames only means the rest comes from the song; only a short read from the
+	// song itself is the end of it.
+	*outIsSongEnd = false;
+	if (framesRead < count)
+	{
+		const size_t framesToRead = count - framesRead;
+		const size_t songFramesRead = mSong->read(buffer + (framesRead * FRAME_SIZE), framesToRead);
+		framesRead += songFramesRead;
+		*outIsSongEnd = songFramesRead < framesToRead;
+	}
+
+	return framesRead;
+}
+
+void MusicStream::prepareNextSong(const SongRequest &request)
+{
+	mNextSong = nullptr;
+	mNextSongPcm.clear();
+
+	int sampleRate;
+	MidiSongPtr song = this->openSong(request.filename, &sampleRate);
+	if (!song)
+	{
+		return;
+	}
+
+	// Songs continue into each other within a buffer, so they must share a sample rate.
+	if (mSong && (sampleRate != mSampleRate))
+	{
+		DebugLogWarning("Next music " + request.filename + " sample rate " + std::to_string(sampleRate) +
+			" doesn't match stream sample rate " + std::to_string(mSampleRate) + ".");
+		return;
+	}
+
+	mNextSongPcm.resize(MAX_PRERENDER_FRAMES * FRAME_SIZE);
+	const size_t framesReceived = song->read(mNextSongPcm.data(), MAX_PRERENDER_FRAMES);
+	mNextSongPcm.resize(framesReceived * FRAME_SIZE);
+	mNextSong = std::move(song);
+	mNextSampleRate = sampleRate;
+	mNextSongLoop = request.loop;
+}
+
+bool MusicStream::tryBeginNextSong()
+{
+	if (!mNextSong)
+	{
+		return false;
+	}
+
+	mSong = std::move(mNextSong);
+	mSampleRate = mNextSampleRate;
+	mSongPcm = std::move(mNextSongPcm);
+	mSongPcmOffset = 0;
+	mLoop = mNextSongLoop;
+	mNextSongPcm.clear();
+	return true;
+}
+
+bool MusicStream::fillBuffer()
+{
+	if (!mSong)
+	{
+		return false;
+	}
+
+	const int sampleRate = mSampleRate;
+	size_t framesFilled = 0;
+	bool isRewound = false;
+	while (framesFilled < BUFFER_FRAMES)
+	{
+		bool isSongEnd;
+		const size_t framesReceived = this->readFrames(mBuffer.begin() + (framesFilled * FRAME_SIZE),
+			BUFFER_FRAMES - framesFilled, &isSongEnd);
+		framesFilled += framesReceived;
+
+		if (!isSongEnd)
+		{
+			continue;
+		}
+
+		// A looping song that was just rewound and still has nothing to read is empty.
+		const bool isEmptyLoop = isRewound && (framesReceived == 0);
+		if (mLoop && !isEmptyLoop)
+		{
+			// Rewind to loop. The pre-decoded start is read from the song again.
+			constexpr size_t beginOffset = 0;
+			if (mSong->seek(beginOffset))
+			{
+				mSongPcm.clear();
+				mSongPcmOffset = 0;
+				isRewound = true;
+				continue;
+			}
+		}
+		else if (this->tryBeginNextSong())
+		{
+			isRewound = false;
+			continue;
+		}
+
+		// No more song data.
+		mSong = nullptr;
+		mSongPcm.clear();
+		mSongPcmOffset = 0;
+		break;
+	}
+
+	if (framesFilled == 0)
+	{
+		return false;
+	}
+
+	std::fill(mBuffer.begin() + (framesFilled * FRAME_SIZE), mBuffer.end(), 0);
+	mOutput->queueBuffer(mBuffer, sampleRate);
+	return true;
+}
+
+int MusicStream::fillBufferQueue()
+{
+	int queued = mOutput->getQueuedBufferCount();
+	while (queued < BUFFER_COUNT)
+	{
+		if (!this->fillBuffer())
+		{
+			break;
+		}
+
+		queued++;
+	}
+
+	return queued;
+}
+
+void MusicStream::handleRequests()
+{
+	std::optional<SongRequest> songRequest, nextSongRequest;
+	bool stopRequested;
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		songRequest = std::move(mRequestedSong);
+		nextSongRequest = std::move(mRequestedNextSong);
+		stopRequested = mStopRequested;
+		mRequestedSong = std::nullopt;
+		mRequestedNextSong = std::nullopt;
+		mStopRequested = false;
+	}
+
+	if (stopRequested || songRequest.has_value())
+	{
+		mOutput->stop();
+		mHasStarted = false;
+		mSong = nullptr;
+		mSongPcm.clear();
+		mSongPcmOffset = 0;
+		mNextSong = nullptr;
+		mNextSongPcm.clear();
+	}
+
+	if (songRequest.has_value())
+	{
+		int sampleRate;
+		MidiSongPtr song = this->openSong(songRequest->filename, &sampleRate);
+		if (song)
+		{
+			mSong = std::move(song);
+			mSampleRate = sampleRate;
+			mLoop = songRequest->loop;
+			DebugLog("Playing music " + songRequest->filename + ".");
+		}
+	}
+
+	if (nextSongRequest.has_value())
+	{
+		this->prepareNextSong(*nextSongRequest);
+
+		if (!mSong && this->tryBeginNextSong())
+		{
+			DebugLog("Playing music " + nextSongRequest->filename + ".");
+		}
+	}
+}
+
+bool MusicStream::hasRequest() const
+{
+	return mQuit || mStopRequested || mRequestedSong.has_value() || mRequestedNextSong.has_value();
+}
+
+std::chrono::microseconds MusicStream::getRefillWaitTime()
+{
+	// The earliest a buffer can be refilled is when the oldest queued buffer finishes playing. With a full
+	// queue, the remaining buffers are slack for a late wakeup.
+	if (mOutput->getProcessedBufferCount() > 0)
+	{
+		return std::chrono::microseconds(0);
+	}
+
+	const int playedFrames = mOutput->getPlayedFrameCount();
+	const int remainingFrames = std::clamp(BUFFER_FRAMES - playedFrames, 0, BUFFER_FRAMES);
+	const int sampleRate = std::max(mSampleRate, 1);
+	const int64_t remainingMicroseconds = (static_cast<int64_t>(remainingFrames) * 1000000) / sampleRate;
+	return std::chrono::microseconds(remainingMicroseconds);
+}
+
+void MusicStream::backgroundProc()
+{
+	while (true)
+	{
+		this->update();
+
+		// Sleep until a request if there's nothing left to play, otherwise until a buffer can be refilled.
+		const bool isIdle = mOutput->getQueuedBufferCount() == 0;
+		const std::chrono::microseconds waitTime = !isIdle ? this->getRefillWaitTime() : std::chrono::microseconds(0);
+
+		std::unique_lock<std::mutex> lock(mMutex);
+		if (isIdle)
+		{
+			mWakeCondition.wait(lock, [this]() { return this->hasRequest(); });
+		}
+		else
+		{
+			mWakeCondition.wait_for(lock, waitTime, [this]() { return this->hasRequest(); });
+		}
+
+		if (mQuit)
+		{
+			return;
+		}
+	}
+}
+
+void MusicStream::start()
+{
+	DebugAssert(!mThread.joinable());
+	mThread = std::thread([this]() { this->backgroundProc(); });
+}
+
+void MusicStream::setNextSong(const std::string &filename, bool loop, bool replaceCurrent)
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		SongRequest request;
+		request.filename = filename;
+		request.loop = loop;
+
+		if (replaceCurrent)
+		{
+			// Anything requested to follow the old song no longer applies.
+			mRequestedSong = std::move(request);
+			mRequestedNextSong = std::nullopt;
+			mStopRequested = false;
+		}
+		else
+		{
+			mRequestedNextSong = std::move(request);
+		}
+	}
+
+	mWakeCondition.notify_one();
+}
+
+void MusicStream::stopSong()
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mRequestedSong = std::nullopt;
+		mRequestedNextSong = std::nullopt;
+		mStopRequested = true;
+	}
+
+	mWakeCondition.notify_one();
+}
+
+int MusicStream::getUnderrunCount() const
+{
+	return mUnderrunCount.load();
+}
+
+void MusicStream::update()
+{
+	this->handleRequests();
+
+	// Remove played buffers and make sure the queue is filled.
+	mOutput->unqueueProcessedBuffers();
+	this->fillBufferQueue();
+
+	if (!mOutput->isPlaying())
+	{
+		/* If the output is not playing or paused, it either underran or
+		 * hasn't started at all yet. Make sure the buffer queue is still
+		 * filled, in case another buffer had finished before checking the
+		 * state and after the last fill. If the queue is empty, playback is
+		 * over until the next request.
+		 */
+		mOutput->unqueueProcessedBuffers();
+		if (this->fillBufferQueue() == 0)
+		{
+			mHasStarted = false;
+			return;
+		}
+
+		if (mHasStarted)
+		{
+			mUnderrunCount++;
+		}
+
+		mOutput->play();
+		mHasStarted = true;
+	}
+}
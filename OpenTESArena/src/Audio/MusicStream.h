@@ -0,0 +1,147 @@
+#ifndef MUSIC_STREAM_H
+#define MUSIC_STREAM_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Midi.h"
+
+#include "components/utilities/Buffer.h"
+#include "components/utilities/BufferView.h"
+
+// Destination for decoded music, i.e. an OpenAL source with a queue of buffers. Only used by the music
+// stream's background thread (or whatever drives its updates), so implementations don't need locking.
+class MusicStreamOutput
+{
+public:
+	virtual ~MusicStreamOutput() = default;
+
+	virtual int getQueuedBufferCount() = 0;
+	virtual int getProcessedBufferCount() = 0;
+
+	// Frames already played of the oldest queued buffer.
+	virtual int getPlayedFrameCount() = 0;
+
+	// Whether the output is playing or paused, as opposed to stopped or never started.
+	virtual bool isPlaying() = 0;
+
+	virtual void queueBuffer(BufferView<const char> pcm, int sampleRate) = 0;
+	virtual void unqueueProcessedBuffers() = 0;
+	virtual void play() = 0;
+
+	// Stops playback and removes all queued buffers.
+	virtual void stop() = 0;
+};
+
+// Decodes music into an output's buffer queue. One background thread lives as long as the stream and does all
+// song opening and decoding, so track changes are only requests and the game thread never waits on them.
+class MusicStream
+{
+public:
+	using SongOpenFunc = std::function<MidiSongPtr(const std::string &filename)>;
+
+	static constexpr int BUFFER_COUNT = 4;
+	static constexpr int BUFFER_FRAMES = 16384;
+	static constexpr int FRAME_SIZE = 4; // Currently hard-coded to 16-bit stereo.
+
+	// Frames decoded ahead of time from the start of the next song while the current one plays.
+	static constexpr int MAX_PRERENDER_FRAMES = BUFFER_FRAMES * 4;
+private:
+	struct SongRequest
+	{
+		std::string filename;
+		bool loop;
+	};
+
+	MusicStreamOutput *mOutput;
+	SongOpenFunc mOpenFunc;
+
+	/* Current song. The start of it might have been decoded ahead of time,
+	 * played before reading any further from the song.
+	 */
+	MidiSongPtr mSong;
+	int mSampleRate;
+	bool mLoop;
+	std::vector<char> mSongPcm;
+	size_t mSongPcmOffset;
+
+	/* Song to continue with once the current one ends, so track changes
+	 * don't restart the output.
+	 */
+	MidiSongPtr mNextSong;
+	int mNextSampleRate;
+	std::vector<char> mNextSongPcm;
+	bool mNextSongLoop;
+
+	bool mHasStarted; // Whether the output was started since it last ran out of audio.
+	Buffer<char> mBuffer; // Temporary storage for one output buffer, reused during playback.
+	std::atomic<int> mUnderrunCount; // Times the output ran dry while there was still audio to queue.
+
+	/* Requests from other threads, guarded by the mutex. The background
+	 * thread sleeps until the oldest queued buffer is due to finish or
+	 * there's a new request.
+	 */
+	std::mutex mMutex;
+	std::condition_variable mWakeCondition;
+	std::optional<SongRequest> mRequestedSong; // Replaces the current song.
+	std::optional<SongRequest> mRequestedNextSong; // Continues after the current song.
+	bool mStopRequested;
+	bool mQuit;
+	std::thread mThread;
+
+	MidiSongPtr openSong(const std::string &filename, int *outSampleRate);
+
+	// Reads sample frames from the pre-decoded start of the song if any are left, then from the song itself.
+	size_t readFrames(char *buffer, size_t count, bool *outIsSongEnd);
+
+	// Opens the next song and decodes its start.
+	void prepareNextSong(const SongRequest &request);
+
+	// Switches to the next song if there is one. Returns true if playback can continue.
+	bool tryBeginNextSong();
+
+	// Reads one buffer's worth of the song and queues it. Returns true if anything was queued.
+	bool fillBuffer();
+
+	// Fills buffers until the output queue is full. Returns the number of queued buffers.
+	int fillBufferQueue();
+
+	void handleRequests();
+	bool hasRequest() const;
+	std::chrono::microseconds getRefillWaitTime();
+	void backgroundProc();
+public:
+	MusicStream(MusicStreamOutput &output, SongOpenFunc &&openFunc);
+	MusicStream(const MusicStream&) = delete;
+	MusicStream(MusicStream&&) = delete;
+	~MusicStream();
+
+	MusicStream &operator=(const MusicStream&) = delete;
+	MusicStream &operator=(MusicStream&&) = delete;
+
+	// Starts the background thread that updates the stream until it's destroyed.
+	void start();
+
+	// Requests a song, either replacing the current one immediately or continuing with it once the current
+	// one ends. The song starts right away if nothing is playing.
+	void setNextSong(const std::string &filename, bool loop, bool replaceCurrent);
+
+	// Requests that the current and next songs stop.
+	void stopSong();
+
+	int getUnderrunCount() const;
+
+	// One iteration of the background thread: handles requests and keeps the output queue filled. Public so
+	// the stream can be driven without the thread and an audio device.
+	void update();
+};
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef SOUND_UTILS_H
+#define SOUND_UTILS_H
+
+// Sound handles and playback settings shared by the audio manager and anything that stores sounds to
+// play later, without needing the OpenAL headers.
+
+// Interned handle to a sound filename. Valid for the lifetime of the audio manager.
+using SoundID = int;
+
+// Sounds with higher priority can take a voice from lower priority sounds when all voices are in use.
+enum class SoundPriority
+{
+	Low,
+	Normal,
+	High
+};
+
+#endif
@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <array>
 #include <cmath>
 
 #include "Physics.h"
@@ -17,6 +18,7 @@
 #include "../World/MeshUtils.h"
 
 #include "components/debug/Debug.h"
+#include "components/utilities/Allocator.h"
 
 namespace Physics
 {
@@ -24,8 +26,14 @@ namespace Physics
 	// entities in case some of them overlap the chunk edge.
 	struct ChunkEntityMap
 	{
+		using VisStateList = FrameVector<EntityVisibilityState3D>;
+		using MappingAllocator = FrameAllocator<std::pair<const VoxelInt3, VisStateList>>;
+
 		ChunkInt2 chunk;
-		std::unordered_map<VoxelInt3, std::vector<EntityVisibilityState3D>> mappings;
+		std::unordered_map<VoxelInt3, VisStateList, std::hash<VoxelInt3>, std::equal_to<VoxelInt3>, MappingAllocator> mappings;
+
+		ChunkEntityMap(FrameArena &frameArena)
+			: mappings(0, std::hash<VoxelInt3>(), std::equal_to<VoxelInt3>(), MappingAllocator(frameArena)) { }
 
 		void init(const ChunkInt2 &chunk)
 		{
@@ -37,19 +45,110 @@ namespace Physics
 			auto iter = this->mappings.find(voxel);
 			if (iter == this->mappings.end())
 			{
-				iter = this->mappings.emplace(voxel, std::vector<EntityVisibilityState3D>()).first;
+				iter = this->mappings.emplace(voxel, VisStateList(this->mappings.get_allocator())).first;
 			}
 
-			std::vector<EntityVisibilityState3D> &visStateList = iter->second;
+			VisStateList &visStateList = iter->second;
 			visStateList.emplace_back(visState);
 		}
 	};
 
+	// Chunk pointers touched by ray casts. Consecutive DDA steps and rays in a batch tend to stay within a few
+	// chunks, so this avoids repeating the chunk managers' linear searches for every voxel. Entries live inline
+	// so a cast never allocates for them; once full, the oldest entry is replaced.
+	struct ChunkLookupCache
+	{
+		struct Entry
+		{
+			ChunkInt2 chunk;
+			const VoxelChunk *voxelChunk;
+			const CollisionChunk *collisionChunk;
+		};
+
+		static constexpr int MAX_ENTRIES = 16;
+
+		const VoxelChunkManager *voxelChunkManager;
+		const CollisionChunkManager *collisionChunkManager;
+		std::array<Entry, MAX_ENTRIES> entries;
+		int entryCount;
+		int nextReplaceIndex;
+
+		void init(const VoxelChunkManager &voxelChunkManager, const CollisionChunkManager &collisionChunkManager)
+		{
+			this->voxelChunkManager = &voxelChunkManager;
+			this->collisionChunkManager = &collisionChunkManager;
+			this->entryCount = 0;
+			this->nextReplaceIndex = 0;
+		}
+
+		const Entry &getEntry(const ChunkInt2 &chunk)
+		{
+			for (int i = 0; i < this->entryCount; i++)
+			{
+				const Entry &entry = this->entries[i];
+				if (entry.chunk == chunk)
+				{
+					return entry;
+				}
+			}
+
+			int index;
+			if (this->entryCount < MAX_ENTRIES)
+			{
+				index = this->entryCount;
+				this->entryCount++;
+			}
+			else
+			{
+				index = this->nextReplaceIndex;
+				this->nextReplaceIndex = (this->nextReplaceIndex + 1) % MAX_ENTRIES;
+			}
+
+			Entry &newEntry = this->entries[index];
+			newEntry.chunk = chunk;
+			newEntry.voxelChunk = this->voxelChunkManager->tryGetChunkAtPosition(chunk);
+			newEntry.collisionChunk = this->collisionChunkManager->tryGetChunkAtPosition(chunk);
+			return newEntry;
+		}
+
+		const VoxelChunk *tryGetVoxelChunk(const ChunkInt2 &chunk)
+		{
+			return this->getEntry(chunk).voxelChunk;
+		}
+
+		const CollisionChunk *tryGetCollisionChunk(const ChunkInt2 &chunk)
+		{
+			return this->getEntry(chunk).collisionChunk;
+		}
+	};
+
+	// Voxel->entity mappings for rays that share a start point. The mappings depend on the view point
+	// (for entity animation angles), so they can only be shared between rays cast from the same place.
+	struct ViewEntityMaps
+	{
+		CoordDouble3 viewCoord;
+		FrameVector<ChunkEntityMap> chunkEntityMaps;
+
+		ViewEntityMaps(FrameArena &frameArena)
+			: chunkEntityMaps(FrameAllocator<ChunkEntityMap>(frameArena)) { }
+
+		void init(const CoordDouble3 &viewCoord)
+		{
+			this->viewCoord = viewCoord;
+			this->chunkEntityMaps.clear();
+		}
+
+		bool matches(const CoordDouble3 &coord) const
+		{
+			return (this->viewCoord.chunk == coord.chunk) && (this->viewCoord.point == coord.point);
+		}
+	};
+
 	// Builds a set of voxels for a chunk that are at least partially touched by entities. A point of reference
 	// is needed for evaluating entity animations. Ignores entities behind the camera.
 	Physics::ChunkEntityMap makeChunkEntityMap(const ChunkInt2 &chunk, const CoordDouble3 &viewCoord,
 		double ceilingScale, const VoxelChunkManager &voxelChunkManager, const EntityChunkManager &entityChunkManager,
-		const EntityDefinitionLibrary &entityDefLibrary)
+		const EntityDefinitionLibrary &entityDefLibrary, FrameArena &frameArena)
 	{
 		// Include entities within one chunk of the center chunk to get entities that are partially touching
 		// the center chunk.
@@ -76,14 +175,13 @@ namespace Physics
 			return count;
 		}();
 
-		Buffer<EntityInstanceID> entityInstIDs(totalNearbyEntities);
-		entityInstIDs.fill(-1);
+		FrameVector<EntityInstanceID> entityInstIDs(totalNearbyEntities, -1, FrameAllocator<EntityInstanceID>(frameArena));
 
 		int entityInsertIndex = 0;
 		auto addEntitiesFromChunk = [&entityChunkManager, &entityInstIDs, &entityInsertIndex](SNInt chunkX, WEInt chunkZ)
 		{
-			EntityInstanceID *entityInstIDsPtr = entityInstIDs.begin() + entityInsertIndex;
-			const int size = entityInstIDs.getCount() - entityInsertIndex;
+			EntityInstanceID *entityInstIDsPtr = entityInstIDs.data() + entityInsertIndex;
+			const int size = static_cast<int>(entityInstIDs.size()) - entityInsertIndex;
 			const EntityChunk *entityChunkPtr = entityChunkManager.tryGetChunkAtPosition(ChunkInt2(chunkX, chunkZ));
 			if (entityChunkPtr != nullptr)
 			{
@@ -112,7 +210,7 @@ namespace Physics
 			}
 		}
 
-		ChunkEntityMap chunkEntityMap;
+		ChunkEntityMap chunkEntityMap(frameArena);
 		chunkEntityMap.init(chunk);
 
 		// Build mappings of voxels to entities.
@@ -162,7 +260,7 @@ namespace Physics
 	// The given chunk coordinate is known to be loaded.
 	const ChunkEntityMap &getOrAddChunkEntityMap(const ChunkInt2 &chunk, const CoordDouble3 &viewCoord,
 		double ceilingScale, const VoxelChunkManager &voxelChunkManager, const EntityChunkManager &entityChunkManager,
-		const EntityDefinitionLibrary &entityDefLibrary, std::vector<ChunkEntityMap> &chunkEntityMaps)
+		const EntityDefinitionLibrary &entityDefLibrary, FrameVector<ChunkEntityMap> &chunkEntityMaps)
 	{
 		for (const ChunkEntityMap &map : chunkEntityMaps)
 		{
@@ -172,8 +270,10 @@ namespace Physics
 			}
 		}
 
+		// The new map lives in the same arena as the list it's added to.
+		FrameArena &frameArena = *chunkEntityMaps.get_allocator().getArena();
 		ChunkEntityMap newMap = Physics::makeChunkEntityMap(chunk, viewCoord, ceilingScale, voxelChunkManager,
-			entityChunkManager, entityDefLibrary);
+			entityChunkManager, entityDefLibrary, frameArena);
 		chunkEntityMaps.emplace_back(std::move(newMap));
 		return chunkEntityMaps.back();
 	}
@@ -229,17 +329,16 @@ namespace Physics
 	// Checks an initial voxel for ray hits and writes them into the output parameter.
 	// Returns true if the ray hit something.
 	bool testInitialVoxelRay(const CoordDouble3 &rayCoord, const VoxelDouble3 &rayDirection, const VoxelInt3 &voxel,
-		VoxelFacing3D farFacing, double ceilingScale, const VoxelChunkManager &voxelChunkManager,
-		const CollisionChunkManager &collisionChunkManager, Physics::Hit &hit)
+		VoxelFacing3D farFacing, double ceilingScale, ChunkLookupCache &chunkLookupCache, Physics::Hit &hit)
 	{
-		const VoxelChunk *voxelChunk = voxelChunkManager.tryGetChunkAtPosition(rayCoord.chunk);
+		const VoxelChunk *voxelChunk = chunkLookupCache.tryGetVoxelChunk(rayCoord.chunk);
 		if (voxelChunk == nullptr)
 		{
 			// Nothing to intersect with.
 			return false;
 		}
 
-		const CollisionChunk *collisionChunk = collisionChunkManager.tryGetChunkAtPosition(rayCoord.chunk);
+		const CollisionChunk *collisionChunk = chunkLookupCache.tryGetCollisionChunk(rayCoord.chunk);
 		DebugAssert(collisionChunk != nullptr);
 
 		if (!voxelChunk->isValidVoxel(voxel.x, voxel.y, voxel.z))
@@ -331,17 +430,16 @@ namespace Physics
 	// are in the voxel coord's chunk, not necessarily the ray's. Returns true if the ray hit something.
 	bool testVoxelRay(const CoordDouble3 &rayCoord, const VoxelDouble3 &rayDirection, const CoordInt3 &voxelCoord,
 		VoxelFacing3D nearFacing, const CoordDouble3 &nearCoord, const CoordDouble3 &farCoord,
-		double ceilingScale, const VoxelChunkManager &voxelChunkManager, const CollisionChunkManager &collisionChunkManager,
-		Physics::Hit &hit)
+		double ceilingScale, ChunkLookupCache &chunkLookupCache, Physics::Hit &hit)
 	{
-		const VoxelChunk *voxelChunk = voxelChunkManager.tryGetChunkAtPosition(rayCoord.chunk);
+		const VoxelChunk *voxelChunk = chunkLookupCache.tryGetVoxelChunk(rayCoord.chunk);
 		if (voxelChunk == nullptr)
 		{
 			// Nothing to intersect with.
 			return false;
 		}
 
-		const CollisionChunk *collisionChunk = collisionChunkManager.tryGetChunkAtPosition(rayCoord.chunk);
+		const CollisionChunk *collisionChunk = chunkLookupCache.tryGetCollisionChunk(rayCoord.chunk);
 		DebugAssert(collisionChunk != nullptr);
 
 		const VoxelInt3 &voxel = voxelCoord.voxel;
@@ -446,7 +544,7 @@ namespace Physics
 		if (iter != entityMappings.end())
 		{
 			// Iterate over all the entities that cross this voxel and ray test them.
-			const std::vector<EntityVisibilityState3D> &entityVisStateList = iter->second;
+			const ChunkEntityMap::VisStateList &entityVisStateList = iter->second;
 			for (const EntityVisibilityState3D &visState : entityVisStateList)
 			{
 				const EntityInstanceID entityInstID = visState.entityInstID;
@@ -490,8 +588,8 @@ namespace Physics
 	template <bool NonNegativeDirX, bool NonNegativeDirY, bool NonNegativeDirZ>
 	void rayCastInternal(const CoordDouble3 &rayCoord, const VoxelDouble3 &rayDirection, const VoxelDouble3 &cameraForward,
 		double ceilingScale, const VoxelChunkManager &voxelChunkManager, const EntityChunkManager &entityChunkManager,
-		const CollisionChunkManager &collisionChunkManager, bool includeEntities, const EntityDefinitionLibrary &entityDefLibrary,
-		const Renderer &renderer, std::vector<ChunkEntityMap> &chunkEntityMaps, Physics::Hit &hit)
+		bool includeEntities, const EntityDefinitionLibrary &entityDefLibrary, const Renderer &renderer,
+		ChunkLookupCache &chunkLookupCache, FrameVector<ChunkEntityMap> &chunkEntityMaps, Physics::Hit &hit)
 	{
 		// Each flat shares the same axes. Their forward direction always faces opposite to the camera direction.
 		const VoxelDouble3 flatForward = VoxelDouble3(-cameraForward.x, 0.0, -cameraForward.z).normalized();
@@ -570,7 +668,7 @@ namespace Physics
 
 		// Check whether the initial voxel is in a loaded chunk.
 		ChunkInt2 currentChunk = rayCoord.chunk;
-		const VoxelChunk *currentChunkPtr = voxelChunkManager.tryGetChunkAtPosition(currentChunk);
+		const VoxelChunk *currentChunkPtr = chunkLookupCache.tryGetVoxelChunk(currentChunk);
 
 		// The initial DDA step is a special case, so it's brought outside the DDA loop. This complicates things
 		// a little bit, but it's important enough that it should be kept.
@@ -599,7 +697,7 @@ namespace Physics
 
 			// Test the initial voxel's geometry for ray intersections.
 			bool success = Physics::testInitialVoxelRay(rayCoord, rayDirection, rayVoxel, facing,
-				ceilingScale, voxelChunkManager, collisionChunkManager, hit);
+				ceilingScale, chunkLookupCache, hit);
 
 			if (includeEntities)
 			{
@@ -638,7 +736,7 @@ namespace Physics
 		constexpr WEDouble halfOneMinusStepZReal = static_cast<WEDouble>((1 - stepZ) / 2);
 
 		// Lambda for stepping to the next voxel in the grid and updating various values.
-		auto doDDAStep = [&rayCoord, &rayDirection, &voxelChunkManager, &deltaDist, stepX, stepY, stepZ, initialDeltaDistX,
+		auto doDDAStep = [&rayCoord, &rayDirection, &chunkLookupCache, &deltaDist, stepX, stepY, stepZ, initialDeltaDistX,
 			initialDeltaDistY, initialDeltaDistZ, &visibleWallFacings, &rayDistance, &facing, &currentChunk,
 			&currentChunkPtr, &currentVoxel, &deltaDistSumX, &deltaDistSumY, &deltaDistSumZ, &canDoYStep,
 			halfOneMinusStepXReal, halfOneMinusStepYReal, halfOneMinusStepZReal]()
@@ -712,7 +810,7 @@ namespace Physics
 
 			if (currentChunk != oldChunk)
 			{
-				currentChunkPtr = voxelChunkManager.tryGetChunkAtPosition(currentChunk);
+				currentChunkPtr = chunkLookupCache.tryGetVoxelChunk(currentChunk);
 			}
 		};
 
@@ -741,7 +839,7 @@ namespace Physics
 
 			// Test the current voxel's geometry for ray intersections.
 			bool success = Physics::testVoxelRay(rayCoord, rayDirection, savedVoxelCoord, savedFacing,
-				nearCoord, farCoord, ceilingScale, voxelChunkManager, collisionChunkManager, hit);
+				nearCoord, farCoord, ceilingScale, chunkLookupCache, hit);
 
 			if (includeEntities)
 			{
@@ -759,6 +857,76 @@ namespace Physics
 			}
 		}
 	}
+
+	// Direction octant of a ray, one bit per non-negative axis. Rays in the same octant share a ray casting
+	// loop instantiation.
+	int getRayOctant(const VoxelDouble3 &rayDirection)
+	{
+		const bool nonNegativeDirX = rayDirection.x >= 0.0;
+		const bool nonNegativeDirY = rayDirection.y >= 0.0;
+		const bool nonNegativeDirZ = rayDirection.z >= 0.0;
+		return (nonNegativeDirX ? 4 : 0) | (nonNegativeDirY ? 2 : 0) | (nonNegativeDirZ ? 1 : 0);
+	}
+
+	// Ray casts through the voxel grid with the loop instantiation for the given direction octant. Use the ray
+	// direction booleans for better code generation (at the expense of having a pile of branches here).
+	void rayCastOctant(int octant, const CoordDouble3 &rayStart, const VoxelDouble3 &rayDirection,
+		const VoxelDouble3 &cameraForward, double ceilingScale, const VoxelChunkManager &voxelChunkManager,
+		const EntityChunkManager &entityChunkManager, bool includeEntities, const EntityDefinitionLibrary &entityDefLibrary,
+		const Renderer &renderer, ChunkLookupCache &chunkLookupCache, FrameVector<ChunkEntityMap> &chunkEntityMaps,
+		Physics::Hit &hit)
+	{
+		// Set the hit distance to max. This will ensure that if we don't hit a voxel but do hit an
+		// entity, the distance can still be used.
+		hit.setT(Hit::MAX_T);
+
+		switch (octant)
+		{
+		case 7:
+			Physics::rayCastInternal<true, true, true>(rayStart, rayDirection, cameraForward, ceilingScale,
+				voxelChunkManager, entityChunkManager, includeEntities, entityDefLibrary, renderer, chunkLookupCache,
+				chunkEntityMaps, hit);
+			break;
+		case 6:
+			Physics::rayCastInternal<true, true, false>(rayStart, rayDirection, cameraForward, ceilingScale,
+				voxelChunkManager, entityChunkManager, includeEntities, entityDefLibrary, renderer, chunkLookupCache,
+				chunkEntityMaps, hit);
+			break;
+		case 5:
+			Physics::rayCastInternal<true, false, true>(rayStart, rayDirection, cameraForward, ceilingScale,
+				voxelChunkManager, entityChunkManager, includeEntities, entityDefLibrary, renderer, chunkLookupCache,
+				chunkEntityMaps, hit);
+			break;
+		case 4:
+			Physics::rayCastInternal<true, false, false>(rayStart, rayDirection, cameraForward, ceilingScale,
+				voxelChunkManager, entityChunkManager, includeEntities, entityDefLibrary, renderer, chunkLookupCache,
+				chunkEntityMaps, hit);
+			break;
+		case 3:
+			Physics::rayCastInternal<false, true, true>(rayStart, rayDirection, cameraForward, ceilingScale,
+				voxelChunkManager, entityChunkManager, includeEntities, entityDefLibrary, renderer, chunkLookupCache,
+				chunkEntityMaps, hit);
+			break;
+		case 2:
+			Physics::rayCastInternal<false, true, false>(rayStart, rayDirection, cameraForward, ceilingScale,
+				voxelChunkManager, entityChunkManager, includeEntities, entityDefLibrary, renderer, chunkLookupCache,
+				chunkEntityMaps, hit);
+			break;
+		case 1:
+			Physics::rayCastInternal<false, false, true>(rayStart, rayDirection, cameraForward, ceilingScale,
+				voxelChunkManager, entityChunkManager, includeEntities, entityDefLibrary, renderer, chunkLookupCache,
+				chunkEntityMaps, hit);
+			break;
+		case 0:
+			Physics::rayCastInternal<false, false, false>(rayStart, rayDirection, cameraForward, ceilingScale,
+				voxelChunkManager, entityChunkManager, includeEntities, entityDefLibrary, renderer, chunkLookupCache,
+				chunkEntityMaps, hit);
+			break;
+		default:
+			DebugNotImplementedMsg(std::to_string(octant));
+			break;
+		}
+	}
 }
 
 void Physics::Hit::initVoxel(double t, const CoordDouble3 &coord, const VoxelInt3 &voxel, const VoxelFacing3D *facing)
@@ -823,101 +991,130 @@ void Physics::Hit::setT(double t)
 	this->t = t;
 }
 
+void Physics::Ray::init(const CoordDouble3 &start, const VoxelDouble3 &direction)
+{
+	this->start = start;
+	this->direction = direction;
+}
+
 bool Physics::rayCast(const CoordDouble3 &rayStart, const VoxelDouble3 &rayDirection, double ceilingScale,
 	const VoxelDouble3 &cameraForward, bool includeEntities, const VoxelChunkManager &voxelChunkManager,
 	const EntityChunkManager &entityChunkManager, const CollisionChunkManager &collisionChunkManager,
-	const EntityDefinitionLibrary &entityDefLibrary, const Renderer &renderer, Physics::Hit &hit)
+	const EntityDefinitionLibrary &entityDefLibrary, const Renderer &renderer, FrameArena &frameArena, Physics::Hit &hit)
 {
-	// Set the hit distance to max. This will ensure that if we don't hit a voxel but do hit an
-	// entity, the distance can still be used.
-	hit.setT(Hit::MAX_T);
+	ChunkLookupCache chunkLookupCache;
+	chunkLookupCache.init(voxelChunkManager, collisionChunkManager);
 
 	// Voxel->entity mappings for each chunk touched by the ray casting loop.
-	std::vector<ChunkEntityMap> chunkEntityMaps;
+	FrameVector<ChunkEntityMap> chunkEntityMaps{ FrameAllocator<ChunkEntityMap>(frameArena) };
+
+	// Ray cast through the voxel grid, populating the output hit data.
+	const int octant = Physics::getRayOctant(rayDirection);
+	Physics::rayCastOctant(octant, rayStart, rayDirection, cameraForward, ceilingScale, voxelChunkManager,
+		entityChunkManager, includeEntities, entityDefLibrary, renderer, chunkLookupCache, chunkEntityMaps, hit);
+
+	// Return whether the ray hit something.
+	return hit.getT() < Hit::MAX_T;
+}
+
+bool Physics::rayCast(const CoordDouble3 &rayStart, const VoxelDouble3 &rayDirection,
+	const VoxelDouble3 &cameraForward, bool includeEntities, const VoxelChunkManager &voxelChunkManager,
+	const EntityChunkManager &entityChunkManager, const CollisionChunkManager &collisionChunkManager,
+	const EntityDefinitionLibrary &entityDefLibrary, const Renderer &renderer, FrameArena &frameArena, Physics::Hit &hit)
+{
+	constexpr double ceilingScale = 1.0;
+	return Physics::rayCast(rayStart, rayDirection, ceilingScale, cameraForward, includeEntities, voxelChunkManager,
+		entityChunkManager, collisionChunkManager, entityDefLibrary, renderer, frameArena, hit);
+}
+
+int Physics::rayCastBatch(BufferView<const Physics::Ray> rays, double ceilingScale, const VoxelDouble3 &cameraForward,
+	bool includeEntities, const VoxelChunkManager &voxelChunkManager, const EntityChunkManager &entityChunkManager,
+	const CollisionChunkManager &collisionChunkManager, const EntityDefinitionLibrary &entityDefLibrary,
+	const Renderer &renderer, FrameArena &frameArena, BufferView<Physics::Hit> outHits, BufferView<bool> outSuccesses)
+{
+	const int rayCount = rays.getCount();
+	DebugAssert(outHits.getCount() == rayCount);
+	DebugAssert(outSuccesses.getCount() == rayCount);
+
+	// Order rays by start chunk then direction octant so consecutive casts walk the same chunks with the same
+	// loop instantiation. Results are written back in the caller's order.
+	struct RayOrder
+	{
+		ChunkInt2 chunk;
+		int octant;
+		int rayIndex;
+	};
 
-	// Ray cast through the voxel grid, populating the output hit data. Use the ray direction booleans for
-	// better code generation (at the expense of having a pile of if/else branches here).
-	const bool nonNegativeDirX = rayDirection.x >= 0.0;
-	const bool nonNegativeDirY = rayDirection.y >= 0.0;
-	const bool nonNegativeDirZ = rayDirection.z >= 0.0;
+	FrameVector<RayOrder> rayOrders(rayCount, RayOrder(), FrameAllocator<RayOrder>(frameArena));
+	for (int i = 0; i < rayCount; i++)
+	{
+		const Physics::Ray &ray = rays.get(i);
+		RayOrder &rayOrder = rayOrders[i];
+		rayOrder.chunk = ray.start.chunk;
+		rayOrder.octant = Physics::getRayOctant(ray.direction);
+		rayOrder.rayIndex = i;
+	}
 
-	if (nonNegativeDirX)
+	std::sort(rayOrders.begin(), rayOrders.end(),
+		[](const RayOrder &a, const RayOrder &b)
 	{
-		if (nonNegativeDirY)
+		if (a.chunk.x != b.chunk.x)
 		{
-			if (nonNegativeDirZ)
-			{
-				Physics::rayCastInternal<true, true, true>(rayStart, rayDirection, cameraForward, ceilingScale,
-					voxelChunkManager, entityChunkManager, collisionChunkManager, includeEntities, entityDefLibrary,
-					renderer, chunkEntityMaps, hit);
-			}
-			else
-			{
-				Physics::rayCastInternal<true, true, false>(rayStart, rayDirection, cameraForward, ceilingScale,
-					voxelChunkManager, entityChunkManager, collisionChunkManager, includeEntities, entityDefLibrary,
-					renderer, chunkEntityMaps, hit);
-			}
+			return a.chunk.x < b.chunk.x;
 		}
-		else
+
+		if (a.chunk.y != b.chunk.y)
 		{
-			if (nonNegativeDirZ)
-			{
-				Physics::rayCastInternal<true, false, true>(rayStart, rayDirection, cameraForward, ceilingScale,
-					voxelChunkManager, entityChunkManager, collisionChunkManager, includeEntities, entityDefLibrary,
-					renderer, chunkEntityMaps, hit);
-			}
-			else
-			{
-				Physics::rayCastInternal<true, false, false>(rayStart, rayDirection, cameraForward, ceilingScale,
-					voxelChunkManager, entityChunkManager, collisionChunkManager, includeEntities, entityDefLibrary,
-					renderer, chunkEntityMaps, hit);
-			}
+			return a.chunk.y < b.chunk.y;
 		}
-	}
-	else
+
+		if (a.octant != b.octant)
+		{
+			return a.octant < b.octant;
+		}
+
+		return a.rayIndex < b.rayIndex;
+	});
+
+	// Chunk lookups are shared by every ray in the batch. Entity mappings are shared by rays with the same start.
+	ChunkLookupCache chunkLookupCache;
+	chunkLookupCache.init(voxelChunkManager, collisionChunkManager);
+
+	FrameVector<ViewEntityMaps> viewEntityMapsList{ FrameAllocator<ViewEntityMaps>(frameArena) };
+	auto getOrAddViewEntityMaps = [&viewEntityMapsList, &frameArena](const CoordDouble3 &viewCoord) -> ViewEntityMaps&
 	{
-		if (nonNegativeDirY)
+		for (ViewEntityMaps &viewEntityMaps : viewEntityMapsList)
 		{
-			if (nonNegativeDirZ)
+			if (viewEntityMaps.matches(viewCoord))
 			{
-				Physics::rayCastInternal<false, true, true>(rayStart, rayDirection, cameraForward, ceilingScale,
-					voxelChunkManager, entityChunkManager, collisionChunkManager, includeEntities, entityDefLibrary,
-					renderer, chunkEntityMaps, hit);
-			}
-			else
-			{
-				Physics::rayCastInternal<false, true, false>(rayStart, rayDirection, cameraForward, ceilingScale,
-					voxelChunkManager, entityChunkManager, collisionChunkManager, includeEntities, entityDefLibrary,
-					renderer, chunkEntityMaps, hit);
+				return viewEntityMaps;
 			}
 		}
-		else
+
+		ViewEntityMaps newViewEntityMaps(frameArena);
+		newViewEntityMaps.init(viewCoord);
+		viewEntityMapsList.emplace_back(std::move(newViewEntityMaps));
+		return viewEntityMapsList.back();
+	};
+
+	int hitCount = 0;
+	for (const RayOrder &rayOrder : rayOrders)
+	{
+		const int rayIndex = rayOrder.rayIndex;
+		const Physics::Ray &ray = rays.get(rayIndex);
+		Physics::Hit &hit = outHits.get(rayIndex);
+		ViewEntityMaps &viewEntityMaps = getOrAddViewEntityMaps(ray.start);
+		Physics::rayCastOctant(rayOrder.octant, ray.start, ray.direction, cameraForward, ceilingScale,
+			voxelChunkManager, entityChunkManager, includeEntities, entityDefLibrary, renderer, chunkLookupCache,
+			viewEntityMaps.chunkEntityMaps, hit);
+
+		const bool success = hit.getT() < Hit::MAX_T;
+		outSuccesses.set(rayIndex, success);
+		if (success)
 		{
-			if (nonNegativeDirZ)
-			{
-				Physics::rayCastInternal<false, false, true>(rayStart, rayDirection, cameraForward, ceilingScale,
-					voxelChunkManager, entityChunkManager, collisionChunkManager, includeEntities, entityDefLibrary,
-					renderer, chunkEntityMaps, hit);
-			}
-			else
-			{
-				Physics::rayCastInternal<false, false, false>(rayStart, rayDirection, cameraForward, ceilingScale,
-					voxelChunkManager, entityChunkManager, collisionChunkManager, includeEntities, entityDefLibrary,
-					renderer, chunkEntityMaps, hit);
-			}
+			hitCount++;
 		}
 	}
 
-	// Return whether the ray hit something.
-	return hit.getT() < Hit::MAX_T;
-}
-
-bool Physics::rayCast(const CoordDouble3 &rayStart, const VoxelDouble3 &rayDirection,
-	const VoxelDouble3 &cameraForward, bool includeEntities, const VoxelChunkManager &voxelChunkManager,
-	const EntityChunkManager &entityChunkManager, const CollisionChunkManager &collisionChunkManager,
-	const EntityDefinitionLibrary &entityDefLibrary, const Renderer &renderer, Physics::Hit &hit)
-{
-	constexpr double ceilingScale = 1.0;
-	return Physics::rayCast(rayStart, rayDirection, ceilingScale, cameraForward, includeEntities, voxelChunkManager,
-		entityChunkManager, collisionChunkManager, entityDefLibrary, renderer, hit);
+	return hitCount;
 }
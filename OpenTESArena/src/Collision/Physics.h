@@ -12,8 +12,11 @@
 #include "../Rendering/Renderer.h"
 #include "../Voxels/VoxelUtils.h"
 
+#include "components/utilities/BufferView.h"
+
 class CollisionChunkManager;
 class EntityChunkManager;
+class FrameArena;
 class VoxelChunkManager;
 
 // Namespace for physics-related calculations like ray casting.
@@ -60,18 +63,37 @@ namespace Physics
 		void setT(double t);
 	};
 
+	// Input for batched ray casts.
+	struct Ray
+	{
+		CoordDouble3 start;
+		VoxelDouble3 direction;
+
+		void init(const CoordDouble3 &start, const VoxelDouble3 &direction);
+	};
+
 	// @todo: bit mask elements for each voxel data type.
 
 	// Casts a ray through the world and writes any intersection data into the output parameter. Returns true
-	// if the ray hit something.
+	// if the ray hit something. Temporary lookups are allocated in the frame arena.
 	bool rayCast(const CoordDouble3 &rayStart, const VoxelDouble3 &rayDirection, double ceilingScale,
 		const VoxelDouble3 &cameraForward, bool includeEntities, const VoxelChunkManager &voxelChunkManager,
 		const EntityChunkManager &entityChunkManager, const CollisionChunkManager &collisionChunkManager,
-		const EntityDefinitionLibrary &entityDefLibrary, const Renderer &renderer, Physics::Hit &hit);
+		const EntityDefinitionLibrary &entityDefLibrary, const Renderer &renderer, FrameArena &frameArena, Physics::Hit &hit);
 	bool rayCast(const CoordDouble3 &rayStart, const VoxelDouble3 &rayDirection, const VoxelDouble3 &cameraForward,
 		bool includeEntities, const VoxelChunkManager &voxelChunkManager, const EntityChunkManager &entityChunkManager,
 		const CollisionChunkManager &collisionChunkManager, const EntityDefinitionLibrary &entityDefLibrary,
-		const Renderer &renderer, Physics::Hit &hit);
+		const Renderer &renderer, FrameArena &frameArena, Physics::Hit &hit);
+
+	// Casts several rays through the world at once and writes each ray's intersection data into the output
+	// parameters at the ray's index. Chunk lookups are shared by the whole batch and entity mappings are shared
+	// by rays with the same start point. Results are identical to calling rayCast() once per ray. Returns the
+	// number of rays that hit something.
+	int rayCastBatch(BufferView<const Physics::Ray> rays, double ceilingScale, const VoxelDouble3 &cameraForward,
+		bool includeEntities, const VoxelChunkManager &voxelChunkManager, const EntityChunkManager &entityChunkManager,
+		const CollisionChunkManager &collisionChunkManager, const EntityDefinitionLibrary &entityDefLibrary,
+		const Renderer &renderer, FrameArena &frameArena, BufferView<Physics::Hit> outHits,
+		BufferView<bool> outSuccesses);
 };
 
 #endif
@@ -0,0 +1,135 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "SweepUtils.h"
+#include "../Math/Constants.h"
+#include "../World/ChunkUtils.h"
+
+#include "components/debug/Debug.h"
+
+bool SweepUtils::sweepSquare(const CoordDouble3 &start, double halfWidth, const VoxelDouble2 &delta, int voxelY,
+	const ColliderFunc &isColliderFunc, SweepHit &hit)
+{
+	DebugAssert(halfWidth > 0.0);
+	DebugAssert(halfWidth < 0.50);
+
+	const double startX = start.point.x;
+	const double startZ = start.point.z;
+	const double endX = startX + delta.x;
+	const double endZ = startZ + delta.y;
+
+	// Broadphase: voxels touched by the footprint anywhere along the movement, relative to the start chunk.
+	const SNInt minVoxelX = static_cast<SNInt>(std::floor(std::min(startX, endX) - halfWidth));
+	const SNInt maxVoxelX = static_cast<SNInt>(std::floor(std::max(startX, endX) + halfWidth));
+	const WEInt minVoxelZ = static_cast<WEInt>(std::floor(std::min(startZ, endZ) - halfWidth));
+	const WEInt maxVoxelZ = static_cast<WEInt>(std::floor(std::max(startZ, endZ) + halfWidth));
+
+	// Intersects the movement with one axis of a voxel grown by the half width. Writes the entry and exit
+	// fractions, or returns false if the movement never overlaps that axis.
+	auto getSlabTimes = [](double position, double movement, double slabMin, double slabMax, double *outEnter, double *outExit)
+	{
+		if (movement == 0.0)
+		{
+			*outEnter = -std::numeric_limits<double>::infinity();
+			*outExit = std::numeric_limits<double>::infinity();
+			return (position > slabMin) && (position < slabMax);
+		}
+
+		const double t0 = (slabMin - position) / movement;
+		const double t1 = (slabMax - position) / movement;
+		*outEnter = std::min(t0, t1);
+		*outExit = std::max(t0, t1);
+		return true;
+	};
+
+	hit.t = std::numeric_limits<double>::infinity();
+	for (WEInt z = minVoxelZ; z <= maxVoxelZ; z++)
+	{
+		for (SNInt x = minVoxelX; x <= maxVoxelX; x++)
+		{
+			const double slabMinX = static_cast<double>(x) - halfWidth;
+			const double slabMaxX = static_cast<double>(x + 1) + halfWidth;
+			const double slabMinZ = static_cast<double>(z) - halfWidth;
+			const double slabMaxZ = static_cast<double>(z + 1) + halfWidth;
+
+			double enterX, exitX, enterZ, exitZ;
+			if (!getSlabTimes(startX, delta.x, slabMinX, slabMaxX, &enterX, &exitX) ||
+				!getSlabTimes(startZ, delta.y, slabMinZ, slabMaxZ, &enterZ, &exitZ))
+			{
+				continue;
+			}
+
+			const double enterT = std::max(enterX, enterZ);
+			const double exitT = std::min(exitX, exitZ);
+			const bool isHitInRange = (enterT < exitT) && (enterT >= 0.0) && (enterT <= 1.0);
+			if (!isHitInRange || (enterT >= hit.t))
+			{
+				continue;
+			}
+
+			// Only query the voxel once the sweep is known to reach it before the current earliest hit.
+			const CoordInt3 coord = ChunkUtils::recalculateCoord(start.chunk, VoxelInt3(x, voxelY, z));
+			if (!isColliderFunc(coord))
+			{
+				continue;
+			}
+
+			hit.t = enterT;
+			hit.coord = coord;
+			if (enterX > enterZ)
+			{
+				hit.normal = VoxelDouble2((delta.x > 0.0) ? -1.0 : 1.0, 0.0);
+			}
+			else
+			{
+				hit.normal = VoxelDouble2(0.0, (delta.y > 0.0) ? -1.0 : 1.0);
+			}
+		}
+	}
+
+	return hit.t <= 1.0;
+}
+
+CoordDouble3 SweepUtils::slideSquare(const CoordDouble3 &start, double halfWidth, const VoxelDouble2 &delta, int voxelY,
+	const ColliderFunc &isColliderFunc, VoxelDouble2 *velocity)
+{
+	CoordDouble3 position = start;
+	VoxelDouble2 remainingDelta = delta;
+	for (int i = 0; i < MAX_SLIDES; i++)
+	{
+		const double remainingDistance = remainingDelta.length();
+		if (remainingDistance <= Constants::Epsilon)
+		{
+			break;
+		}
+
+		SweepHit hit;
+		const bool isHit = SweepUtils::sweepSquare(position, halfWidth, remainingDelta, voxelY, isColliderFunc, hit);
+		const double moveT = isHit ? hit.t : 1.0;
+
+		// Backing off along the movement instead would leave almost no gap at grazing angles, and the sweep
+		// ignores colliders the footprint already overlaps.
+		const VoxelDouble2 skinOffset = isHit ? (hit.normal * SKIN) : VoxelDouble2::Zero;
+		const VoxelDouble3 newPoint(
+			position.point.x + (remainingDelta.x * moveT) + skinOffset.x,
+			position.point.y,
+			position.point.z + (remainingDelta.y * moveT) + skinOffset.y);
+		if (std::isfinite(newPoint.length()))
+		{
+			position = ChunkUtils::recalculateCoord(position.chunk, newPoint);
+		}
+
+		if (!isHit)
+		{
+			break;
+		}
+
+		// Remove the part of the movement and velocity going into the collider.
+		remainingDelta = remainingDelta * (1.0 - moveT);
+		remainingDelta = remainingDelta - (hit.normal * remainingDelta.dot(hit.normal));
+		*velocity = *velocity - (hit.normal * velocity->dot(hit.normal));
+	}
+
+	return position;
+}
@@ -0,0 +1,46 @@
+#ifndef SWEEP_UTILS_H
+#define SWEEP_UTILS_H
+
+#include <functional>
+
+#include "../Math/Vector2.h"
+#include "../World/Coord.h"
+
+// Swept collision of square footprints against voxels in the XZ plane, independent of how voxels are stored
+// so it can be tested on its own.
+
+namespace SweepUtils
+{
+	// Distance a square is pushed out along a collider's normal after an impact so the next sweep doesn't
+	// start touching or overlapping it.
+	constexpr double SKIN = 0.001;
+
+	// Most times movement can be redirected along a collider in one move (i.e. sliding into a corner).
+	constexpr int MAX_SLIDES = 3;
+
+	// Earliest collider hit by a sweep.
+	struct SweepHit
+	{
+		double t; // Fraction of the movement completed before impact, in [0, 1].
+		VoxelDouble2 normal; // Outward normal of the hit voxel side in the XZ plane (X south, Y west).
+		CoordInt3 coord;
+	};
+
+	// Returns whether the voxel at a coordinate blocks movement.
+	using ColliderFunc = std::function<bool(const CoordInt3 &coord)>;
+
+	// Sweeps a square footprint in the XZ plane through one row of voxels from the start point along the delta
+	// and writes the earliest collider it would hit. Only voxels within the bounds of the sweep are tested, so
+	// movement of any length can't skip over thin geometry. Colliders the footprint already overlaps are ignored
+	// so it can always move out of them. Returns true if something was hit before the end of the movement.
+	bool sweepSquare(const CoordDouble3 &start, double halfWidth, const VoxelDouble2 &delta, int voxelY,
+		const ColliderFunc &isColliderFunc, SweepHit &hit);
+
+	// Moves a square footprint along the delta. On impact it stops at the collider, is pushed out along its
+	// normal by the skin, and slides the rest of the movement along its side. The part of the XZ velocity going
+	// into any hit collider is removed. Returns the final position.
+	CoordDouble3 slideSquare(const CoordDouble3 &start, double halfWidth, const VoxelDouble2 &delta, int voxelY,
+		const ColliderFunc &isColliderFunc, VoxelDouble2 *velocity);
+}
+
+#endif
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "EntityChunkManager.h"
 #include "EntityDefinitionLibrary.h"
 #include "EntityVisibilityState.h"
@@ -54,6 +56,23 @@ namespace
 
 		return animTextureRefs;
 	}
+
+	void EvictLeastRecentlyUsedSnapshot(std::vector<EntityChunkSnapshot> &snapshots)
+	{
+		DebugAssert(!snapshots.empty());
+		const auto iter = std::min_element(snapshots.begin(), snapshots.end(),
+			[](const EntityChunkSnapshot &a, const EntityChunkSnapshot &b)
+		{
+			return a.lastUsedTick < b.lastUsedTick;
+		});
+
+		snapshots.erase(iter);
+	}
+}
+
+EntityChunkManager::EntityChunkManager()
+{
+	this->currentSnapshotTick = 0;
 }
 
 const EntityDefinition &EntityChunkManager::getEntityDef(EntityDefID defID) const
@@ -104,11 +123,183 @@ EntityInstanceID EntityChunkManager::spawnEntity()
 	return instID;
 }
 
+void EntityChunkManager::storeChunkSnapshot(const EntityChunk &entityChunk, int maxSnapshotCount)
+{
+	if (maxSnapshotCount == 0)
+	{
+		return;
+	}
+
+	const ChunkInt2 &chunkPos = entityChunk.getPosition();
+	auto iter = std::find_if(this->chunkSnapshots.begin(), this->chunkSnapshots.end(),
+		[&chunkPos](const EntityChunkSnapshot &snapshot)
+	{
+		return snapshot.position == chunkPos;
+	});
+
+	if (iter == this->chunkSnapshots.end())
+	{
+		// Same least-recently-used eviction as voxel chunk snapshots so both caches hold the same chunks.
+		while (static_cast<int>(this->chunkSnapshots.size()) >= maxSnapshotCount)
+		{
+			EvictLeastRecentlyUsedSnapshot(this->chunkSnapshots);
+		}
+
+		this->chunkSnapshots.emplace_back(EntityChunkSnapshot());
+		iter = this->chunkSnapshots.end() - 1;
+	}
+
+	EntityChunkSnapshot &chunkSnapshot = *iter;
+	chunkSnapshot.position = chunkPos;
+	chunkSnapshot.entities.clear();
+	chunkSnapshot.lastUsedTick = this->currentSnapshotTick;
+	this->currentSnapshotTick++;
+
+	for (const EntityInstanceID entityInstID : entityChunk.entityIDs)
+	{
+		const EntityInstance &entityInst = this->entities.get(entityInstID);
+
+		EntitySnapshot entitySnapshot;
+		entitySnapshot.defID = entityInst.defID;
+		entitySnapshot.position = this->positions.get(entityInst.positionID);
+		entitySnapshot.bbox = this->boundingBoxes.get(entityInst.bboxID);
+
+		if (entityInst.directionID >= 0)
+		{
+			entitySnapshot.direction = this->directions.get(entityInst.directionID);
+		}
+
+		if (entityInst.animInstID >= 0)
+		{
+			entitySnapshot.animInst = this->animInsts.get(entityInst.animInstID);
+		}
+
+		if (entityInst.creatureSoundInstID >= 0)
+		{
+			entitySnapshot.creatureSoundInst = this->creatureSoundInsts.get(entityInst.creatureSoundInstID);
+		}
+
+		if (entityInst.citizenDirectionIndexID >= 0)
+		{
+			entitySnapshot.citizenDirectionIndex = this->citizenDirectionIndices.get(entityInst.citizenDirectionIndexID);
+		}
+
+		if (entityInst.paletteIndicesInstID >= 0)
+		{
+			entitySnapshot.paletteIndices = this->paletteIndices.get(entityInst.paletteIndicesInstID);
+		}
+
+		chunkSnapshot.entities.emplace_back(std::move(entitySnapshot));
+	}
+}
+
+bool EntityChunkManager::tryRestoreChunkSnapshot(EntityChunk &entityChunk)
+{
+	const ChunkInt2 &chunkPos = entityChunk.getPosition();
+	const auto iter = std::find_if(this->chunkSnapshots.begin(), this->chunkSnapshots.end(),
+		[&chunkPos](const EntityChunkSnapshot &snapshot)
+	{
+		return snapshot.position == chunkPos;
+	});
+
+	if (iter == this->chunkSnapshots.end())
+	{
+		return false;
+	}
+
+	// Citizens that walked in from chunks populated since then still count toward the active limit.
+	int citizenCount = CitizenUtils::getCitizenCount(*this);
+
+	for (EntitySnapshot &entitySnapshot : iter->entities)
+	{
+		const bool isCitizen = entitySnapshot.citizenDirectionIndex.has_value();
+		if (isCitizen && (citizenCount >= CitizenUtils::MAX_ACTIVE_CITIZENS))
+		{
+			continue;
+		}
+
+		const EntityInstanceID entityInstID = this->spawnEntity();
+		EntityInstance &entityInst = this->entities.get(entityInstID);
+
+		EntityPositionID positionID;
+		if (!this->positions.tryAlloc(&positionID))
+		{
+			DebugCrash("Couldn't allocate EntityPositionID.");
+		}
+
+		EntityBoundingBoxID bboxID;
+		if (!this->boundingBoxes.tryAlloc(&bboxID))
+		{
+			DebugCrash("Couldn't allocate EntityBoundingBoxID.");
+		}
+
+		entityInst.init(entityInstID, entitySnapshot.defID, positionID, bboxID);
+		this->positions.get(positionID) = entitySnapshot.position;
+		this->boundingBoxes.get(bboxID) = entitySnapshot.bbox;
+
+		if (entitySnapshot.direction.has_value())
+		{
+			if (!this->directions.tryAlloc(&entityInst.directionID))
+			{
+				DebugCrash("Couldn't allocate EntityDirectionID.");
+			}
+
+			this->directions.get(entityInst.directionID) = *entitySnapshot.direction;
+		}
+
+		if (entitySnapshot.animInst.has_value())
+		{
+			if (!this->animInsts.tryAlloc(&entityInst.animInstID))
+			{
+				DebugCrash("Couldn't allocate EntityAnimationInstanceID.");
+			}
+
+			this->animInsts.get(entityInst.animInstID) = std::move(*entitySnapshot.animInst);
+		}
+
+		if (entitySnapshot.creatureSoundInst.has_value())
+		{
+			if (!this->creatureSoundInsts.tryAlloc(&entityInst.creatureSoundInstID))
+			{
+				DebugCrash("Couldn't allocate EntityCreatureSoundInstanceID.");
+			}
+
+			this->creatureSoundInsts.get(entityInst.creatureSoundInstID) = *entitySnapshot.creatureSoundInst;
+		}
+
+		if (entitySnapshot.citizenDirectionIndex.has_value())
+		{
+			if (!this->citizenDirectionIndices.tryAlloc(&entityInst.citizenDirectionIndexID))
+			{
+				DebugCrash("Couldn't allocate EntityCitizenDirectionIndexID.");
+			}
+
+			this->citizenDirectionIndices.get(entityInst.citizenDirectionIndexID) = *entitySnapshot.citizenDirectionIndex;
+			citizenCount++;
+		}
+
+		if (entitySnapshot.paletteIndices.has_value())
+		{
+			if (!this->paletteIndices.tryAlloc(&entityInst.paletteIndicesInstID))
+			{
+				DebugCrash("Couldn't allocate EntityPaletteIndicesInstanceID.");
+			}
+
+			this->paletteIndices.get(entityInst.paletteIndicesInstID) = *entitySnapshot.paletteIndices;
+		}
+
+		entityChunk.entityIDs.emplace_back(entityInstID);
+	}
+
+	this->chunkSnapshots.erase(iter);
+	return true;
+}
+
 void EntityChunkManager::populateChunkEntities(EntityChunk &entityChunk, const VoxelChunk &voxelChunk,
 	const LevelDefinition &levelDefinition, const LevelInfoDefinition &levelInfoDefinition, const WorldInt2 &levelOffset,
 	const EntityGeneration::EntityGenInfo &entityGenInfo, const std::optional<CitizenUtils::CitizenGenInfo> &citizenGenInfo,
 	Random &random, const EntityDefinitionLibrary &entityDefLibrary, const BinaryAssetLibrary &binaryAssetLibrary,
-	TextureManager &textureManager, Renderer &renderer)
+	AudioManager &audioManager, TextureManager &textureManager, Renderer &renderer)
 {
 	SNInt startX, endX;
 	int startY, endY;
@@ -135,6 +326,11 @@ void EntityChunkManager::populateChunkEntities(EntityChunk &entityChunk, const V
 			continue;
 		}
 
+		// Interned here so ambient sounds don't look up the filename each time they play.
+		const std::string creatureSoundFilename = EntityUtils::getCreatureSoundFilename(entityDef);
+		const std::optional<SoundID> creatureSoundID = !creatureSoundFilename.empty() ?
+			std::make_optional(audioManager.getSoundID(creatureSoundFilename)) : std::nullopt;
+
 		std::optional<EntityDefID> entityDefID; // Global entity def ID (shared across all active chunks).
 		for (const WorldDouble3 &position : placementDef.positions)
 		{
@@ -188,15 +384,16 @@ void EntityChunkManager::populateChunkEntities(EntityChunk &entityChunk, const V
 					VoxelDouble2 &entityDir = this->directions.get(entityInst.directionID);
 					entityDir = CardinalDirection::North;
 
-					if (entityDefType == EntityDefinition::Type::Enemy)
+					if (creatureSoundID.has_value())
 					{
 						if (!this->creatureSoundInsts.tryAlloc(&entityInst.creatureSoundInstID))
 						{
 							DebugCrash("Couldn't allocate EntityCreatureSoundInstanceID.");
 						}
 
-						double &secondsTillCreatureSound = this->creatureSoundInsts.get(entityInst.creatureSoundInstID);
-						secondsTillCreatureSound = EntityUtils::nextCreatureSoundWaitTime(random);
+						EntityCreatureSoundInstance &creatureSoundInst = this->creatureSoundInsts.get(entityInst.creatureSoundInstID);
+						creatureSoundInst.secondsTillSound = EntityUtils::nextCreatureSoundWaitTime(random);
+						creatureSoundInst.soundID = *creatureSoundID;
 					}
 				}
 
@@ -358,7 +555,8 @@ void EntityChunkManager::populateChunk(EntityChunk &entityChunk, const VoxelChun
 	const LevelDefinition &levelDef, const LevelInfoDefinition &levelInfoDef, const MapSubDefinition &mapSubDef, 
 	const EntityGeneration::EntityGenInfo &entityGenInfo, const std::optional<CitizenUtils::CitizenGenInfo> &citizenGenInfo,
 	double ceilingScale, Random &random, const EntityDefinitionLibrary &entityDefLibrary,
-	const BinaryAssetLibrary &binaryAssetLibrary, TextureManager &textureManager, Renderer &renderer)
+	const BinaryAssetLibrary &binaryAssetLibrary, AudioManager &audioManager, TextureManager &textureManager,
+	Renderer &renderer)
 {
 	const ChunkInt2 &chunkPos = entityChunk.getPosition();
 	const SNInt levelWidth = levelDef.getWidth();
@@ -375,7 +573,7 @@ void EntityChunkManager::populateChunk(EntityChunk &entityChunk, const VoxelChun
 			// Populate chunk from the part of the level it overlaps.
 			const WorldInt2 levelOffset = chunkPos * ChunkUtils::CHUNK_DIM;
 			this->populateChunkEntities(entityChunk, voxelChunk, levelDef, levelInfoDef, levelOffset, entityGenInfo,
-				citizenGenInfo, random, entityDefLibrary, binaryAssetLibrary, textureManager, renderer);
+				citizenGenInfo, random, entityDefLibrary, binaryAssetLibrary, audioManager, textureManager, renderer);
 		}
 	}
 	else if (mapType == MapType::City)
@@ -387,7 +585,7 @@ void EntityChunkManager::populateChunk(EntityChunk &entityChunk, const VoxelChun
 			// Populate chunk from the part of the level it overlaps.
 			const WorldInt2 levelOffset = chunkPos * ChunkUtils::CHUNK_DIM;
 			this->populateChunkEntities(entityChunk, voxelChunk, levelDef, levelInfoDef, levelOffset, entityGenInfo,
-				citizenGenInfo, random, entityDefLibrary, binaryAssetLibrary, textureManager, renderer);
+				citizenGenInfo, random, entityDefLibrary, binaryAssetLibrary, audioManager, textureManager, renderer);
 		}
 	}
 	else if (mapType == MapType::Wilderness)
@@ -399,7 +597,7 @@ void EntityChunkManager::populateChunk(EntityChunk &entityChunk, const VoxelChun
 		// Copy level definition directly into chunk.
 		const WorldInt2 levelOffset = WorldInt2::Zero;
 		this->populateChunkEntities(entityChunk, voxelChunk, levelDef, levelInfoDef, levelOffset, entityGenInfo,
-			citizenGenInfo, random, entityDefLibrary, binaryAssetLibrary, textureManager, renderer);
+			citizenGenInfo, random, entityDefLibrary, binaryAssetLibrary, audioManager, textureManager, renderer);
 	}
 }
 
@@ -553,6 +751,7 @@ void EntityChunkManager::updateCitizenStates(double dt, EntityChunk &entityChunk
 			}
 
 			// Integrate by delta time.
+			this->prevMovedPositions[entityInst.positionID] = entityCoord;
 			const VoxelDouble2 entityVelocity = entityDir * CitizenUtils::SPEED;
 			entityCoord = ChunkUtils::recalculateCoord(entityCoord.chunk, entityCoord.point + (entityVelocity * dt));
 		}
@@ -570,25 +769,6 @@ void EntityChunkManager::updateCitizenStates(double dt, EntityChunk &entityChunk
 	}
 }
 
-std::string EntityChunkManager::getCreatureSoundFilename(const EntityDefID defID) const
-{
-	const EntityDefinition &entityDef = this->getEntityDef(defID);
-	if (entityDef.getType() != EntityDefinition::Type::Enemy)
-	{
-		return std::string();
-	}
-
-	const auto &enemyDef = entityDef.getEnemy();
-	if (enemyDef.getType() != EntityDefinition::EnemyDefinition::Type::Creature)
-	{
-		return std::string();
-	}
-
-	const auto &creatureDef = enemyDef.getCreature();
-	const std::string_view creatureSoundName = creatureDef.soundName;
-	return String::toUppercase(std::string(creatureSoundName));
-}
-
 const EntityInstance &EntityChunkManager::getEntity(EntityInstanceID id) const
 {
 	return this->entities.get(id);
@@ -599,6 +779,20 @@ const CoordDouble2 &EntityChunkManager::getEntityPosition(EntityPositionID id) c
 	return this->positions.get(id);
 }
 
+CoordDouble2 EntityChunkManager::getEntityInterpolatedPosition(EntityPositionID id, double percent) const
+{
+	const CoordDouble2 &entityCoord = this->positions.get(id);
+	const auto iter = this->prevMovedPositions.find(id);
+	if (iter == this->prevMovedPositions.end())
+	{
+		return entityCoord;
+	}
+
+	const CoordDouble2 &prevEntityCoord = iter->second;
+	const VoxelDouble2 delta = entityCoord - prevEntityCoord;
+	return prevEntityCoord + (delta * percent);
+}
+
 const BoundingBox3D &EntityChunkManager::getEntityBoundingBox(EntityBoundingBoxID id) const
 {
 	return this->boundingBoxes.get(id);
@@ -844,28 +1038,22 @@ void EntityChunkManager::updateCreatureSounds(double dt, EntityChunk &entityChun
 		EntityInstance &entityInst = this->entities.get(instID);
 		if (entityInst.creatureSoundInstID >= 0)
 		{
-			double &secondsTillCreatureSound = this->creatureSoundInsts.get(entityInst.creatureSoundInstID);
-			secondsTillCreatureSound -= dt;
-			if (secondsTillCreatureSound <= 0.0)
+			EntityCreatureSoundInstance &creatureSoundInst = this->creatureSoundInsts.get(entityInst.creatureSoundInstID);
+			creatureSoundInst.secondsTillSound -= dt;
+			if (creatureSoundInst.secondsTillSound <= 0.0)
 			{
 				const CoordDouble2 &entityCoord = this->positions.get(entityInst.positionID);
 				if (EntityUtils::withinHearingDistance(playerCoord, entityCoord, ceilingScale))
 				{
-					// @todo: store some kind of sound def ID w/ the secondsTillCreatureSound instead of generating the sound filename here.
-					const std::string creatureSoundFilename = this->getCreatureSoundFilename(entityInst.defID);
-					if (creatureSoundFilename.empty())
-					{
-						continue;
-					}
-
 					// Center the sound inside the creature.
 					const CoordDouble3 soundCoord(
 						entityCoord.chunk,
 						VoxelDouble3(entityCoord.point.x, ceilingScale * 1.50, entityCoord.point.y));
 					const WorldDouble3 absoluteSoundPosition = VoxelUtils::coordToWorldPoint(soundCoord);
-					audioManager.playSound(creatureSoundFilename, absoluteSoundPosition);
+					// Ambient creature noises give way to gameplay sounds when voices run out.
+					audioManager.playSound(creatureSoundInst.soundID, absoluteSoundPosition, SoundPriority::Low);
 
-					secondsTillCreatureSound = EntityUtils::nextCreatureSoundWaitTime(random);
+					creatureSoundInst.secondsTillSound = EntityUtils::nextCreatureSoundWaitTime(random);
 				}
 			}
 		}
@@ -884,10 +1072,21 @@ void EntityChunkManager::update(double dt, BufferView<const ChunkInt2> activeChu
 	const EntityDefinitionLibrary &entityDefLibrary = EntityDefinitionLibrary::getInstance();
 	const BinaryAssetLibrary &binaryAssetLibrary = BinaryAssetLibrary::getInstance();
 
+	// Only entities that move during this tick should be interpolated.
+	this->prevMovedPositions.clear();
+
+	const int maxSnapshotCount = voxelChunkManager.getSnapshotCache().getMaxEntryCount();
+	while (static_cast<int>(this->chunkSnapshots.size()) > maxSnapshotCount)
+	{
+		EvictLeastRecentlyUsedSnapshot(this->chunkSnapshots);
+	}
+
 	for (const ChunkInt2 &chunkPos : freedChunkPositions)
 	{
 		const int chunkIndex = this->getChunkIndex(chunkPos);
 		const EntityChunk &entityChunk = this->getChunkAtIndex(chunkIndex);
+		this->storeChunkSnapshot(entityChunk, maxSnapshotCount);
+
 		for (const EntityInstanceID entityInstID : entityChunk.entityIDs)
 		{
 			this->queueEntityDestroy(entityInstID);
@@ -904,6 +1103,23 @@ void EntityChunkManager::update(double dt, BufferView<const ChunkInt2> activeChu
 		EntityChunk &entityChunk = this->getChunkAtIndex(spawnIndex);
 		entityChunk.init(chunkPos, voxelChunk.getHeight());
 
+		// Entities are only restored with their voxels, otherwise a regenerated chunk could get stale entities.
+		if (voxelChunkManager.wasChunkRestored(chunkPos))
+		{
+			if (this->tryRestoreChunkSnapshot(entityChunk))
+			{
+				continue;
+			}
+		}
+		else
+		{
+			this->chunkSnapshots.erase(std::remove_if(this->chunkSnapshots.begin(), this->chunkSnapshots.end(),
+				[&chunkPos](const EntityChunkSnapshot &snapshot)
+			{
+				return snapshot.position == chunkPos;
+			}), this->chunkSnapshots.end());
+		}
+
 		// Default to the active level def unless it's the wilderness which relies on this chunk coordinate.
 		const LevelDefinition *levelDefPtr = activeLevelDef;
 		const LevelInfoDefinition *levelInfoDefPtr = activeLevelInfoDef;
@@ -918,7 +1134,7 @@ void EntityChunkManager::update(double dt, BufferView<const ChunkInt2> activeChu
 		}
 
 		this->populateChunk(entityChunk, voxelChunk, *levelDefPtr, *levelInfoDefPtr, mapSubDef, entityGenInfo, citizenGenInfo,
-			ceilingScale, random, entityDefLibrary, binaryAssetLibrary, textureManager, renderer);
+			ceilingScale, random, entityDefLibrary, binaryAssetLibrary, audioManager, textureManager, renderer);
 	}
 
 	// Free any unneeded chunks for memory savings in case the chunk distance was once large
@@ -968,6 +1184,7 @@ void EntityChunkManager::cleanUp()
 		if (entityInst.positionID >= 0)
 		{
 			this->positions.free(entityInst.positionID);
+			this->prevMovedPositions.erase(entityInst.positionID);
 		}
 
 		if (entityInst.bboxID >= 0)
@@ -1024,4 +1241,6 @@ void EntityChunkManager::clear()
 
 	this->cleanUp();
 	this->recycleAllChunks();
+	this->chunkSnapshots.clear();
+	this->currentSnapshotTick = 0;
 }
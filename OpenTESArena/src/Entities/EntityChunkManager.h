@@ -1,6 +1,11 @@
 #ifndef ENTITY_CHUNK_MANAGER_H
 #define ENTITY_CHUNK_MANAGER_H
 
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
 #include "CitizenUtils.h"
 #include "EntityAnimationDefinition.h"
 #include "EntityAnimationInstance.h"
@@ -8,6 +13,7 @@
 #include "EntityGeneration.h"
 #include "EntityInstance.h"
 #include "EntityUtils.h"
+#include "../Audio/SoundUtils.h"
 #include "../Math/BoundingBox.h"
 #include "../World/SpecializedChunkManager.h"
 
@@ -30,6 +36,33 @@ struct EntityVisibilityState2D;
 struct EntityVisibilityState3D;
 struct MapSubDefinition;
 
+// Countdown to a creature's next ambient sound.
+struct EntityCreatureSoundInstance
+{
+	double secondsTillSound;
+	SoundID soundID; // Interned when the creature is spawned.
+};
+
+// State of an entity in a chunk that left the active chunk area, restored along with the chunk's voxels.
+struct EntitySnapshot
+{
+	EntityDefID defID;
+	CoordDouble2 position;
+	BoundingBox3D bbox;
+	std::optional<VoxelDouble2> direction;
+	std::optional<EntityAnimationInstance> animInst;
+	std::optional<EntityCreatureSoundInstance> creatureSoundInst;
+	std::optional<int8_t> citizenDirectionIndex;
+	std::optional<PaletteIndices> paletteIndices;
+};
+
+struct EntityChunkSnapshot
+{
+	ChunkInt2 position;
+	std::vector<EntitySnapshot> entities;
+	int64_t lastUsedTick;
+};
+
 class EntityChunkManager final : public SpecializedChunkManager<EntityChunk>
 {
 private:
@@ -38,7 +71,7 @@ private:
 	using EntityBoundingBoxPool = RecyclablePool<BoundingBox3D, EntityBoundingBoxID>;
 	using EntityDirectionPool = RecyclablePool<VoxelDouble2, EntityDirectionID>;
 	using EntityAnimationInstancePool = RecyclablePool<EntityAnimationInstance, EntityAnimationInstanceID>;
-	using EntityCreatureSoundPool = RecyclablePool<double, EntityCreatureSoundInstanceID>;
+	using EntityCreatureSoundPool = RecyclablePool<EntityCreatureSoundInstance, EntityCreatureSoundInstanceID>;
 	using EntityCitizenDirectionIndexPool = RecyclablePool<int8_t, EntityCitizenDirectionIndexID>;
 	using EntityPaletteIndicesInstancePool = RecyclablePool<PaletteIndices, EntityPaletteIndicesInstanceID>;
 
@@ -64,32 +97,46 @@ private:
 	// was unloaded, or they were otherwise despawned. Cleared at end-of-frame.
 	std::vector<EntityInstanceID> destroyedEntityIDs;
 
+	// Positions from before the latest simulation tick for entities that moved during it, so rendering can
+	// interpolate them. Cleared at the start of each tick.
+	std::unordered_map<EntityPositionID, CoordDouble2> prevMovedPositions;
+
+	// Entities of recently freed chunks. Mirrors the voxel chunk snapshot cache so a chunk restored from its
+	// voxel snapshot gets its entities back too instead of a regenerated set.
+	std::vector<EntityChunkSnapshot> chunkSnapshots;
+	int64_t currentSnapshotTick;
+
 	EntityDefID addEntityDef(EntityDefinition &&def, const EntityDefinitionLibrary &defLibrary);
 	EntityDefID getOrAddEntityDefID(const EntityDefinition &def, const EntityDefinitionLibrary &defLibrary);
 
 	EntityInstanceID spawnEntity();
 
+	void storeChunkSnapshot(const EntityChunk &entityChunk, int maxSnapshotCount);
+	bool tryRestoreChunkSnapshot(EntityChunk &entityChunk);
+
 	void populateChunkEntities(EntityChunk &entityChunk, const VoxelChunk &chunk, const LevelDefinition &levelDefinition,
 		const LevelInfoDefinition &levelInfoDefinition, const WorldInt2 &levelOffset,
 		const EntityGeneration::EntityGenInfo &entityGenInfo, const std::optional<CitizenUtils::CitizenGenInfo> &citizenGenInfo,
 		Random &random, const EntityDefinitionLibrary &entityDefLibrary, const BinaryAssetLibrary &binaryAssetLibrary,
-		TextureManager &textureManager, Renderer &renderer);
+		AudioManager &audioManager, TextureManager &textureManager, Renderer &renderer);
 	void populateChunk(EntityChunk &entityChunk, const VoxelChunk &voxelChunk, const LevelDefinition &levelDef,
 		const LevelInfoDefinition &levelInfoDef, const MapSubDefinition &mapSubDef, const EntityGeneration::EntityGenInfo &entityGenInfo,
 		const std::optional<CitizenUtils::CitizenGenInfo> &citizenGenInfo, double ceilingScale,
 		Random &random, const EntityDefinitionLibrary &entityDefLibrary, const BinaryAssetLibrary &binaryAssetLibrary,
-		TextureManager &textureManager, Renderer &renderer);
+		AudioManager &audioManager, TextureManager &textureManager, Renderer &renderer);
 
 	void updateCitizenStates(double dt, EntityChunk &entityChunk, const CoordDouble2 &playerCoordXZ, bool isPlayerMoving,
 		bool isPlayerWeaponSheathed, Random &random, const VoxelChunkManager &voxelChunkManager);
 
-	std::string getCreatureSoundFilename(const EntityDefID defID) const;
 	void updateCreatureSounds(double dt, EntityChunk &entityChunk, const CoordDouble3 &playerCoord,
 		double ceilingScale, Random &random, AudioManager &audioManager);
 public:
+	EntityChunkManager();
+
 	const EntityDefinition &getEntityDef(EntityDefID defID) const;
 	const EntityInstance &getEntity(EntityInstanceID id) const;
 	const CoordDouble2 &getEntityPosition(EntityPositionID id) const;
+	CoordDouble2 getEntityInterpolatedPosition(EntityPositionID id, double percent) const;
 	const BoundingBox3D &getEntityBoundingBox(EntityBoundingBoxID id) const;
 	const VoxelDouble2 &getEntityDirection(EntityDirectionID id) const;
 	EntityAnimationInstance &getEntityAnimationInstance(EntityAnimationInstanceID id);
@@ -10,6 +10,7 @@
 #include "../World/ChunkUtils.h"
 
 #include "components/debug/Debug.h"
+#include "components/utilities/String.h"
 
 bool EntityUtils::isDynamicEntity(EntityDefinition::Type defType)
 {
@@ -205,3 +206,21 @@ double EntityUtils::nextCreatureSoundWaitTime(Random &random)
 	// Arbitrary amount of time.
 	return 2.75 + (random.nextReal() * 4.50);
 }
+
+std::string EntityUtils::getCreatureSoundFilename(const EntityDefinition &entityDef)
+{
+	if (entityDef.getType() != EntityDefinition::Type::Enemy)
+	{
+		return std::string();
+	}
+
+	const auto &enemyDef = entityDef.getEnemy();
+	if (enemyDef.getType() != EntityDefinition::EnemyDefinition::Type::Creature)
+	{
+		return std::string();
+	}
+
+	const auto &creatureDef = enemyDef.getCreature();
+	const std::string_view creatureSoundName = creatureDef.soundName;
+	return String::toUppercase(std::string(creatureSoundName));
+}
@@ -50,6 +50,9 @@ namespace EntityUtils
 	bool withinHearingDistance(const CoordDouble3 &listenerCoord, const CoordDouble2 &soundCoord, double ceilingScale);
 
 	double nextCreatureSoundWaitTime(Random &random);
+
+	// Gets the .VOC filename of a creature's sound, or an empty string if the entity isn't a creature.
+	std::string getCreatureSoundFilename(const EntityDefinition &entityDef);
 }
 
 #endif
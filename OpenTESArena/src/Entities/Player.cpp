@@ -8,6 +8,7 @@
 #include "PrimaryAttributeName.h"
 #include "../Collision/CollisionChunk.h"
 #include "../Collision/CollisionChunkManager.h"
+#include "../Collision/SweepUtils.h"
 #include "../Game/CardinalDirection.h"
 #include "../Game/Game.h"
 #include "../Game/GameState.h"
@@ -30,6 +31,9 @@ namespace // @todo: could be in a PlayerUtils instead
 
 	// Friction for slowing the player down on ground.
 	constexpr double FRICTION = 3.0;
+
+	// Half the width of the player's square footprint for collision, in voxels.
+	constexpr double COLLISION_HALF_WIDTH = 0.15;
 }
 
 Player::Player()
@@ -39,6 +43,7 @@ Player::Player()
 	this->charClassDefID = -1;
 	this->portraitID = -1;
 	this->camera.init(CoordDouble3(), -Double3::UnitX); // To avoid audio listener normalization issues w/ uninitialized player.
+	this->prevPosition = this->camera.position;
 	this->maxWalkSpeed = 0.0;
 	this->friction = 0.0;
 }
@@ -53,6 +58,7 @@ void Player::init(const std::string &displayName, bool male, int raceID, int cha
 	this->charClassDefID = charClassDefID;
 	this->portraitID = portraitID;
 	this->camera.init(position, direction);
+	this->prevPosition = position;
 	this->velocity = velocity;
 	this->maxWalkSpeed = maxWalkSpeed;
 	this->friction = FRICTION;
@@ -70,6 +76,7 @@ void Player::init(const std::string &displayName, bool male, int raceID, int cha
 	this->charClassDefID = charClassDefID;
 	this->portraitID = portraitID;
 	this->camera.init(position, direction);
+	this->prevPosition = position;
 	this->velocity = velocity;
 	this->maxWalkSpeed = maxWalkSpeed;
 	this->friction = FRICTION;
@@ -88,6 +95,7 @@ void Player::initRandom(const CharacterClassLibrary &charClassLibrary, const Exe
 	const CoordDouble3 position(ChunkInt2::Zero, VoxelDouble3::Zero);
 	const Double3 direction(CardinalDirection::North.x, 0.0, CardinalDirection::North.y);
 	this->camera.init(position, direction);
+	this->prevPosition = position;
 	this->velocity = Double3::Zero;
 	this->maxWalkSpeed = Player::DEFAULT_WALK_SPEED;
 	this->friction = FRICTION;
@@ -119,6 +127,12 @@ const CoordDouble3 &Player::getPosition() const
 	return this->camera.position;
 }
 
+CoordDouble3 Player::getInterpolatedPosition(double percent) const
+{
+	const VoxelDouble3 delta = this->camera.position - this->prevPosition;
+	return this->prevPosition + (delta * percent);
+}
+
 const std::string &Player::getDisplayName() const
 {
 	return this->displayName;
@@ -239,7 +253,9 @@ bool Player::onGround(const CollisionChunkManager &collisionChunkManager) const
 
 void Player::teleport(const CoordDouble3 &position)
 {
+	// Don't interpolate across a teleport.
 	this->camera.position = position;
+	this->prevPosition = position;
 }
 
 void Player::rotate(double dx, double dy, double hSensitivity, double vSensitivity,
@@ -276,37 +292,6 @@ void Player::handleCollision(double dt, const VoxelChunkManager &voxelChunkManag
 		return &voxelTraitsDef;
 	};
 
-	// Coordinates of the base of the voxel the feet are in.
-	// - @todo: add delta velocity Y?
-	const int feetVoxelY = static_cast<int>(std::floor(this->getFeetY() / ceilingScale));
-
-	// Regular old Euler integration in XZ plane.
-	const CoordDouble3 curPlayerCoord = this->getPosition();
-	const VoxelDouble3 deltaPosition(this->velocity.x * dt, 0.0, this->velocity.z * dt);
-
-	// The next voxels in X/Y/Z directions based on player movement.
-	const VoxelInt3 nextXVoxel(
-		static_cast<SNInt>(std::floor(curPlayerCoord.point.x + deltaPosition.x)),
-		feetVoxelY,
-		static_cast<WEInt>(std::floor(curPlayerCoord.point.z)));
-	const VoxelInt3 nextYVoxel(
-		static_cast<SNInt>(std::floor(curPlayerCoord.point.x)),
-		nextXVoxel.y,
-		nextXVoxel.z);
-	const VoxelInt3 nextZVoxel(
-		nextYVoxel.x,
-		nextYVoxel.y,
-		static_cast<WEInt>(std::floor(curPlayerCoord.point.z + deltaPosition.z)));
-
-	const CoordInt3 nextXCoord = ChunkUtils::recalculateCoord(curPlayerCoord.chunk, nextXVoxel);
-	const CoordInt3 nextYCoord = ChunkUtils::recalculateCoord(curPlayerCoord.chunk, nextYVoxel);
-	const CoordInt3 nextZCoord = ChunkUtils::recalculateCoord(curPlayerCoord.chunk, nextZVoxel);
-	const VoxelTraitsDefinition *xVoxelTraitsDef = tryGetVoxelTraitsDef(nextXCoord);
-	const VoxelTraitsDefinition *yVoxelTraitsDef = tryGetVoxelTraitsDef(nextYCoord);
-	const VoxelTraitsDefinition *zVoxelTraitsDef = tryGetVoxelTraitsDef(nextZCoord);
-
-	// Check horizontal collisions.
-
 	// -- Temp hack until Y collision detection is implemented --
 	// - @todo: formalize the collision calculation and get rid of this hack.
 	//   We should be able to cover all collision cases in Arena now.
@@ -379,20 +364,27 @@ void Player::handleCollision(double dt, const VoxelChunkManager &voxelChunkManag
 		}
 	};
 
-	if ((xVoxelTraitsDef != nullptr) && wouldCollideWithVoxel(nextXCoord, *xVoxelTraitsDef))
+	auto isColliderFunc = [&tryGetVoxelTraitsDef, &wouldCollideWithVoxel](const CoordInt3 &coord)
 	{
-		this->velocity.x = 0.0;
-	}
+		const VoxelTraitsDefinition *voxelTraitsDef = tryGetVoxelTraitsDef(coord);
+		return (voxelTraitsDef != nullptr) && wouldCollideWithVoxel(coord, *voxelTraitsDef);
+	};
 
-	if ((zVoxelTraitsDef != nullptr) && wouldCollideWithVoxel(nextZCoord, *zVoxelTraitsDef))
-	{
-		this->velocity.z = 0.0;
-	}
+	// Coordinates of the base of the voxel the feet are in.
+	// - @todo: add delta velocity Y?
+	const int feetVoxelY = static_cast<int>(std::floor(this->getFeetY() / ceilingScale));
+
+	// Sweep the player's footprint along the movement so no collider is skipped regardless of speed or delta
+	// time, sliding along anything it hits.
+	const VoxelDouble2 delta(this->velocity.x * dt, this->velocity.z * dt);
+	VoxelDouble2 velocityXZ(this->velocity.x, this->velocity.z);
+	this->camera.position = SweepUtils::slideSquare(this->getPosition(), COLLISION_HALF_WIDTH, delta, feetVoxelY,
+		isColliderFunc, &velocityXZ);
+	this->velocity.x = velocityXZ.x;
+	this->velocity.z = velocityXZ.y;
 
 	this->velocity.y = 0.0;
 	// -- end hack --
-
-	// @todo: use an axis-aligned bounding box or cylinder instead of a point?
 }
 
 void Player::setVelocityToZero()
@@ -458,21 +450,12 @@ void Player::updatePhysics(double dt, const VoxelChunkManager &voxelChunkManager
 	// Acceleration from gravity (always).
 	this->accelerate(-Double3::UnitY, GRAVITY, dt);
 
-	// Change the player's velocity based on collision.
-	this->handleCollision(dt, voxelChunkManager, collisionChunkManager, ceilingScale);
-
 	// Temp: get floor Y until Y collision is implemented.
 	const double floorY = ceilingScale;
 	this->camera.position.point.y = floorY + Player::HEIGHT; // Temp: keep camera Y fixed until Y collision is implemented.
 
-	// Simple Euler integration for updating the player's position.
-	const VoxelDouble3 newPoint = this->camera.position.point + (this->velocity * dt);
-
-	// Update the position if valid.
-	if (std::isfinite(newPoint.length()))
-	{
-		this->camera.position = ChunkUtils::recalculateCoord(this->camera.position.chunk, newPoint);
-	}
+	// Move the player, stopping at and sliding along anything in the way.
+	this->handleCollision(dt, voxelChunkManager, collisionChunkManager, ceilingScale);
 
 	if (this->onGround(collisionChunkManager))
 	{
@@ -490,6 +473,8 @@ void Player::updatePhysics(double dt, const VoxelChunkManager &voxelChunkManager
 
 void Player::tick(Game &game, double dt)
 {
+	this->prevPosition = this->camera.position;
+
 	// Update player position and velocity due to collisions.
 	const bool isGhostModeEnabled = game.getOptions().getMisc_GhostMode();
 	if (!isGhostModeEnabled)
@@ -25,6 +25,7 @@ private:
 	int charClassDefID;
 	int portraitID;
 	Camera3D camera;
+	CoordDouble3 prevPosition; // Position at the start of the latest simulation tick, for render interpolation.
 	VoxelDouble3 velocity;
 	double maxWalkSpeed; // Eventually a function of 'Speed'.
 	double friction;
@@ -35,7 +36,8 @@ private:
 	// Gets the Y position of the player's feet.
 	double getFeetY() const;
 
-	// Changes the player's velocity based on collision with objects in the world.
+	// Moves the player by their velocity over the delta time, sweeping against colliders in the world and
+	// sliding along any that are hit.
 	void handleCollision(double dt, const VoxelChunkManager &voxelChunkManager, const CollisionChunkManager &collisionChunkManager, double ceilingScale);
 
 	// Updates the player's position and velocity based on interactions with the world.
@@ -63,6 +65,11 @@ public:
 	static constexpr double DEFAULT_WALK_SPEED = 2.0;
 
 	const CoordDouble3 &getPosition() const;
+
+	// Gets the player's position blended between the previous and current simulation ticks. Only meant for
+	// presentation (camera, audio listener); game logic should use the simulated position.
+	CoordDouble3 getInterpolatedPosition(double percent) const;
+
 	const std::string &getDisplayName() const;
 	std::string getFirstName() const;
 	int getPortraitID() const;
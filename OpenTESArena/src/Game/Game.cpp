@@ -1,7 +1,10 @@
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <cstdint>
 #include <filesystem>
+#include <functional>
+#include <limits>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -13,6 +16,7 @@
 #include "Options.h"
 #include "PlayerInterface.h"
 #include "../Assets/ArenaLevelLibrary.h"
+#include "../Assets/AssetCache.h"
 #include "../Assets/BinaryAssetLibrary.h"
 #include "../Assets/CityDataFile.h"
 #include "../Assets/TextAssetLibrary.h"
@@ -30,6 +34,7 @@
 #include "../Interface/IntroUiModel.h"
 #include "../Interface/Panel.h"
 #include "../Rendering/Renderer.h"
+#include "../Rendering/RendererUtils.h"
 #include "../UI/CursorData.h"
 #include "../UI/FontLibrary.h"
 #include "../UI/GuiUtils.h"
@@ -39,6 +44,7 @@
 #include "components/debug/Debug.h"
 #include "components/utilities/Directory.h"
 #include "components/utilities/File.h"
+#include "components/utilities/HeapAllocationCounter.h"
 #include "components/utilities/Path.h"
 #include "components/utilities/String.h"
 #include "components/utilities/TextLinesFile.h"
@@ -46,6 +52,73 @@
 
 namespace
 {
+	// The game world is simulated at a fixed rate independent of the frame rate so movement and timers
+	// behave the same at any FPS.
+	constexpr int SIMULATION_TICKS_PER_SECOND = 60;
+	constexpr double SIMULATION_TICK_SECONDS = 1.0 / static_cast<double>(SIMULATION_TICKS_PER_SECOND);
+
+	// Upper limit on simulation ticks in one frame. Any time accumulated past this is dropped so a slow frame
+	// can't cause even more ticks the next frame and spiral out of control.
+	constexpr int MAX_SIMULATION_TICKS_PER_FRAME = 5;
+
+	// Appends each piece in place so the debug text doesn't build heap-allocated temporaries.
+	template <typename... Args>
+	void AppendDebugText(FrameString &text, const Args&... args)
+	{
+		((text += args), ...);
+	}
+
+	// Per-stage timings accumulated over an input replay, logged when the replay finishes.
+	struct ReplayStats
+	{
+		int frameCount;
+		double inputSeconds, tickSeconds, renderSeconds;
+		double minFrameSeconds, maxFrameSeconds;
+
+		ReplayStats()
+		{
+			this->frameCount = 0;
+			this->inputSeconds = 0.0;
+			this->tickSeconds = 0.0;
+			this->renderSeconds = 0.0;
+			this->minFrameSeconds = std::numeric_limits<double>::infinity();
+			this->maxFrameSeconds = 0.0;
+		}
+
+		void addFrame(double inputTime, double tickTime, double renderTime)
+		{
+			const double frameTime = inputTime + tickTime + renderTime;
+			this->frameCount++;
+			this->inputSeconds += inputTime;
+			this->tickSeconds += tickTime;
+			this->renderSeconds += renderTime;
+			this->minFrameSeconds = std::min(this->minFrameSeconds, frameTime);
+			this->maxFrameSeconds = std::max(this->maxFrameSeconds, frameTime);
+		}
+
+		void log() const
+		{
+			if (this->frameCount == 0)
+			{
+				DebugLogWarning("Input replay had no frames.");
+				return;
+			}
+
+			auto toAverageMsString = [this](double seconds)
+			{
+				return String::fixedPrecision((seconds * 1000.0) / static_cast<double>(this->frameCount), 3);
+			};
+
+			const double totalSeconds = this->inputSeconds + this->tickSeconds + this->renderSeconds;
+			DebugLog("Input replay finished: " + std::to_string(this->frameCount) + " frames in " +
+				String::fixedPrecision(totalSeconds, 3) + "s (avg " + toAverageMsString(totalSeconds) + "ms, min " +
+				String::fixedPrecision(this->minFrameSeconds * 1000.0, 3) + "ms, max " +
+				String::fixedPrecision(this->maxFrameSeconds * 1000.0, 3) + "ms).");
+			DebugLog("Input replay stage averages: input " + toAverageMsString(this->inputSeconds) + "ms, tick " +
+				toAverageMsString(this->tickSeconds) + "ms, render " + toAverageMsString(this->renderSeconds) + "ms.");
+		}
+	};
+
 	bool TryMakeValidArenaExePath(const std::string &vfsFolderPath, std::string *outExePath, bool *outIsFloppyDiskVersion)
 	{
 		// Check for CD version first.
@@ -72,6 +145,31 @@ namespace
 		// No valid Arena .exe found.
 		return false;
 	}
+
+	// An asset library being initialized by a job. Results are only read after the job is waited on.
+	struct LibraryInitJob
+	{
+		std::string name;
+		std::function<bool()> initFunc;
+		bool success;
+		double seconds;
+		JobHandle handle;
+
+		LibraryInitJob(const std::string &name, std::function<bool()> &&initFunc)
+			: name(name), initFunc(std::move(initFunc))
+		{
+			this->success = false;
+			this->seconds = 0.0;
+		}
+
+		void run()
+		{
+			const auto startTime = std::chrono::high_resolution_clock::now();
+			this->success = this->initFunc();
+			const auto endTime = std::chrono::high_resolution_clock::now();
+			this->seconds = std::chrono::duration<double>(endTime - startTime).count();
+		}
+	};
 }
 
 Game::Game()
@@ -81,6 +179,8 @@ Game::Game()
 	this->requestedSubPanelPop = false;
 
 	this->shouldSimulateScene = false;
+	this->simulationInterpolationPercent = 0.0;
+	this->prevFrameHeapAllocationCount = 0;
 	this->running = true;
 }
 
@@ -116,10 +216,23 @@ Game::~Game()
 	renderWeatherManager.shutdown(this->renderer);
 }
 
-bool Game::init()
+bool Game::init(const std::string &recordInputPath, const std::string &replayInputPath)
 {
 	DebugLog("Initializing (Platform: " + Platform::getPlatform() + ").");
 
+	if (!replayInputPath.empty())
+	{
+		if (!this->inputRecording.initReplay(replayInputPath.c_str()))
+		{
+			DebugLogError("Couldn't init input replay \"" + replayInputPath + "\".");
+			return false;
+		}
+
+		// Replays are for benchmarking and can run unattended, so use SDL's windowless video driver.
+		SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+		DebugLog("Replaying input from \"" + replayInputPath + "\".");
+	}
+
 	// Current working directory (in most cases). This is most relevant for platforms like macOS, where
 	// the base path might be in the app's Resources folder.
 	const std::string basePath = Platform::getBasePath();
@@ -130,6 +243,9 @@ bool Game::init()
 	const std::string optionsPath = Platform::getOptionsPath();
 	this->initOptions(basePath, optionsPath);
 
+	// Data derived from the game files is cached next to the options.
+	AssetCache::init(optionsPath + "cache/");
+
 	const std::string &arenaPath = this->options.getMisc_ArenaPath();
 	DebugLog("Using ArenaPath \"" + arenaPath + "\".");
 
@@ -161,6 +277,9 @@ bool Game::init()
 		this->options.getAudio_SoundChannels(), this->options.getAudio_SoundResampling(),
 		this->options.getAudio_Is3DAudio(), midiFilePath, audioDataPath);
 
+	// Initialize the worker pool shared by parallel systems, sized by the render threads setting.
+	this->jobSystem.init(RendererUtils::getJobWorkersFromMode(this->options.getGraphics_RenderThreadsMode()));
+
 	// Initialize the renderer and window with the given settings.
 	auto resolutionScaleFunc = [this]()
 	{
@@ -168,12 +287,20 @@ bool Game::init()
 		return options.getGraphics_ResolutionScale();
 	};
 
+	// A replay uses the recorded window size since mouse positions are relative to it.
+	const bool isReplaying = this->inputRecording.isReplaying();
+	const Int2 recordedWindowDims = this->inputRecording.getWindowDimensions();
+	const int screenWidth = isReplaying ? recordedWindowDims.x : this->options.getGraphics_ScreenWidth();
+	const int screenHeight = isReplaying ? recordedWindowDims.y : this->options.getGraphics_ScreenHeight();
+	const Renderer::WindowMode windowMode = isReplaying ? Renderer::WindowMode::Window :
+		static_cast<Renderer::WindowMode>(this->options.getGraphics_WindowMode());
+
 	constexpr RendererSystemType2D rendererSystemType2D = RendererSystemType2D::SDL2;
 	constexpr RendererSystemType3D rendererSystemType3D = RendererSystemType3D::SoftwareClassic;
-	if (!this->renderer.init(this->options.getGraphics_ScreenWidth(), this->options.getGraphics_ScreenHeight(),
-		static_cast<Renderer::WindowMode>(this->options.getGraphics_WindowMode()),
+	if (!this->renderer.init(screenWidth, screenHeight, windowMode,
 		this->options.getGraphics_LetterboxMode(), this->options.getGraphics_ModernInterface(),
-		resolutionScaleFunc, rendererSystemType2D, rendererSystemType3D, this->options.getGraphics_RenderThreadsMode()))
+		resolutionScaleFunc, rendererSystemType2D, rendererSystemType3D, this->options.getGraphics_RenderThreadsMode(),
+		this->jobSystem))
 	{
 		DebugLogError("Couldn't init renderer (2D: " + std::to_string(static_cast<int>(rendererSystemType2D)) +
 			", 3D: " + std::to_string(static_cast<int>(rendererSystemType3D)) + ").");
@@ -210,44 +337,108 @@ bool Game::init()
 	this->debugProfilerListenerID = this->inputManager.addInputActionListener(
 		InputActionName::DebugProfiler, CommonUiController::onDebugInputAction);
 
-	// Load various asset libraries.
-	if (!FontLibrary::getInstance().init())
+	// Load various asset libraries as jobs. The ones that only read game files don't depend on each other so
+	// they are loaded concurrently. Libraries needing the executable data depend on the binary asset library
+	// job, and anything using the texture manager runs as a main-thread job.
+	const auto libraryStartTime = std::chrono::high_resolution_clock::now();
+	BinaryAssetLibrary &binaryAssetLibrary = BinaryAssetLibrary::getInstance();
+	const std::string musicLibraryPath = audioDataPath + "MusicDefinitions.txt";
+
+	std::vector<std::unique_ptr<LibraryInitJob>> libraryInitJobs;
+	auto scheduleLibraryInit = [this, &libraryInitJobs](const std::string &name, std::function<bool()> &&initFunc,
+		BufferView<const JobHandle> dependencies, bool mainThreadOnly) -> LibraryInitJob&
 	{
-		DebugLogError("Couldn't init font library.");
-		return false;
-	}
+		LibraryInitJob &job = *libraryInitJobs.emplace_back(std::make_unique<LibraryInitJob>(name, std::move(initFunc)));
+		Job func = [&job]() { job.run(); };
+		job.handle = mainThreadOnly ? this->jobSystem.scheduleMainThread(std::move(func), dependencies) :
+			this->jobSystem.schedule(std::move(func), dependencies);
+		return job;
+	};
 
-	if (!ArenaLevelLibrary::getInstance().init())
+	scheduleLibraryInit("font library",
+		[]() { return FontLibrary::getInstance().init(); }, BufferView<const JobHandle>(), false);
+	scheduleLibraryInit("Arena level library",
+		[]() { return ArenaLevelLibrary::getInstance().init(); }, BufferView<const JobHandle>(), false);
+	scheduleLibraryInit("text asset library",
+		[]() { return TextAssetLibrary::getInstance().init(); }, BufferView<const JobHandle>(), false);
+	scheduleLibraryInit("music library",
+		[&musicLibraryPath]()
 	{
-		DebugLogError("Couldn't init Arena level library.");
-		return false;
+		if (!MusicLibrary::getInstance().init(musicLibraryPath.c_str()))
+		{
+			DebugLogError("Couldn't init music library with path \"" + musicLibraryPath + "\".");
+			return false;
+		}
+
+		return true;
+	}, BufferView<const JobHandle>(), false);
+	scheduleLibraryInit("cinematic library",
+		[]() { CinematicLibrary::getInstance().init(); return true; }, BufferView<const JobHandle>(), false);
+
+	const LibraryInitJob &binaryAssetLibraryJob = scheduleLibraryInit("binary asset library",
+		[&binaryAssetLibrary, isFloppyDiskVersion]() { return binaryAssetLibrary.init(isFloppyDiskVersion); },
+		BufferView<const JobHandle>(), false);
+
+	// The dependency only orders the jobs, so these also skip their work if the executable data failed to load.
+	const JobHandle exeDataDependencies[] = { binaryAssetLibraryJob.handle };
+	scheduleLibraryInit("character class library",
+		[&binaryAssetLibrary, &binaryAssetLibraryJob]()
+	{
+		if (!binaryAssetLibraryJob.success)
+		{
+			return false;
+		}
+
+		CharacterClassLibrary::getInstance().init(binaryAssetLibrary.getExeData());
+		return true;
+	}, exeDataDependencies, false);
+	scheduleLibraryInit("entity definition library",
+		[this, &binaryAssetLibrary, &binaryAssetLibraryJob]()
+	{
+		if (!binaryAssetLibraryJob.success)
+		{
+			return false;
+		}
+
+		EntityDefinitionLibrary::getInstance().init(binaryAssetLibrary.getExeData(), this->textureManager);
+		return true;
+	}, exeDataDependencies, true);
+
+	// Wait for every job before returning so none are still running if one fails. Main-thread jobs run
+	// during the wait.
+	std::vector<JobHandle> libraryInitHandles;
+	for (const std::unique_ptr<LibraryInitJob> &job : libraryInitJobs)
+	{
+		libraryInitHandles.emplace_back(job->handle);
 	}
 
-	BinaryAssetLibrary &binaryAssetLibrary = BinaryAssetLibrary::getInstance();
-	if (!binaryAssetLibrary.init(isFloppyDiskVersion))
+	this->jobSystem.wait(libraryInitHandles);
+
+	bool allLibrariesInited = true;
+	for (const std::unique_ptr<LibraryInitJob> &job : libraryInitJobs)
 	{
-		DebugLogError("Couldn't init binary asset library.");
-		return false;
+		if (!job->success)
+		{
+			DebugLogError("Couldn't init " + job->name + ".");
+			allLibrariesInited = false;
+		}
 	}
 
-	if (!TextAssetLibrary::getInstance().init())
+	if (!allLibrariesInited)
 	{
-		DebugLogError("Couldn't init text asset library.");
 		return false;
 	}
 
-	const std::string musicLibraryPath = audioDataPath + "MusicDefinitions.txt";
-	if (!MusicLibrary::getInstance().init(musicLibraryPath.c_str()))
+	const auto libraryEndTime = std::chrono::high_resolution_clock::now();
+	const double librarySeconds = std::chrono::duration<double>(libraryEndTime - libraryStartTime).count();
+	for (const std::unique_ptr<LibraryInitJob> &job : libraryInitJobs)
 	{
-		DebugLogError("Couldn't init music library with path \"" + musicLibraryPath + "\".");
-		return false;
+		DebugLog("Loaded " + job->name + " in " + String::fixedPrecision(job->seconds * 1000.0, 1) + "ms.");
 	}
 
-	CinematicLibrary::getInstance().init();
+	DebugLog("Asset libraries loaded in " + String::fixedPrecision(librarySeconds * 1000.0, 1) + "ms.");
 
 	const ExeData &exeData = binaryAssetLibrary.getExeData();
-	CharacterClassLibrary::getInstance().init(exeData);
-	EntityDefinitionLibrary::getInstance().init(exeData, this->textureManager);
 
 	this->sceneManager.init(this->textureManager, this->renderer);
 
@@ -281,8 +472,39 @@ bool Game::init()
 	const Int2 windowDims = this->renderer.getWindowDimensions();
 	this->updateNativeCursorRegions(windowDims.x, windowDims.y);
 
-	// Random seed.
-	this->random.init();
+	if (isReplaying && (windowDims != recordedWindowDims))
+	{
+		DebugLogWarning("Replay window size " + windowDims.toString() + " doesn't match recorded size " +
+			recordedWindowDims.toString() + ".");
+	}
+
+	// Random seed. A replay starts from the seeds its recording was made with.
+	if (isReplaying)
+	{
+		this->random.init(this->inputRecording.getRandomSeed());
+		this->arenaRandom.srand(this->inputRecording.getArenaRandomSeed());
+	}
+	else if (!recordInputPath.empty())
+	{
+		const auto currentTime = std::chrono::system_clock::now();
+		const int64_t secondsSinceEpoch = std::chrono::duration_cast<std::chrono::seconds>(currentTime.time_since_epoch()).count();
+		const int randomSeed = static_cast<int>(secondsSinceEpoch % std::numeric_limits<int>::max());
+		this->random.init(randomSeed);
+
+		if (!this->inputRecording.initRecord(recordInputPath.c_str(), randomSeed, this->arenaRandom.getSeed(), windowDims))
+		{
+			DebugLogError("Couldn't init input recording \"" + recordInputPath + "\".");
+			return false;
+		}
+
+		DebugLog("Recording input to \"" + recordInputPath + "\".");
+	}
+	else
+	{
+		this->random.init();
+	}
+
+	this->inputManager.setRecording(&this->inputRecording);
 
 	// Use an in-game texture as the cursor instead of system cursor.
 	SDL_ShowCursor(SDL_FALSE);
@@ -336,6 +558,11 @@ void Game::setIsSimulatingScene(bool active)
 	this->shouldSimulateScene = active;
 }
 
+double Game::getSimulationInterpolationPercent() const
+{
+	return this->simulationInterpolationPercent;
+}
+
 bool Game::characterCreationIsActive() const
 {
 	return this->charCreationState.get() != nullptr;
@@ -357,6 +584,16 @@ Renderer &Game::getRenderer()
 	return this->renderer;
 }
 
+JobSystem &Game::getJobSystem()
+{
+	return this->jobSystem;
+}
+
+FrameArena &Game::getFrameArena()
+{
+	return this->frameArena;
+}
+
 TextureManager &Game::getTextureManager()
 {
 	return this->textureManager;
@@ -596,7 +833,8 @@ void Game::renderDebugInfo()
 		return;
 	}
 
-	std::string debugText;
+	// Built in the frame arena since it's rebuilt every frame.
+	FrameString debugText{ FrameAllocator<char>(this->frameArena) };
 	if (profilerLevel >= 1)
 	{
 		// FPS.
@@ -610,8 +848,8 @@ void Game::renderDebugInfo()
 		const std::string averageFrameTimeText = String::fixedPrecision(averageFrameTimeMS, 1);
 		const std::string lowestFrameTimeText = String::fixedPrecision(lowestFrameTimeMS, 1);
 		const std::string highestFrameTimeText = String::fixedPrecision(highestFrameTimeMS, 1);
-		debugText.append("FPS: " + averageFpsText + " (" + averageFrameTimeText + "ms " + lowestFrameTimeText +
-			"ms " + highestFrameTimeText + "ms)");
+		AppendDebugText(debugText, "FPS: ", averageFpsText, " (", averageFrameTimeText, "ms ", lowestFrameTimeText,
+			"ms ", highestFrameTimeText, "ms)");
 	}
 
 	const Int2 windowDims = this->renderer.getWindowDimensions();
@@ -620,7 +858,30 @@ void Game::renderDebugInfo()
 		// Renderer details (window res, render res, threads, frame times, etc.).
 		const std::string windowWidth = std::to_string(windowDims.x);
 		const std::string windowHeight = std::to_string(windowDims.y);
-		debugText.append("\nScreen: " + windowWidth + "x" + windowHeight);
+		AppendDebugText(debugText, "\nScreen: ", windowWidth, "x", windowHeight);
+
+		// Busy percent of each job system worker since the last time this was shown.
+		const int jobWorkerCount = this->jobSystem.getWorkerCount();
+		FrameVector<double> jobWorkerUtilizations(jobWorkerCount, 0.0, FrameAllocator<double>(this->frameArena));
+		this->jobSystem.sampleWorkerUtilization(BufferView<double>(jobWorkerUtilizations.data(), jobWorkerCount));
+		AppendDebugText(debugText, "\nJob workers: ", std::to_string(jobWorkerCount));
+		for (int i = 0; i < jobWorkerCount; i++)
+		{
+			AppendDebugText(debugText, (i == 0) ? " (" : " ", std::to_string(static_cast<int>(jobWorkerUtilizations[i] * 100.0)), "%");
+		}
+
+		if (jobWorkerCount > 0)
+		{
+			AppendDebugText(debugText, ")");
+		}
+
+		// Main thread heap allocations vs. transient ones served by the frame arena, both from the last full frame.
+		// Heap counts need a build with OTA_PROFILE_HEAP_ALLOCATIONS.
+		const std::string heapAllocationCount = HeapAllocationCounter::isEnabled() ?
+			std::to_string(this->prevFrameHeapAllocationCount) : "n/a";
+		const std::string frameArenaKbCount = std::to_string(this->frameArena.getPrevByteCount() / 1024);
+		AppendDebugText(debugText, "\nAllocs/frame: heap ", heapAllocationCount, ", frame arena ",
+			std::to_string(this->frameArena.getPrevAllocationCount()), " (", frameArenaKbCount, " KB)");
 
 		const Renderer::ProfilerData &profilerData = this->renderer.getProfilerData();
 		const Int2 renderDims(profilerData.width, profilerData.height);
@@ -633,19 +894,33 @@ void Game::renderDebugInfo()
 			const std::string renderResScale = String::fixedPrecision(resolutionScale, 2);
 			const std::string renderThreadCount = std::to_string(profilerData.threadCount);
 			const std::string renderTime = String::fixedPrecision(profilerData.frameTime * 1000.0, 2);
+			const std::string renderWaitTime = String::fixedPrecision(profilerData.waitTime * 1000.0, 2);
+			const std::string renderLatency = String::fixedPrecision(profilerData.latency * 1000.0, 2);
 			const std::string renderDrawCallCount = std::to_string(profilerData.drawCallCount);
 			const std::string objectTextureMbCount = String::fixedPrecision(static_cast<double>(profilerData.objectTextureByteCount) / (1024.0 * 1024.0), 2);
-			debugText.append("\nRender: " + renderWidth + "x" + renderHeight + " (" + renderResScale + "), " +
-				renderThreadCount + " thread" + ((profilerData.threadCount > 1) ? "s" : "") + '\n' +
-				"3D render: " + renderTime + "ms" + '\n' +
-				"Textures: " + std::to_string(profilerData.objectTextureCount) + " (" + objectTextureMbCount + "MB)" + '\n' +
-				"Draw calls: " + renderDrawCallCount + '\n' +
-				"Triangles: " + std::to_string(profilerData.visTriangleCount) + " / " + std::to_string(profilerData.sceneTriangleCount) + '\n' +
-				"Lights: " + std::to_string(profilerData.totalLightCount));
+			const std::string geometryMbCount = String::fixedPrecision(static_cast<double>(profilerData.geometryByteCount) / (1024.0 * 1024.0), 2);
+			AppendDebugText(debugText, "\nRender: ", renderWidth, "x", renderHeight, " (", renderResScale, "), ",
+				renderThreadCount, " thread", (profilerData.threadCount > 1) ? "s" : "", '\n',
+				"3D render: ", renderTime, "ms (wait ", renderWaitTime, "ms, latency ", renderLatency, "ms)", '\n',
+				"Textures: ", std::to_string(profilerData.objectTextureCount), " (", objectTextureMbCount, "MB)", '\n',
+				"Geometry: ", geometryMbCount, "MB", '\n',
+				"Draw calls: ", renderDrawCallCount, '\n',
+				"Triangles: ", std::to_string(profilerData.visTriangleCount), " / ", std::to_string(profilerData.sceneTriangleCount), '\n',
+				"Lights: ", std::to_string(profilerData.totalLightCount));
+
+			const VoxelVisibilityChunkManager &voxelVisChunkManager = this->sceneManager.voxelVisChunkManager;
+			const int visibleVoxelCount = voxelVisChunkManager.getVisibleVoxelCount();
+			const int culledVoxelCount = voxelVisChunkManager.getCulledVoxelCount();
+			AppendDebugText(debugText, "\nVoxels culled: ", std::to_string(culledVoxelCount), " / ", std::to_string(visibleVoxelCount + culledVoxelCount));
+
+			const VoxelChunkSnapshotCache &chunkSnapshotCache = this->sceneManager.voxelChunkManager.getSnapshotCache();
+			AppendDebugText(debugText, "\nChunk cache: ", std::to_string(chunkSnapshotCache.getEntryCount()), " / ",
+				std::to_string(chunkSnapshotCache.getMaxEntryCount()), " (", std::to_string(chunkSnapshotCache.getCompressedByteCount() / 1024), " KB), hits: ",
+				std::to_string(chunkSnapshotCache.getHitCount()), ", misses: ", std::to_string(chunkSnapshotCache.getMissCount()));
 		}
 		else
 		{
-			debugText.append("\nNo profiler data available.");
+			AppendDebugText(debugText, "\nNo profiler data available.");
 		}
 	}
 
@@ -663,12 +938,12 @@ void Game::renderDebugInfo()
 		const std::string dirY = String::fixedPrecision(direction.y, 2);
 		const std::string dirZ = String::fixedPrecision(direction.z, 2);
 
-		debugText.append("\nChunk: " + chunkStr + '\n' +
-			"Chunk pos: " + chunkPosX + ", " + chunkPosY + ", " + chunkPosZ + '\n' +
-			"Dir: " + dirX + ", " + dirY + ", " + dirZ);
+		AppendDebugText(debugText, "\nChunk: ", chunkStr, '\n',
+			"Chunk pos: ", chunkPosX, ", ", chunkPosY, ", ", chunkPosZ, '\n',
+			"Dir: ", dirX, ", ", dirY, ", ", dirZ);
 	}
 
-	this->debugInfoTextBox.setText(debugText);
+	this->debugInfoTextBox.setText(std::string_view(debugText.data(), debugText.size()));
 
 	const UiTextureID textureID = this->debugInfoTextBox.getTextureID();
 	const Rect &debugInfoRect = this->debugInfoTextBox.getRect();
@@ -716,6 +991,18 @@ void Game::loop()
 	// help compensate.
 	std::chrono::nanoseconds sleepBias(0);
 
+	// UI draw calls submitted together, reused between frames.
+	std::vector<RendererSystem2D::RenderElement> uiRenderElements;
+
+	// Frame time not yet consumed by fixed-rate simulation ticks.
+	double simulationAccumulator = 0.0;
+
+	// Recorded and replayed sessions advance by exactly one simulation tick per frame so the same input
+	// produces the same simulation regardless of how fast each frame ran. Replays also run unthrottled.
+	const bool isReplaying = this->inputRecording.isReplaying();
+	const bool isFixedDeltaTime = isReplaying || this->inputRecording.isRecording();
+	ReplayStats replayStats;
+
 	auto thisTime = std::chrono::high_resolution_clock::now();
 
 	// Primary game loop.
@@ -723,10 +1010,11 @@ void Game::loop()
 	{
 		const auto lastTime = thisTime;
 		thisTime = std::chrono::high_resolution_clock::now();
+		const uint64_t frameStartHeapAllocationCount = HeapAllocationCounter::getThreadAllocationCount();
 
 		// Shortest allowed frame time.
 		const std::chrono::duration<int64_t, std::nano> minFrameTime(
-			timeUnits / this->options.getGraphics_TargetFPS());
+			isReplaying ? 0 : (timeUnits / this->options.getGraphics_TargetFPS()));
 
 		// Time since the last frame started.
 		const auto frameTime = [minFrameTime, &sleepBias, &thisTime, lastTime]()
@@ -757,15 +1045,20 @@ void Game::loop()
 		// Two delta times: actual and clamped. Use the clamped delta time for game calculations
 		// so things don't break at low frame rates.
 		constexpr double timeUnitsReal = static_cast<double>(timeUnits);
-		const double dt = static_cast<double>(frameTime.count()) / timeUnitsReal;
-		const double clampedDt = std::fmin(frameTime.count(), maxFrameTime.count()) / timeUnitsReal;
+		const double frameSeconds = static_cast<double>(frameTime.count()) / timeUnitsReal;
+		const double dt = isFixedDeltaTime ? SIMULATION_TICK_SECONDS : frameSeconds;
+		const double clampedDt = isFixedDeltaTime ? SIMULATION_TICK_SECONDS :
+			(std::fmin(frameTime.count(), maxFrameTime.count()) / timeUnitsReal);
 
 		// Update FPS counter.
-		this->fpsCounter.updateFrameTime(dt);
+		this->fpsCounter.updateFrameTime(frameSeconds);
 
 		// User input.
+		this->profiler.setStart(ProfilerUtils::INPUT);
 		try
 		{
+			const int replayFrameIndex = this->inputRecording.getFrameCount();
+
 			const BufferView<const ButtonProxy> buttonProxies = this->getActivePanel()->getButtonProxies();
 			auto onFinishedProcessingEventFunc = [this]()
 			{
@@ -775,13 +1068,27 @@ void Game::loop()
 
 			this->inputManager.update(*this, dt, buttonProxies, onFinishedProcessingEventFunc);
 
+			if (isReplaying && (this->inputRecording.getFrameCount() == replayFrameIndex))
+			{
+				// Recording exhausted.
+				replayStats.log();
+				this->running = false;
+				break;
+			}
+
 			if (this->isSimulatingScene())
 			{
-				// Handle input for player motion.
+				// Handle input for player turning. Movement is handled per simulation tick.
 				const BufferView<const Rect> nativeCursorRegionsView(this->nativeCursorRegions);
 				const Double2 playerTurnDeltaXY = PlayerLogicController::makeTurningAngularValues(*this, clampedDt, nativeCursorRegionsView);
 				PlayerLogicController::turnPlayer(*this, playerTurnDeltaXY.x, playerTurnDeltaXY.y);
-				PlayerLogicController::handlePlayerMovement(*this, clampedDt, nativeCursorRegionsView);
+
+				if (this->gameState.isActiveMapValid())
+				{
+					// The mouse delta is only valid this frame so attacks can't wait for a simulation tick.
+					const Int2 mouseDelta = this->inputManager.getMouseDelta();
+					PlayerLogicController::handlePlayerAttack(*this, mouseDelta);
+				}
 			}
 		}
 		catch (const std::exception &e)
@@ -789,9 +1096,15 @@ void Game::loop()
 			DebugCrash("User input exception: " + std::string(e.what()));
 		}
 
+		this->profiler.setStop(ProfilerUtils::INPUT);
+
 		// Tick.
+		this->profiler.setStart(ProfilerUtils::WORLD);
 		try
 		{
+			// Finish any work that other threads handed back to the main thread.
+			this->jobSystem.runMainThreadJobs();
+
 			// Animate the current UI panel by delta time.
 			this->getActivePanel()->tick(clampedDt);
 
@@ -800,34 +1113,77 @@ void Game::loop()
 
 			if (this->isSimulatingScene() && this->gameState.isActiveMapValid())
 			{
-				// Recalculate the active chunks.
-				const CoordDouble3 playerCoord = this->player.getPosition();
-				const int chunkDistance = this->options.getMisc_ChunkDistance();
-				ChunkManager &chunkManager = this->sceneManager.chunkManager;
-				chunkManager.update(playerCoord.chunk, chunkDistance);
-
-				// @todo: we should be able to get the voxel/entity/collision/etc. managers right here.
-				// It shouldn't be abstracted into a game state.
-				// - it should be like "do we need to clear the scene? yes/no. update the scene immediately? yes/no"
-
-				// Tick the various pieces of game world state.
-				this->gameState.tickGameClock(clampedDt, *this);
-				this->gameState.tickChasmAnimation(clampedDt);
-				this->gameState.tickSky(clampedDt, *this);
-				this->gameState.tickWeather(clampedDt, *this);
-				this->gameState.tickUiMessages(clampedDt);
-				this->gameState.tickPlayer(clampedDt, *this);
-				this->gameState.tickVoxels(clampedDt, *this);
-				this->gameState.tickEntities(clampedDt, *this);
-				this->gameState.tickCollision(clampedDt, *this);
+				simulationAccumulator += clampedDt;
+
+				int simulationTickCount = 0;
+				while ((simulationAccumulator >= SIMULATION_TICK_SECONDS) && (simulationTickCount < MAX_SIMULATION_TICKS_PER_FRAME))
+				{
+					const BufferView<const Rect> nativeCursorRegionsView(this->nativeCursorRegions);
+					PlayerLogicController::handlePlayerMovement(*this, SIMULATION_TICK_SECONDS, nativeCursorRegionsView);
+
+					// Recalculate the active chunks. New and freed chunks are only consumed by the first tick of a
+					// frame since rendering expects one set of chunk changes between frames.
+					ChunkManager &chunkManager = this->sceneManager.chunkManager;
+					if (simulationTickCount == 0)
+					{
+						const CoordDouble3 playerCoord = this->player.getPosition();
+						const int chunkDistance = this->options.getMisc_ChunkDistance();
+						chunkManager.update(playerCoord.chunk, chunkDistance);
+					}
+
+					const BufferView<const ChunkInt2> newChunkPositions = (simulationTickCount == 0) ?
+						chunkManager.getNewChunkPositions() : BufferView<const ChunkInt2>();
+					const BufferView<const ChunkInt2> freedChunkPositions = (simulationTickCount == 0) ?
+						chunkManager.getFreedChunkPositions() : BufferView<const ChunkInt2>();
+
+					// @todo: we should be able to get the voxel/entity/collision/etc. managers right here.
+					// It shouldn't be abstracted into a game state.
+					// - it should be like "do we need to clear the scene? yes/no. update the scene immediately? yes/no"
+
+					// Tick the various pieces of game world state.
+					this->gameState.tickGameClock(SIMULATION_TICK_SECONDS, *this);
+					this->gameState.tickChasmAnimation(SIMULATION_TICK_SECONDS);
+					this->gameState.tickSky(SIMULATION_TICK_SECONDS, *this);
+					this->gameState.tickWeather(SIMULATION_TICK_SECONDS, *this);
+					this->gameState.tickUiMessages(SIMULATION_TICK_SECONDS);
+					this->gameState.tickPlayer(SIMULATION_TICK_SECONDS, *this);
+					this->gameState.tickVoxels(SIMULATION_TICK_SECONDS, newChunkPositions, freedChunkPositions, *this);
+					this->gameState.tickEntities(SIMULATION_TICK_SECONDS, newChunkPositions, freedChunkPositions, *this);
+					this->gameState.tickCollision(SIMULATION_TICK_SECONDS, newChunkPositions, freedChunkPositions, *this);
+
+					simulationAccumulator -= SIMULATION_TICK_SECONDS;
+					simulationTickCount++;
+
+					// A scene change invalidates the rest of this frame's simulation.
+					if (this->gameState.hasPendingSceneChange())
+					{
+						simulationAccumulator = 0.0;
+						break;
+					}
+				}
+
+				if (simulationTickCount == MAX_SIMULATION_TICKS_PER_FRAME)
+				{
+					// Fell behind; drop the excess instead of trying to catch up.
+					simulationAccumulator = std::fmod(simulationAccumulator, SIMULATION_TICK_SECONDS);
+				}
+
+				this->simulationInterpolationPercent = simulationAccumulator / SIMULATION_TICK_SECONDS;
 				this->gameState.tickRendering(*this);
 
 				// Update audio listener orientation.
+				const CoordDouble3 playerCoord = this->player.getInterpolatedPosition(this->simulationInterpolationPercent);
 				const WorldDouble3 absolutePosition = VoxelUtils::coordToWorldPoint(playerCoord);
 				const WorldDouble3 &direction = this->player.getDirection();
 				const AudioManager::ListenerData listenerData(absolutePosition, direction);
 				this->audioManager.updateListener(listenerData);
 			}
+			else
+			{
+				// Don't let time spent in menus turn into a burst of simulation afterwards.
+				simulationAccumulator = 0.0;
+				this->simulationInterpolationPercent = 0.0;
+			}
 
 			this->audioManager.updateSources();
 		}
@@ -850,11 +1206,14 @@ void Game::loop()
 			DebugCrash("Late tick exception: " + std::string(e.what()));
 		}
 
+		this->profiler.setStop(ProfilerUtils::WORLD);
+
 		// Render.
+		this->profiler.setStart(ProfilerUtils::RENDERING);
 		try
 		{
 			// Get the draw calls from each UI panel/sub-panel and determine what to draw.
-			std::vector<const Panel*> panelsToRender;
+			FrameVector<const Panel*> panelsToRender{ FrameAllocator<const Panel*>(this->frameArena) };
 			panelsToRender.emplace_back(this->panel.get());
 			for (const auto &subPanel : this->subPanels)
 			{
@@ -873,6 +1232,46 @@ void Game::loop()
 
 			const Int2 windowDims = this->renderer.getWindowDimensions();
 
+			// Consecutive draw calls with the same render space and clip rect are submitted as one batch. They
+			// can't be reordered by state since later draw calls are layered on top of earlier ones.
+			RenderSpace batchRenderSpace = RenderSpace::Classic;
+			std::optional<Rect> batchClipRect;
+			uiRenderElements.clear();
+
+			auto isSameClipRect = [](const std::optional<Rect> &a, const std::optional<Rect> &b)
+			{
+				if (a.has_value() != b.has_value())
+				{
+					return false;
+				}
+
+				return !a.has_value() || ((a->getLeft() == b->getLeft()) && (a->getTop() == b->getTop()) &&
+					(a->getWidth() == b->getWidth()) && (a->getHeight() == b->getHeight()));
+			};
+
+			auto flushUiRenderElements = [this, &uiRenderElements, &batchRenderSpace, &batchClipRect]()
+			{
+				if (uiRenderElements.empty())
+				{
+					return;
+				}
+
+				if (batchClipRect.has_value())
+				{
+					const SDL_Rect clipRect = batchClipRect->getSdlRect();
+					this->renderer.setClipRect(&clipRect);
+				}
+
+				this->renderer.draw(uiRenderElements.data(), static_cast<int>(uiRenderElements.size()), batchRenderSpace);
+
+				if (batchClipRect.has_value())
+				{
+					this->renderer.setClipRect(nullptr);
+				}
+
+				uiRenderElements.clear();
+			};
+
 			for (const Panel *currentPanel : panelsToRender)
 			{
 				const BufferView<const UiDrawCall> drawCallsView = currentPanel->getDrawCalls();
@@ -884,32 +1283,29 @@ void Game::loop()
 					}
 
 					const std::optional<Rect> &optClipRect = drawCall.getClipRect();
-					if (optClipRect.has_value())
-					{
-						const SDL_Rect clipRect = optClipRect->getSdlRect();
-						this->renderer.setClipRect(&clipRect);
-					}
-
 					const UiTextureID textureID = drawCall.getTextureID();
 					const Int2 position = drawCall.getPosition();
 					const Int2 size = drawCall.getSize();
 					const PivotType pivotType = drawCall.getPivotType();
 					const RenderSpace renderSpace = drawCall.getRenderSpace();
 
+					if ((renderSpace != batchRenderSpace) || !isSameClipRect(optClipRect, batchClipRect))
+					{
+						flushUiRenderElements();
+						batchRenderSpace = renderSpace;
+						batchClipRect = optClipRect;
+					}
+
 					double xPercent, yPercent, wPercent, hPercent;
 					GuiUtils::makeRenderElementPercents(position.x, position.y, size.x, size.y, windowDims.x, windowDims.y,
 						renderSpace, pivotType, &xPercent, &yPercent, &wPercent, &hPercent);
 
-					const RendererSystem2D::RenderElement renderElement(textureID, xPercent, yPercent, wPercent, hPercent);
-					this->renderer.draw(&renderElement, 1, renderSpace);
-
-					if (optClipRect.has_value())
-					{
-						this->renderer.setClipRect(nullptr);
-					}
+					uiRenderElements.emplace_back(RendererSystem2D::RenderElement(textureID, xPercent, yPercent, wPercent, hPercent));
 				}
 			}
 
+			flushUiRenderElements();
+
 			this->renderDebugInfo();
 			this->renderer.present();
 		}
@@ -918,10 +1314,22 @@ void Game::loop()
 			DebugCrash("Render exception: " + std::string(e.what()));
 		}
 
+		this->profiler.setStop(ProfilerUtils::RENDERING);
+
+		if (isReplaying)
+		{
+			replayStats.addFrame(this->profiler.getSeconds(ProfilerUtils::INPUT), this->profiler.getSeconds(ProfilerUtils::WORLD),
+				this->profiler.getSeconds(ProfilerUtils::RENDERING));
+		}
+
 		// End-of-frame clean up.
 		try
 		{
 			this->sceneManager.cleanUp();
+
+			// Nothing allocated from the frame arena may be used past this point.
+			this->frameArena.reset();
+			this->prevFrameHeapAllocationCount = static_cast<int>(HeapAllocationCounter::getThreadAllocationCount() - frameStartHeapAllocationCount);
 		}
 		catch (const std::exception &e)
 		{
@@ -930,5 +1338,6 @@ void Game::loop()
 	}
 
 	// At this point, the engine has received an exit signal and is now quitting peacefully.
+	this->inputRecording.close();
 	this->options.saveChanges();
 }
@@ -21,7 +21,9 @@
 #include "../World/ChunkManager.h"
 #include "../World/SceneManager.h"
 
+#include "components/utilities/Allocator.h"
 #include "components/utilities/FPSCounter.h"
+#include "components/utilities/JobSystem.h"
 #include "components/utilities/Profiler.h"
 
 // This class holds the current game state, manages the primary game loop, and 
@@ -43,6 +45,9 @@ public:
 private:
 	AudioManager audioManager;
 
+	// Optional input capture for benchmarking. Positioned before the input manager which points to it.
+	InputRecording inputRecording;
+
 	// Listener IDs are optional in case of failed Game construction.
 	InputManager inputManager;
 	std::optional<InputManager::ListenerID> applicationExitListenerID, windowResizedListenerID,
@@ -51,6 +56,7 @@ private:
 	std::unique_ptr<CharacterCreationState> charCreationState;
 	GameWorldRenderCallback gameWorldRenderCallback;
 	Options options;
+	JobSystem jobSystem; // Positioned before the renderer which runs jobs on it.
 	Renderer renderer;
 	TextureManager textureManager;
 
@@ -76,6 +82,10 @@ private:
 	Profiler profiler;
 	FPSCounter fpsCounter;
 
+	// Scratch memory for the main thread that is reclaimed at the end of every frame.
+	FrameArena frameArena;
+	int prevFrameHeapAllocationCount;
+
 	SceneManager sceneManager;
 
 	// Active game session (needs to be positioned after Renderer member due to order of texture destruction).
@@ -85,6 +95,10 @@ private:
 	// Engine variables for what kinds of simulation should be attempted each frame.
 	bool shouldSimulateScene;
 
+	// How far the current frame is between the last two fixed-rate simulation ticks, for interpolating
+	// what gets rendered.
+	double simulationInterpolationPercent;
+
 	bool requestedSubPanelPop;
 	bool running;
 
@@ -118,7 +132,8 @@ public:
 	Game &operator=(const Game&) = delete;
 	Game &operator=(Game&&) = delete;
 
-	bool init();
+	// Optionally records this session's input to a file, or replays a recorded session without a window.
+	bool init(const std::string &recordInputPath, const std::string &replayInputPath);
 
 	// Gets the audio manager for changing the current music and sound.
 	AudioManager &getAudioManager();
@@ -140,6 +155,10 @@ public:
 	bool isSimulatingScene() const;
 	void setIsSimulatingScene(bool active);
 
+	// Gets the percent [0, 1) of a simulation tick that has accumulated since the last one. Rendering blends
+	// moving things between their previous and current simulation state by this amount.
+	double getSimulationInterpolationPercent() const;
+
 	// Returns whether a new character is currently being created.
 	bool characterCreationIsActive() const;
 
@@ -152,6 +171,12 @@ public:
 	// Gets the renderer object for rendering methods.
 	Renderer &getRenderer();
 
+	// Gets the shared worker pool for parallel work.
+	JobSystem &getJobSystem();
+
+	// Gets the main thread's scratch memory for data that doesn't outlive the current frame.
+	FrameArena &getFrameArena();
+
 	// Gets the texture manager object for loading images from file.
 	TextureManager &getTextureManager();
 
@@ -15,9 +15,9 @@
 #include "../Assets/TextureManager.h"
 #include "../Audio/MusicLibrary.h"
 #include "../Entities/EntityDefinitionLibrary.h"
+#include "../Entities/EntityUtils.h"
 #include "../Entities/Player.h"
 #include "../GameLogic/MapLogicController.h"
-#include "../GameLogic/PlayerLogicController.h"
 #include "../Interface/GameWorldUiView.h"
 #include "../Math/Constants.h"
 #include "../Rendering/RenderCamera.h"
@@ -27,8 +27,10 @@
 #include "../UI/TextBox.h"
 #include "../UI/TextRenderUtils.h"
 #include "../Voxels/ArenaVoxelUtils.h"
+#include "../Voxels/DoorDefinition.h"
 #include "../Weather/ArenaWeatherUtils.h"
 #include "../Weather/WeatherUtils.h"
+#include "../World/LevelInfoDefinition.h"
 #include "../World/MapType.h"
 #include "../WorldMap/ArenaLocationUtils.h"
 #include "../WorldMap/LocationDefinition.h"
@@ -37,6 +39,50 @@
 #include "components/debug/Debug.h"
 #include "components/utilities/String.h"
 
+namespace
+{
+	// Gets the sound filenames of the doors and creatures placed in a map's levels so they can be decoded
+	// before the level's first frame.
+	std::vector<std::string> GetMapSoundFilenames(const MapDefinition &mapDef)
+	{
+		std::vector<std::string> filenames;
+		auto tryAddFilename = [&filenames](std::string &&filename)
+		{
+			if (!filename.empty() && (std::find(filenames.begin(), filenames.end(), filename) == filenames.end()))
+			{
+				filenames.emplace_back(std::move(filename));
+			}
+		};
+
+		const BufferView<const LevelDefinition> levelDefs = mapDef.getLevels();
+		const BufferView<const int> levelInfoDefIndices = mapDef.getLevelInfoIndices();
+		const BufferView<const LevelInfoDefinition> levelInfoDefs = mapDef.getLevelInfos();
+		for (int levelIndex = 0; levelIndex < levelDefs.getCount(); levelIndex++)
+		{
+			const LevelDefinition &levelDef = levelDefs[levelIndex];
+			const int levelInfoIndex = levelInfoDefIndices[levelIndex];
+			const LevelInfoDefinition &levelInfoDef = levelInfoDefs[levelInfoIndex];
+
+			for (int i = 0; i < levelDef.getDoorPlacementDefCount(); i++)
+			{
+				const LevelDefinition::DoorPlacementDef &placementDef = levelDef.getDoorPlacementDef(i);
+				const DoorDefinition &doorDef = levelInfoDef.getDoorDef(placementDef.id);
+				tryAddFilename(std::string(doorDef.getOpenSound().soundFilename));
+				tryAddFilename(std::string(doorDef.getCloseSound().soundFilename));
+			}
+
+			for (int i = 0; i < levelDef.getEntityPlacementDefCount(); i++)
+			{
+				const LevelDefinition::EntityPlacementDef &placementDef = levelDef.getEntityPlacementDef(i);
+				const EntityDefinition &entityDef = levelInfoDef.getEntityDef(placementDef.id);
+				tryAddFilename(EntityUtils::getCreatureSoundFilename(entityDef));
+			}
+		}
+
+		return filenames;
+	}
+}
+
 GameState::WorldMapLocationIDs::WorldMapLocationIDs(int provinceID, int locationID)
 {
 	this->provinceID = provinceID;
@@ -183,7 +229,7 @@ void GameState::queueMapDefChange(MapDefinition &&newMapDef, const std::optional
 	this->nextMapDefWeatherDef = weatherDef;
 }
 
-void GameState::queueMapDefPop()
+void GameState::queueMapDefPop(Random &random)
 {
 	if (this->hasPendingMapDefChange())
 	{
@@ -217,7 +263,6 @@ void GameState::queueMapDefPop()
 
 	// Calculate weather.
 	const ArenaTypes::WeatherType weatherType = this->getWeatherForLocation(this->provinceIndex, this->locationIndex);
-	Random random; // @todo: get from Game
 	this->nextMapDefWeatherDef = WeatherDefinition();
 	this->nextMapDefWeatherDef->initFromClassic(weatherType, this->date.getDay(), random);
 
@@ -620,6 +665,11 @@ void GameState::applyPendingSceneChange(Game &game, double dt)
 
 	player.setVelocityToZero();
 
+	// Decode the level's sounds in the background while the scene is populated.
+	AudioManager &audioManager = game.getAudioManager();
+	const std::vector<std::string> soundFilenames = GetMapSoundFilenames(this->activeMapDef);
+	audioManager.preloadSounds(soundFilenames);
+
 	TextureManager &textureManager = game.getTextureManager();
 	Renderer &renderer = game.getRenderer();
 	SceneManager &sceneManager = game.getSceneManager();
@@ -632,11 +682,12 @@ void GameState::applyPendingSceneChange(Game &game, double dt)
 	chunkManager.clear();
 	chunkManager.update(playerCoord.chunk, options.getMisc_ChunkDistance());
 
-	sceneManager.voxelChunkManager.recycleAllChunks();
+	sceneManager.voxelChunkManager.clear();
 	sceneManager.entityChunkManager.clear();
 	sceneManager.collisionChunkManager.recycleAllChunks();
 	sceneManager.voxelVisChunkManager.recycleAllChunks();
 	sceneManager.renderChunkManager.unloadScene(renderer);
+	renderer.discardGameWorldFrame();
 	
 	sceneManager.skyInstance.clear();
 	sceneManager.renderSkyManager.unloadScene(renderer);
@@ -654,12 +705,17 @@ void GameState::applyPendingSceneChange(Game &game, double dt)
 	const BinaryAssetLibrary &binaryAssetLibrary = BinaryAssetLibrary::getInstance();
 	this->weatherInst.init(this->weatherDef, this->clock, binaryAssetLibrary.getExeData(), game.getRandom(), textureManager);
 
-	this->tickVoxels(0.0, game);
-	this->tickEntities(0.0, game);
-	this->tickCollision(0.0, game);
+	const BufferView<const ChunkInt2> newChunkPositions = chunkManager.getNewChunkPositions();
+	const BufferView<const ChunkInt2> freedChunkPositions = chunkManager.getFreedChunkPositions();
+	this->tickVoxels(0.0, newChunkPositions, freedChunkPositions, game);
+	this->tickEntities(0.0, newChunkPositions, freedChunkPositions, game);
+	this->tickCollision(0.0, newChunkPositions, freedChunkPositions, game);
 	this->tickSky(0.0, game);
 	this->tickRendering(game);
 
+	// Sounds must be uploaded before the first frame so playback never waits on disk.
+	audioManager.waitForPreloadedSounds();
+
 	if (this->nextMusicFunc)
 	{
 		const MusicDefinition *musicDef = this->nextMusicFunc(game);
@@ -669,7 +725,6 @@ void GameState::applyPendingSceneChange(Game &game, double dt)
 			jingleMusicDef = this->nextJingleMusicFunc(game);
 		}
 
-		AudioManager &audioManager = game.getAudioManager();
 		audioManager.setMusic(musicDef, jingleMusicDef);
 
 		this->nextMusicFunc = SceneChangeMusicFunc();
@@ -815,11 +870,6 @@ void GameState::tickPlayer(double dt, Game &game)
 	player.tick(game, dt);
 	const CoordDouble3 newPlayerCoord = player.getPosition();
 
-	// Handle input for the player's attack.
-	const auto &inputManager = game.getInputManager();
-	const Int2 mouseDelta = inputManager.getMouseDelta();
-	PlayerLogicController::handlePlayerAttack(game, mouseDelta);
-
 	// See if the player changed voxels in the XZ plane. If so, trigger text and sound events,
 	// and handle any level transition.
 	const double ceilingScale = this->getActiveCeilingScale();
@@ -839,11 +889,10 @@ void GameState::tickPlayer(double dt, Game &game)
 	}
 }
 
-void GameState::tickVoxels(double dt, Game &game)
+void GameState::tickVoxels(double dt, BufferView<const ChunkInt2> newChunkPositions, BufferView<const ChunkInt2> freedChunkPositions,
+	Game &game)
 {
 	SceneManager &sceneManager = game.getSceneManager();
-	const ChunkManager &chunkManager = sceneManager.chunkManager;
-
 	const Player &player = game.getPlayer();
 
 	const MapDefinition &mapDef = this->getActiveMapDef();
@@ -856,13 +905,15 @@ void GameState::tickVoxels(double dt, Game &game)
 	const LevelInfoDefinition &levelInfoDef = levelInfoDefs[levelInfoIndex];
 	const MapSubDefinition &mapSubDef = mapDef.getSubDefinition();
 
+	const Options &options = game.getOptions();
 	VoxelChunkManager &voxelChunkManager = sceneManager.voxelChunkManager;
-	voxelChunkManager.update(dt, chunkManager.getNewChunkPositions(), chunkManager.getFreedChunkPositions(),
+	voxelChunkManager.update(dt, newChunkPositions, freedChunkPositions,
 		player.getPosition(), &levelDef, &levelInfoDef, mapSubDef, levelDefs, levelInfoDefIndices, levelInfoDefs,
-		this->getActiveCeilingScale(), game.getAudioManager());
+		this->getActiveCeilingScale(), options.getMisc_ChunkCacheSize(), game.getAudioManager());
 }
 
-void GameState::tickEntities(double dt, Game &game)
+void GameState::tickEntities(double dt, BufferView<const ChunkInt2> newChunkPositions, BufferView<const ChunkInt2> freedChunkPositions,
+	Game &game)
 {
 	SceneManager &sceneManager = game.getSceneManager();
 	const ChunkManager &chunkManager = sceneManager.chunkManager;
@@ -892,21 +943,22 @@ void GameState::tickEntities(double dt, Game &game)
 	const double ceilingScale = this->getActiveCeilingScale();
 
 	EntityChunkManager &entityChunkManager = sceneManager.entityChunkManager;
-	entityChunkManager.update(dt, chunkManager.getActiveChunkPositions(), chunkManager.getNewChunkPositions(),
-		chunkManager.getFreedChunkPositions(), player, &levelDef, &levelInfoDef, mapSubDef, levelDefs, levelInfoDefIndices,
-		levelInfoDefs, entityGenInfo, citizenGenInfo, ceilingScale, game.getRandom(), voxelChunkManager, game.getAudioManager(),
-		game.getTextureManager(), game.getRenderer());
+	entityChunkManager.update(dt, chunkManager.getActiveChunkPositions(), newChunkPositions, freedChunkPositions,
+		player, &levelDef, &levelInfoDef, mapSubDef, levelDefs, levelInfoDefIndices, levelInfoDefs, entityGenInfo,
+		citizenGenInfo, ceilingScale, game.getRandom(), voxelChunkManager, game.getAudioManager(), game.getTextureManager(),
+		game.getRenderer());
 }
 
-void GameState::tickCollision(double dt, Game &game)
+void GameState::tickCollision(double dt, BufferView<const ChunkInt2> newChunkPositions, BufferView<const ChunkInt2> freedChunkPositions,
+	Game &game)
 {
 	SceneManager &sceneManager = game.getSceneManager();
 	const ChunkManager &chunkManager = sceneManager.chunkManager;
 	const VoxelChunkManager &voxelChunkManager = sceneManager.voxelChunkManager;
 
 	CollisionChunkManager &collisionChunkManager = sceneManager.collisionChunkManager;
-	collisionChunkManager.update(dt, chunkManager.getActiveChunkPositions(), chunkManager.getNewChunkPositions(),
-		chunkManager.getFreedChunkPositions(), voxelChunkManager);
+	collisionChunkManager.update(dt, chunkManager.getActiveChunkPositions(), newChunkPositions, freedChunkPositions,
+		voxelChunkManager);
 }
 
 void GameState::tickRendering(Game &game)
@@ -924,8 +976,10 @@ void GameState::tickRendering(Game &game)
 	const double ceilingScale = this->getActiveCeilingScale();
 	const double chasmAnimPercent = this->getChasmAnimPercent();
 
+	// Moving things are drawn between their last two simulation states.
+	const double simulationPercent = game.getSimulationInterpolationPercent();
 	const Player &player = game.getPlayer();
-	const CoordDouble3 &playerCoord = player.getPosition();
+	const CoordDouble3 playerCoord = player.getInterpolatedPosition(simulationPercent);
 	const CoordDouble2 playerCoordXZ(playerCoord.chunk, VoxelDouble2(playerCoord.point.x, playerCoord.point.z));
 	const Double2 playerDirXZ = player.getGroundDirection();
 
@@ -938,26 +992,28 @@ void GameState::tickRendering(Game &game)
 	const RenderCamera renderCamera = RendererUtils::makeCamera(playerCoord.chunk, playerCoord.point, player.getDirection(),
 		options.getGraphics_VerticalFOV(), renderer.getViewAspect(), options.getGraphics_TallPixelCorrection());
 
+	const bool isInterior = this->getActiveMapType() == MapType::Interior;
 	VoxelVisibilityChunkManager &voxelVisChunkManager = sceneManager.voxelVisChunkManager;
-	voxelVisChunkManager.update(newChunkPositions, freedChunkPositions, renderCamera, ceilingScale, voxelChunkManager);
+	voxelVisChunkManager.update(newChunkPositions, freedChunkPositions, renderCamera, ceilingScale, isInterior, voxelChunkManager);
 
 	RenderChunkManager &renderChunkManager = sceneManager.renderChunkManager;
 	renderChunkManager.updateActiveChunks(newChunkPositions, freedChunkPositions, voxelChunkManager, renderer);
 	renderChunkManager.updateLights(activeChunkPositions, newChunkPositions, playerCoord, ceilingScale, isFoggy, nightLightsAreActive,
 		options.getMisc_PlayerHasLight(), entityChunkManager, renderer);
 	renderChunkManager.updateVoxels(activeChunkPositions, newChunkPositions, ceilingScale, chasmAnimPercent,
-		voxelChunkManager, voxelVisChunkManager, textureManager, renderer);
+		voxelChunkManager, voxelVisChunkManager, options.getGraphics_BatchVoxelGeometry(), textureManager, renderer);
 	renderChunkManager.updateEntities(activeChunkPositions, newChunkPositions, playerCoordXZ, playerDirXZ, ceilingScale,
-		voxelChunkManager, entityChunkManager, textureManager, renderer);
+		simulationPercent, voxelChunkManager, entityChunkManager, textureManager, renderer);
 
-	const bool isInterior = this->getActiveMapType() == MapType::Interior;
 	const WeatherType weatherType = this->weatherDef.type;
 	const double daytimePercent = this->getDaytimePercent();
 	sceneManager.updateGameWorldPalette(isInterior, weatherType, isFoggy, daytimePercent, textureManager);
 
 	const double distantAmbientPercent = ArenaRenderUtils::getDistantAmbientPercent(this->clock);
 	RenderSkyManager &renderSkyManager = sceneManager.renderSkyManager;
-	renderSkyManager.update(skyInst, this->weatherInst, playerCoord, isInterior, daytimePercent, isFoggy, distantAmbientPercent, renderer);
+	const double latitude = this->getLocationDefinition().getLatitude();
+	renderSkyManager.update(skyInst, this->weatherInst, playerCoord, isInterior, latitude, this->date.getDay(), daytimePercent,
+		isFoggy, distantAmbientPercent, renderer);
 
 	const WeatherInstance &weatherInst = game.getGameState().getWeatherInstance();
 
@@ -130,7 +130,7 @@ public:
 		const std::optional<CoordInt3> &returnCoord = std::nullopt, const VoxelInt2 &playerStartOffset = VoxelInt2::Zero,
 		const std::optional<WorldMapLocationIDs> &worldMapLocationIDs = std::nullopt,
 		bool clearPreviousMap = false, const std::optional<WeatherDefinition> &weatherDef = std::nullopt);
-	void queueMapDefPop();
+	void queueMapDefPop(Random &random);
 	void queueMusicOnSceneChange(const SceneChangeMusicFunc &musicFunc, const SceneChangeMusicFunc &jingleMusicFunc = SceneChangeMusicFunc());
 
 	MapType getActiveMapType() const;
@@ -202,9 +202,13 @@ public:
 	void tickWeather(double dt, Game &game);
 	void tickUiMessages(double dt);
 	void tickPlayer(double dt, Game &game);
-	void tickVoxels(double dt, Game &game);
-	void tickEntities(double dt, Game &game);
-	void tickCollision(double dt, Game &game);
+
+	// Chunk changes are passed in rather than read from the chunk manager since only one of possibly several
+	// simulation ticks in a frame should populate and free chunks.
+	void tickVoxels(double dt, BufferView<const ChunkInt2> newChunkPositions, BufferView<const ChunkInt2> freedChunkPositions, Game &game);
+	void tickEntities(double dt, BufferView<const ChunkInt2> newChunkPositions, BufferView<const ChunkInt2> freedChunkPositions, Game &game);
+	void tickCollision(double dt, BufferView<const ChunkInt2> newChunkPositions, BufferView<const ChunkInt2> freedChunkPositions, Game &game);
+
 	void tickRendering(Game &game);
 };
 
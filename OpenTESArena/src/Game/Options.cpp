@@ -29,7 +29,8 @@ namespace
 		{ "CursorScale", OptionType::Double },
 		{ "ModernInterface", OptionType::Bool },
 		{ "TallPixelCorrection", OptionType::Bool },
-		{ "RenderThreadsMode", OptionType::Int }
+		{ "RenderThreadsMode", OptionType::Int },
+		{ "BatchVoxelGeometry", OptionType::Bool }
 	};
 
 	const std::vector<std::pair<std::string, OptionType>> AudioMappings =
@@ -58,6 +59,7 @@ namespace
 		{ "ShowIntro", OptionType::Bool },
 		{ "ShowCompass", OptionType::Bool },
 		{ "ChunkDistance", OptionType::Int },
+		{ "ChunkCacheSize", OptionType::Int },
 		{ "StarDensity", OptionType::Int },
 		{ "PlayerHasLight", OptionType::Bool }
 	};
@@ -573,6 +575,13 @@ void Options::checkMisc_ChunkDistance(int value) const
 		std::to_string(Options::MIN_CHUNK_DISTANCE) + ".");
 }
 
+void Options::checkMisc_ChunkCacheSize(int value) const
+{
+	DebugAssertMsg(value >= Options::MIN_CHUNK_CACHE_SIZE,
+		"Chunk cache size cannot be less than " +
+		std::to_string(Options::MIN_CHUNK_CACHE_SIZE) + ".");
+}
+
 void Options::checkMisc_StarDensity(int value) const
 {
 	DebugAssertMsg(value >= Options::MIN_STAR_DENSITY_MODE,
@@ -81,6 +81,7 @@ public:
 	static constexpr int MIN_SOUND_CHANNELS = 1;
 	static constexpr int RESAMPLING_OPTION_COUNT = 4;
 	static constexpr int MIN_CHUNK_DISTANCE = 1;
+	static constexpr int MIN_CHUNK_CACHE_SIZE = 0;
 	static constexpr int MIN_STAR_DENSITY_MODE = 0;
 	static constexpr int MAX_STAR_DENSITY_MODE = 2;
 	static constexpr int MIN_PROFILER_LEVEL = 0;
@@ -146,6 +147,7 @@ void set##section##_##name(const std::string &value) \
 	OPTION_BOOL(Graphics, ModernInterface)
 	OPTION_BOOL(Graphics, TallPixelCorrection)
 	OPTION_INT(Graphics, RenderThreadsMode)
+	OPTION_BOOL(Graphics, BatchVoxelGeometry)
 
 	OPTION_DOUBLE(Audio, MusicVolume)
 	OPTION_DOUBLE(Audio, SoundVolume)
@@ -165,6 +167,7 @@ void set##section##_##name(const std::string &value) \
 	OPTION_BOOL(Misc, ShowIntro)
 	OPTION_BOOL(Misc, ShowCompass)
 	OPTION_INT(Misc, ChunkDistance)
+	OPTION_INT(Misc, ChunkCacheSize)
 	OPTION_INT(Misc, StarDensity)
 	OPTION_BOOL(Misc, PlayerHasLight)
 
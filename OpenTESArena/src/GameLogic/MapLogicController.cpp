@@ -195,7 +195,7 @@ void MapLogicController::handleMapTransition(Game &game, const Physics::Hit &hit
 		};
 
 		// Leave the interior and go to the saved exterior.
-		gameState.queueMapDefPop();
+		gameState.queueMapDefPop(game.getRandom());
 		gameState.queueMusicOnSceneChange(musicDefFunc, jingleMusicDefFunc);
 	}
 	else
@@ -595,7 +595,7 @@ void PlayerLogicController::handleScreenToWorldInteraction(Game &game, const Int
 	Physics::Hit hit;
 	const bool success = Physics::rayCast(rayStart, rayDirection, ceilingScale, cameraDirection,
 		includeEntities, voxelChunkManager, entityChunkManager, collisionChunkManager,
-		EntityDefinitionLibrary::getInstance(), game.getRenderer(), hit);
+		EntityDefinitionLibrary::getInstance(), game.getRenderer(), game.getFrameArena(), hit);
 
 	// See if the ray hit anything.
 	if (success)
@@ -671,15 +671,12 @@ void PlayerLogicController::handleScreenToWorldInteraction(Game &game, const Int
 								DebugCrash("Expected door def ID to exist.");
 							}
 
-							const DoorDefinition &doorDef = chunk.getDoorDef(doorDefID);
-							const DoorDefinition::OpenSoundDef &openSoundDef = doorDef.getOpenSound();
-
 							auto &audioManager = game.getAudioManager();
-							const std::string &soundFilename = openSoundDef.soundFilename;
+							const SoundID openSoundID = chunk.getDoorOpenSoundID(doorDefID);
 
 							const CoordDouble3 soundCoord(chunk.getPosition(), VoxelUtils::getVoxelCenter(voxel, ceilingScale));
 							const WorldDouble3 soundPosition = VoxelUtils::coordToWorldPoint(soundCoord);
-							audioManager.playSound(soundFilename, soundPosition);
+							audioManager.playSound(openSoundID, soundPosition);
 						}
 					}
 				}
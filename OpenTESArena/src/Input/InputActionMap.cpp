@@ -211,6 +211,12 @@ namespace
 				InputActionName::WorldMap,
 				InputStateType::BeginPerform,
 				SDLK_m));
+
+			// Debug.
+			defs.emplace_back(makeKeyDef(
+				InputActionName::DebugRaycastBenchmark,
+				InputStateType::BeginPerform,
+				SDLK_F6));
 		}
 		else if (StringView::equals(mapName, InputActionMapName::Logbook))
 		{
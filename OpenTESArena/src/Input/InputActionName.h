@@ -50,6 +50,7 @@ namespace InputActionName
 
 	// Debug.
 	constexpr const char *DebugProfiler = "DebugProfiler";
+	constexpr const char *DebugRaycastBenchmark = "DebugRaycastBenchmark";
 }
 
 #endif
@@ -159,8 +159,8 @@ void InputManager::TextInputListenerEntry::reset()
 }
 
 InputManager::InputManager()
-	: mouseDelta(0, 0)
 {
+	this->recording = nullptr;
 	this->nextListenerID = 0;
 }
 
@@ -192,14 +192,12 @@ bool InputManager::keyReleased(const SDL_Event &e, SDL_Keycode keycode) const
 
 bool InputManager::keyIsDown(SDL_Scancode scancode) const
 {
-	const uint8_t *keys = SDL_GetKeyboardState(nullptr);
-	return keys[scancode] != 0;
+	return this->frame.keyboardState[scancode] != 0;
 }
 
 bool InputManager::keyIsUp(SDL_Scancode scancode) const
 {
-	const uint8_t *keys = SDL_GetKeyboardState(nullptr);
-	return keys[scancode] == 0;
+	return this->frame.keyboardState[scancode] == 0;
 }
 
 bool InputManager::isMouseButtonEvent(const SDL_Event &e) const
@@ -229,14 +227,12 @@ bool InputManager::mouseButtonReleased(const SDL_Event &e, uint8_t button) const
 
 bool InputManager::mouseButtonIsDown(uint8_t button) const
 {
-	const uint32_t mouse = SDL_GetMouseState(nullptr, nullptr);
-	return (mouse & SDL_BUTTON(button)) != 0;
+	return (this->frame.mouseState & SDL_BUTTON(button)) != 0;
 }
 
 bool InputManager::mouseButtonIsUp(uint8_t button) const
 {
-	const uint32_t mouse = SDL_GetMouseState(nullptr, nullptr);
-	return (mouse & SDL_BUTTON(button)) == 0;
+	return (this->frame.mouseState & SDL_BUTTON(button)) == 0;
 }
 
 bool InputManager::mouseWheeledUp(const SDL_Event &e) const
@@ -283,14 +279,12 @@ InputManager::ListenerID InputManager::getNextListenerID()
 
 Int2 InputManager::getMousePosition() const
 {
-	int x, y;
-	SDL_GetMouseState(&x, &y);
-	return Int2(x, y);
+	return this->frame.mousePosition;
 }
 
 Int2 InputManager::getMouseDelta() const
 {
-	return this->mouseDelta;
+	return this->frame.mouseDelta;
 }
 
 bool InputManager::setInputActionMapActive(const std::string &name, bool active)
@@ -548,6 +542,11 @@ void InputManager::setListenerEnabled(ListenerID id, bool enabled)
 	}
 }
 
+void InputManager::setRecording(InputRecording *recording)
+{
+	this->recording = recording;
+}
+
 void InputManager::setRelativeMouseMode(bool active)
 {
 	const SDL_bool enabled = active ? SDL_TRUE : SDL_FALSE;
@@ -561,9 +560,10 @@ bool InputManager::isInTextEntryMode() const
 }
 
 void InputManager::handleHeldInputs(Game &game, BufferView<const InputActionMap*> activeMaps,
-	BufferView<const InputActionListenerEntry*> enabledInputActionListeners,
-	uint32_t mouseState, const Int2 &mousePosition, double dt)
+	BufferView<const InputActionListenerEntry*> enabledInputActionListeners, double dt)
 {
+	const uint32_t mouseState = this->frame.mouseState;
+	const Int2 &mousePosition = this->frame.mousePosition;
 	auto handleHeldMouseButton = [this, &game, mouseState, &mousePosition, dt](MouseButtonType buttonType)
 	{
 		const int sdlMouseButton = GetSdlMouseButton(buttonType);
@@ -585,8 +585,8 @@ void InputManager::handleHeldInputs(Game &game, BufferView<const InputActionMap*
 		handleHeldMouseButton(buttonType);
 	}
 
-	const uint8_t *keyboardState = SDL_GetKeyboardState(nullptr);
-	const SDL_Keymod keyboardMod = SDL_GetModState();
+	const uint8_t *keyboardState = this->frame.keyboardState;
+	const SDL_Keymod keyboardMod = static_cast<SDL_Keymod>(this->frame.keymod);
 
 	for (const InputActionMap *map : activeMaps)
 	{
@@ -624,11 +624,52 @@ void InputManager::handleHeldInputs(Game &game, BufferView<const InputActionMap*
 	}
 }
 
+void InputManager::pollFrame()
+{
+	this->frame.events.clear();
+	SDL_PumpEvents();
+
+	SDL_GetRelativeMouseState(&this->frame.mouseDelta.x, &this->frame.mouseDelta.y);
+	this->frame.mouseState = SDL_GetMouseState(&this->frame.mousePosition.x, &this->frame.mousePosition.y);
+	this->frame.keymod = static_cast<uint16_t>(SDL_GetModState());
+
+	int keyCount;
+	const uint8_t *keyboardState = SDL_GetKeyboardState(&keyCount);
+	std::copy(keyboardState, keyboardState + std::min(keyCount, SDL_NUM_SCANCODES), std::begin(this->frame.keyboardState));
+
+	SDL_Event e;
+	while (SDL_PollEvent(&e) != 0)
+	{
+		this->frame.events.emplace_back(e);
+	}
+}
+
 void InputManager::update(Game &game, double dt, BufferView<const ButtonProxy> buttonProxies,
 	const std::function<void()> &onFinishedProcessingEvent)
 {
-	// @todo: don't save mouse delta as member, just keep local variable here once we can.
-	SDL_GetRelativeMouseState(&this->mouseDelta.x, &this->mouseDelta.y);
+	if ((this->recording != nullptr) && this->recording->isReplaying())
+	{
+		// An exhausted recording leaves an empty frame; the game loop decides when to stop.
+		this->recording->tryReadFrame(&this->frame);
+
+		// Keep the OS event queue drained even though its contents are ignored.
+		SDL_PumpEvents();
+		SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+	}
+	else
+	{
+		this->pollFrame();
+
+		if ((this->recording != nullptr) && this->recording->isRecording())
+		{
+			// Drop what can't be recorded so this session handles the same events its replay will.
+			std::vector<SDL_Event> &events = this->frame.events;
+			events.erase(std::remove_if(events.begin(), events.end(),
+				[](const SDL_Event &e) { return !InputRecording::isRecordableEvent(e); }), events.end());
+
+			this->recording->writeFrame(this->frame);
+		}
+	}
 
 	// Cache active maps and listeners before looping over them since callbacks can change which ones are active.
 	std::vector<const InputActionMap*> activeMaps;
@@ -706,15 +747,14 @@ void InputManager::update(Game &game, double dt, BufferView<const ButtonProxy> b
 	// Handle held mouse buttons and keys.
 	const BufferView<const InputActionMap*> activeMapsView(activeMaps);
 	const BufferView<const InputActionListenerEntry*> enabledInputActionListenersView(enabledInputActionListeners);
-	Int2 mousePosition;
-	const uint32_t mouseState = SDL_GetMouseState(&mousePosition.x, &mousePosition.y);
-	this->handleHeldInputs(game, activeMapsView, enabledInputActionListenersView, mouseState, mousePosition, dt);
+	this->handleHeldInputs(game, activeMapsView, enabledInputActionListenersView, dt);
+
+	const Int2 &mousePosition = this->frame.mousePosition;
 
 	// Handle SDL events.
 	// @todo: make sure to not fire duplicate callbacks for the same input action if it is registered to multiple
 	// keys/mouse buttons like Skip.
-	SDL_Event e;
-	while (SDL_PollEvent(&e) != 0)
+	for (const SDL_Event &e : this->frame.events)
 	{
 		if (this->isKeyEvent(e))
 		{
@@ -875,7 +915,7 @@ void InputManager::update(Game &game, double dt, BufferView<const ButtonProxy> b
 		{
 			for (const MouseMotionListenerEntry *entry : enabledMouseMotionListeners)
 			{
-				entry->callback(game, this->mouseDelta.x, this->mouseDelta.y);
+				entry->callback(game, this->frame.mouseDelta.x, this->frame.mouseDelta.y);
 			}
 		}
 		else if (this->applicationExit(e))
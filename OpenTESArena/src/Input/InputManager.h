@@ -13,6 +13,7 @@
 #include "ApplicationEvents.h"
 #include "InputActionEvents.h"
 #include "InputActionMap.h"
+#include "InputRecording.h"
 #include "PointerEvents.h"
 #include "TextEvents.h"
 #include "../Math/Vector2.h"
@@ -150,7 +151,9 @@ private:
 	ListenerID nextListenerID;
 	std::vector<ListenerID> freedListenerIDs;
 
-	Int2 mouseDelta;
+	// Input sampled at the start of the current frame, either from SDL or from a recording.
+	InputFrame frame;
+	InputRecording *recording;
 
 	ListenerID getNextListenerID();
 
@@ -161,8 +164,10 @@ private:
 		std::vector<int> &freedListenerIndices);
 	
 	void handleHeldInputs(Game &game, BufferView<const InputActionMap*> activeMaps,
-		BufferView<const InputActionListenerEntry*> enabledInputActionListeners, uint32_t mouseState,
-		const Int2 &mousePosition, double dt);
+		BufferView<const InputActionListenerEntry*> enabledInputActionListeners, double dt);
+
+	// Samples this frame's input from SDL.
+	void pollFrame();
 public:
 	InputManager();
 
@@ -210,6 +215,9 @@ public:
 	// Sets whether keyboard input is interpreted as text input or hotkeys.
 	void setTextInputMode(bool active);
 
+	// Sets the recording that frames are written to or read back from. Null samples SDL directly.
+	void setRecording(InputRecording *recording);
+
 	// Handle input listener callbacks, etc..
 	void update(Game &game, double dt, BufferView<const ButtonProxy> buttonProxies,
 		const std::function<void()> &onFinishedProcessingEvent);
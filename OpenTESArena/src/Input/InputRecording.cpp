@@ -0,0 +1,333 @@
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include "InputRecording.h"
+
+#include "components/debug/Debug.h"
+
+namespace
+{
+	// Bump when the header or frame layout changes.
+	constexpr uint32_t RECORDING_VERSION = 2;
+
+	constexpr char RECORDING_MAGIC[8] = { 'O', 'T', 'A', 'I', 'N', 'P', 'U', 'T' };
+
+	struct RecordingHeader
+	{
+		char magic[8];
+		uint32_t version;
+		uint32_t eventSize; // sizeof(SDL_Event) of the writing build.
+		int32_t randomSeed;
+		uint32_t arenaRandomSeed;
+		int32_t windowWidth, windowHeight;
+	};
+
+	// Followed by the held scancodes, then the events.
+	struct RecordedFrameHeader
+	{
+		int32_t mouseDeltaX, mouseDeltaY;
+		int32_t mousePositionX, mousePositionY;
+		uint32_t mouseState;
+		uint16_t keymod;
+		uint16_t heldKeyCount;
+		uint32_t eventCount;
+	};
+
+	template<typename T>
+	void WriteValue(std::ofstream &stream, const T &value)
+	{
+		stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	template<typename T>
+	bool TryReadValue(std::ifstream &stream, T *outValue)
+	{
+		stream.read(reinterpret_cast<char*>(outValue), sizeof(T));
+		return stream.good();
+	}
+}
+
+InputFrame::InputFrame()
+{
+	this->clear();
+}
+
+void InputFrame::clear()
+{
+	this->mouseDelta = Int2::Zero;
+	this->mousePosition = Int2::Zero;
+	this->mouseState = 0;
+	this->keymod = 0;
+	std::fill(std::begin(this->keyboardState), std::end(this->keyboardState), 0);
+	this->events.clear();
+}
+
+InputRecording::InputRecording()
+{
+	this->inputStreamSize = 0;
+	this->mode = Mode::None;
+	this->randomSeed = 0;
+	this->arenaRandomSeed = 0;
+	this->windowDims = Int2::Zero;
+	this->frameCount = 0;
+}
+
+bool InputRecording::isRecordableEvent(const SDL_Event &e)
+{
+	switch (e.type)
+	{
+	case SDL_KEYDOWN:
+	case SDL_KEYUP:
+	case SDL_MOUSEBUTTONDOWN:
+	case SDL_MOUSEBUTTONUP:
+	case SDL_MOUSEWHEEL:
+	case SDL_MOUSEMOTION:
+	case SDL_QUIT:
+	case SDL_TEXTINPUT:
+		return true;
+	case SDL_WINDOWEVENT:
+		return e.window.event == SDL_WINDOWEVENT_RESIZED;
+	default:
+		return false;
+	}
+}
+
+bool InputRecording::initRecord(const char *filename, int randomSeed, uint32_t arenaRandomSeed, const Int2 &windowDims)
+{
+	DebugAssert(this->mode == Mode::None);
+
+	this->outputStream.open(filename, std::ios::binary | std::ios::trunc);
+	if (!this->outputStream.is_open())
+	{
+		DebugLogError("Couldn't open input recording \"" + std::string(filename) + "\" for writing.");
+		return false;
+	}
+
+	RecordingHeader header;
+	std::memcpy(header.magic, RECORDING_MAGIC, sizeof(header.magic));
+	header.version = RECORDING_VERSION;
+	header.eventSize = static_cast<uint32_t>(sizeof(SDL_Event));
+	header.randomSeed = randomSeed;
+	header.arenaRandomSeed = arenaRandomSeed;
+	header.windowWidth = windowDims.x;
+	header.windowHeight = windowDims.y;
+	WriteValue(this->outputStream, header);
+
+	this->mode = Mode::Record;
+	this->randomSeed = randomSeed;
+	this->arenaRandomSeed = arenaRandomSeed;
+	this->windowDims = windowDims;
+	this->frameCount = 0;
+	return true;
+}
+
+bool InputRecording::initReplay(const char *filename)
+{
+	DebugAssert(this->mode == Mode::None);
+
+	this->inputStream.open(filename, std::ios::binary | std::ios::ate);
+	if (!this->inputStream.is_open())
+	{
+		DebugLogError("Couldn't open input recording \"" + std::string(filename) + "\".");
+		return false;
+	}
+
+	// Frames are checked against the file size so a bad count can't allocate past it.
+	this->inputStreamSize = static_cast<int64_t>(this->inputStream.tellg());
+	this->inputStream.seekg(0, std::ios::beg);
+
+	RecordingHeader header;
+	if (!TryReadValue(this->inputStream, &header))
+	{
+		DebugLogError("Couldn't read input recording header in \"" + std::string(filename) + "\".");
+		return false;
+	}
+
+	if (std::memcmp(header.magic, RECORDING_MAGIC, sizeof(header.magic)) != 0)
+	{
+		DebugLogError("\"" + std::string(filename) + "\" is not an input recording.");
+		return false;
+	}
+
+	if ((header.version != RECORDING_VERSION) || (header.eventSize != sizeof(SDL_Event)))
+	{
+		DebugLogError("Input recording \"" + std::string(filename) + "\" was made by an incompatible build (version " +
+			std::to_string(header.version) + ", event size " + std::to_string(header.eventSize) + ").");
+		return false;
+	}
+
+	if ((header.windowWidth <= 0) || (header.windowHeight <= 0))
+	{
+		DebugLogError("Invalid window size " + std::to_string(header.windowWidth) + "x" + std::to_string(header.windowHeight) +
+			" in input recording \"" + std::string(filename) + "\".");
+		return false;
+	}
+
+	this->mode = Mode::Replay;
+	this->randomSeed = header.randomSeed;
+	this->arenaRandomSeed = header.arenaRandomSeed;
+	this->windowDims = Int2(header.windowWidth, header.windowHeight);
+	this->frameCount = 0;
+	return true;
+}
+
+bool InputRecording::isRecording() const
+{
+	return this->mode == Mode::Record;
+}
+
+bool InputRecording::isReplaying() const
+{
+	return this->mode == Mode::Replay;
+}
+
+int InputRecording::getRandomSeed() const
+{
+	return this->randomSeed;
+}
+
+uint32_t InputRecording::getArenaRandomSeed() const
+{
+	return this->arenaRandomSeed;
+}
+
+const Int2 &InputRecording::getWindowDimensions() const
+{
+	return this->windowDims;
+}
+
+int InputRecording::getFrameCount() const
+{
+	return this->frameCount;
+}
+
+void InputRecording::writeFrame(const InputFrame &frame)
+{
+	DebugAssert(this->mode == Mode::Record);
+
+	// Only held keys are stored since most of the keyboard is up on any given frame.
+	uint16_t heldScancodes[SDL_NUM_SCANCODES];
+	uint16_t heldKeyCount = 0;
+	for (int i = 0; i < SDL_NUM_SCANCODES; i++)
+	{
+		if (frame.keyboardState[i] != 0)
+		{
+			heldScancodes[heldKeyCount] = static_cast<uint16_t>(i);
+			heldKeyCount++;
+		}
+	}
+
+	std::vector<SDL_Event> events;
+	for (const SDL_Event &e : frame.events)
+	{
+		if (InputRecording::isRecordableEvent(e) && (static_cast<int>(events.size()) < MAX_EVENTS_PER_FRAME))
+		{
+			events.emplace_back(e);
+		}
+	}
+
+	RecordedFrameHeader frameHeader;
+	frameHeader.mouseDeltaX = frame.mouseDelta.x;
+	frameHeader.mouseDeltaY = frame.mouseDelta.y;
+	frameHeader.mousePositionX = frame.mousePosition.x;
+	frameHeader.mousePositionY = frame.mousePosition.y;
+	frameHeader.mouseState = frame.mouseState;
+	frameHeader.keymod = frame.keymod;
+	frameHeader.heldKeyCount = heldKeyCount;
+	frameHeader.eventCount = static_cast<uint32_t>(events.size());
+	WriteValue(this->outputStream, frameHeader);
+
+	this->outputStream.write(reinterpret_cast<const char*>(heldScancodes), heldKeyCount * sizeof(heldScancodes[0]));
+	this->outputStream.write(reinterpret_cast<const char*>(events.data()), events.size() * sizeof(SDL_Event));
+	this->frameCount++;
+}
+
+bool InputRecording::tryReadFrame(InputFrame *outFrame)
+{
+	DebugAssert(this->mode == Mode::Replay);
+	outFrame->clear();
+
+	RecordedFrameHeader frameHeader;
+	if (!TryReadValue(this->inputStream, &frameHeader))
+	{
+		return false;
+	}
+
+	uint16_t heldScancodes[SDL_NUM_SCANCODES];
+	if (frameHeader.heldKeyCount > SDL_NUM_SCANCODES)
+	{
+		DebugLogError("Invalid held key count " + std::to_string(frameHeader.heldKeyCount) + " in input recording frame " +
+			std::to_string(this->frameCount) + ".");
+		return false;
+	}
+
+	if (frameHeader.eventCount > MAX_EVENTS_PER_FRAME)
+	{
+		DebugLogError("Invalid event count " + std::to_string(frameHeader.eventCount) + " in input recording frame " +
+			std::to_string(this->frameCount) + ".");
+		return false;
+	}
+
+	const int64_t frameDataSize = static_cast<int64_t>((frameHeader.heldKeyCount * sizeof(heldScancodes[0])) +
+		(frameHeader.eventCount * sizeof(SDL_Event)));
+	const int64_t remainingSize = this->inputStreamSize - static_cast<int64_t>(this->inputStream.tellg());
+	if (frameDataSize > remainingSize)
+	{
+		DebugLogWarning("Input recording truncated at frame " + std::to_string(this->frameCount) + ".");
+		return false;
+	}
+
+	this->inputStream.read(reinterpret_cast<char*>(heldScancodes), frameHeader.heldKeyCount * sizeof(heldScancodes[0]));
+	outFrame->events.resize(frameHeader.eventCount);
+	this->inputStream.read(reinterpret_cast<char*>(outFrame->events.data()), frameHeader.eventCount * sizeof(SDL_Event));
+	if (!this->inputStream.good())
+	{
+		DebugLogWarning("Input recording truncated at frame " + std::to_string(this->frameCount) + ".");
+		outFrame->clear();
+		return false;
+	}
+
+	for (const SDL_Event &e : outFrame->events)
+	{
+		if (!InputRecording::isRecordableEvent(e))
+		{
+			DebugLogError("Unexpected event type " + std::to_string(e.type) + " in input recording frame " +
+				std::to_string(this->frameCount) + ".");
+			outFrame->clear();
+			return false;
+		}
+	}
+
+	outFrame->mouseDelta = Int2(frameHeader.mouseDeltaX, frameHeader.mouseDeltaY);
+	outFrame->mousePosition = Int2(frameHeader.mousePositionX, frameHeader.mousePositionY);
+	outFrame->mouseState = frameHeader.mouseState;
+	outFrame->keymod = frameHeader.keymod;
+	for (int i = 0; i < frameHeader.heldKeyCount; i++)
+	{
+		const uint16_t scancode = heldScancodes[i];
+		if (scancode < SDL_NUM_SCANCODES)
+		{
+			outFrame->keyboardState[scancode] = 1;
+		}
+	}
+
+	this->frameCount++;
+	return true;
+}
+
+void InputRecording::close()
+{
+	if (this->outputStream.is_open())
+	{
+		this->outputStream.close();
+	}
+
+	if (this->inputStream.is_open())
+	{
+		this->inputStream.close();
+	}
+
+	this->inputStreamSize = 0;
+	this->mode = Mode::None;
+}
@@ -0,0 +1,87 @@
+#ifndef INPUT_RECORDING_H
+#define INPUT_RECORDING_H
+
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+#include "SDL_events.h"
+
+#include "../Math/Vector2.h"
+
+// Everything the input manager reads from SDL in one frame. Held keys and mouse buttons are sampled once at
+// the start of the frame so the same snapshot can be written to and read back from a recording.
+struct InputFrame
+{
+	Int2 mouseDelta;
+	Int2 mousePosition;
+	uint32_t mouseState; // SDL_BUTTON() mask.
+	uint16_t keymod;
+	uint8_t keyboardState[SDL_NUM_SCANCODES];
+	std::vector<SDL_Event> events;
+
+	InputFrame();
+
+	void clear();
+};
+
+// Writes or reads the per-frame input stream of a session along with the random seeds and window size it
+// started with, so the same session can be simulated again for benchmarking. The file uses native layout
+// since a recording is only meant to be replayed by the build that made it. Only events the input manager
+// handles are kept; others like file drops carry pointers that would be garbage when read back.
+class InputRecording
+{
+private:
+	enum class Mode
+	{
+		None,
+		Record,
+		Replay
+	};
+
+	std::ofstream outputStream;
+	std::ifstream inputStream;
+	int64_t inputStreamSize;
+	Mode mode;
+	int randomSeed;
+	uint32_t arenaRandomSeed;
+	Int2 windowDims;
+	int frameCount;
+public:
+	// Upper bound on events in a recorded frame, well past what SDL queues in one poll.
+	static constexpr int MAX_EVENTS_PER_FRAME = 4096;
+
+	InputRecording();
+
+	// Whether the event is one the input manager handles and can be written to a recording.
+	static bool isRecordableEvent(const SDL_Event &e);
+
+	// Starts writing frames to the given file.
+	bool initRecord(const char *filename, int randomSeed, uint32_t arenaRandomSeed, const Int2 &windowDims);
+
+	// Opens a recording for reading frames back.
+	bool initReplay(const char *filename);
+
+	bool isRecording() const;
+	bool isReplaying() const;
+
+	// Seeds the recorded session started with.
+	int getRandomSeed() const;
+	uint32_t getArenaRandomSeed() const;
+
+	// Window dimensions the recorded session started with. Mouse positions are relative to them.
+	const Int2 &getWindowDimensions() const;
+
+	// Number of frames written or read so far.
+	int getFrameCount() const;
+
+	// Writes the frame, leaving out events that can't be recorded.
+	void writeFrame(const InputFrame &frame);
+
+	// Reads the next recorded frame. Returns false once the recording is exhausted.
+	bool tryReadFrame(InputFrame *outFrame);
+
+	void close();
+};
+
+#endif
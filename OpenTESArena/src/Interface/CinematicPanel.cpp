@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "CinematicPanel.h"
 #include "../Assets/TextureManager.h"
 #include "../Game/Game.h"
@@ -11,7 +13,7 @@ CinematicPanel::CinematicPanel(Game &game)
 	: Panel(game) { }
 
 bool CinematicPanel::init(const std::string &paletteName, const std::string &sequenceName,
-	double secondsPerImage, const OnFinishedFunction &onFinished)
+	const OnFinishedFunction &onFinished)
 {
 	auto &game = this->getGame();
 
@@ -35,37 +37,44 @@ bool CinematicPanel::init(const std::string &paletteName, const std::string &seq
 		}
 	});
 
-	auto &textureManager = game.getTextureManager();
-	const std::optional<TextureFileMetadataID> metadataID = textureManager.tryGetMetadataID(sequenceName.c_str());
-	if (!metadataID.has_value())
+	// Frames are streamed from the file instead of going through the texture manager so only the
+	// current one is ever decoded.
+	if (!this->flc.init(sequenceName.c_str()))
 	{
-		DebugLogError("Couldn't get texture file metadata for \"" + sequenceName + "\".");
+		DebugLogError("Couldn't init cinematic sequence \"" + sequenceName + "\".");
 		return false;
 	}
 
-	const TextureFileMetadata &textureFileMetadata = textureManager.getMetadataHandle(*metadataID);
-	const TextureAsset paletteTextureAsset = TextureAsset(std::string(paletteName));
+	if (this->flc.getFrameCount() == 0)
+	{
+		DebugLogError("No frames in cinematic sequence \"" + sequenceName + "\".");
+		return false;
+	}
 
-	auto &renderer = game.getRenderer();
-	this->textureRefs.init(textureFileMetadata.getTextureCount());
-	for (int i = 0; i < textureFileMetadata.getTextureCount(); i++)
+	auto &textureManager = game.getTextureManager();
+	const TextureAsset paletteTextureAsset = TextureAsset(std::string(paletteName));
+	const std::optional<PaletteID> paletteID = textureManager.tryGetPaletteID(paletteTextureAsset);
+	if (!paletteID.has_value())
 	{
-		const TextureAsset textureAsset = TextureAsset(std::string(sequenceName), i);
+		DebugLogError("Couldn't get palette ID for \"" + paletteName + "\".");
+		return false;
+	}
 
-		UiTextureID textureID;
-		if (!TextureUtils::tryAllocUiTexture(textureAsset, paletteTextureAsset, textureManager, renderer, &textureID))
-		{
-			DebugLogError("Couldn't create UI texture for sequence \"" + sequenceName + "\" frame " + std::to_string(i) + ".");
-			return false;
-		}
+	this->palette = textureManager.getPaletteHandle(*paletteID);
 
-		this->textureRefs.set(i, ScopedUiTextureRef(textureID, renderer));
+	auto &renderer = game.getRenderer();
+	UiTextureID textureID;
+	if (!renderer.tryCreateUiTexture(this->flc.getWidth(), this->flc.getHeight(), &textureID))
+	{
+		DebugLogError("Couldn't create UI texture for sequence \"" + sequenceName + "\".");
+		return false;
 	}
 
+	this->textureRef.init(textureID, renderer);
+
 	UiDrawCall::TextureFunc textureFunc = [this]()
 	{
-		const ScopedUiTextureRef &textureRef = this->textureRefs.get(this->imageIndex);
-		return textureRef.get();
+		return this->textureRef.get();
 	};
 
 	this->addDrawCall(
@@ -74,9 +83,39 @@ bool CinematicPanel::init(const std::string &paletteName, const std::string &seq
 		Int2(ArenaRenderUtils::SCREEN_WIDTH, ArenaRenderUtils::SCREEN_HEIGHT),
 		PivotType::TopLeft);
 	
-	this->secondsPerImage = secondsPerImage;
+	this->secondsPerImage = this->flc.getSecondsPerFrame();
 	this->currentSeconds = 0.0;
 	this->imageIndex = 0;
+	this->decodedImageIndex = -1;
+	return this->tryUpdateTexture();
+}
+
+bool CinematicPanel::tryUpdateTexture()
+{
+	if (this->imageIndex == this->decodedImageIndex)
+	{
+		return true;
+	}
+
+	auto &renderer = this->getGame().getRenderer();
+	const UiTextureID textureID = this->textureRef.get();
+	uint32_t *dstTexels = renderer.lockUiTexture(textureID);
+	if (dstTexels == nullptr)
+	{
+		DebugLogError("Couldn't lock cinematic texture for writing frame " + std::to_string(this->imageIndex) + ".");
+		return false;
+	}
+
+	const uint8_t *srcTexels = this->flc.decodeFrame(this->imageIndex);
+	const int texelCount = this->flc.getWidth() * this->flc.getHeight();
+	std::transform(srcTexels, srcTexels + texelCount, dstTexels,
+		[this](uint8_t texel)
+	{
+		return this->palette[texel].toARGB();
+	});
+
+	renderer.unlockUiTexture(textureID);
+	this->decodedImageIndex = this->imageIndex;
 	return true;
 }
 
@@ -91,10 +130,17 @@ void CinematicPanel::tick(double dt)
 	}
 
 	// If at the end, then prepare for the next panel.
-	const int textureCount = this->textureRefs.getCount();
-	if (this->imageIndex >= textureCount)
+	const int imageCount = this->flc.getFrameCount();
+	const bool isFinished = this->imageIndex >= imageCount;
+	if (isFinished)
+	{
+		this->imageIndex = imageCount - 1;
+	}
+
+	this->tryUpdateTexture();
+
+	if (isFinished)
 	{
-		this->imageIndex = textureCount - 1;
 		this->skipButton.click(this->getGame());
 	}
 }
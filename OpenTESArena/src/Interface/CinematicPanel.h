@@ -5,12 +5,13 @@
 #include <string>
 
 #include "Panel.h"
+#include "../Assets/FLCFile.h"
 #include "../Assets/TextureAsset.h"
-
-#include "components/utilities/Buffer.h"
+#include "../Utilities/Palette.h"
 
 // Designed for sets of images (i.e., videos) that play one after another and
-// eventually lead to another panel. Skipping is available, too.
+// eventually lead to another panel. Skipping is available, too. Frames are decoded
+// one at a time into a single texture as playback advances.
 
 class Game;
 class Renderer;
@@ -21,15 +22,19 @@ public:
 	using OnFinishedFunction = std::function<void(Game&)>;
 private:
 	Button<Game&> skipButton;
-	Buffer<ScopedUiTextureRef> textureRefs;
+	FLCFile flc;
+	Palette palette;
+	ScopedUiTextureRef textureRef;
 	double secondsPerImage, currentSeconds;
-	int imageIndex;
+	int imageIndex, decodedImageIndex;
+
+	// Decodes the current image and writes it to the texture if it's not already there.
+	bool tryUpdateTexture();
 public:
 	CinematicPanel(Game &game);
 	~CinematicPanel() override = default;
 
-	bool init(const std::string &paletteName, const std::string &sequenceName, double secondsPerImage,
-		const OnFinishedFunction &onFinished);
+	bool init(const std::string &paletteName, const std::string &sequenceName, const OnFinishedFunction &onFinished);
 
 	virtual void tick(double dt) override;
 };
@@ -248,6 +248,8 @@ bool GameWorldPanel::init()
 	});
 
 	this->addInputActionListener(InputActionName::PauseMenu, GameWorldUiController::onPauseInputAction);
+	this->addInputActionListener(InputActionName::DebugRaycastBenchmark,
+		GameWorldUiController::onDebugRaycastBenchmarkInputAction);
 
 	this->addMouseButtonChangedListener([this](Game &game, MouseButtonType type, const Int2 &position, bool pressed)
 	{
@@ -799,12 +801,14 @@ void GameWorldPanel::initUiDrawCalls()
 bool GameWorldPanel::gameWorldRenderCallback(Game &game)
 {
 	static std::vector<RenderDrawCall> drawCalls; // Preserved between frames for less fragmentation.
+	static std::vector<RenderScreenSpaceSprite> screenSpaceSprites;
 	drawCalls.clear();
+	screenSpaceSprites.clear();
 
 	// Draw game world onto the native frame buffer. The game world buffer might not completely fill
 	// up the native buffer (bottom corners), so clearing the native buffer beforehand is still necessary.
 	const auto &player = game.getPlayer();
-	const CoordDouble3 &playerPos = player.getPosition();
+	const CoordDouble3 playerPos = player.getInterpolatedPosition(game.getSimulationInterpolationPercent());
 	const VoxelDouble3 &playerDir = player.getDirection();
 
 	auto &gameState = game.getGameState();
@@ -826,14 +830,14 @@ bool GameWorldPanel::gameWorldRenderCallback(Game &game)
 	const RenderWeatherManager &renderWeatherManager = sceneManager.renderWeatherManager;
 	if (activeWeatherInst.hasRain())
 	{
-		const BufferView<const RenderDrawCall> rainDrawCalls = renderWeatherManager.getRainDrawCalls();
-		drawCalls.insert(drawCalls.end(), rainDrawCalls.begin(), rainDrawCalls.end());
+		const BufferView<const RenderScreenSpaceSprite> rainSprites = renderWeatherManager.getRainSprites();
+		screenSpaceSprites.insert(screenSpaceSprites.end(), rainSprites.begin(), rainSprites.end());
 	}
 
 	if (activeWeatherInst.hasSnow())
 	{
-		const BufferView<const RenderDrawCall> snowDrawCalls = renderWeatherManager.getSnowDrawCalls();
-		drawCalls.insert(drawCalls.end(), snowDrawCalls.begin(), snowDrawCalls.end());
+		const BufferView<const RenderScreenSpaceSprite> snowSprites = renderWeatherManager.getSnowSprites();
+		screenSpaceSprites.insert(screenSpaceSprites.end(), snowSprites.begin(), snowSprites.end());
 	}
 
 	if (activeWeatherInst.hasFog())
@@ -872,7 +876,8 @@ bool GameWorldPanel::gameWorldRenderCallback(Game &game)
 		lightTableTextureID = sceneManager.normalLightTableNightTextureRef.get();
 	}
 
-	renderer.submitFrame(renderCamera, drawCalls, ambientPercent, paletteTextureID, lightTableTextureID, options.getGraphics_RenderThreadsMode());
+	renderer.submitFrame(renderCamera, drawCalls, screenSpaceSprites, ambientPercent, paletteTextureID, lightTableTextureID,
+		options.getGraphics_RenderThreadsMode());
 
 	return true;
 }
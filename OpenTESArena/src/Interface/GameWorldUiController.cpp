@@ -255,3 +255,12 @@ void GameWorldUiController::onPauseInputAction(const InputActionCallbackValues &
 		game.setPanel<PauseMenuPanel>();
 	}
 }
+
+void GameWorldUiController::onDebugRaycastBenchmarkInputAction(const InputActionCallbackValues &values)
+{
+	if (values.performed)
+	{
+		auto &game = values.game;
+		GameWorldUiView::DEBUG_RaycastBenchmark(game);
+	}
+}
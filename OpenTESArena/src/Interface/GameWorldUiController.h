@@ -38,6 +38,7 @@ namespace GameWorldUiController
 	void onToggleCompassInputAction(const InputActionCallbackValues &values);
 	void onPlayerPositionInputAction(const InputActionCallbackValues &values, TextBox &actionText);
 	void onPauseInputAction(const InputActionCallbackValues &values);
+	void onDebugRaycastBenchmarkInputAction(const InputActionCallbackValues &values);
 }
 
 #endif
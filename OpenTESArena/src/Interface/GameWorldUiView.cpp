@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <vector>
 
 #include "GameWorldPanel.h"
 #include "GameWorldUiModel.h"
@@ -6,6 +7,7 @@
 #include "../Assets/ArenaPaletteName.h"
 #include "../Assets/ArenaPortraitUtils.h"
 #include "../Assets/ArenaTextureName.h"
+#include "../Collision/Physics.h"
 #include "../Entities/CharacterClassLibrary.h"
 #include "../Entities/EntityDefinitionLibrary.h"
 #include "../Game/Game.h"
@@ -502,21 +504,75 @@ UiTextureID GameWorldUiView::allocArrowCursorTexture(int cursorIndex, TextureMan
 	return textureID;
 }
 
+namespace
+{
+	// Screen-space grid of rays used by the ray casting debug visualizations.
+	void DEBUG_MakeRaycastGrid(Game &game, int xOffset, int yOffset, std::vector<Physics::Ray> &outRays,
+		std::vector<Int2> &outPixels)
+	{
+		const auto &renderer = game.getRenderer();
+		const Int2 windowDims = renderer.getWindowDimensions();
+		const CoordDouble3 &rayStart = game.getPlayer().getPosition();
+
+		for (int y = 0; y < windowDims.y; y += yOffset)
+		{
+			for (int x = 0; x < windowDims.x; x += xOffset)
+			{
+				const Int2 pixel(x, y);
+				Physics::Ray ray;
+				ray.init(rayStart, GameWorldUiModel::screenToWorldRayDirection(game, pixel));
+				outRays.emplace_back(std::move(ray));
+				outPixels.emplace_back(pixel);
+			}
+		}
+	}
+
+	// Whether two ray casts found the same thing: same distance, same hit type, and the same voxel and facing
+	// or the same entity.
+	bool DEBUG_RaycastHitsMatch(const Physics::Hit &a, const Physics::Hit &b)
+	{
+		const bool aSuccess = a.getT() < Physics::Hit::MAX_T;
+		const bool bSuccess = b.getT() < Physics::Hit::MAX_T;
+		if (aSuccess != bSuccess)
+		{
+			return false;
+		}
+
+		if (!aSuccess)
+		{
+			return true;
+		}
+
+		if ((a.getT() != b.getT()) || (a.getType() != b.getType()) || (a.getCoord().chunk != b.getCoord().chunk))
+		{
+			return false;
+		}
+
+		if (a.getType() == Physics::HitType::Voxel)
+		{
+			const Physics::Hit::VoxelHit &aVoxelHit = a.getVoxelHit();
+			const Physics::Hit::VoxelHit &bVoxelHit = b.getVoxelHit();
+			return (aVoxelHit.voxel == bVoxelHit.voxel) && (aVoxelHit.facing == bVoxelHit.facing);
+		}
+		else
+		{
+			return a.getEntityHit().id == b.getEntityHit().id;
+		}
+	}
+}
+
 // @temp: keep until 3D-DDA ray casting is fully correct (i.e. entire ground is red dots for
 // levels where ceilingScale < 1.0, and same with ceiling blue dots).
 void GameWorldUiView::DEBUG_ColorRaycastPixel(Game &game)
 {
 	auto &renderer = game.getRenderer();
 	const int selectionDim = 3;
-	const Int2 windowDims = renderer.getWindowDimensions();
 
 	constexpr int xOffset = 16;
 	constexpr int yOffset = 16;
 
 	const auto &player = game.getPlayer();
-	const CoordDouble3 &rayStart = player.getPosition();
 	const VoxelDouble3 &cameraDirection = player.getDirection();
-	const double viewAspectRatio = renderer.getViewAspect();
 
 	const auto &gameState = game.getGameState();
 	const double ceilingScale = gameState.getActiveCeilingScale();
@@ -526,50 +582,121 @@ void GameWorldUiView::DEBUG_ColorRaycastPixel(Game &game)
 	const EntityChunkManager &entityChunkManager = sceneManager.entityChunkManager;
 	const CollisionChunkManager &collisionChunkManager = sceneManager.collisionChunkManager;
 
-	for (int y = 0; y < windowDims.y; y += yOffset)
+	std::vector<Physics::Ray> rays;
+	std::vector<Int2> pixels;
+	DEBUG_MakeRaycastGrid(game, xOffset, yOffset, rays, pixels);
+
+	const int rayCount = static_cast<int>(rays.size());
+	Buffer<Physics::Hit> hits(rayCount);
+	Buffer<bool> successes(rayCount);
+
+	// Not registering entities with ray cast hits for efficiency since this debug visualization
+	// is for voxels.
+	constexpr bool includeEntities = false;
+	Physics::rayCastBatch(rays, ceilingScale, cameraDirection, includeEntities, voxelChunkManager,
+		entityChunkManager, collisionChunkManager, EntityDefinitionLibrary::getInstance(), renderer, game.getFrameArena(),
+		hits, successes);
+
+	for (int i = 0; i < rayCount; i++)
 	{
-		for (int x = 0; x < windowDims.x; x += xOffset)
+		if (!successes.get(i))
 		{
-			const Double3 rayDirection = GameWorldUiModel::screenToWorldRayDirection(game, Int2(x, y));
-
-			// Not registering entities with ray cast hits for efficiency since this debug visualization
-			// is for voxels.
-			constexpr bool includeEntities = false;
-			Physics::Hit hit;
-			const bool success = Physics::rayCast(rayStart, rayDirection, ceilingScale, cameraDirection,
-				includeEntities, voxelChunkManager, entityChunkManager, collisionChunkManager,
-				EntityDefinitionLibrary::getInstance(), renderer, hit);
+			continue;
+		}
 
-			if (success)
+		const Physics::Hit &hit = hits.get(i);
+		Color color;
+		switch (hit.getType())
+		{
+		case Physics::HitType::Voxel:
+		{
+			const std::array<Color, 5> colors =
 			{
-				Color color;
-				switch (hit.getType())
-				{
-				case Physics::HitType::Voxel:
-				{
-					const std::array<Color, 5> colors =
-					{
-						Color::Red, Color::Green, Color::Blue, Color::Cyan, Color::Yellow
-					};
-
-					const VoxelInt3 &voxel = hit.getVoxelHit().voxel;
-					const int colorsIndex = std::min(voxel.y, 4);
-					color = colors[colorsIndex];
-					break;
-				}
-				case Physics::HitType::Entity:
-				{
-					color = Color::Yellow;
-					break;
-				}
-				}
-
-				renderer.drawRect(color, x, y, selectionDim, selectionDim);
-			}
+				Color::Red, Color::Green, Color::Blue, Color::Cyan, Color::Yellow
+			};
+
+			const VoxelInt3 &voxel = hit.getVoxelHit().voxel;
+			const int colorsIndex = std::min(voxel.y, 4);
+			color = colors[colorsIndex];
+			break;
+		}
+		case Physics::HitType::Entity:
+		{
+			color = Color::Yellow;
+			break;
+		}
 		}
+
+		const Int2 &pixel = pixels[i];
+		renderer.drawRect(color, pixel.x, pixel.y, selectionDim, selectionDim);
 	}
 }
 
+// @temp: compares batched ray casting against one rayCast() per ray over a dense screen grid, verifying both
+// produce the same hits. Triggered by the DebugRaycastBenchmark input action in the game world.
+void GameWorldUiView::DEBUG_RaycastBenchmark(Game &game)
+{
+	constexpr int xOffset = 4;
+	constexpr int yOffset = 4;
+
+	const auto &renderer = game.getRenderer();
+	const auto &player = game.getPlayer();
+	const VoxelDouble3 &cameraDirection = player.getDirection();
+
+	const auto &gameState = game.getGameState();
+	const double ceilingScale = gameState.getActiveCeilingScale();
+
+	const SceneManager &sceneManager = game.getSceneManager();
+	const VoxelChunkManager &voxelChunkManager = sceneManager.voxelChunkManager;
+	const EntityChunkManager &entityChunkManager = sceneManager.entityChunkManager;
+	const CollisionChunkManager &collisionChunkManager = sceneManager.collisionChunkManager;
+	const EntityDefinitionLibrary &entityDefLibrary = EntityDefinitionLibrary::getInstance();
+
+	std::vector<Physics::Ray> rays;
+	std::vector<Int2> pixels;
+	DEBUG_MakeRaycastGrid(game, xOffset, yOffset, rays, pixels);
+
+	const int rayCount = static_cast<int>(rays.size());
+	Buffer<Physics::Hit> singleHits(rayCount);
+	Buffer<Physics::Hit> batchHits(rayCount);
+	Buffer<bool> batchSuccesses(rayCount);
+
+	constexpr bool includeEntities = true;
+	Profiler &profiler = game.getProfiler();
+	const std::string singleSamplerName = "RayCastSingle";
+	const std::string batchSamplerName = "RayCastBatch";
+
+	profiler.setStart(singleSamplerName);
+	for (int i = 0; i < rayCount; i++)
+	{
+		const Physics::Ray &ray = rays[i];
+		Physics::rayCast(ray.start, ray.direction, ceilingScale, cameraDirection, includeEntities, voxelChunkManager,
+			entityChunkManager, collisionChunkManager, entityDefLibrary, renderer, game.getFrameArena(), singleHits.get(i));
+	}
+
+	profiler.setStop(singleSamplerName);
+
+	profiler.setStart(batchSamplerName);
+	Physics::rayCastBatch(rays, ceilingScale, cameraDirection, includeEntities, voxelChunkManager, entityChunkManager,
+		collisionChunkManager, entityDefLibrary, renderer, game.getFrameArena(), batchHits, batchSuccesses);
+	profiler.setStop(batchSamplerName);
+
+	int mismatchCount = 0;
+	for (int i = 0; i < rayCount; i++)
+	{
+		const Physics::Hit &singleHit = singleHits.get(i);
+		const Physics::Hit &batchHit = batchHits.get(i);
+		if (!DEBUG_RaycastHitsMatch(singleHit, batchHit))
+		{
+			mismatchCount++;
+		}
+	}
+
+	DebugLog("Ray cast benchmark (" + std::to_string(rayCount) + " rays): single " +
+		profiler.getMillisecondsString(singleSamplerName) + "ms, batch " +
+		profiler.getMillisecondsString(batchSamplerName) + "ms, " + std::to_string(mismatchCount) + " mismatches.");
+}
+
 // @temp: keep until 3D-DDA ray casting is fully correct (i.e. entire ground is red dots for
 // levels where ceilingScale < 1.0, and same with ceiling blue dots).
 void GameWorldUiView::DEBUG_PhysicsRaycast(Game &game)
@@ -601,7 +728,7 @@ void GameWorldUiView::DEBUG_PhysicsRaycast(Game &game)
 	constexpr bool includeEntities = true;
 	Physics::Hit hit;
 	const bool success = Physics::rayCast(rayStart, rayDirection, ceilingScale, cameraDirection, includeEntities,
-		voxelChunkManager, entityChunkManager, collisionChunkManager, entityDefLibrary, renderer, hit);
+		voxelChunkManager, entityChunkManager, collisionChunkManager, entityDefLibrary, renderer, game.getFrameArena(), hit);
 
 	std::string text;
 	if (success)
@@ -32,18 +32,7 @@ void IntroUiController::onIntroQuoteFinished(Game &game)
 {
 	const std::string paletteFilename = IntroUiView::getOpeningScrollPaletteFilename();
 	const std::string sequenceFilename = IntroUiView::getOpeningScrollSequenceFilename();
-
-	TextureManager &textureManager = game.getTextureManager();
-	const std::optional<TextureFileMetadataID> metadataID = textureManager.tryGetMetadataID(sequenceFilename.c_str());
-	if (!metadataID.has_value())
-	{
-		DebugLogError("Couldn't get texture file metadata for opening scroll animation \"" + sequenceFilename + "\".");
-		return;
-	}
-
-	const TextureFileMetadata &metadata = textureManager.getMetadataHandle(*metadataID);
-	const double secondsPerFrame = metadata.getSecondsPerFrame();
-	game.setPanel<CinematicPanel>(paletteFilename, sequenceFilename, secondsPerFrame, IntroUiController::onOpeningScrollFinished);
+	game.setPanel<CinematicPanel>(paletteFilename, sequenceFilename, IntroUiController::onOpeningScrollFinished);
 }
 
 void IntroUiController::onOpeningScrollFinished(Game &game)
@@ -42,18 +42,7 @@ std::unique_ptr<Panel> IntroUiModel::makeStartupPanel(Game &game)
 		std::unique_ptr<CinematicPanel> panel = std::make_unique<CinematicPanel>(game);
 		const std::string paletteFilename = IntroUiView::getIntroBookPaletteFilename();
 		const std::string sequenceFilename = IntroUiView::getIntroBookSequenceFilename();
-
-		TextureManager &textureManager = game.getTextureManager();
-		const std::optional<TextureFileMetadataID> metadataID = textureManager.tryGetMetadataID(sequenceFilename.c_str());
-		if (!metadataID.has_value())
-		{
-			DebugLogError("Couldn't get texture file metadata for start-up cinematic \"" + sequenceFilename + "\".");
-			return nullptr;
-		}
-
-		const TextureFileMetadata &metadata = textureManager.getMetadataHandle(*metadataID);
-		const double secondsPerFrame = metadata.getSecondsPerFrame();
-		if (!panel->init(paletteFilename, sequenceFilename, secondsPerFrame, IntroUiController::onIntroBookFinished))
+		if (!panel->init(paletteFilename, sequenceFilename, IntroUiController::onIntroBookFinished))
 		{
 			DebugLogError("Couldn't init start-up CinematicPanel.");
 			return nullptr;
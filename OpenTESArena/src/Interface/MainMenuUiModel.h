@@ -11,6 +11,7 @@
 class ExeData;
 class Game;
 class ProvinceDefinition;
+class Random;
 
 enum class MapType;
 
@@ -108,11 +109,11 @@ namespace MainMenuUiModel
 
 	void getMainQuestLocationFromIndex(int testIndex, const ExeData &exeData,
 		int *outLocationID, int *outProvinceID, SpecialCaseType *outSpecialCaseType);
-	std::vector<int> makeShuffledLocationIndices(const ProvinceDefinition &provinceDef);
+	std::vector<int> makeShuffledLocationIndices(const ProvinceDefinition &provinceDef, Random &random);
 	std::optional<int> getRandomCityLocationDefIndexIfType(const ProvinceDefinition &provinceDef,
-		ArenaTypes::CityType cityType);
-	int getRandomCityLocationIndex(const ProvinceDefinition &provinceDef);
-	std::optional<int> getRandomDungeonLocationDefIndex(const ProvinceDefinition &provinceDef);
+		ArenaTypes::CityType cityType, Random &random);
+	int getRandomCityLocationIndex(const ProvinceDefinition &provinceDef, Random &random);
+	std::optional<int> getRandomDungeonLocationDefIndex(const ProvinceDefinition &provinceDef, Random &random);
 }
 
 #endif
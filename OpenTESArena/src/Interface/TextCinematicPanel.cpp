@@ -129,6 +129,19 @@ bool TextCinematicPanel::init(int textCinematicDefIndex, double secondsPerImage,
 	if (TextCinematicUiModel::shouldPlaySpeech(game))
 	{
 		this->speechState.init(textCinematicDef.getTemplateDatKey());
+
+		// Find how many voice lines there are up front so ticking only deals with sound IDs.
+		auto &audioManager = game.getAudioManager();
+		for (int voiceIndex = 0; ; voiceIndex++)
+		{
+			const std::string voiceFilename = this->speechState.getVoiceFilename(voiceIndex);
+			if (!audioManager.soundExists(voiceFilename))
+			{
+				break;
+			}
+
+			this->voiceSoundIDs.emplace_back(audioManager.getSoundID(voiceFilename));
+		}
 	}
 
 	this->onFinished = onFinished;
@@ -176,27 +189,30 @@ void TextCinematicPanel::tick(double dt)
 		// Update speech state, optionally ending the cinematic if done with last speech.
 		auto &audioManager = game.getAudioManager();
 
+		const int voiceCount = static_cast<int>(this->voiceSoundIDs.size());
 		const bool playedFirstVoice = !TextCinematicUiModel::SpeechState::isFirstVoice(this->speechState.getNextVoiceIndex());
 		if (!playedFirstVoice)
 		{
-			const std::string voiceFilename = this->speechState.getVoiceFilename(this->speechState.getNextVoiceIndex());
-			audioManager.playSound(voiceFilename);
+			if (voiceCount > 0)
+			{
+				audioManager.playSound(this->voiceSoundIDs[0], std::nullopt, SoundPriority::High);
+			}
+
 			this->speechState.incrementVoiceIndex();
 		}
 		else
 		{
 			const int prevVoiceIndex = this->speechState.getNextVoiceIndex() - 1;
-			const std::string prevVoiceFilename = this->speechState.getVoiceFilename(prevVoiceIndex);
+			const bool isPrevVoicePlaying = (prevVoiceIndex < voiceCount) &&
+				audioManager.isPlayingSound(this->voiceSoundIDs[prevVoiceIndex]);
 
 			// Wait until previous voice is done playing.
-			if (!audioManager.isPlayingSound(prevVoiceFilename))
+			if (!isPrevVoicePlaying)
 			{
 				const int nextVoiceIndex = this->speechState.getNextVoiceIndex();
-				const std::string nextVoiceFilename = this->speechState.getVoiceFilename(nextVoiceIndex);
-
-				if (audioManager.soundExists(nextVoiceFilename))
+				if (nextVoiceIndex < voiceCount)
 				{
-					audioManager.playSound(nextVoiceFilename);
+					audioManager.playSound(this->voiceSoundIDs[nextVoiceIndex], std::nullopt, SoundPriority::High);
 					this->speechState.incrementVoiceIndex();
 
 					if (TextCinematicUiModel::SpeechState::isBeginningOfNewPage(nextVoiceIndex))
@@ -8,6 +8,7 @@
 #include "Panel.h"
 #include "TextCinematicUiModel.h"
 #include "../Assets/TextureManager.h"
+#include "../Audio/SoundUtils.h"
 #include "../UI/Button.h"
 #include "../UI/TextBox.h"
 
@@ -36,6 +37,7 @@ private:
 	std::vector<std::string> textPages; // One string per page of text.
 	std::vector<ScopedUiTextureRef> animTextureRefs; // One per animation image.
 	TextCinematicUiModel::SpeechState speechState;
+	std::vector<SoundID> voiceSoundIDs; // Every voice line of the speech in order, interned on init.
 	double secondsPerImage, currentImageSeconds;
 	int animImageIndex, textIndex, textCinematicDefIndex;
 
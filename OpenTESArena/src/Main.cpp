@@ -2,6 +2,7 @@
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 
 #include "SDL.h"
 
@@ -12,8 +13,22 @@
 
 int main(int argc, char *argv[])
 {
-	static_cast<void>(argc);
-	static_cast<void>(argv);
+	// Optional input capture for benchmarking: --record-input <path> or --replay-input <path>.
+	std::string recordInputPath, replayInputPath;
+	for (int i = 1; i < (argc - 1); i++)
+	{
+		const std::string_view arg = argv[i];
+		if (arg == "--record-input")
+		{
+			i++;
+			recordInputPath = argv[i];
+		}
+		else if (arg == "--replay-input")
+		{
+			i++;
+			replayInputPath = argv[i];
+		}
+	}
 
 	const std::string logPath = Platform::getLogPath();
 	if (!Debug::init(logPath.c_str()))
@@ -26,7 +41,7 @@ int main(int argc, char *argv[])
 	{
 		// Allocated on the heap to avoid stack overflow warning.
 		std::unique_ptr<Game> game = std::make_unique<Game>();
-		if (!game->init())
+		if (!game->init(recordInputPath, replayInputPath))
 		{
 			DebugCrash("Couldn't init Game instance. Closing.");
 		}
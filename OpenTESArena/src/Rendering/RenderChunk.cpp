@@ -36,23 +36,23 @@ void RenderVoxelLightIdList::clear()
 	this->lightCount = 0;
 }
 
+RenderVoxelBatch::RenderVoxelBatch()
+{
+	this->textureID = -1;
+}
+
 void RenderChunk::init(const ChunkInt2 &position, int height)
 {
 	Chunk::init(position, height);
 	this->meshDefIDs.init(ChunkUtils::CHUNK_DIM, height, ChunkUtils::CHUNK_DIM);
 	this->meshDefIDs.fill(RenderChunk::AIR_MESH_DEF_ID);
-	this->meshDefMappings.emplace(VoxelChunk::AIR_MESH_DEF_ID, RenderChunk::AIR_MESH_DEF_ID);
 	this->voxelLightIdLists.init(ChunkUtils::CHUNK_DIM, height, ChunkUtils::CHUNK_DIM);
-
-	// Add empty mesh instance for air.
-	this->addMeshDefinition(RenderVoxelMeshDefinition());
-}
-
-RenderVoxelMeshDefID RenderChunk::addMeshDefinition(RenderVoxelMeshDefinition &&meshDef)
-{
-	const RenderVoxelMeshDefID id = static_cast<RenderVoxelMeshDefID>(this->meshDefs.size());
-	this->meshDefs.emplace_back(std::move(meshDef));
-	return id;
+	this->batchTiles.init(BATCH_TILE_COUNT_PER_SIDE, BATCH_TILE_COUNT_PER_SIDE);
+	this->dirtyBatchTiles.init(BATCH_TILE_COUNT_PER_SIDE, BATCH_TILE_COUNT_PER_SIDE);
+	this->dirtyBatchTiles.fill(true);
+	this->batchedVoxels.init(ChunkUtils::CHUNK_DIM, height, ChunkUtils::CHUNK_DIM);
+	this->batchedVoxels.fill(false);
+	this->isBatchingEnabled = false;
 }
 
 void RenderChunk::addDirtyLightPosition(const VoxelInt3 &position)
@@ -64,19 +64,70 @@ void RenderChunk::addDirtyLightPosition(const VoxelInt3 &position)
 	}
 }
 
+void RenderChunk::addDirtyBatchTiles(const VoxelInt3 &position)
+{
+	// Neighbors in other tiles may have had a face hidden by this voxel.
+	const VoxelInt2 positionsXZ[] =
+	{
+		VoxelInt2(position.x, position.z),
+		VoxelInt2(position.x - 1, position.z),
+		VoxelInt2(position.x + 1, position.z),
+		VoxelInt2(position.x, position.z - 1),
+		VoxelInt2(position.x, position.z + 1)
+	};
+
+	for (const VoxelInt2 &positionXZ : positionsXZ)
+	{
+		if ((positionXZ.x >= 0) && (positionXZ.x < Chunk::WIDTH) && (positionXZ.y >= 0) && (positionXZ.y < Chunk::DEPTH))
+		{
+			this->dirtyBatchTiles.set(positionXZ.x / BATCH_TILE_DIM, positionXZ.y / BATCH_TILE_DIM, true);
+		}
+	}
+}
+
+void RenderChunk::setAllBatchTilesDirty()
+{
+	this->dirtyBatchTiles.fill(true);
+}
+
+void RenderChunk::freeBatchTile(int tileX, int tileZ, Renderer &renderer)
+{
+	std::vector<RenderVoxelBatch> &batches = this->batchTiles.get(tileX, tileZ);
+	for (RenderVoxelBatch &batch : batches)
+	{
+		batch.meshDef.freeBuffers(renderer);
+	}
+
+	batches.clear();
+
+	const SNInt startX = tileX * BATCH_TILE_DIM;
+	const WEInt startZ = tileZ * BATCH_TILE_DIM;
+	for (WEInt z = startZ; z < (startZ + BATCH_TILE_DIM); z++)
+	{
+		for (int y = 0; y < this->batchedVoxels.getHeight(); y++)
+		{
+			for (SNInt x = startX; x < (startX + BATCH_TILE_DIM); x++)
+			{
+				this->batchedVoxels.set(x, y, z, false);
+			}
+		}
+	}
+}
+
 void RenderChunk::freeBuffers(Renderer &renderer)
 {
-	for (RenderVoxelMeshDefinition &meshDef : this->meshDefs)
+	for (WEInt z = 0; z < this->batchTiles.getHeight(); z++)
 	{
-		meshDef.freeBuffers(renderer);
+		for (SNInt x = 0; x < this->batchTiles.getWidth(); x++)
+		{
+			this->freeBatchTile(x, z, renderer);
+		}
 	}
 }
 
 void RenderChunk::clear()
 {
 	Chunk::clear();
-	this->meshDefs.clear();
-	this->meshDefMappings.clear();
 	this->meshDefIDs.clear();
 	this->chasmWallIndexBufferIDsMap.clear();
 	this->voxelLightIdLists.clear();
@@ -86,4 +137,14 @@ void RenderChunk::clear()
 	this->chasmDrawCalls.clear();
 	this->fadingDrawCalls.clear();
 	this->entityDrawCalls.clear();
+	this->staticDrawCallVoxels.clear();
+	this->doorDrawCallVoxels.clear();
+	this->chasmDrawCallVoxels.clear();
+	this->fadingDrawCallVoxels.clear();
+	this->batchTiles.clear();
+	this->dirtyBatchTiles.clear();
+	this->batchedVoxels.clear();
+	this->isBatchingEnabled = false;
+	this->batchDrawCalls.clear();
+	this->batchDrawCallVoxels.clear();
 }
@@ -12,6 +12,7 @@
 #include "../World/Chunk.h"
 
 #include "components/utilities/Buffer.h"
+#include "components/utilities/Buffer2D.h"
 #include "components/utilities/Buffer3D.h"
 #include "components/utilities/BufferView.h"
 
@@ -33,14 +34,26 @@ struct RenderVoxelLightIdList
 	void clear();
 };
 
+// Static opaque voxel faces of one texture merged across a tile of voxel columns.
+struct RenderVoxelBatch
+{
+	RenderVoxelMeshDefinition meshDef; // Only uses the first opaque index buffer.
+	ObjectTextureID textureID;
+
+	RenderVoxelBatch();
+};
+
 class RenderChunk final : public Chunk
 {
 public:
 	static constexpr RenderVoxelMeshDefID AIR_MESH_DEF_ID = 0;
 
-	std::vector<RenderVoxelMeshDefinition> meshDefs;
-	std::unordered_map<VoxelChunk::VoxelMeshDefID, RenderVoxelMeshDefID> meshDefMappings; // Note: this doesn't support VoxelIDs changing which def they point to (important if VoxelChunk::removeVoxelDef() is ever in use).
-	Buffer3D<RenderVoxelMeshDefID> meshDefIDs; // Points into mesh instances.
+	// Width and depth in voxel columns of a batched geometry tile.
+	static constexpr int BATCH_TILE_DIM = 4;
+	static constexpr int BATCH_TILE_COUNT_PER_SIDE = Chunk::WIDTH / BATCH_TILE_DIM;
+	static_assert((Chunk::WIDTH % BATCH_TILE_DIM) == 0);
+
+	Buffer3D<RenderVoxelMeshDefID> meshDefIDs; // Points into the render chunk manager's shared voxel mesh definitions.
 	std::unordered_map<VoxelInt3, IndexBufferID> chasmWallIndexBufferIDsMap; // If an index buffer ID exists for a voxel, it adds a draw call for the chasm wall. IDs are owned by the render chunk manager.
 	Buffer3D<RenderVoxelLightIdList> voxelLightIdLists; // Lights touching each voxel. IDs are owned by RenderChunkManager.
 	std::vector<VoxelInt3> dirtyLightPositions; // Voxels that need relevant lights updated.
@@ -50,15 +63,27 @@ public:
 	std::vector<RenderDrawCall> fadingDrawCalls; // Voxels with fade shader. Note that the static draw call in the same voxel needs to be deleted to avoid a conflict in the depth buffer.
 	std::vector<RenderDrawCall> entityDrawCalls;
 
-	// @todo: quadtree
-	// - thinking that each 'visible slice' of the tree could be a BufferView2D maybe, or a VoxelInt2 begin + end pattern
+	// Voxel of each draw call in the equivalent list above, for frustum culling against the voxel visibility chunk.
+	std::vector<VoxelInt3> staticDrawCallVoxels, doorDrawCallVoxels, chasmDrawCallVoxels, fadingDrawCallVoxels;
+
+	// Merged static geometry. Voxels covered by a batch don't get their own opaque draw calls.
+	Buffer2D<std::vector<RenderVoxelBatch>> batchTiles;
+	Buffer2D<bool> dirtyBatchTiles; // Tiles needing their batches rebuilt.
+	Buffer3D<bool> batchedVoxels;
+	bool isBatchingEnabled; // Whether the batches were last built with batching on.
+	std::vector<RenderDrawCall> batchDrawCalls;
+	std::vector<VoxelInt3> batchDrawCallVoxels; // First voxel of each draw call's tile.
 
 	// @todo: bounding box for "the whole chunk", update every frame. This box can be larger than the chunk because of entity overhang.
 	// @todo: entities (stores vertex buffer id, etc. as well as transform and bounding box)
 
 	void init(const ChunkInt2 &position, int height);
-	RenderVoxelMeshDefID addMeshDefinition(RenderVoxelMeshDefinition &&meshDef);
 	void addDirtyLightPosition(const VoxelInt3 &position);
+
+	// Marks the tile containing the voxel plus any tiles whose hidden faces depend on it.
+	void addDirtyBatchTiles(const VoxelInt3 &position);
+	void setAllBatchTilesDirty();
+	void freeBatchTile(int tileX, int tileZ, Renderer &renderer);
 	void freeBuffers(Renderer &renderer);
 	void clear();
 };
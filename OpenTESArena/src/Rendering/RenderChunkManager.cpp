@@ -6,6 +6,7 @@
 #include "ArenaRenderUtils.h"
 #include "RenderCamera.h"
 #include "RenderChunkManager.h"
+#include "RenderGeometryUtils.h"
 #include "Renderer.h"
 #include "RendererSystem3D.h"
 #include "RendererUtils.h"
@@ -24,6 +25,7 @@
 #include "../World/ChunkManager.h"
 #include "../World/MapDefinition.h"
 #include "../World/MapType.h"
+#include "../World/MeshUtils.h"
 
 #include "components/debug/Debug.h"
 
@@ -166,20 +168,17 @@ namespace sgTexture
 		}
 	}
 
-	void LoadChasmDefTextures(VoxelChunk::ChasmDefID chasmDefID, const VoxelChunk &voxelChunk,
+	void LoadChasmDefTextures(VoxelChunk::ChasmDefID chasmDefID, const ChasmDefinition &chasmDef,
 		BufferView<const RenderChunkManager::LoadedVoxelTexture> voxelTextures,
 		std::vector<RenderChunkManager::LoadedChasmFloorTextureList> &chasmFloorTextureLists,
 		std::vector<RenderChunkManager::LoadedChasmTextureKey> &chasmTextureKeys,
 		TextureManager &textureManager, Renderer &renderer)
 	{
-		const ChunkInt2 chunkPos = voxelChunk.getPosition();
-		const ChasmDefinition &chasmDef = voxelChunk.getChasmDef(chasmDefID);
-
-		// Check if this chasm already has a mapping (i.e. have we seen this chunk before?).
+		// Check if this chasm already has a mapping.
 		const auto keyIter = std::find_if(chasmTextureKeys.begin(), chasmTextureKeys.end(),
-			[chasmDefID, &chunkPos](const RenderChunkManager::LoadedChasmTextureKey &loadedKey)
+			[chasmDefID](const RenderChunkManager::LoadedChasmTextureKey &loadedKey)
 		{
-			return (loadedKey.chasmDefID == chasmDefID) && (loadedKey.chunkPos == chunkPos);
+			return loadedKey.chasmDefID == chasmDefID;
 		});
 
 		if (keyIter != chasmTextureKeys.end())
@@ -284,7 +283,7 @@ namespace sgTexture
 		DebugAssert(chasmWallIndex >= 0);
 
 		RenderChunkManager::LoadedChasmTextureKey key;
-		key.init(chunkPos, chasmDefID, chasmFloorListIndex, chasmWallIndex);
+		key.init(chasmDefID, chasmFloorListIndex, chasmWallIndex);
 		chasmTextureKeys.emplace_back(std::move(key));
 	}
 
@@ -383,6 +382,61 @@ namespace sgTexture
 	}
 }
 
+namespace sgGeometry
+{
+	// Whether a wall voxel's face on the given side is fully covered by the adjacent voxel.
+	bool IsVoxelFaceHidden(const VoxelChunk &voxelChunk, const VoxelInt3 &voxel, const Double3 &faceNormal)
+	{
+		const VoxelInt3 adjacentVoxel(
+			voxel.x + static_cast<int>(faceNormal.x),
+			voxel.y + static_cast<int>(faceNormal.y),
+			voxel.z + static_cast<int>(faceNormal.z));
+		if (!voxelChunk.isValidVoxel(adjacentVoxel.x, adjacentVoxel.y, adjacentVoxel.z))
+		{
+			return false;
+		}
+
+		const VoxelChunk::VoxelTraitsDefID adjacentTraitsDefID = voxelChunk.getTraitsDefID(adjacentVoxel.x, adjacentVoxel.y, adjacentVoxel.z);
+		const VoxelTraitsDefinition &adjacentTraitsDef = voxelChunk.getTraitsDef(adjacentTraitsDefID);
+		if (adjacentTraitsDef.type != ArenaTypes::VoxelType::Wall)
+		{
+			return false;
+		}
+
+		// Fading walls are see-through.
+		int fadeAnimInstIndex;
+		return !voxelChunk.tryGetFadeAnimInstIndex(adjacentVoxel.x, adjacentVoxel.y, adjacentVoxel.z, &fadeAnimInstIndex);
+	}
+
+	// Returns the axis-aligned unit normal of the triangle if it lies on a face of the voxel's unit cube.
+	std::optional<Double3> TryGetVoxelBoundaryNormal(const VoxelMeshDefinition &voxelMeshDef, int32_t index0, int32_t index1, int32_t index2)
+	{
+		const int32_t indices[] = { index0, index1, index2 };
+		for (int axis = 0; axis < 3; axis++)
+		{
+			for (const double boundary : { 0.0, 1.0 })
+			{
+				const bool isOnBoundary = std::all_of(std::begin(indices), std::end(indices),
+					[&voxelMeshDef, axis, boundary](int32_t index)
+				{
+					return voxelMeshDef.rendererVertices[(index * MeshUtils::POSITION_COMPONENTS_PER_VERTEX) + axis] == boundary;
+				});
+
+				if (isOnBoundary)
+				{
+					const double normalComponent = (boundary == 0.0) ? -1.0 : 1.0;
+					return Double3(
+						(axis == 0) ? normalComponent : 0.0,
+						(axis == 1) ? normalComponent : 0.0,
+						(axis == 2) ? normalComponent : 0.0);
+				}
+			}
+		}
+
+		return std::nullopt;
+	}
+}
+
 void RenderChunkManager::LoadedVoxelTexture::init(const TextureAsset &textureAsset,
 	ScopedObjectTextureRef &&objectTextureRef)
 {
@@ -432,10 +486,8 @@ int RenderChunkManager::LoadedChasmFloorTextureList::getTextureIndex(double chas
 	}
 }
 
-void RenderChunkManager::LoadedChasmTextureKey::init(const ChunkInt2 &chunkPos, VoxelChunk::ChasmDefID chasmDefID,
-	int chasmFloorListIndex, int chasmWallIndex)
+void RenderChunkManager::LoadedChasmTextureKey::init(VoxelChunk::ChasmDefID chasmDefID, int chasmFloorListIndex, int chasmWallIndex)
 {
-	this->chunkPos = chunkPos;
 	this->chasmDefID = chasmDefID;
 	this->chasmFloorListIndex = chasmFloorListIndex;
 	this->chasmWallIndex = chasmWallIndex;
@@ -462,6 +514,8 @@ void RenderChunkManager::Light::init(RenderLightID lightID, bool enabled)
 RenderChunkManager::RenderChunkManager()
 {
 	this->chasmWallIndexBufferIDs.fill(-1);
+	this->loadedVoxelTextureDefCount = 0;
+	this->loadedVoxelChasmDefCount = 0;
 	this->playerLightID = -1;
 }
 
@@ -526,20 +580,20 @@ void RenderChunkManager::init(Renderer &renderer)
 	constexpr int entityMeshVertexCount = 4;
 	constexpr int entityMeshIndexCount = 6;
 
-	if (!renderer.tryCreateVertexBuffer(entityMeshVertexCount, positionComponentsPerVertex, &this->entityMeshDef.vertexBufferID))
+	if (!renderer.tryCreateVertexBuffer(entityMeshVertexCount, positionComponentsPerVertex, VertexAttributeFormat::Int16, &this->entityMeshDef.vertexBufferID))
 	{
 		DebugLogError("Couldn't create vertex buffer for entity mesh ID.");
 		return;
 	}
 
-	if (!renderer.tryCreateAttributeBuffer(entityMeshVertexCount, normalComponentsPerVertex, &this->entityMeshDef.normalBufferID))
+	if (!renderer.tryCreateAttributeBuffer(entityMeshVertexCount, normalComponentsPerVertex, VertexAttributeFormat::OctahedralInt16, &this->entityMeshDef.normalBufferID))
 	{
 		DebugLogError("Couldn't create normal attribute buffer for entity mesh def.");
 		this->entityMeshDef.freeBuffers(renderer);
 		return;
 	}
 
-	if (!renderer.tryCreateAttributeBuffer(entityMeshVertexCount, texCoordComponentsPerVertex, &this->entityMeshDef.texCoordBufferID))
+	if (!renderer.tryCreateAttributeBuffer(entityMeshVertexCount, texCoordComponentsPerVertex, VertexAttributeFormat::Int16, &this->entityMeshDef.texCoordBufferID))
 	{
 		DebugLogError("Couldn't create tex coord attribute buffer for entity mesh def.");
 		this->entityMeshDef.freeBuffers(renderer);
@@ -631,9 +685,12 @@ void RenderChunkManager::shutdown(Renderer &renderer)
 	}
 
 	this->entityLights.clear();
+	this->freeVoxelMeshDefs(renderer);
 	this->voxelTextures.clear();
 	this->chasmFloorTextureLists.clear();
 	this->chasmTextureKeys.clear();
+	this->loadedVoxelTextureDefCount = 0;
+	this->loadedVoxelChasmDefCount = 0;
 	this->entityAnims.clear();
 	this->entityMeshDef.freeBuffers(renderer);
 	this->entityPaletteIndicesTextureRefs.clear();
@@ -654,17 +711,16 @@ ObjectTextureID RenderChunkManager::getVoxelTextureID(const TextureAsset &textur
 	return objectTextureRef.get();
 }
 
-ObjectTextureID RenderChunkManager::getChasmFloorTextureID(const ChunkInt2 &chunkPos, VoxelChunk::ChasmDefID chasmDefID,
-	double chasmAnimPercent) const
+ObjectTextureID RenderChunkManager::getChasmFloorTextureID(VoxelChunk::ChasmDefID chasmDefID, double chasmAnimPercent) const
 {
 	const auto keyIter = std::find_if(this->chasmTextureKeys.begin(), this->chasmTextureKeys.end(),
-		[&chunkPos, chasmDefID](const LoadedChasmTextureKey &key)
+		[chasmDefID](const LoadedChasmTextureKey &key)
 	{
-		return (key.chunkPos == chunkPos) && (key.chasmDefID == chasmDefID);
+		return key.chasmDefID == chasmDefID;
 	});
 
 	DebugAssertMsg(keyIter != this->chasmTextureKeys.end(), "No chasm texture key for chasm def ID \"" +
-		std::to_string(chasmDefID) + "\" in chunk (" + chunkPos.toString() + ").");
+		std::to_string(chasmDefID) + "\".");
 
 	const int floorListIndex = keyIter->chasmFloorListIndex;
 	DebugAssertIndex(this->chasmFloorTextureLists, floorListIndex);
@@ -676,16 +732,16 @@ ObjectTextureID RenderChunkManager::getChasmFloorTextureID(const ChunkInt2 &chun
 	return objectTextureRef.get();
 }
 
-ObjectTextureID RenderChunkManager::getChasmWallTextureID(const ChunkInt2 &chunkPos, VoxelChunk::ChasmDefID chasmDefID) const
+ObjectTextureID RenderChunkManager::getChasmWallTextureID(VoxelChunk::ChasmDefID chasmDefID) const
 {
 	const auto keyIter = std::find_if(this->chasmTextureKeys.begin(), this->chasmTextureKeys.end(),
-		[&chunkPos, chasmDefID](const LoadedChasmTextureKey &key)
+		[chasmDefID](const LoadedChasmTextureKey &key)
 	{
-		return (key.chunkPos == chunkPos) && (key.chasmDefID == chasmDefID);
+		return key.chasmDefID == chasmDefID;
 	});
 
 	DebugAssertMsg(keyIter != this->chasmTextureKeys.end(), "No chasm texture key for chasm def ID \"" +
-		std::to_string(chasmDefID) + "\" in chunk (" + chunkPos.toString() + ").");
+		std::to_string(chasmDefID) + "\".");
 
 	const int wallIndex = keyIter->chasmWallIndex;
 	const LoadedVoxelTexture &voxelTexture = this->voxelTextures[wallIndex];
@@ -726,33 +782,39 @@ BufferView<const RenderDrawCall> RenderChunkManager::getEntityDrawCalls() const
 	return BufferView<const RenderDrawCall>(this->entityDrawCallsCache);
 }
 
-void RenderChunkManager::loadVoxelTextures(const VoxelChunk &voxelChunk, TextureManager &textureManager, Renderer &renderer)
+void RenderChunkManager::loadVoxelTextures(const VoxelDefinitionRegistry &voxelDefRegistry, TextureManager &textureManager,
+	Renderer &renderer)
 {
-	for (int i = 0; i < voxelChunk.getTextureDefCount(); i++)
+	// The registry only grows while a scene is active, so only its newest definitions need loading.
+	for (int i = this->loadedVoxelTextureDefCount; i < voxelDefRegistry.getTextureDefCount(); i++)
 	{
-		const VoxelTextureDefinition &voxelTextureDef = voxelChunk.getTextureDef(i);
+		const VoxelTextureDefinition &voxelTextureDef = voxelDefRegistry.getTextureDef(i);
 		sgTexture::LoadVoxelDefTextures(voxelTextureDef, this->voxelTextures, textureManager, renderer);
 	}
 
-	for (int i = 0; i < voxelChunk.getChasmDefCount(); i++)
+	for (int i = this->loadedVoxelChasmDefCount; i < voxelDefRegistry.getChasmDefCount(); i++)
 	{
 		const VoxelChunk::ChasmDefID chasmDefID = static_cast<VoxelChunk::ChasmDefID>(i);
-		sgTexture::LoadChasmDefTextures(chasmDefID, voxelChunk, this->voxelTextures, this->chasmFloorTextureLists,
+		const ChasmDefinition &chasmDef = voxelDefRegistry.getChasmDef(chasmDefID);
+		sgTexture::LoadChasmDefTextures(chasmDefID, chasmDef, this->voxelTextures, this->chasmFloorTextureLists,
 			this->chasmTextureKeys, textureManager, renderer);
 	}
+
+	this->loadedVoxelTextureDefCount = voxelDefRegistry.getTextureDefCount();
+	this->loadedVoxelChasmDefCount = voxelDefRegistry.getChasmDefCount();
 }
 
-void RenderChunkManager::loadVoxelMeshBuffers(RenderChunk &renderChunk, const VoxelChunk &voxelChunk, double ceilingScale, Renderer &renderer)
+void RenderChunkManager::loadVoxelMeshBuffers(const VoxelDefinitionRegistry &voxelDefRegistry, double ceilingScale, Renderer &renderer)
 {
-	const ChunkInt2 &chunkPos = voxelChunk.getPosition();
-
-	// Add render chunk voxel mesh instances and create mappings to them.
-	for (int meshDefIndex = 0; meshDefIndex < voxelChunk.getMeshDefCount(); meshDefIndex++)
+	// Create buffers once per unique voxel mesh definition. These are shared by all render chunks.
+	for (int meshDefIndex = static_cast<int>(this->voxelMeshDefs.size()); meshDefIndex < voxelDefRegistry.getMeshDefCount(); meshDefIndex++)
 	{
 		const VoxelChunk::VoxelMeshDefID voxelMeshDefID = static_cast<VoxelChunk::VoxelMeshDefID>(meshDefIndex);
-		const VoxelMeshDefinition &voxelMeshDef = voxelChunk.getMeshDef(voxelMeshDefID);
+		const VoxelMeshDefinition &voxelMeshDef = voxelDefRegistry.getMeshDef(voxelMeshDefID);
 
-		RenderVoxelMeshDefinition renderVoxelMeshDef;
+		// Added up front so render mesh def IDs stay equal to voxel mesh def IDs even if buffer creation fails.
+		this->voxelMeshDefs.emplace_back(RenderVoxelMeshDefinition());
+		RenderVoxelMeshDefinition &renderVoxelMeshDef = this->voxelMeshDefs.back();
 		if (!voxelMeshDef.isEmpty()) // Only attempt to create buffers for non-air voxels.
 		{
 			constexpr int positionComponentsPerVertex = MeshUtils::POSITION_COMPONENTS_PER_VERTEX;
@@ -760,25 +822,22 @@ void RenderChunkManager::loadVoxelMeshBuffers(RenderChunk &renderChunk, const Vo
 			constexpr int texCoordComponentsPerVertex = MeshUtils::TEX_COORDS_PER_VERTEX;
 
 			const int vertexCount = voxelMeshDef.rendererVertexCount;
-			if (!renderer.tryCreateVertexBuffer(vertexCount, positionComponentsPerVertex, &renderVoxelMeshDef.vertexBufferID))
+			if (!renderer.tryCreateVertexBuffer(vertexCount, positionComponentsPerVertex, VertexAttributeFormat::Int16, &renderVoxelMeshDef.vertexBufferID))
 			{
-				DebugLogError("Couldn't create vertex buffer for voxel mesh ID " + std::to_string(voxelMeshDefID) +
-					" in chunk (" + voxelChunk.getPosition().toString() + ").");
+				DebugLogError("Couldn't create vertex buffer for voxel mesh ID " + std::to_string(voxelMeshDefID) + ".");
 				continue;
 			}
 
-			if (!renderer.tryCreateAttributeBuffer(vertexCount, normalComponentsPerVertex, &renderVoxelMeshDef.normalBufferID))
+			if (!renderer.tryCreateAttributeBuffer(vertexCount, normalComponentsPerVertex, VertexAttributeFormat::OctahedralInt16, &renderVoxelMeshDef.normalBufferID))
 			{
-				DebugLogError("Couldn't create normal attribute buffer for voxel mesh ID " + std::to_string(voxelMeshDefID) +
-					" in chunk (" + voxelChunk.getPosition().toString() + ").");
+				DebugLogError("Couldn't create normal attribute buffer for voxel mesh ID " + std::to_string(voxelMeshDefID) + ".");
 				renderVoxelMeshDef.freeBuffers(renderer);
 				continue;
 			}
 
-			if (!renderer.tryCreateAttributeBuffer(vertexCount, texCoordComponentsPerVertex, &renderVoxelMeshDef.texCoordBufferID))
+			if (!renderer.tryCreateAttributeBuffer(vertexCount, texCoordComponentsPerVertex, VertexAttributeFormat::Int16, &renderVoxelMeshDef.texCoordBufferID))
 			{
-				DebugLogError("Couldn't create tex coord attribute buffer for voxel mesh ID " + std::to_string(voxelMeshDefID) +
-					" in chunk (" + voxelChunk.getPosition().toString() + ").");
+				DebugLogError("Couldn't create tex coord attribute buffer for voxel mesh ID " + std::to_string(voxelMeshDefID) + ".");
 				renderVoxelMeshDef.freeBuffers(renderer);
 				continue;
 			}
@@ -805,7 +864,7 @@ void RenderChunkManager::loadVoxelMeshBuffers(RenderChunk &renderChunk, const Vo
 				if (!renderer.tryCreateIndexBuffer(opaqueIndexCount, &opaqueIndexBufferID))
 				{
 					DebugLogError("Couldn't create opaque index buffer for voxel mesh ID " +
-						std::to_string(voxelMeshDefID) + " in chunk (" + voxelChunk.getPosition().toString() + ").");
+						std::to_string(voxelMeshDefID) + ".");
 					renderVoxelMeshDef.freeBuffers(renderer);
 					continue;
 				}
@@ -824,7 +883,7 @@ void RenderChunkManager::loadVoxelMeshBuffers(RenderChunk &renderChunk, const Vo
 				if (!renderer.tryCreateIndexBuffer(alphaTestedIndexCount, &renderVoxelMeshDef.alphaTestedIndexBufferID))
 				{
 					DebugLogError("Couldn't create alpha-tested index buffer for voxel mesh ID " +
-						std::to_string(voxelMeshDefID) + " in chunk (" + voxelChunk.getPosition().toString() + ").");
+						std::to_string(voxelMeshDefID) + ".");
 					renderVoxelMeshDef.freeBuffers(renderer);
 					continue;
 				}
@@ -834,11 +893,19 @@ void RenderChunkManager::loadVoxelMeshBuffers(RenderChunk &renderChunk, const Vo
 			}
 		}
 
-		const RenderVoxelMeshDefID renderMeshDefID = renderChunk.addMeshDefinition(std::move(renderVoxelMeshDef));
-		renderChunk.meshDefMappings.emplace(voxelMeshDefID, renderMeshDefID);
 	}
 }
 
+void RenderChunkManager::freeVoxelMeshDefs(Renderer &renderer)
+{
+	for (RenderVoxelMeshDefinition &meshDef : this->voxelMeshDefs)
+	{
+		meshDef.freeBuffers(renderer);
+	}
+
+	this->voxelMeshDefs.clear();
+}
+
 void RenderChunkManager::loadVoxelChasmWall(RenderChunk &renderChunk, const VoxelChunk &voxelChunk, SNInt x, int y, WEInt z)
 {
 	int chasmWallInstIndex;
@@ -921,12 +988,304 @@ void RenderChunkManager::loadEntityTextures(const EntityChunk &entityChunk, cons
 	}
 }
 
-void RenderChunkManager::addVoxelDrawCall(const Double3 &position, const Double3 &preScaleTranslation, const Matrix4d &rotationMatrix,
+void RenderChunkManager::loadVoxelBatchTile(RenderChunk &renderChunk, const VoxelChunk &voxelChunk, int tileX, int tileZ,
+	double ceilingScale, Renderer &renderer)
+{
+	renderChunk.freeBatchTile(tileX, tileZ, renderer);
+	renderChunk.dirtyBatchTiles.set(tileX, tileZ, false);
+
+	struct BatchGeometry
+	{
+		ObjectTextureID textureID;
+		std::vector<double> vertices, normals, texCoords;
+		std::vector<int32_t> indices;
+	};
+
+	std::vector<BatchGeometry> batchGeometries;
+	auto getOrAddBatchGeometry = [&batchGeometries](ObjectTextureID textureID) -> BatchGeometry&
+	{
+		const auto iter = std::find_if(batchGeometries.begin(), batchGeometries.end(),
+			[textureID](const BatchGeometry &batchGeometry)
+		{
+			return batchGeometry.textureID == textureID;
+		});
+
+		if (iter != batchGeometries.end())
+		{
+			return *iter;
+		}
+
+		BatchGeometry &batchGeometry = batchGeometries.emplace_back();
+		batchGeometry.textureID = textureID;
+		return batchGeometry;
+	};
+
+	// Mesh vertex index -> batch vertex index for the current voxel.
+	std::array<int32_t, ArenaMeshUtils::MAX_RENDERER_VERTICES> batchVertexIndices;
+
+	const SNInt startX = tileX * RenderChunk::BATCH_TILE_DIM;
+	const WEInt startZ = tileZ * RenderChunk::BATCH_TILE_DIM;
+	for (WEInt z = startZ; z < (startZ + RenderChunk::BATCH_TILE_DIM); z++)
+	{
+		for (int y = 0; y < voxelChunk.getHeight(); y++)
+		{
+			for (SNInt x = startX; x < (startX + RenderChunk::BATCH_TILE_DIM); x++)
+			{
+				const VoxelChunk::VoxelMeshDefID voxelMeshDefID = voxelChunk.getMeshDefID(x, y, z);
+				const VoxelMeshDefinition &voxelMeshDef = voxelChunk.getMeshDef(voxelMeshDefID);
+				if (voxelMeshDef.isEmpty() || (voxelMeshDef.opaqueIndicesListCount == 0))
+				{
+					continue;
+				}
+
+				// Animating voxels keep their own draw calls.
+				VoxelChunk::DoorDefID doorDefID;
+				VoxelChunk::ChasmDefID chasmDefID;
+				int fadeAnimInstIndex;
+				if (voxelChunk.tryGetDoorDefID(x, y, z, &doorDefID) || voxelChunk.tryGetChasmDefID(x, y, z, &chasmDefID) ||
+					voxelChunk.tryGetFadeAnimInstIndex(x, y, z, &fadeAnimInstIndex))
+				{
+					continue;
+				}
+
+				const VoxelChunk::VoxelTextureDefID voxelTextureDefID = voxelChunk.getTextureDefID(x, y, z);
+				const VoxelChunk::VoxelTraitsDefID voxelTraitsDefID = voxelChunk.getTraitsDefID(x, y, z);
+				const VoxelTextureDefinition &voxelTextureDef = voxelChunk.getTextureDef(voxelTextureDefID);
+				const VoxelTraitsDefinition &voxelTraitsDef = voxelChunk.getTraitsDef(voxelTraitsDefID);
+				const ArenaTypes::VoxelType voxelType = voxelTraitsDef.type;
+
+				// All of the voxel's opaque textures must be loaded for it to be batched.
+				ObjectTextureID textureIDs[RenderVoxelMeshDefinition::MAX_TEXTURES];
+				bool hasAllTextures = true;
+				for (int bufferIndex = 0; bufferIndex < voxelMeshDef.opaqueIndicesListCount; bufferIndex++)
+				{
+					const int textureAssetIndex = sgTexture::GetVoxelOpaqueTextureAssetIndex(voxelType, bufferIndex);
+					const TextureAsset &textureAsset = voxelTextureDef.getTextureAsset(textureAssetIndex);
+					const auto voxelTextureIter = std::find_if(this->voxelTextures.begin(), this->voxelTextures.end(),
+						[&textureAsset](const RenderChunkManager::LoadedVoxelTexture &loadedTexture)
+					{
+						return loadedTexture.textureAsset == textureAsset;
+					});
+
+					if (voxelTextureIter == this->voxelTextures.end())
+					{
+						hasAllTextures = false;
+						break;
+					}
+
+					textureIDs[bufferIndex] = voxelTextureIter->objectTextureRef.get();
+				}
+
+				if (!hasAllTextures)
+				{
+					continue;
+				}
+
+				const VoxelInt3 voxel(x, y, z);
+				const Double3 voxelOffset(static_cast<SNDouble>(x), static_cast<double>(y) * ceilingScale, static_cast<WEDouble>(z));
+				const bool canHideFaces = voxelType == ArenaTypes::VoxelType::Wall;
+
+				for (int bufferIndex = 0; bufferIndex < voxelMeshDef.opaqueIndicesListCount; bufferIndex++)
+				{
+					BatchGeometry &batchGeometry = getOrAddBatchGeometry(textureIDs[bufferIndex]);
+					batchVertexIndices.fill(-1);
+
+					BufferView<const int32_t> indices = voxelMeshDef.getOpaqueIndicesList(bufferIndex);
+					for (int i = 0; i < indices.getCount(); i += 3)
+					{
+						const int32_t triangleIndices[] = { indices[i], indices[i + 1], indices[i + 2] };
+						if (canHideFaces)
+						{
+							const std::optional<Double3> boundaryNormal = sgGeometry::TryGetVoxelBoundaryNormal(
+								voxelMeshDef, triangleIndices[0], triangleIndices[1], triangleIndices[2]);
+							if (boundaryNormal.has_value() && sgGeometry::IsVoxelFaceHidden(voxelChunk, voxel, *boundaryNormal))
+							{
+								continue;
+							}
+						}
+
+						for (const int32_t index : triangleIndices)
+						{
+							int32_t &batchVertexIndex = batchVertexIndices[index];
+							if (batchVertexIndex < 0)
+							{
+								batchVertexIndex = static_cast<int32_t>(batchGeometry.vertices.size() / MeshUtils::POSITION_COMPONENTS_PER_VERTEX);
+
+								// Voxel-local positions are rounded like the unbatched Int16 meshes so shared edges line up.
+								const int positionIndex = index * MeshUtils::POSITION_COMPONENTS_PER_VERTEX;
+								const double srcX = voxelMeshDef.rendererVertices[positionIndex];
+								const double srcY = voxelMeshDef.rendererVertices[positionIndex + 1];
+								const double srcZ = voxelMeshDef.rendererVertices[positionIndex + 2];
+								const double scaledY = MeshUtils::getScaledVertexY(srcY, voxelMeshDef.scaleType, ceilingScale);
+								batchGeometry.vertices.emplace_back(voxelOffset.x + RenderGeometryUtils::quantizeFixedPoint(srcX));
+								batchGeometry.vertices.emplace_back(voxelOffset.y + RenderGeometryUtils::quantizeFixedPoint(scaledY));
+								batchGeometry.vertices.emplace_back(voxelOffset.z + RenderGeometryUtils::quantizeFixedPoint(srcZ));
+
+								const int normalIndex = index * MeshUtils::NORMAL_COMPONENTS_PER_VERTEX;
+								batchGeometry.normals.insert(batchGeometry.normals.end(), voxelMeshDef.rendererNormals.begin() + normalIndex,
+									voxelMeshDef.rendererNormals.begin() + normalIndex + MeshUtils::NORMAL_COMPONENTS_PER_VERTEX);
+
+								const int texCoordIndex = index * MeshUtils::TEX_COORDS_PER_VERTEX;
+								batchGeometry.texCoords.insert(batchGeometry.texCoords.end(), voxelMeshDef.rendererTexCoords.begin() + texCoordIndex,
+									voxelMeshDef.rendererTexCoords.begin() + texCoordIndex + MeshUtils::TEX_COORDS_PER_VERTEX);
+							}
+
+							batchGeometry.indices.emplace_back(batchVertexIndex);
+						}
+					}
+				}
+
+				renderChunk.batchedVoxels.set(x, y, z, true);
+			}
+		}
+	}
+
+	std::vector<RenderVoxelBatch> &batches = renderChunk.batchTiles.get(tileX, tileZ);
+	for (const BatchGeometry &batchGeometry : batchGeometries)
+	{
+		if (batchGeometry.indices.empty())
+		{
+			continue;
+		}
+
+		RenderVoxelBatch batch;
+		batch.textureID = batchGeometry.textureID;
+
+		RenderVoxelMeshDefinition &meshDef = batch.meshDef;
+		const int vertexCount = static_cast<int>(batchGeometry.vertices.size()) / MeshUtils::POSITION_COMPONENTS_PER_VERTEX;
+		const int indexCount = static_cast<int>(batchGeometry.indices.size());
+		// Positions are Float32 since a ceiling-scaled voxel offset in Y isn't a whole number of 1/256 steps, so
+		// Int16 would round it differently than unbatched draw calls. X and Z are exact (whole voxels plus 1/256
+		// steps); Y can differ by float rounding, far below one step.
+		if (!renderer.tryCreateVertexBuffer(vertexCount, MeshUtils::POSITION_COMPONENTS_PER_VERTEX, VertexAttributeFormat::Float32, &meshDef.vertexBufferID) ||
+			!renderer.tryCreateAttributeBuffer(vertexCount, MeshUtils::NORMAL_COMPONENTS_PER_VERTEX, VertexAttributeFormat::OctahedralInt16, &meshDef.normalBufferID) ||
+			!renderer.tryCreateAttributeBuffer(vertexCount, MeshUtils::TEX_COORDS_PER_VERTEX, VertexAttributeFormat::Int16, &meshDef.texCoordBufferID) ||
+			!renderer.tryCreateIndexBuffer(indexCount, &meshDef.opaqueIndexBufferIDs[0]))
+		{
+			DebugLogError("Couldn't create batch buffers for tile (" + std::to_string(tileX) + ", " + std::to_string(tileZ) +
+				") in chunk (" + renderChunk.getPosition().toString() + ").");
+			meshDef.opaqueIndexBufferIdCount = (meshDef.opaqueIndexBufferIDs[0] >= 0) ? 1 : 0;
+			meshDef.freeBuffers(renderer);
+
+			// Fall back to per-voxel draw calls for the whole tile.
+			renderChunk.freeBatchTile(tileX, tileZ, renderer);
+			return;
+		}
+
+		meshDef.opaqueIndexBufferIdCount = 1;
+
+		renderer.populateVertexBuffer(meshDef.vertexBufferID, batchGeometry.vertices);
+		renderer.populateAttributeBuffer(meshDef.normalBufferID, batchGeometry.normals);
+		renderer.populateAttributeBuffer(meshDef.texCoordBufferID, batchGeometry.texCoords);
+		renderer.populateIndexBuffer(meshDef.opaqueIndexBufferIDs[0], batchGeometry.indices);
+
+		batches.emplace_back(std::move(batch));
+	}
+}
+
+bool RenderChunkManager::loadVoxelBatchTiles(RenderChunk &renderChunk, const VoxelChunk &voxelChunk, double ceilingScale,
+	bool batchStaticGeometry, Renderer &renderer)
+{
+	if (renderChunk.isBatchingEnabled != batchStaticGeometry)
+	{
+		renderChunk.isBatchingEnabled = batchStaticGeometry;
+		renderChunk.setAllBatchTilesDirty();
+	}
+
+	bool anyTileChanged = false;
+	for (int tileZ = 0; tileZ < RenderChunk::BATCH_TILE_COUNT_PER_SIDE; tileZ++)
+	{
+		for (int tileX = 0; tileX < RenderChunk::BATCH_TILE_COUNT_PER_SIDE; tileX++)
+		{
+			if (!renderChunk.dirtyBatchTiles.get(tileX, tileZ))
+			{
+				continue;
+			}
+
+			if (batchStaticGeometry)
+			{
+				this->loadVoxelBatchTile(renderChunk, voxelChunk, tileX, tileZ, ceilingScale, renderer);
+			}
+			else
+			{
+				renderChunk.freeBatchTile(tileX, tileZ, renderer);
+				renderChunk.dirtyBatchTiles.set(tileX, tileZ, false);
+			}
+
+			anyTileChanged = true;
+		}
+	}
+
+	return anyTileChanged;
+}
+
+void RenderChunkManager::loadVoxelBatchDrawCalls(RenderChunk &renderChunk)
+{
+	const WorldInt2 chunkOriginXZ = VoxelUtils::chunkVoxelToWorldVoxel(renderChunk.getPosition(), VoxelInt2::Zero);
+	const Double3 chunkOrigin(static_cast<SNDouble>(chunkOriginXZ.x), 0.0, static_cast<WEDouble>(chunkOriginXZ.y));
+
+	for (int tileZ = 0; tileZ < RenderChunk::BATCH_TILE_COUNT_PER_SIDE; tileZ++)
+	{
+		for (int tileX = 0; tileX < RenderChunk::BATCH_TILE_COUNT_PER_SIDE; tileX++)
+		{
+			const std::vector<RenderVoxelBatch> &batches = renderChunk.batchTiles.get(tileX, tileZ);
+			if (batches.empty())
+			{
+				continue;
+			}
+
+			// Lights touching any batched voxel in the tile, up to the draw call limit.
+			const SNInt startX = tileX * RenderChunk::BATCH_TILE_DIM;
+			const WEInt startZ = tileZ * RenderChunk::BATCH_TILE_DIM;
+			RenderVoxelLightIdList tileLightIdList;
+			for (WEInt z = startZ; z < (startZ + RenderChunk::BATCH_TILE_DIM); z++)
+			{
+				for (int y = 0; y < renderChunk.batchedVoxels.getHeight(); y++)
+				{
+					for (SNInt x = startX; x < (startX + RenderChunk::BATCH_TILE_DIM); x++)
+					{
+						if (!renderChunk.batchedVoxels.get(x, y, z))
+						{
+							continue;
+						}
+
+						const RenderVoxelLightIdList &voxelLightIdList = renderChunk.voxelLightIdLists.get(x, y, z);
+						for (const RenderLightID lightID : voxelLightIdList.getLightIDs())
+						{
+							BufferView<RenderLightID> tileLightIDs = tileLightIdList.getLightIDs();
+							if (std::find(tileLightIDs.begin(), tileLightIDs.end(), lightID) == tileLightIDs.end())
+							{
+								tileLightIdList.tryAddLight(lightID);
+							}
+						}
+					}
+				}
+			}
+
+			const BufferView<const RenderLightID> tileLightIDs(tileLightIdList.lightIDs, tileLightIdList.lightCount);
+			const VoxelInt3 tileVoxel(startX, 0, startZ);
+			for (const RenderVoxelBatch &batch : batches)
+			{
+				const RenderVoxelMeshDefinition &meshDef = batch.meshDef;
+				constexpr TextureSamplingType textureSamplingType = TextureSamplingType::Default;
+				constexpr double meshLightPercent = 0.0;
+				constexpr double pixelShaderParam0 = 0.0;
+				this->addVoxelDrawCall(tileVoxel, chunkOrigin, Double3::Zero, Matrix4d::identity(), Matrix4d::identity(),
+					meshDef.vertexBufferID, meshDef.normalBufferID, meshDef.texCoordBufferID, meshDef.opaqueIndexBufferIDs[0],
+					batch.textureID, std::nullopt, textureSamplingType, textureSamplingType, RenderLightingType::PerPixel,
+					meshLightPercent, tileLightIDs, VertexShaderType::Voxel, PixelShaderType::Opaque,
+					pixelShaderParam0, renderChunk.batchDrawCalls, renderChunk.batchDrawCallVoxels);
+			}
+		}
+	}
+}
+
+void RenderChunkManager::addVoxelDrawCall(const VoxelInt3 &voxel, const Double3 &position, const Double3 &preScaleTranslation, const Matrix4d &rotationMatrix,
 	const Matrix4d &scaleMatrix, VertexBufferID vertexBufferID, AttributeBufferID normalBufferID, AttributeBufferID texCoordBufferID,
 	IndexBufferID indexBufferID, ObjectTextureID textureID0, const std::optional<ObjectTextureID> &textureID1,
 	TextureSamplingType textureSamplingType0, TextureSamplingType textureSamplingType1, RenderLightingType lightingType,
 	double meshLightPercent, BufferView<const RenderLightID> lightIDs, VertexShaderType vertexShaderType, PixelShaderType pixelShaderType,
-	double pixelShaderParam0, std::vector<RenderDrawCall> &drawCalls)
+	double pixelShaderParam0, std::vector<RenderDrawCall> &drawCalls, std::vector<VoxelInt3> &drawCallVoxels)
 {
 	RenderDrawCall drawCall;
 	drawCall.position = position;
@@ -953,6 +1312,7 @@ void RenderChunkManager::addVoxelDrawCall(const Double3 &position, const Double3
 	drawCall.pixelShaderParam0 = pixelShaderParam0;
 
 	drawCalls.emplace_back(std::move(drawCall));
+	drawCallVoxels.emplace_back(voxel);
 }
 
 void RenderChunkManager::loadVoxelDrawCalls(RenderChunk &renderChunk, const VoxelChunk &voxelChunk, double ceilingScale,
@@ -980,12 +1340,11 @@ void RenderChunkManager::loadVoxelDrawCalls(RenderChunk &renderChunk, const Voxe
 				const VoxelTextureDefinition &voxelTextureDef = voxelChunk.getTextureDef(voxelTextureDefID);
 				const VoxelTraitsDefinition &voxelTraitsDef = voxelChunk.getTraitsDef(voxelTraitsDefID);
 
-				const auto defIter = renderChunk.meshDefMappings.find(voxelMeshDefID);
-				DebugAssert(defIter != renderChunk.meshDefMappings.end());
-				const RenderVoxelMeshDefID renderMeshDefID = defIter->second;
+				const RenderVoxelMeshDefID renderMeshDefID = voxelMeshDefID;
+				DebugAssertIndex(this->voxelMeshDefs, renderMeshDefID);
 				renderChunk.meshDefIDs.set(x, y, z, renderMeshDefID);
 
-				const RenderVoxelMeshDefinition &renderMeshDef = renderChunk.meshDefs[renderMeshDefID];
+				const RenderVoxelMeshDefinition &renderMeshDef = this->voxelMeshDefs[renderMeshDefID];
 
 				// Convert voxel XYZ to world space.
 				const WorldInt2 worldXZ = VoxelUtils::chunkVoxelToWorldVoxel(chunkPos, VoxelInt2(x, z));
@@ -1015,7 +1374,8 @@ void RenderChunkManager::loadVoxelDrawCalls(RenderChunk &renderChunk, const Voxe
 				const RenderVoxelLightIdList &voxelLightIdList = renderChunk.voxelLightIdLists.get(x, y, z);
 
 				const bool canAnimate = isDoor || isChasm || isFading;
-				if ((!canAnimate && updateStatics) || (canAnimate && updateAnimating))
+				const bool isBatched = renderChunk.batchedVoxels.get(x, y, z);
+				if ((!canAnimate && updateStatics && !isBatched) || (canAnimate && updateAnimating))
 				{
 					for (int bufferIndex = 0; bufferIndex < renderMeshDef.opaqueIndexBufferIdCount; bufferIndex++)
 					{
@@ -1041,7 +1401,7 @@ void RenderChunkManager::loadVoxelDrawCalls(RenderChunk &renderChunk, const Voxe
 						}
 						else
 						{
-							textureID = this->getChasmFloorTextureID(chunkPos, chasmDefID, chasmAnimPercent);
+							textureID = this->getChasmFloorTextureID(chasmDefID, chasmAnimPercent);
 						}
 
 						if (textureID < 0)
@@ -1064,6 +1424,7 @@ void RenderChunkManager::loadVoxelDrawCalls(RenderChunk &renderChunk, const Voxe
 						}
 
 						std::vector<RenderDrawCall> *drawCallsPtr = nullptr;
+						std::vector<VoxelInt3> *drawCallVoxelsPtr = nullptr;
 						if (isChasm)
 						{
 							const ChasmDefinition &chasmDef = voxelChunk.getChasmDef(chasmDefID);
@@ -1074,22 +1435,25 @@ void RenderChunkManager::loadVoxelDrawCalls(RenderChunk &renderChunk, const Voxe
 							}
 
 							drawCallsPtr = &renderChunk.chasmDrawCalls;
+							drawCallVoxelsPtr = &renderChunk.chasmDrawCallVoxels;
 						}
 						else if (isFading)
 						{
 							drawCallsPtr = &renderChunk.fadingDrawCalls;
+							drawCallVoxelsPtr = &renderChunk.fadingDrawCallVoxels;
 						}
 						else
 						{
 							drawCallsPtr = &renderChunk.staticDrawCalls;
+							drawCallVoxelsPtr = &renderChunk.staticDrawCallVoxels;
 						}
 
 						const PixelShaderType pixelShaderType = PixelShaderType::Opaque;
 						const double pixelShaderParam0 = 0.0;
-						this->addVoxelDrawCall(worldPos, preScaleTranslation, rotationMatrix, scaleMatrix, renderMeshDef.vertexBufferID,
+						this->addVoxelDrawCall(voxel, worldPos, preScaleTranslation, rotationMatrix, scaleMatrix, renderMeshDef.vertexBufferID,
 							renderMeshDef.normalBufferID, renderMeshDef.texCoordBufferID, opaqueIndexBufferID, textureID, std::nullopt,
 							textureSamplingType, textureSamplingType, lightingType, meshLightPercent, voxelLightIdList.getLightIDs(),
-							VertexShaderType::Voxel, pixelShaderType, pixelShaderParam0, *drawCallsPtr);
+							VertexShaderType::Voxel, pixelShaderType, pixelShaderParam0, *drawCallsPtr, *drawCallVoxelsPtr);
 					}
 				}
 
@@ -1187,11 +1551,11 @@ void RenderChunkManager::loadVoxelDrawCalls(RenderChunk &renderChunk, const Voxe
 									const TextureSamplingType textureSamplingType = TextureSamplingType::Default;
 									constexpr double meshLightPercent = 0.0;
 									constexpr double pixelShaderParam0 = 0.0;
-									this->addVoxelDrawCall(doorHingePosition, doorPreScaleTranslation, doorRotationMatrix, doorScaleMatrix,
+									this->addVoxelDrawCall(voxel, doorHingePosition, doorPreScaleTranslation, doorRotationMatrix, doorScaleMatrix,
 										renderMeshDef.vertexBufferID, renderMeshDef.normalBufferID, renderMeshDef.texCoordBufferID,
 										renderMeshDef.alphaTestedIndexBufferID, textureID, std::nullopt, textureSamplingType, textureSamplingType,
 										RenderLightingType::PerPixel, meshLightPercent, voxelLightIdList.getLightIDs(), VertexShaderType::SwingingDoor,
-										PixelShaderType::AlphaTested, pixelShaderParam0, renderChunk.doorDrawCalls);
+										PixelShaderType::AlphaTested, pixelShaderParam0, renderChunk.doorDrawCalls, renderChunk.doorDrawCallVoxels);
 								}
 
 								break;
@@ -1217,11 +1581,11 @@ void RenderChunkManager::loadVoxelDrawCalls(RenderChunk &renderChunk, const Voxe
 									const TextureSamplingType textureSamplingType = TextureSamplingType::Default;
 									constexpr double meshLightPercent = 0.0;
 									const double pixelShaderParam0 = uMin;
-									this->addVoxelDrawCall(doorHingePosition, doorPreScaleTranslation, doorRotationMatrix, doorScaleMatrix,
+									this->addVoxelDrawCall(voxel, doorHingePosition, doorPreScaleTranslation, doorRotationMatrix, doorScaleMatrix,
 										renderMeshDef.vertexBufferID, renderMeshDef.normalBufferID, renderMeshDef.texCoordBufferID,
 										renderMeshDef.alphaTestedIndexBufferID, textureID, std::nullopt, textureSamplingType, textureSamplingType,
 										RenderLightingType::PerPixel, meshLightPercent, voxelLightIdList.getLightIDs(), VertexShaderType::SlidingDoor,
-										PixelShaderType::AlphaTestedWithVariableTexCoordUMin, pixelShaderParam0, renderChunk.doorDrawCalls);
+										PixelShaderType::AlphaTestedWithVariableTexCoordUMin, pixelShaderParam0, renderChunk.doorDrawCalls, renderChunk.doorDrawCallVoxels);
 								}
 
 								break;
@@ -1248,11 +1612,11 @@ void RenderChunkManager::loadVoxelDrawCalls(RenderChunk &renderChunk, const Voxe
 									const TextureSamplingType textureSamplingType = TextureSamplingType::Default;
 									constexpr double meshLightPercent = 0.0;
 									const double pixelShaderParam0 = vMin;
-									this->addVoxelDrawCall(doorHingePosition, doorPreScaleTranslation, doorRotationMatrix, doorScaleMatrix,
+									this->addVoxelDrawCall(voxel, doorHingePosition, doorPreScaleTranslation, doorRotationMatrix, doorScaleMatrix,
 										renderMeshDef.vertexBufferID, renderMeshDef.normalBufferID, renderMeshDef.texCoordBufferID,
 										renderMeshDef.alphaTestedIndexBufferID, textureID, std::nullopt, textureSamplingType, textureSamplingType,
 										RenderLightingType::PerPixel, meshLightPercent, voxelLightIdList.getLightIDs(), VertexShaderType::RaisingDoor,
-										PixelShaderType::AlphaTestedWithVariableTexCoordVMin, pixelShaderParam0, renderChunk.doorDrawCalls);
+										PixelShaderType::AlphaTestedWithVariableTexCoordVMin, pixelShaderParam0, renderChunk.doorDrawCalls, renderChunk.doorDrawCallVoxels);
 								}
 
 								break;
@@ -1275,18 +1639,20 @@ void RenderChunkManager::loadVoxelDrawCalls(RenderChunk &renderChunk, const Voxe
 							RenderLightingType lightingType = RenderLightingType::PerPixel;
 							double meshLightPercent = 0.0;
 							std::vector<RenderDrawCall> *drawCallsPtr = &renderChunk.staticDrawCalls;
+							std::vector<VoxelInt3> *drawCallVoxelsPtr = &renderChunk.staticDrawCallVoxels;
 							if (isFading)
 							{
 								lightingType = RenderLightingType::PerMesh;
 								meshLightPercent = std::clamp(1.0 - fadeAnimInst->percentFaded, 0.0, 1.0);
 								drawCallsPtr = &renderChunk.fadingDrawCalls;
+								drawCallVoxelsPtr = &renderChunk.fadingDrawCallVoxels;
 							}
 
 							constexpr double pixelShaderParam0 = 0.0;
-							this->addVoxelDrawCall(worldPos, preScaleTranslation, rotationMatrix, scaleMatrix, renderMeshDef.vertexBufferID,
+							this->addVoxelDrawCall(voxel, worldPos, preScaleTranslation, rotationMatrix, scaleMatrix, renderMeshDef.vertexBufferID,
 								renderMeshDef.normalBufferID, renderMeshDef.texCoordBufferID, renderMeshDef.alphaTestedIndexBufferID,
 								textureID, std::nullopt, textureSamplingType, textureSamplingType, lightingType, meshLightPercent,
-								voxelLightIdList.getLightIDs(), VertexShaderType::Voxel, PixelShaderType::AlphaTested, pixelShaderParam0, *drawCallsPtr);
+								voxelLightIdList.getLightIDs(), VertexShaderType::Voxel, PixelShaderType::AlphaTested, pixelShaderParam0, *drawCallsPtr, *drawCallVoxelsPtr);
 						}
 					}
 				}
@@ -1302,8 +1668,8 @@ void RenderChunkManager::loadVoxelDrawCalls(RenderChunk &renderChunk, const Voxe
 						const IndexBufferID chasmWallIndexBufferID = chasmWallIter->second;
 
 						// Need to give two textures since chasm walls are multi-textured.
-						ObjectTextureID textureID0 = this->getChasmFloorTextureID(chunkPos, chasmDefID, chasmAnimPercent);
-						ObjectTextureID textureID1 = this->getChasmWallTextureID(chunkPos, chasmDefID);
+						ObjectTextureID textureID0 = this->getChasmFloorTextureID(chasmDefID, chasmAnimPercent);
+						ObjectTextureID textureID1 = this->getChasmWallTextureID(chasmDefID);
 
 						const Double3 preScaleTranslation = Double3::Zero;
 						const Matrix4d rotationMatrix = Matrix4d::identity();
@@ -1319,10 +1685,10 @@ void RenderChunkManager::loadVoxelDrawCalls(RenderChunk &renderChunk, const Voxe
 						}
 
 						constexpr double pixelShaderParam0 = 0.0;
-						this->addVoxelDrawCall(worldPos, preScaleTranslation, rotationMatrix, scaleMatrix, renderMeshDef.vertexBufferID,
+						this->addVoxelDrawCall(voxel, worldPos, preScaleTranslation, rotationMatrix, scaleMatrix, renderMeshDef.vertexBufferID,
 							renderMeshDef.normalBufferID, renderMeshDef.texCoordBufferID, chasmWallIndexBufferID, textureID0, textureID1,
 							textureSamplingType, textureSamplingType, lightingType, meshLightPercent, voxelLightIdList.getLightIDs(),
-							VertexShaderType::Voxel, PixelShaderType::OpaqueWithAlphaTestLayer, pixelShaderParam0, renderChunk.chasmDrawCalls);
+							VertexShaderType::Voxel, PixelShaderType::OpaqueWithAlphaTestLayer, pixelShaderParam0, renderChunk.chasmDrawCalls, renderChunk.chasmDrawCallVoxels);
 					}
 				}
 			}
@@ -1336,6 +1702,10 @@ void RenderChunkManager::rebuildVoxelChunkDrawCalls(RenderChunk &renderChunk, co
 	if (updateStatics)
 	{
 		renderChunk.staticDrawCalls.clear();
+		renderChunk.staticDrawCallVoxels.clear();
+		renderChunk.batchDrawCalls.clear();
+		renderChunk.batchDrawCallVoxels.clear();
+		this->loadVoxelBatchDrawCalls(renderChunk);
 	}
 
 	if (updateAnimating)
@@ -1343,27 +1713,70 @@ void RenderChunkManager::rebuildVoxelChunkDrawCalls(RenderChunk &renderChunk, co
 		renderChunk.doorDrawCalls.clear();
 		renderChunk.chasmDrawCalls.clear();
 		renderChunk.fadingDrawCalls.clear();
+		renderChunk.doorDrawCallVoxels.clear();
+		renderChunk.chasmDrawCallVoxels.clear();
+		renderChunk.fadingDrawCallVoxels.clear();
 	}
 
 	this->loadVoxelDrawCalls(renderChunk, voxelChunk, ceilingScale, chasmAnimPercent, updateStatics, updateAnimating);
 }
 
-void RenderChunkManager::rebuildVoxelDrawCallsList()
+void RenderChunkManager::rebuildVoxelDrawCallsList(const VoxelVisibilityChunkManager &voxelVisChunkManager)
 {
 	this->voxelDrawCallsCache.clear();
 
+	auto addVisibleDrawCalls = [this](BufferView<const RenderDrawCall> drawCalls, BufferView<const VoxelInt3> drawCallVoxels,
+		const VoxelVisibilityChunk &visChunk)
+	{
+		DebugAssert(drawCalls.getCount() == drawCallVoxels.getCount());
+		for (int i = 0; i < drawCalls.getCount(); i++)
+		{
+			const VoxelInt3 &voxel = drawCallVoxels[i];
+			if (visChunk.insideFrustumTests.get(voxel.x, voxel.y, voxel.z))
+			{
+				this->voxelDrawCallsCache.emplace_back(drawCalls[i]);
+			}
+		}
+	};
+
+	auto addVisibleBatchDrawCalls = [this](BufferView<const RenderDrawCall> drawCalls, BufferView<const VoxelInt3> drawCallVoxels,
+		const VoxelVisibilityChunk &visChunk)
+	{
+		DebugAssert(drawCalls.getCount() == drawCallVoxels.getCount());
+		for (int i = 0; i < drawCalls.getCount(); i++)
+		{
+			// Visible if any column in the tile is.
+			const VoxelInt3 &tileVoxel = drawCallVoxels[i];
+			bool isTileVisible = false;
+			for (WEInt z = tileVoxel.z; (z < (tileVoxel.z + RenderChunk::BATCH_TILE_DIM)) && !isTileVisible; z++)
+			{
+				for (SNInt x = tileVoxel.x; x < (tileVoxel.x + RenderChunk::BATCH_TILE_DIM); x++)
+				{
+					if (visChunk.insideFrustumTests.get(x, 0, z))
+					{
+						isTileVisible = true;
+						break;
+					}
+				}
+			}
+
+			if (isTileVisible)
+			{
+				this->voxelDrawCallsCache.emplace_back(drawCalls[i]);
+			}
+		}
+	};
+
 	// @todo: eventually this should sort by distance from a CoordDouble2
 	for (size_t i = 0; i < this->activeChunks.size(); i++)
 	{
 		const ChunkPtr &chunkPtr = this->activeChunks[i];
-		BufferView<const RenderDrawCall> staticDrawCalls = chunkPtr->staticDrawCalls;
-		BufferView<const RenderDrawCall> doorDrawCalls = chunkPtr->doorDrawCalls;
-		BufferView<const RenderDrawCall> chasmDrawCalls = chunkPtr->chasmDrawCalls;
-		BufferView<const RenderDrawCall> fadingDrawCalls = chunkPtr->fadingDrawCalls;
-		this->voxelDrawCallsCache.insert(this->voxelDrawCallsCache.end(), staticDrawCalls.begin(), staticDrawCalls.end());
-		this->voxelDrawCallsCache.insert(this->voxelDrawCallsCache.end(), doorDrawCalls.begin(), doorDrawCalls.end());
-		this->voxelDrawCallsCache.insert(this->voxelDrawCallsCache.end(), chasmDrawCalls.begin(), chasmDrawCalls.end());
-		this->voxelDrawCallsCache.insert(this->voxelDrawCallsCache.end(), fadingDrawCalls.begin(), fadingDrawCalls.end());
+		const VoxelVisibilityChunk &visChunk = voxelVisChunkManager.getChunkAtPosition(chunkPtr->getPosition());
+		addVisibleBatchDrawCalls(chunkPtr->batchDrawCalls, chunkPtr->batchDrawCallVoxels, visChunk);
+		addVisibleDrawCalls(chunkPtr->staticDrawCalls, chunkPtr->staticDrawCallVoxels, visChunk);
+		addVisibleDrawCalls(chunkPtr->doorDrawCalls, chunkPtr->doorDrawCallVoxels, visChunk);
+		addVisibleDrawCalls(chunkPtr->chasmDrawCalls, chunkPtr->chasmDrawCallVoxels, visChunk);
+		addVisibleDrawCalls(chunkPtr->fadingDrawCalls, chunkPtr->fadingDrawCallVoxels, visChunk);
 	}
 }
 
@@ -1399,7 +1812,7 @@ void RenderChunkManager::addEntityDrawCall(const Double3 &position, const Matrix
 }
 
 void RenderChunkManager::rebuildEntityChunkDrawCalls(RenderChunk &renderChunk, const EntityChunk &entityChunk,
-	const CoordDouble2 &cameraCoordXZ, const Matrix4d &rotationMatrix, double ceilingScale,
+	const CoordDouble2 &cameraCoordXZ, const Matrix4d &rotationMatrix, double ceilingScale, double simulationPercent,
 	const VoxelChunkManager &voxelChunkManager, const EntityChunkManager &entityChunkManager)
 {
 	renderChunk.entityDrawCalls.clear();
@@ -1420,8 +1833,11 @@ void RenderChunkManager::rebuildEntityChunkDrawCalls(RenderChunk &renderChunk, c
 		DebugAssertIndex(animDef.keyframes, linearizedKeyframeIndex);
 		const EntityAnimationDefinitionKeyframe &keyframe = animDef.keyframes[linearizedKeyframeIndex];
 
-		// Convert entity XYZ to world space.
-		const Double3 worldPos = VoxelUtils::coordToWorldPoint(visState.flatPosition);
+		// Convert entity XYZ to world space, drawing moving entities between their last two simulation states.
+		const CoordDouble2 interpolatedEntityCoord = entityChunkManager.getEntityInterpolatedPosition(entityInst.positionID, simulationPercent);
+		const VoxelDouble2 interpolationOffset = interpolatedEntityCoord - entityCoord;
+		const Double3 worldPos = VoxelUtils::coordToWorldPoint(visState.flatPosition) +
+			Double3(interpolationOffset.x, 0.0, interpolationOffset.y);
 		const Matrix4d scaleMatrix = Matrix4d::scale(1.0, keyframe.height, keyframe.width);
 
 		const ObjectTextureID textureID0 = this->getEntityTextureID(entityInstID, cameraCoordXZ, entityChunkManager);
@@ -1496,14 +1912,18 @@ void RenderChunkManager::updateActiveChunks(BufferView<const ChunkInt2> newChunk
 
 void RenderChunkManager::updateVoxels(BufferView<const ChunkInt2> activeChunkPositions, BufferView<const ChunkInt2> newChunkPositions,
 	double ceilingScale, double chasmAnimPercent, const VoxelChunkManager &voxelChunkManager,
-	const VoxelVisibilityChunkManager &voxelVisChunkManager, TextureManager &textureManager, Renderer &renderer)
+	const VoxelVisibilityChunkManager &voxelVisChunkManager, bool batchStaticGeometry, TextureManager &textureManager,
+	Renderer &renderer)
 {
+	// New chunks might have added voxel definitions to the shared registry.
+	const VoxelDefinitionRegistry &voxelDefRegistry = voxelChunkManager.getDefRegistry();
+	this->loadVoxelTextures(voxelDefRegistry, textureManager, renderer);
+	this->loadVoxelMeshBuffers(voxelDefRegistry, ceilingScale, renderer);
+
 	for (const ChunkInt2 &chunkPos : newChunkPositions)
 	{
 		RenderChunk &renderChunk = this->getChunkAtPosition(chunkPos);
 		const VoxelChunk &voxelChunk = voxelChunkManager.getChunkAtPosition(chunkPos);
-		this->loadVoxelTextures(voxelChunk, textureManager, renderer);
-		this->loadVoxelMeshBuffers(renderChunk, voxelChunk, ceilingScale, renderer);
 		this->loadVoxelChasmWalls(renderChunk, voxelChunk);
 		this->rebuildVoxelChunkDrawCalls(renderChunk, voxelChunk, ceilingScale, chasmAnimPercent, true, false);
 	}
@@ -1522,7 +1942,20 @@ void RenderChunkManager::updateVoxels(BufferView<const ChunkInt2> activeChunkPos
 		BufferView<const VoxelInt3> dirtyMeshDefPositions = voxelChunk.getDirtyMeshDefPositions();
 		BufferView<const VoxelInt3> dirtyFadeAnimInstPositions = voxelChunk.getDirtyFadeAnimInstPositions();
 		BufferView<const VoxelInt3> dirtyLightPositions = renderChunk.dirtyLightPositions;
+		for (const VoxelInt3 &position : dirtyMeshDefPositions)
+		{
+			renderChunk.addDirtyBatchTiles(position);
+		}
+
+		for (const VoxelInt3 &position : dirtyFadeAnimInstPositions)
+		{
+			renderChunk.addDirtyBatchTiles(position);
+		}
+
+		const bool anyBatchTileChanged = this->loadVoxelBatchTiles(renderChunk, voxelChunk, ceilingScale, batchStaticGeometry, renderer);
+
 		bool updateStatics = dirtyMeshDefPositions.getCount() > 0;
+		updateStatics |= anyBatchTileChanged;
 		updateStatics |= dirtyFadeAnimInstPositions.getCount() > 0; // @temp fix for fading voxels being covered by their non-fading draw call
 		updateStatics |= dirtyLightPositions.getCount() > 0; // @temp fix for player light movement, eventually other moving lights too
 		this->rebuildVoxelChunkDrawCalls(renderChunk, voxelChunk, ceilingScale, chasmAnimPercent, updateStatics, true);
@@ -1531,14 +1964,14 @@ void RenderChunkManager::updateVoxels(BufferView<const ChunkInt2> activeChunkPos
 	// @todo: only rebuild if needed; currently we assume that all scenes in the game have some kind of animating chasms/etc., which is inefficient
 	//if ((freedChunkCount > 0) || (newChunkCount > 0))
 	{
-		this->rebuildVoxelDrawCallsList();
+		this->rebuildVoxelDrawCallsList(voxelVisChunkManager);
 	}
 }
 
 void RenderChunkManager::updateEntities(BufferView<const ChunkInt2> activeChunkPositions,
 	BufferView<const ChunkInt2> newChunkPositions, const CoordDouble2 &cameraCoordXZ, const VoxelDouble2 &cameraDirXZ,
-	double ceilingScale, const VoxelChunkManager &voxelChunkManager, const EntityChunkManager &entityChunkManager,
-	TextureManager &textureManager, Renderer &renderer)
+	double ceilingScale, double simulationPercent, const VoxelChunkManager &voxelChunkManager,
+	const EntityChunkManager &entityChunkManager, TextureManager &textureManager, Renderer &renderer)
 {
 	for (const EntityInstanceID entityInstID : entityChunkManager.getQueuedDestroyEntityIDs())
 	{
@@ -1568,7 +2001,7 @@ void RenderChunkManager::updateEntities(BufferView<const ChunkInt2> activeChunkP
 		RenderChunk &renderChunk = this->getChunkAtPosition(chunkPos);
 		const EntityChunk &entityChunk = entityChunkManager.getChunkAtPosition(chunkPos);
 		this->rebuildEntityChunkDrawCalls(renderChunk, entityChunk, cameraCoordXZ, rotationMatrix, ceilingScale,
-			voxelChunkManager, entityChunkManager);
+			simulationPercent, voxelChunkManager, entityChunkManager);
 	}
 
 	this->rebuildEntityDrawCallsList();
@@ -1798,9 +2231,12 @@ void RenderChunkManager::cleanUp()
 
 void RenderChunkManager::unloadScene(Renderer &renderer)
 {
+	this->freeVoxelMeshDefs(renderer);
 	this->voxelTextures.clear();
 	this->chasmFloorTextureLists.clear();
 	this->chasmTextureKeys.clear();
+	this->loadedVoxelTextureDefCount = 0;
+	this->loadedVoxelChasmDefCount = 0;
 	this->entityAnims.clear();
 	this->entityPaletteIndicesTextureRefs.clear();
 
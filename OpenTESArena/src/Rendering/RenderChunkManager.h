@@ -59,12 +59,11 @@ public:
 
 	struct LoadedChasmTextureKey
 	{
-		ChunkInt2 chunkPos;
 		VoxelChunk::ChasmDefID chasmDefID;
 		int chasmFloorListIndex;
 		int chasmWallIndex; // Points into voxel textures.
 
-		void init(const ChunkInt2 &chunkPos, VoxelChunk::ChasmDefID chasmDefID, int chasmFloorListIndex, int chasmWallIndex);
+		void init(VoxelChunk::ChasmDefID chasmDefID, int chasmFloorListIndex, int chasmWallIndex);
 	};
 
 	struct LoadedEntityAnimation
@@ -91,6 +90,9 @@ private:
 	std::vector<LoadedVoxelTexture> voxelTextures; // Includes chasm walls.
 	std::vector<LoadedChasmFloorTextureList> chasmFloorTextureLists;
 	std::vector<LoadedChasmTextureKey> chasmTextureKeys; // Points into floor lists and wall textures.
+	int loadedVoxelTextureDefCount, loadedVoxelChasmDefCount; // Registry definitions with loaded textures.
+
+	std::vector<RenderVoxelMeshDefinition> voxelMeshDefs; // Shared by all render chunks, one per voxel definition registry mesh def.
 
 	std::vector<LoadedEntityAnimation> entityAnims;
 	RenderEntityMeshDefinition entityMeshDef; // Shared by all entities.
@@ -103,39 +105,51 @@ private:
 	std::vector<RenderDrawCall> voxelDrawCallsCache, entityDrawCallsCache;
 
 	ObjectTextureID getVoxelTextureID(const TextureAsset &textureAsset) const;
-	ObjectTextureID getChasmFloorTextureID(const ChunkInt2 &chunkPos, VoxelChunk::ChasmDefID chasmDefID, double chasmAnimPercent) const;
-	ObjectTextureID getChasmWallTextureID(const ChunkInt2 &chunkPos, VoxelChunk::ChasmDefID chasmDefID) const;
+	ObjectTextureID getChasmFloorTextureID(VoxelChunk::ChasmDefID chasmDefID, double chasmAnimPercent) const;
+	ObjectTextureID getChasmWallTextureID(VoxelChunk::ChasmDefID chasmDefID) const;
 	ObjectTextureID getEntityTextureID(EntityInstanceID entityInstID, const CoordDouble2 &cameraCoordXZ,
 		const EntityChunkManager &entityChunkManager) const;
 
-	void loadVoxelTextures(const VoxelChunk &voxelChunk, TextureManager &textureManager, Renderer &renderer);
-	void loadVoxelMeshBuffers(RenderChunk &renderChunk, const VoxelChunk &voxelChunk, double ceilingScale, Renderer &renderer);
+	// Loads resources for voxel definitions added to the registry since the last call.
+	void loadVoxelTextures(const VoxelDefinitionRegistry &voxelDefRegistry, TextureManager &textureManager, Renderer &renderer);
+	void loadVoxelMeshBuffers(const VoxelDefinitionRegistry &voxelDefRegistry, double ceilingScale, Renderer &renderer);
+	void freeVoxelMeshDefs(Renderer &renderer);
 	void loadVoxelChasmWall(RenderChunk &renderChunk, const VoxelChunk &voxelChunk, SNInt x, int y, WEInt z);
 	void loadVoxelChasmWalls(RenderChunk &renderChunk, const VoxelChunk &voxelChunk);
 
 	void loadEntityTextures(const EntityChunk &entityChunk, const EntityChunkManager &entityChunkManager,
 		TextureManager &textureManager, Renderer &renderer);
 
-	void addVoxelDrawCall(const Double3 &position, const Double3 &preScaleTranslation, const Matrix4d &rotationMatrix,
+	void addVoxelDrawCall(const VoxelInt3 &voxel, const Double3 &position, const Double3 &preScaleTranslation, const Matrix4d &rotationMatrix,
 		const Matrix4d &scaleMatrix, VertexBufferID vertexBufferID, AttributeBufferID normalBufferID, AttributeBufferID texCoordBufferID,
 		IndexBufferID indexBufferID, ObjectTextureID textureID0, const std::optional<ObjectTextureID> &textureID1,
 		TextureSamplingType textureSamplingType0, TextureSamplingType textureSamplingType1, RenderLightingType lightingType,
 		double meshLightPercent, BufferView<const RenderLightID> lightIDs, VertexShaderType vertexShaderType, PixelShaderType pixelShaderType,
-		double pixelShaderParam0, std::vector<RenderDrawCall> &drawCalls);
+		double pixelShaderParam0, std::vector<RenderDrawCall> &drawCalls, std::vector<VoxelInt3> &drawCallVoxels);
 	void loadVoxelDrawCalls(RenderChunk &renderChunk, const VoxelChunk &voxelChunk, double ceilingScale,
 		double chasmAnimPercent, bool updateStatics, bool updateAnimating);
 
+	// Merges static opaque voxel faces in a tile into one mesh per texture, leaving out faces between solid walls.
+	void loadVoxelBatchTile(RenderChunk &renderChunk, const VoxelChunk &voxelChunk, int tileX, int tileZ,
+		double ceilingScale, Renderer &renderer);
+
+	// Rebuilds any dirty batch tiles (or frees them if batching is off). Returns whether any tile changed.
+	bool loadVoxelBatchTiles(RenderChunk &renderChunk, const VoxelChunk &voxelChunk, double ceilingScale,
+		bool batchStaticGeometry, Renderer &renderer);
+	void loadVoxelBatchDrawCalls(RenderChunk &renderChunk);
+
 	// Call once per frame per chunk after all voxel chunk changes have been applied to this manager.
 	// All context-sensitive data (like for chasm walls) should be available in the voxel chunk.
 	void rebuildVoxelChunkDrawCalls(RenderChunk &renderChunk, const VoxelChunk &voxelChunk, double ceilingScale,
 		double chasmAnimPercent, bool updateStatics, bool updateAnimating);
-	void rebuildVoxelDrawCallsList();
+	// Gathers draw calls of voxels inside the camera frustum as of the latest visibility chunk update.
+	void rebuildVoxelDrawCallsList(const VoxelVisibilityChunkManager &voxelVisChunkManager);
 
 	void addEntityDrawCall(const Double3 &position, const Matrix4d &rotationMatrix, const Matrix4d &scaleMatrix,
 		ObjectTextureID textureID0, const std::optional<ObjectTextureID> &textureID1, BufferView<const RenderLightID> lightIDs,
 		PixelShaderType pixelShaderType, std::vector<RenderDrawCall> &drawCalls);
 	void rebuildEntityChunkDrawCalls(RenderChunk &renderChunk, const EntityChunk &entityChunk, const CoordDouble2 &cameraCoordXZ,
-		const Matrix4d &rotationMatrix, double ceilingScale, const VoxelChunkManager &voxelChunkManager,
+		const Matrix4d &rotationMatrix, double ceilingScale, double simulationPercent, const VoxelChunkManager &voxelChunkManager,
 		const EntityChunkManager &entityChunkManager);
 	void rebuildEntityDrawCallsList();
 public:
@@ -153,10 +167,12 @@ public:
 
 	void updateVoxels(BufferView<const ChunkInt2> activeChunkPositions, BufferView<const ChunkInt2> newChunkPositions,
 		double ceilingScale, double chasmAnimPercent, const VoxelChunkManager &voxelChunkManager,
-		const VoxelVisibilityChunkManager &voxelVisChunkManager, TextureManager &textureManager, Renderer &renderer);
+		const VoxelVisibilityChunkManager &voxelVisChunkManager, bool batchStaticGeometry, TextureManager &textureManager,
+		Renderer &renderer);
 	void updateEntities(BufferView<const ChunkInt2> activeChunkPositions, BufferView<const ChunkInt2> newChunkPositions,
-		const CoordDouble2 &cameraCoordXZ, const VoxelDouble2 &cameraDirXZ, double ceilingScale, const VoxelChunkManager &voxelChunkManager,
-		const EntityChunkManager &entityChunkManager, TextureManager &textureManager, Renderer &renderer);
+		const CoordDouble2 &cameraCoordXZ, const VoxelDouble2 &cameraDirXZ, double ceilingScale, double simulationPercent,
+		const VoxelChunkManager &voxelChunkManager, const EntityChunkManager &entityChunkManager, TextureManager &textureManager,
+		Renderer &renderer);
 	void updateLights(BufferView<const ChunkInt2> activeChunkPositions, BufferView<const ChunkInt2> newChunkPositions,
 		const CoordDouble3 &cameraCoord, double ceilingScale, bool isFogActive, bool nightLightsAreActive, bool playerHasLight,
 		const EntityChunkManager &entityChunkManager, Renderer &renderer);
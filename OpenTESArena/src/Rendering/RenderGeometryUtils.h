@@ -1,6 +1,8 @@
 #ifndef RENDER_GEOMETRY_UTILS_H
 #define RENDER_GEOMETRY_UTILS_H
 
+#include <cmath>
+
 // Unique ID for a mesh allocated in the renderer's internal format.
 using VertexBufferID = int;
 
@@ -10,4 +12,25 @@ using AttributeBufferID = int;
 // Unique ID for a set of mesh indices allocated in the renderer's internal format.
 using IndexBufferID = int;
 
+// Storage format of vertex and attribute buffer components in the renderer. Source data is always populated
+// as doubles and converted by the renderer.
+enum class VertexAttributeFormat
+{
+	Float64,
+	Float32,
+	Int16, // Fixed-point with 1/256 precision, for local-space positions and texture coordinates.
+	OctahedralInt16 // Unit vectors (normals) in two 16-bit components.
+};
+
+namespace RenderGeometryUtils
+{
+	constexpr double FIXED_POINT_SCALE = 256.0; // Steps per unit in the Int16 format.
+
+	// Rounds a value to what the Int16 format stores, for geometry that must line up with Int16 meshes.
+	inline double quantizeFixedPoint(double value)
+	{
+		return std::round(value * FIXED_POINT_SCALE) / FIXED_POINT_SCALE;
+	}
+}
+
 #endif
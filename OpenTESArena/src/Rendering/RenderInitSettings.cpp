@@ -1,8 +1,9 @@
 #include "RenderInitSettings.h"
 
-void RenderInitSettings::init(int width, int height, int renderThreadsMode)
+void RenderInitSettings::init(int width, int height, int renderThreadsMode, JobSystem *jobSystem)
 {
     this->width = width;
     this->height = height;
     this->renderThreadsMode = renderThreadsMode;
+    this->jobSystem = jobSystem;
 }
@@ -1,6 +1,8 @@
 #ifndef RENDER_INIT_SETTINGS_H
 #define RENDER_INIT_SETTINGS_H
 
+class JobSystem;
+
 struct RenderInitSettings
 {
 	// @todo: rarely modified values
@@ -12,8 +14,9 @@ struct RenderInitSettings
 
 	int width, height;
 	int renderThreadsMode;
+	JobSystem *jobSystem; // Shared worker pool for splitting up rendering work.
 
-	void init(int width, int height, int renderThreadsMode);
+	void init(int width, int height, int renderThreadsMode, JobSystem *jobSystem);
 };
 
 #endif
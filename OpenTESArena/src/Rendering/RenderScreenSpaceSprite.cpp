@@ -0,0 +1,20 @@
+#include "RenderScreenSpaceSprite.h"
+
+RenderScreenSpaceSprite::RenderScreenSpaceSprite()
+{
+	this->xPercent = 0.0;
+	this->yPercent = 0.0;
+	this->widthPercent = 0.0;
+	this->heightPercent = 0.0;
+	this->textureID = -1;
+}
+
+void RenderScreenSpaceSprite::init(double xPercent, double yPercent, double widthPercent, double heightPercent,
+	ObjectTextureID textureID)
+{
+	this->xPercent = xPercent;
+	this->yPercent = yPercent;
+	this->widthPercent = widthPercent;
+	this->heightPercent = heightPercent;
+	this->textureID = textureID;
+}
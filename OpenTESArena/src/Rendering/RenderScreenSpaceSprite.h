@@ -0,0 +1,19 @@
+#ifndef RENDER_SCREEN_SPACE_SPRITE_H
+#define RENDER_SCREEN_SPACE_SPRITE_H
+
+#include "RenderTextureUtils.h"
+
+// Alpha-tested 2D sprite drawn over the finished 3D scene with no depth test or perspective, for
+// screen-space effects like rain and snow.
+struct RenderScreenSpaceSprite
+{
+	double xPercent, yPercent; // Top left corner, 0->1 across the game world frame buffer.
+	double widthPercent, heightPercent; // Size relative to the game world frame buffer.
+	ObjectTextureID textureID;
+
+	RenderScreenSpaceSprite();
+
+	void init(double xPercent, double yPercent, double widthPercent, double heightPercent, ObjectTextureID textureID);
+};
+
+#endif
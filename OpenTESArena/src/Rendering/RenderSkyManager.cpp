@@ -1,8 +1,11 @@
+#include <algorithm>
+#include <array>
 #include <numeric>
 #include <vector>
 
 #include "ArenaRenderUtils.h"
 #include "Renderer.h"
+#include "RendererUtils.h"
 #include "RenderSkyManager.h"
 #include "../Assets/ArenaPaletteName.h"
 #include "../Assets/ArenaTextureName.h"
@@ -17,6 +20,126 @@
 #include "../Weather/WeatherInstance.h"
 #include "../World/MeshUtils.h"
 
+namespace
+{
+	// Shared quad for all sky objects.
+	// @todo: to be more accurate, land/air vertices could rest on the horizon, while star/planet/sun vertices would sit halfway under the horizon, etc., and these would be separate buffers for the draw calls to pick from.
+	constexpr int SkyObjectMeshVertexCount = 4;
+	constexpr int SkyObjectMeshIndexCount = 6;
+
+	constexpr std::array<double, SkyObjectMeshVertexCount * MeshUtils::POSITION_COMPONENTS_PER_VERTEX> SkyObjectVertices =
+	{
+		0.0, 1.0, -0.50,
+		0.0, 0.0, -0.50,
+		0.0, 0.0, 0.50,
+		0.0, 1.0, 0.50
+	};
+
+	constexpr std::array<double, SkyObjectMeshVertexCount * MeshUtils::NORMAL_COMPONENTS_PER_VERTEX> SkyObjectNormals =
+	{
+		-1.0, 0.0, 0.0,
+		-1.0, 0.0, 0.0,
+		-1.0, 0.0, 0.0,
+		-1.0, 0.0, 0.0
+	};
+
+	constexpr std::array<double, SkyObjectMeshVertexCount * MeshUtils::TEX_COORDS_PER_VERTEX> SkyObjectTexCoords =
+	{
+		0.0, 0.0,
+		0.0, 1.0,
+		1.0, 1.0,
+		1.0, 0.0
+	};
+
+	constexpr std::array<int32_t, SkyObjectMeshIndexCount> SkyObjectIndices =
+	{
+		0, 1, 2,
+		2, 3, 0
+	};
+
+	// @temp fix for Z ordering. Later I think we should just not do depth testing in the sky?
+	constexpr double LandDistance = 500.0;
+	constexpr double AirDistance = LandDistance + 400.0;
+	constexpr double MoonDistance = AirDistance + 400.0;
+	constexpr double SunDistance = MoonDistance + 400.0;
+	constexpr double StarDistance = SunDistance + 400.0;
+
+	// Faces a sky object toward the sky origin along its direction.
+	Matrix4d MakeSkyObjectRotation(const Double3 &direction)
+	{
+		const Radians pitchRadians = direction.getYAngleRadians();
+		const Radians yawRadians = MathUtils::fullAtan2(Double2(direction.z, direction.x).normalized()) + Constants::Pi;
+		const Matrix4d pitchRotation = Matrix4d::zRotation(pitchRadians);
+		const Matrix4d yawRotation = Matrix4d::yRotation(yawRadians);
+		return yawRotation * pitchRotation;
+	}
+
+	// Mesh data for a group of sky objects that share a texture, before it's given to the renderer.
+	struct SkyLayerMeshBuilder
+	{
+		ObjectTextureID textureID;
+		bool emissive;
+		std::vector<double> vertices;
+		std::vector<double> normals;
+		std::vector<double> texCoords;
+		std::vector<int32_t> indices;
+
+		// Appends the sky object quad as it would be placed by a per-object draw call around the origin.
+		void addQuad(const Double3 &direction, double width, double height, double distance)
+		{
+			const Matrix4d rotation = MakeSkyObjectRotation(direction);
+			const Matrix4d scale = Matrix4d::scale(1.0, height * distance, width * distance);
+			const Double3 position = direction * distance;
+
+			const int32_t indexOffset = static_cast<int32_t>(this->vertices.size() / MeshUtils::POSITION_COMPONENTS_PER_VERTEX);
+			for (int i = 0; i < SkyObjectMeshVertexCount; i++)
+			{
+				const int vertexIndex = i * MeshUtils::POSITION_COMPONENTS_PER_VERTEX;
+				const Double4 vertex(SkyObjectVertices[vertexIndex], SkyObjectVertices[vertexIndex + 1], SkyObjectVertices[vertexIndex + 2], 1.0);
+				const Double4 transformedVertex = rotation * (scale * vertex);
+				this->vertices.emplace_back(transformedVertex.x + position.x);
+				this->vertices.emplace_back(transformedVertex.y + position.y);
+				this->vertices.emplace_back(transformedVertex.z + position.z);
+
+				const int normalIndex = i * MeshUtils::NORMAL_COMPONENTS_PER_VERTEX;
+				const Double4 normal(SkyObjectNormals[normalIndex], SkyObjectNormals[normalIndex + 1], SkyObjectNormals[normalIndex + 2], 0.0);
+				const Double4 transformedNormal = rotation * normal;
+				this->normals.emplace_back(transformedNormal.x);
+				this->normals.emplace_back(transformedNormal.y);
+				this->normals.emplace_back(transformedNormal.z);
+
+				const int texCoordIndex = i * MeshUtils::TEX_COORDS_PER_VERTEX;
+				this->texCoords.emplace_back(SkyObjectTexCoords[texCoordIndex]);
+				this->texCoords.emplace_back(SkyObjectTexCoords[texCoordIndex + 1]);
+			}
+
+			for (const int32_t index : SkyObjectIndices)
+			{
+				this->indices.emplace_back(indexOffset + index);
+			}
+		}
+	};
+
+	SkyLayerMeshBuilder &GetOrAddSkyLayerMeshBuilder(std::vector<SkyLayerMeshBuilder> &builders, ObjectTextureID textureID, bool emissive)
+	{
+		const auto iter = std::find_if(builders.begin(), builders.end(),
+			[textureID, emissive](const SkyLayerMeshBuilder &builder)
+		{
+			return (builder.textureID == textureID) && (builder.emissive == emissive);
+		});
+
+		if (iter != builders.end())
+		{
+			return *iter;
+		}
+
+		SkyLayerMeshBuilder &builder = builders.emplace_back();
+		builder.textureID = textureID;
+		builder.emissive = emissive;
+		return builder;
+	}
+}
+
 void RenderSkyManager::LoadedGeneralSkyObjectTextureEntry::init(const TextureAsset &textureAsset,
 	ScopedObjectTextureRef &&objectTextureRef)
 {
@@ -30,6 +153,43 @@ void RenderSkyManager::LoadedSmallStarTextureEntry::init(uint8_t paletteIndex, S
 	this->objectTextureRef = std::move(objectTextureRef);
 }
 
+RenderSkyManager::BakedSkyLayerMesh::BakedSkyLayerMesh()
+{
+	this->vertexBufferID = -1;
+	this->normalBufferID = -1;
+	this->texCoordBufferID = -1;
+	this->indexBufferID = -1;
+	this->textureID = -1;
+	this->emissive = false;
+}
+
+void RenderSkyManager::BakedSkyLayerMesh::freeBuffers(Renderer &renderer)
+{
+	if (this->vertexBufferID >= 0)
+	{
+		renderer.freeVertexBuffer(this->vertexBufferID);
+		this->vertexBufferID = -1;
+	}
+
+	if (this->normalBufferID >= 0)
+	{
+		renderer.freeAttributeBuffer(this->normalBufferID);
+		this->normalBufferID = -1;
+	}
+
+	if (this->texCoordBufferID >= 0)
+	{
+		renderer.freeAttributeBuffer(this->texCoordBufferID);
+		this->texCoordBufferID = -1;
+	}
+
+	if (this->indexBufferID >= 0)
+	{
+		renderer.freeIndexBuffer(this->indexBufferID);
+		this->indexBufferID = -1;
+	}
+}
+
 RenderSkyManager::RenderSkyManager()
 {
 	this->bgVertexBufferID = -1;
@@ -41,6 +201,8 @@ RenderSkyManager::RenderSkyManager()
 	this->objectNormalBufferID = -1;
 	this->objectTexCoordBufferID = -1;
 	this->objectIndexBufferID = -1;
+
+	this->bakedDay = -1;
 }
 
 void RenderSkyManager::init(const ExeData &exeData, TextureManager &textureManager, Renderer &renderer)
@@ -171,20 +333,20 @@ void RenderSkyManager::init(const ExeData &exeData, TextureManager &textureManag
 	constexpr int texCoordComponentsPerVertex = MeshUtils::TEX_COORDS_PER_VERTEX;
 
 	const int bgVertexCount = static_cast<int>(bgVertices.size()) / 3;
-	if (!renderer.tryCreateVertexBuffer(bgVertexCount, positionComponentsPerVertex, &this->bgVertexBufferID))
+	if (!renderer.tryCreateVertexBuffer(bgVertexCount, positionComponentsPerVertex, VertexAttributeFormat::Float32, &this->bgVertexBufferID))
 	{
 		DebugLogError("Couldn't create vertex buffer for sky background mesh ID.");
 		return;
 	}
 
-	if (!renderer.tryCreateAttributeBuffer(bgVertexCount, normalComponentsPerVertex, &this->bgNormalBufferID))
+	if (!renderer.tryCreateAttributeBuffer(bgVertexCount, normalComponentsPerVertex, VertexAttributeFormat::OctahedralInt16, &this->bgNormalBufferID))
 	{
 		DebugLogError("Couldn't create normal attribute buffer for sky background mesh ID.");
 		this->freeBgBuffers(renderer);
 		return;
 	}
 
-	if (!renderer.tryCreateAttributeBuffer(bgVertexCount, texCoordComponentsPerVertex, &this->bgTexCoordBufferID))
+	if (!renderer.tryCreateAttributeBuffer(bgVertexCount, texCoordComponentsPerVertex, VertexAttributeFormat::Float32, &this->bgTexCoordBufferID))
 	{
 		DebugLogError("Couldn't create tex coord attribute buffer for sky background mesh ID.");
 		this->freeBgBuffers(renderer);
@@ -278,70 +440,37 @@ void RenderSkyManager::init(const ExeData &exeData, TextureManager &textureManag
 	this->bgDrawCall.pixelShaderParam0 = 0.0;
 
 	// Initialize sky object mesh buffers shared with all sky objects.
-	// @todo: to be more accurate, land/air vertices could rest on the horizon, while star/planet/sun vertices would sit halfway under the horizon, etc., and these would be separate buffers for the draw calls to pick from.
-	constexpr int objectMeshVertexCount = 4;
-	constexpr int objectMeshIndexCount = 6;
-	if (!renderer.tryCreateVertexBuffer(objectMeshVertexCount, positionComponentsPerVertex, &this->objectVertexBufferID))
+	if (!renderer.tryCreateVertexBuffer(SkyObjectMeshVertexCount, positionComponentsPerVertex, VertexAttributeFormat::Float32, &this->objectVertexBufferID))
 	{
 		DebugLogError("Couldn't create vertex buffer for sky object mesh ID.");
 		return;
 	}
 
-	if (!renderer.tryCreateAttributeBuffer(objectMeshVertexCount, normalComponentsPerVertex, &this->objectNormalBufferID))
+	if (!renderer.tryCreateAttributeBuffer(SkyObjectMeshVertexCount, normalComponentsPerVertex, VertexAttributeFormat::OctahedralInt16, &this->objectNormalBufferID))
 	{
 		DebugLogError("Couldn't create normal attribute buffer for sky object mesh def.");
 		this->freeObjectBuffers(renderer);
 		return;
 	}
 
-	if (!renderer.tryCreateAttributeBuffer(objectMeshVertexCount, texCoordComponentsPerVertex, &this->objectTexCoordBufferID))
+	if (!renderer.tryCreateAttributeBuffer(SkyObjectMeshVertexCount, texCoordComponentsPerVertex, VertexAttributeFormat::Int16, &this->objectTexCoordBufferID))
 	{
 		DebugLogError("Couldn't create tex coord attribute buffer for sky object mesh def.");
 		this->freeObjectBuffers(renderer);
 		return;
 	}
 
-	if (!renderer.tryCreateIndexBuffer(objectMeshIndexCount, &this->objectIndexBufferID))
+	if (!renderer.tryCreateIndexBuffer(SkyObjectMeshIndexCount, &this->objectIndexBufferID))
 	{
 		DebugLogError("Couldn't create index buffer for sky object mesh def.");
 		this->freeObjectBuffers(renderer);
 		return;
 	}
 
-	constexpr std::array<double, objectMeshVertexCount * positionComponentsPerVertex> objectVertices =
-	{
-		0.0, 1.0, -0.50,
-		0.0, 0.0, -0.50,
-		0.0, 0.0, 0.50,
-		0.0, 1.0, 0.50
-	};
-
-	constexpr std::array<double, objectMeshVertexCount * normalComponentsPerVertex> objectNormals =
-	{
-		-1.0, 0.0, 0.0,
-		-1.0, 0.0, 0.0,
-		-1.0, 0.0, 0.0,
-		-1.0, 0.0, 0.0
-	};
-
-	constexpr std::array<double, objectMeshVertexCount * texCoordComponentsPerVertex> objectTexCoords =
-	{
-		0.0, 0.0,
-		0.0, 1.0,
-		1.0, 1.0,
-		1.0, 0.0
-	};
-
-	constexpr std::array<int32_t, objectMeshIndexCount> objectIndices =
-	{
-		0, 1, 2,
-		2, 3, 0
-	};
-
-	renderer.populateVertexBuffer(this->objectVertexBufferID, objectVertices);
-	renderer.populateAttributeBuffer(this->objectNormalBufferID, objectNormals);
-	renderer.populateAttributeBuffer(this->objectTexCoordBufferID, objectTexCoords);
-	renderer.populateIndexBuffer(this->objectIndexBufferID, objectIndices);
+	renderer.populateVertexBuffer(this->objectVertexBufferID, SkyObjectVertices);
+	renderer.populateAttributeBuffer(this->objectNormalBufferID, SkyObjectNormals);
+	renderer.populateAttributeBuffer(this->objectTexCoordBufferID, SkyObjectTexCoords);
+	renderer.populateIndexBuffer(this->objectIndexBufferID, SkyObjectIndices);
 }
 
 void RenderSkyManager::shutdown(Renderer &renderer)
@@ -351,6 +480,8 @@ void RenderSkyManager::shutdown(Renderer &renderer)
 
 	this->freeObjectBuffers(renderer);
 	this->objectDrawCalls.clear();
+
+	this->freeBakedSkyLayers(renderer);
 }
 
 ObjectTextureID RenderSkyManager::getGeneralSkyObjectTextureID(const TextureAsset &textureAsset) const
@@ -444,6 +575,106 @@ void RenderSkyManager::freeObjectBuffers(Renderer &renderer)
 	this->smallStarTextures.clear();
 }
 
+void RenderSkyManager::bakeSkyLayers(const SkyInstance &skyInst, Renderer &renderer)
+{
+	this->freeBakedSkyLayers(renderer);
+
+	std::vector<SkyLayerMeshBuilder> starBuilders;
+	for (int i = skyInst.starEnd - 1; i >= skyInst.starStart; i--)
+	{
+		const SkyObjectInstance &skyObjectInst = skyInst.getSkyObjectInst(i);
+		const SkyObjectTextureType textureType = skyObjectInst.textureType;
+
+		ObjectTextureID textureID = -1;
+		if (textureType == SkyObjectTextureType::TextureAsset)
+		{
+			const SkyObjectTextureAssetEntry &textureAssetEntry = skyInst.getTextureAssetEntry(skyObjectInst.textureAssetEntryID);
+			const TextureAsset &textureAsset = textureAssetEntry.textureAssets.get(0);
+			textureID = this->getGeneralSkyObjectTextureID(textureAsset);
+		}
+		else if (textureType == SkyObjectTextureType::PaletteIndex)
+		{
+			const SkyObjectPaletteIndexEntry &paletteIndexEntry = skyInst.getPaletteIndexEntry(skyObjectInst.paletteIndexEntryID);
+			textureID = this->getSmallStarTextureID(paletteIndexEntry.paletteIndex);
+		}
+		else
+		{
+			DebugNotImplementedMsg(std::to_string(static_cast<int>(textureType)));
+		}
+
+		SkyLayerMeshBuilder &builder = GetOrAddSkyLayerMeshBuilder(starBuilders, textureID, true);
+		builder.addQuad(skyObjectInst.baseDirection, skyObjectInst.width, skyObjectInst.height, StarDistance);
+	}
+
+	std::vector<SkyLayerMeshBuilder> landBuilders;
+	for (int i = skyInst.landStart; i < skyInst.landEnd; i++)
+	{
+		const SkyObjectInstance &skyObjectInst = skyInst.getSkyObjectInst(i);
+		const bool hasAnimation = skyObjectInst.animIndex >= 0;
+		if (hasAnimation)
+		{
+			continue;
+		}
+
+		DebugAssertMsg(skyObjectInst.textureType == SkyObjectTextureType::TextureAsset, "Expected all sky land objects to use TextureAsset texture type.");
+		const SkyObjectTextureAssetEntry &textureAssetEntry = skyInst.getTextureAssetEntry(skyObjectInst.textureAssetEntryID);
+		const TextureAsset &textureAsset = textureAssetEntry.textureAssets.get(0);
+		const ObjectTextureID textureID = this->getGeneralSkyObjectTextureID(textureAsset);
+
+		SkyLayerMeshBuilder &builder = GetOrAddSkyLayerMeshBuilder(landBuilders, textureID, skyObjectInst.emissive);
+		builder.addQuad(skyObjectInst.transformedDirection, skyObjectInst.width, skyObjectInst.height, LandDistance);
+	}
+
+	auto createMeshes = [&renderer](const std::vector<SkyLayerMeshBuilder> &builders, std::vector<BakedSkyLayerMesh> &outMeshes)
+	{
+		for (const SkyLayerMeshBuilder &builder : builders)
+		{
+			const int vertexCount = static_cast<int>(builder.vertices.size()) / MeshUtils::POSITION_COMPONENTS_PER_VERTEX;
+			const int indexCount = static_cast<int>(builder.indices.size());
+
+			BakedSkyLayerMesh mesh;
+			mesh.textureID = builder.textureID;
+			mesh.emissive = builder.emissive;
+			if (!renderer.tryCreateVertexBuffer(vertexCount, MeshUtils::POSITION_COMPONENTS_PER_VERTEX, VertexAttributeFormat::Float32, &mesh.vertexBufferID) ||
+				!renderer.tryCreateAttributeBuffer(vertexCount, MeshUtils::NORMAL_COMPONENTS_PER_VERTEX, VertexAttributeFormat::OctahedralInt16, &mesh.normalBufferID) ||
+				!renderer.tryCreateAttributeBuffer(vertexCount, MeshUtils::TEX_COORDS_PER_VERTEX, VertexAttributeFormat::Int16, &mesh.texCoordBufferID) ||
+				!renderer.tryCreateIndexBuffer(indexCount, &mesh.indexBufferID))
+			{
+				DebugLogError("Couldn't create buffers for baked sky layer mesh.");
+				mesh.freeBuffers(renderer);
+				continue;
+			}
+
+			renderer.populateVertexBuffer(mesh.vertexBufferID, builder.vertices);
+			renderer.populateAttributeBuffer(mesh.normalBufferID, builder.normals);
+			renderer.populateAttributeBuffer(mesh.texCoordBufferID, builder.texCoords);
+			renderer.populateIndexBuffer(mesh.indexBufferID, builder.indices);
+			outMeshes.emplace_back(std::move(mesh));
+		}
+	};
+
+	createMeshes(starBuilders, this->bakedStarMeshes);
+	createMeshes(landBuilders, this->bakedLandMeshes);
+}
+
+void RenderSkyManager::freeBakedSkyLayers(Renderer &renderer)
+{
+	for (BakedSkyLayerMesh &mesh : this->bakedStarMeshes)
+	{
+		mesh.freeBuffers(renderer);
+	}
+
+	for (BakedSkyLayerMesh &mesh : this->bakedLandMeshes)
+	{
+		mesh.freeBuffers(renderer);
+	}
+
+	this->bakedStarMeshes.clear();
+	this->bakedLandMeshes.clear();
+	this->bakedLatitude = std::nullopt;
+	this->bakedDay = -1;
+}
+
 const RenderDrawCall &RenderSkyManager::getBgDrawCall() const
 {
 	return this->bgDrawCall;
@@ -587,12 +818,13 @@ void RenderSkyManager::loadScene(const SkyInfoDefinition &skyInfoDef, TextureMan
 		}
 	}
 
-	// @todo: load draw calls for all the sky objects (ideally here, but can be in update() for now if convenient)
+	// Sky layers are baked on the first update since they need the sky instance.
+	this->bakedLatitude = std::nullopt;
 }
 
 void RenderSkyManager::update(const SkyInstance &skyInst, const WeatherInstance &weatherInst,
-	const CoordDouble3 &cameraCoord, bool isInterior, double daytimePercent, bool isFoggy, double distantAmbientPercent,
-	Renderer &renderer)
+	const CoordDouble3 &cameraCoord, bool isInterior, double latitude, int currentDay, double daytimePercent, bool isFoggy,
+	double distantAmbientPercent, Renderer &renderer)
 {
 	const WorldDouble3 cameraPos = VoxelUtils::coordToWorldPoint(cameraCoord);
 
@@ -635,13 +867,6 @@ void RenderSkyManager::update(const SkyInstance &skyInst, const WeatherInstance
 		this->bgDrawCall.textureIDs[0] = this->skyGradientPMTextureRef.get();
 	}
 
-	// @temp fix for Z ordering. Later I think we should just not do depth testing in the sky?
-	constexpr double landDistance = 500.0;
-	constexpr double airDistance = landDistance + 400.0;
-	constexpr double moonDistance = airDistance + 400.0;
-	constexpr double sunDistance = moonDistance + 400.0;
-	constexpr double starDistance = sunDistance + 400.0;
-
 	constexpr double fullBrightLightPercent = 1.0;
 
 	auto addDrawCall = [this, &renderer, &cameraPos](const Double3 &direction, double width, double height, ObjectTextureID textureID,
@@ -650,12 +875,7 @@ void RenderSkyManager::update(const SkyInstance &skyInst, const WeatherInstance
 		RenderDrawCall drawCall;
 		drawCall.position = cameraPos + (direction * arbitraryDistance);
 		drawCall.preScaleTranslation = Double3::Zero;
-		
-		const Radians pitchRadians = direction.getYAngleRadians();
-		const Radians yawRadians = MathUtils::fullAtan2(Double2(direction.z, direction.x).normalized()) + Constants::Pi;
-		const Matrix4d pitchRotation = Matrix4d::zRotation(pitchRadians);
-		const Matrix4d yawRotation = Matrix4d::yRotation(yawRadians);
-		drawCall.rotation = yawRotation * pitchRotation;
+		drawCall.rotation = MakeSkyObjectRotation(direction);
 
 		const double scaledWidth = width * arbitraryDistance;
 		const double scaledHeight = height * arbitraryDistance;
@@ -678,8 +898,39 @@ void RenderSkyManager::update(const SkyInstance &skyInst, const WeatherInstance
 		this->objectDrawCalls.emplace_back(std::move(drawCall));
 	};
 
-	// @todo: create draw calls in loadScene() as an optimization
-	// @todo: update sky object draw call transforms if they are affected by planet rotation
+	auto addBakedDrawCall = [this, &cameraPos](const BakedSkyLayerMesh &mesh, const Matrix4d &rotation, double meshLightPercent,
+		PixelShaderType pixelShaderType)
+	{
+		RenderDrawCall drawCall;
+		drawCall.position = cameraPos;
+		drawCall.preScaleTranslation = Double3::Zero;
+		drawCall.rotation = rotation;
+		drawCall.scale = Matrix4d::identity();
+		drawCall.vertexBufferID = mesh.vertexBufferID;
+		drawCall.normalBufferID = mesh.normalBufferID;
+		drawCall.texCoordBufferID = mesh.texCoordBufferID;
+		drawCall.indexBufferID = mesh.indexBufferID;
+		drawCall.textureIDs[0] = mesh.textureID;
+		drawCall.textureIDs[1] = std::nullopt;
+		drawCall.textureSamplingType0 = TextureSamplingType::Default;
+		drawCall.textureSamplingType1 = TextureSamplingType::Default;
+		drawCall.lightingType = RenderLightingType::PerMesh;
+		drawCall.lightPercent = meshLightPercent;
+		drawCall.lightIdCount = 0;
+		drawCall.vertexShaderType = VertexShaderType::SwingingDoor; // Rotation + translation only.
+		drawCall.pixelShaderType = pixelShaderType;
+		drawCall.pixelShaderParam0 = 0.0;
+		this->objectDrawCalls.emplace_back(std::move(drawCall));
+	};
+
+	// Static layers only change with a new sky instance.
+	const bool needsBake = !this->bakedLatitude.has_value() || (*this->bakedLatitude != latitude) || (this->bakedDay != currentDay);
+	if (needsBake)
+	{
+		this->bakeSkyLayers(skyInst, renderer);
+		this->bakedLatitude = latitude;
+		this->bakedDay = currentDay;
+	}
 
 	this->objectDrawCalls.clear(); // @todo: don't clear every frame, just change their transforms/animation texture ID
 
@@ -689,32 +940,13 @@ void RenderSkyManager::update(const SkyInstance &skyInst, const WeatherInstance
 		return;
 	}
 
-	// Order draw calls back to front.
-	for (int i = skyInst.starEnd - 1; i >= skyInst.starStart; i--)
+	// Order draw calls back to front. Stars rotate with the planet the same way SkyInstance transforms each
+	// star direction (including its X and Z flip, which is a half turn around Y).
+	const Matrix4d starRotation = Matrix4d::yRotation(Constants::Pi) * RendererUtils::getLatitudeRotation(latitude) *
+		RendererUtils::getTimeOfDayRotation(daytimePercent);
+	for (const BakedSkyLayerMesh &mesh : this->bakedStarMeshes)
 	{
-		const SkyObjectInstance &skyObjectInst = skyInst.getSkyObjectInst(i);
-		const SkyObjectTextureType textureType = skyObjectInst.textureType;
-
-		ObjectTextureID textureID = -1;
-		if (textureType == SkyObjectTextureType::TextureAsset)
-		{
-			const SkyObjectTextureAssetEntry &textureAssetEntry = skyInst.getTextureAssetEntry(skyObjectInst.textureAssetEntryID);
-			const TextureAsset &textureAsset = textureAssetEntry.textureAssets.get(0);
-			textureID = this->getGeneralSkyObjectTextureID(textureAsset);
-		}
-		else if (textureType == SkyObjectTextureType::PaletteIndex)
-		{
-			const SkyObjectPaletteIndexEntry &paletteIndexEntry = skyInst.getPaletteIndexEntry(skyObjectInst.paletteIndexEntryID);
-			const uint8_t paletteIndex = paletteIndexEntry.paletteIndex;
-			textureID = this->getSmallStarTextureID(paletteIndex);
-		}
-		else
-		{
-			DebugNotImplementedMsg(std::to_string(static_cast<int>(textureType)));
-		}
-
-		addDrawCall(skyObjectInst.transformedDirection, skyObjectInst.width, skyObjectInst.height, textureID, starDistance,
-			fullBrightLightPercent, PixelShaderType::AlphaTestedWithPreviousBrightnessLimit);
+		addBakedDrawCall(mesh, starRotation, fullBrightLightPercent, PixelShaderType::AlphaTestedWithPreviousBrightnessLimit);
 	}
 
 	for (int i = skyInst.sunStart; i < skyInst.sunEnd; i++)
@@ -727,7 +959,7 @@ void RenderSkyManager::update(const SkyInstance &skyInst, const WeatherInstance
 		const TextureAsset &textureAsset = textureAssetEntry.textureAssets.get(0);
 		const ObjectTextureID textureID = this->getGeneralSkyObjectTextureID(textureAsset);
 
-		addDrawCall(skyObjectInst.transformedDirection, skyObjectInst.width, skyObjectInst.height, textureID, sunDistance,
+		addDrawCall(skyObjectInst.transformedDirection, skyObjectInst.width, skyObjectInst.height, textureID, SunDistance,
 			fullBrightLightPercent, PixelShaderType::AlphaTested);
 	}
 
@@ -741,7 +973,7 @@ void RenderSkyManager::update(const SkyInstance &skyInst, const WeatherInstance
 		const TextureAsset &textureAsset = textureAssetEntry.textureAssets.get(0);
 		const ObjectTextureID textureID = this->getGeneralSkyObjectTextureID(textureAsset);
 
-		addDrawCall(skyObjectInst.transformedDirection, skyObjectInst.width, skyObjectInst.height, textureID, moonDistance,
+		addDrawCall(skyObjectInst.transformedDirection, skyObjectInst.width, skyObjectInst.height, textureID, MoonDistance,
 			fullBrightLightPercent, PixelShaderType::AlphaTestedWithLightLevelColor);
 	}
 
@@ -755,13 +987,27 @@ void RenderSkyManager::update(const SkyInstance &skyInst, const WeatherInstance
 		const TextureAsset &textureAsset = textureAssetEntry.textureAssets.get(0);
 		const ObjectTextureID textureID = this->getGeneralSkyObjectTextureID(textureAsset);
 
-		addDrawCall(skyObjectInst.transformedDirection, skyObjectInst.width, skyObjectInst.height, textureID, airDistance,
+		addDrawCall(skyObjectInst.transformedDirection, skyObjectInst.width, skyObjectInst.height, textureID, AirDistance,
 			distantAmbientPercent, PixelShaderType::AlphaTestedWithLightLevelColor);
 	}
 
+	for (const BakedSkyLayerMesh &mesh : this->bakedLandMeshes)
+	{
+		const double meshLightPercent = mesh.emissive ? fullBrightLightPercent : distantAmbientPercent;
+		addBakedDrawCall(mesh, Matrix4d::identity(), meshLightPercent, PixelShaderType::AlphaTested);
+	}
+
 	for (int i = skyInst.landStart; i < skyInst.landEnd; i++)
 	{
 		const SkyObjectInstance &skyObjectInst = skyInst.getSkyObjectInst(i);
+		const int animIndex = skyObjectInst.animIndex;
+		const bool hasAnimation = animIndex >= 0;
+		if (!hasAnimation)
+		{
+			// Already in a baked land mesh.
+			continue;
+		}
+
 		const SkyObjectTextureType textureType = skyObjectInst.textureType;
 		DebugAssertMsg(textureType == SkyObjectTextureType::TextureAsset, "Expected all sky land objects to use TextureAsset texture type.");
 
@@ -769,20 +1015,14 @@ void RenderSkyManager::update(const SkyInstance &skyInst, const WeatherInstance
 		const BufferView<const TextureAsset> textureAssets = textureAssetEntry.textureAssets;
 		const int textureCount = textureAssets.getCount();
 
-		int textureAssetIndex = 0;
-		const int animIndex = skyObjectInst.animIndex;
-		const bool hasAnimation = animIndex >= 0;
-		if (hasAnimation)
-		{
-			const SkyObjectAnimationInstance &animInst = skyInst.getAnimInst(animIndex);
-			const double animPercent = animInst.percentDone;
-			textureAssetIndex = std::clamp(static_cast<int>(static_cast<double>(textureCount) * animPercent), 0, textureCount - 1);
-		}
+		const SkyObjectAnimationInstance &animInst = skyInst.getAnimInst(animIndex);
+		const double animPercent = animInst.percentDone;
+		const int textureAssetIndex = std::clamp(static_cast<int>(static_cast<double>(textureCount) * animPercent), 0, textureCount - 1);
 
 		const TextureAsset &textureAsset = textureAssets.get(textureAssetIndex);
 		const ObjectTextureID textureID = this->getGeneralSkyObjectTextureID(textureAsset);
 		const double meshLightPercent = skyObjectInst.emissive ? fullBrightLightPercent : distantAmbientPercent;
-		addDrawCall(skyObjectInst.transformedDirection, skyObjectInst.width, skyObjectInst.height, textureID, landDistance,
+		addDrawCall(skyObjectInst.transformedDirection, skyObjectInst.width, skyObjectInst.height, textureID, LandDistance,
 			meshLightPercent, PixelShaderType::AlphaTested);
 	}
 
@@ -813,13 +1053,14 @@ void RenderSkyManager::update(const SkyInstance &skyInst, const WeatherInstance
 
 		const TextureAsset &textureAsset = textureAssets.get(textureAssetIndex);
 		const ObjectTextureID textureID = this->getGeneralSkyObjectTextureID(textureAsset);
-		addDrawCall(skyObjectInst.transformedDirection, skyObjectInst.width, skyObjectInst.height, textureID, landDistance,
+		addDrawCall(skyObjectInst.transformedDirection, skyObjectInst.width, skyObjectInst.height, textureID, LandDistance,
 			meshLightPercent, PixelShaderType::AlphaTested);
 	}
 }
 
 void RenderSkyManager::unloadScene(Renderer &renderer)
 {
+	this->freeBakedSkyLayers(renderer);
 	this->generalSkyObjectTextures.clear();
 	this->smallStarTextures.clear();
 	this->objectDrawCalls.clear();
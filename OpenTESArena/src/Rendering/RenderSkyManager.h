@@ -1,6 +1,9 @@
 #ifndef RENDER_SKY_MANAGER_H
 #define RENDER_SKY_MANAGER_H
 
+#include <optional>
+#include <vector>
+
 #include "RenderDrawCall.h"
 #include "RenderGeometryUtils.h"
 #include "RenderTextureUtils.h"
@@ -34,6 +37,22 @@ private:
 		void init(uint8_t paletteIndex, ScopedObjectTextureRef &&objectTextureRef);
 	};
 
+	// Sky objects that only ever move with the whole sky, merged into one mesh per texture so a clear
+	// night costs a few draw calls instead of one per star.
+	struct BakedSkyLayerMesh
+	{
+		VertexBufferID vertexBufferID;
+		AttributeBufferID normalBufferID;
+		AttributeBufferID texCoordBufferID;
+		IndexBufferID indexBufferID;
+		ObjectTextureID textureID;
+		bool emissive;
+
+		BakedSkyLayerMesh();
+
+		void freeBuffers(Renderer &renderer);
+	};
+
 	// All the possible sky color textures to choose from, dependent on the active weather. These are used by
 	// the renderer to look up palette colors.
 	ScopedObjectTextureRef skyGradientAMTextureRef;
@@ -57,11 +76,22 @@ private:
 	std::vector<LoadedSmallStarTextureEntry> smallStarTextures;
 	std::vector<RenderDrawCall> objectDrawCalls; // Order matters: stars, sun, planets, clouds, mountains.
 
+	// Baked stars are in unrotated sky space and rotated each frame by the planet's rotation. Baked land is
+	// fixed to the horizon (animated land is still drawn per object).
+	std::vector<BakedSkyLayerMesh> bakedStarMeshes;
+	std::vector<BakedSkyLayerMesh> bakedLandMeshes;
+	std::optional<double> bakedLatitude; // Empty if the sky layers need baking.
+	int bakedDay;
+
 	ObjectTextureID getGeneralSkyObjectTextureID(const TextureAsset &textureAsset) const;
 	ObjectTextureID getSmallStarTextureID(uint8_t paletteIndex) const;
 
 	void freeBgBuffers(Renderer &renderer);
 	void freeObjectBuffers(Renderer &renderer);
+
+	// Builds the merged star and land meshes from the sky instance's current objects.
+	void bakeSkyLayers(const SkyInstance &skyInst, Renderer &renderer);
+	void freeBakedSkyLayers(Renderer &renderer);
 public:
 	RenderSkyManager();
 
@@ -73,7 +103,7 @@ public:
 
 	void loadScene(const SkyInfoDefinition &skyInfoDef, TextureManager &textureManager, Renderer &renderer);
 	void update(const SkyInstance &skyInst, const WeatherInstance &weatherInst, const CoordDouble3 &cameraCoord, bool isInterior,
-		double daytimePercent, bool isFoggy, double distantAmbientPercent, Renderer &renderer);
+		double latitude, int currentDay, double daytimePercent, bool isFoggy, double distantAmbientPercent, Renderer &renderer);
 	void unloadScene(Renderer &renderer);
 };
 
@@ -74,7 +74,8 @@ public:
 	int getWidth() const;
 	int getHeight() const;
 
-	// Texture updating functions. The returned pointer allows for changing any texels in the texture.
+	// Texture updating functions. The returned pointer allows for changing any texels in the texture. Its contents
+	// are undefined (not the previous texels) so every texel must be written before unlocking.
 	uint32_t *lockTexels();
 	void unlockTexels();
 };
@@ -27,11 +27,6 @@ namespace
 
 RenderWeatherManager::RenderWeatherManager()
 {
-	this->particleVertexBufferID = -1;
-	this->particleNormalBufferID = -1;
-	this->particleTexCoordBufferID = -1;
-	this->particleIndexBufferID = -1;
-
 	this->rainTextureID = -1;
 	for (ObjectTextureID &textureID : this->snowTextureIDs)
 	{
@@ -51,72 +46,6 @@ bool RenderWeatherManager::initMeshes(Renderer &renderer)
 	constexpr int normalComponentsPerVertex = MeshUtils::NORMAL_COMPONENTS_PER_VERTEX;
 	constexpr int texCoordComponentsPerVertex = MeshUtils::TEX_COORDS_PER_VERTEX;
 
-	constexpr int particleMeshVertexCount = 4;
-	constexpr int particleMeshIndexCount = 6;
-
-	constexpr double particleVertices[particleMeshVertexCount * positionComponentsPerVertex] =
-	{
-		0.0, 0.0, 0.0, // Let the top left be the origin so each particle is positioned like a cursor icon
-		0.0, -1.0, 0.0,
-		0.0, -1.0, 1.0,
-		0.0, 0.0, 1.0
-	};
-
-	constexpr double particleNormals[particleMeshVertexCount * normalComponentsPerVertex] =
-	{
-		-1.0, 0.0, 0.0,
-		-1.0, 0.0, 0.0,
-		-1.0, 0.0, 0.0,
-		-1.0, 0.0, 0.0
-	};
-
-	constexpr double particleTexCoords[particleMeshVertexCount * texCoordComponentsPerVertex] =
-	{
-		0.0, 0.0,
-		0.0, 1.0,
-		1.0, 1.0,
-		1.0, 0.0
-	};
-
-	constexpr int32_t particleIndices[particleMeshIndexCount] =
-	{
-		0, 1, 2,
-		2, 3, 0
-	};
-
-	if (!renderer.tryCreateVertexBuffer(particleMeshVertexCount, positionComponentsPerVertex, &this->particleVertexBufferID))
-	{
-		DebugLogError("Couldn't create vertex buffer for rain mesh ID.");
-		this->freeParticleBuffers(renderer);
-		return false;
-	}
-
-	if (!renderer.tryCreateAttributeBuffer(particleMeshVertexCount, normalComponentsPerVertex, &this->particleNormalBufferID))
-	{
-		DebugLogError("Couldn't create normal attribute buffer for rain mesh def.");
-		this->freeParticleBuffers(renderer);
-		return false;
-	}
-
-	if (!renderer.tryCreateAttributeBuffer(particleMeshVertexCount, texCoordComponentsPerVertex, &this->particleTexCoordBufferID))
-	{
-		DebugLogError("Couldn't create tex coord attribute buffer for rain mesh def.");
-		this->freeParticleBuffers(renderer);
-		return false;
-	}
-
-	if (!renderer.tryCreateIndexBuffer(particleMeshIndexCount, &this->particleIndexBufferID))
-	{
-		DebugLogError("Couldn't create index buffer for rain mesh def.");
-		this->freeParticleBuffers(renderer);
-		return false;
-	}
-
-	renderer.populateVertexBuffer(this->particleVertexBufferID, particleVertices);
-	renderer.populateAttributeBuffer(this->particleNormalBufferID, particleNormals);
-	renderer.populateAttributeBuffer(this->particleTexCoordBufferID, particleTexCoords);
-	renderer.populateIndexBuffer(this->particleIndexBufferID, particleIndices);
-
 	constexpr int fogMeshVertexCount = 24; // 4 vertices per cube face
 	constexpr int fogMeshIndexCount = 36;
 
@@ -245,25 +174,22 @@ bool RenderWeatherManager::initMeshes(Renderer &renderer)
 		22, 23, 20
 	};
 
-	if (!renderer.tryCreateVertexBuffer(fogMeshVertexCount, positionComponentsPerVertex, &this->fogVertexBufferID))
+	if (!renderer.tryCreateVertexBuffer(fogMeshVertexCount, positionComponentsPerVertex, VertexAttributeFormat::Float32, &this->fogVertexBufferID))
 	{
 		DebugLogError("Couldn't create vertex buffer for fog mesh ID.");
-		this->freeParticleBuffers(renderer);
 		return false;
 	}
 
-	if (!renderer.tryCreateAttributeBuffer(fogMeshVertexCount, normalComponentsPerVertex, &this->fogNormalBufferID))
+	if (!renderer.tryCreateAttributeBuffer(fogMeshVertexCount, normalComponentsPerVertex, VertexAttributeFormat::OctahedralInt16, &this->fogNormalBufferID))
 	{
 		DebugLogError("Couldn't create normal attribute buffer for fog mesh def.");
-		this->freeParticleBuffers(renderer);
 		this->freeFogBuffers(renderer);
 		return false;
 	}
 
-	if (!renderer.tryCreateAttributeBuffer(fogMeshVertexCount, texCoordComponentsPerVertex, &this->fogTexCoordBufferID))
+	if (!renderer.tryCreateAttributeBuffer(fogMeshVertexCount, texCoordComponentsPerVertex, VertexAttributeFormat::Float32, &this->fogTexCoordBufferID))
 	{
 		DebugLogError("Couldn't create tex coord attribute buffer for fog mesh def.");
-		this->freeParticleBuffers(renderer);
 		this->freeFogBuffers(renderer);
 		return false;
 	}
@@ -271,7 +197,6 @@ bool RenderWeatherManager::initMeshes(Renderer &renderer)
 	if (!renderer.tryCreateIndexBuffer(fogMeshIndexCount, &this->fogIndexBufferID))
 	{
 		DebugLogError("Couldn't create index buffer for fog mesh def.");
-		this->freeParticleBuffers(renderer);
 		this->freeFogBuffers(renderer);
 		return false;
 	}
@@ -291,7 +216,7 @@ bool RenderWeatherManager::initTextures(Renderer &renderer)
 	if (!renderer.tryCreateObjectTexture(RainTextureWidth, RainTextureHeight, BytesPerTexel, &this->rainTextureID))
 	{
 		DebugLogError("Couldn't create rain object texture.");
-		this->freeParticleBuffers(renderer);
+		this->freeParticleTextures(renderer);
 		return false;
 	}
 
@@ -299,7 +224,7 @@ bool RenderWeatherManager::initTextures(Renderer &renderer)
 	if (!lockedRainTexture.isValid())
 	{
 		DebugLogError("Couldn't lock rain object texture for writing.");
-		this->freeParticleBuffers(renderer);
+		this->freeParticleTextures(renderer);
 		return false;
 	}
 
@@ -318,7 +243,7 @@ bool RenderWeatherManager::initTextures(Renderer &renderer)
 		if (!renderer.tryCreateObjectTexture(snowTextureWidth, snowTextureHeight, BytesPerTexel, &snowTextureID))
 		{
 			DebugLogError("Couldn't create snow object texture \"" + std::to_string(i) + "\".");
-			this->freeParticleBuffers(renderer);
+			this->freeParticleTextures(renderer);
 			return false;
 		}
 
@@ -326,7 +251,7 @@ bool RenderWeatherManager::initTextures(Renderer &renderer)
 		if (!lockedSnowTexture.isValid())
 		{
 			DebugLogError("Couldn't lock snow object texture \"" + std::to_string(i) + "\" for writing.");
-			this->freeParticleBuffers(renderer);
+			this->freeParticleTextures(renderer);
 			return false;
 		}
 
@@ -380,22 +305,22 @@ bool RenderWeatherManager::init(Renderer &renderer)
 
 void RenderWeatherManager::shutdown(Renderer &renderer)
 {
-	this->freeParticleBuffers(renderer);
-	this->rainDrawCalls.clear();
-	this->snowDrawCalls.clear();
+	this->freeParticleTextures(renderer);
+	this->rainSprites.clear();
+	this->snowSprites.clear();
 
 	this->freeFogBuffers(renderer);
 	this->fogDrawCall.clear();
 }
 
-BufferView<const RenderDrawCall> RenderWeatherManager::getRainDrawCalls() const
+BufferView<const RenderScreenSpaceSprite> RenderWeatherManager::getRainSprites() const
 {
-	return this->rainDrawCalls;
+	return this->rainSprites;
 }
 
-BufferView<const RenderDrawCall> RenderWeatherManager::getSnowDrawCalls() const
+BufferView<const RenderScreenSpaceSprite> RenderWeatherManager::getSnowSprites() const
 {
-	return this->snowDrawCalls;
+	return this->snowSprites;
 }
 
 const RenderDrawCall &RenderWeatherManager::getFogDrawCall() const
@@ -403,32 +328,8 @@ const RenderDrawCall &RenderWeatherManager::getFogDrawCall() const
 	return this->fogDrawCall;
 }
 
-void RenderWeatherManager::freeParticleBuffers(Renderer &renderer)
+void RenderWeatherManager::freeParticleTextures(Renderer &renderer)
 {
-	if (this->particleVertexBufferID >= 0)
-	{
-		renderer.freeVertexBuffer(this->particleVertexBufferID);
-		this->particleVertexBufferID = -1;
-	}
-
-	if (this->particleNormalBufferID >= 0)
-	{
-		renderer.freeAttributeBuffer(this->particleNormalBufferID);
-		this->particleNormalBufferID = -1;
-	}
-
-	if (this->particleTexCoordBufferID >= 0)
-	{
-		renderer.freeAttributeBuffer(this->particleTexCoordBufferID);
-		this->particleTexCoordBufferID = -1;
-	}
-
-	if (this->particleIndexBufferID >= 0)
-	{
-		renderer.freeIndexBuffer(this->particleIndexBufferID);
-		this->particleIndexBufferID = -1;
-	}
-
 	if (this->rainTextureID >= 0)
 	{
 		renderer.freeObjectTexture(this->rainTextureID);
@@ -485,63 +386,36 @@ void RenderWeatherManager::loadScene()
 
 void RenderWeatherManager::update(const WeatherInstance &weatherInst, const RenderCamera &camera)
 {
-	this->rainDrawCalls.clear();
-	this->snowDrawCalls.clear();
+	this->rainSprites.clear();
+	this->snowSprites.clear();
 	this->fogDrawCall.clear();
 
-	auto populateParticleDrawCall = [this, &camera](RenderDrawCall &drawCall, double xPercent, double yPercent,
-		int textureWidth, int textureHeight, ObjectTextureID textureID)
-	{
-		constexpr double arbitraryDistance = 0.005; // Close to camera but in front of near plane. @todo: use shader w/ no depth test
-
-		const Double3 &basePosition = camera.worldPoint;
-		const Double3 centerDir = camera.forwardScaled * arbitraryDistance;
-		const Double3 rightDir = camera.rightScaled * arbitraryDistance;
-		const Double3 upDir = camera.upScaled * arbitraryDistance;
-		const Double3 topLeftPoint = basePosition + centerDir - rightDir + upDir;
-		drawCall.position = topLeftPoint + (rightDir * (2.0 * xPercent)) - (upDir * (2.0 * yPercent));
-
-		drawCall.preScaleTranslation = Double3::Zero;
-
-		const Radians pitchRadians = camera.forward.getYAngleRadians();
-		const Radians yawRadians = MathUtils::fullAtan2(Double2(camera.forward.z, camera.forward.x).normalized()) + Constants::Pi;
-		const Matrix4d pitchRotation = Matrix4d::zRotation(pitchRadians);
-		const Matrix4d yawRotation = Matrix4d::yRotation(yawRadians);
-		drawCall.rotation = yawRotation * pitchRotation;
+	// Particle textures are sized as if they were 1/100th of a unit wide at 1 unit in front of the camera,
+	// and the camera's scaled right/up vectors span half the screen at that distance.
+	const double screenWidthReal = camera.rightScaled.length() * 2.0;
+	const double screenHeightReal = camera.upScaled.length() * 2.0;
 
+	auto populateParticleSprite = [screenWidthReal, screenHeightReal](RenderScreenSpaceSprite &sprite,
+		double xPercent, double yPercent, int textureWidth, int textureHeight, ObjectTextureID textureID)
+	{
 		const double baseWidth = static_cast<double>(textureWidth) / 100.0;
 		const double baseHeight = static_cast<double>(textureHeight) / 100.0;
-		const double scaledWidth = baseWidth * arbitraryDistance;
-		const double scaledHeight = baseHeight * arbitraryDistance;
-		drawCall.scale = Matrix4d::scale(1.0, scaledHeight, scaledWidth);
-
-		drawCall.vertexBufferID = this->particleVertexBufferID;
-		drawCall.normalBufferID = this->particleNormalBufferID;
-		drawCall.texCoordBufferID = this->particleTexCoordBufferID;
-		drawCall.indexBufferID = this->particleIndexBufferID;
-		drawCall.textureIDs[0] = textureID;
-		drawCall.textureIDs[1] = std::nullopt;
-		drawCall.textureSamplingType0 = TextureSamplingType::Default;
-		drawCall.textureSamplingType1 = TextureSamplingType::Default;
-		drawCall.lightingType = RenderLightingType::PerMesh;
-		drawCall.lightPercent = 1.0;
-		drawCall.lightIdCount = 0;
-		drawCall.vertexShaderType = VertexShaderType::SlidingDoor;
-		drawCall.pixelShaderType = PixelShaderType::AlphaTested;
-		drawCall.pixelShaderParam0 = 0.0;
+		const double widthPercent = baseWidth / screenWidthReal;
+		const double heightPercent = baseHeight / screenHeightReal;
+		sprite.init(xPercent, yPercent, widthPercent, heightPercent, textureID);
 	};
 
-	auto populateRainDrawCall = [this, &populateParticleDrawCall](RenderDrawCall &drawCall, double xPercent, double yPercent)
+	auto populateRainSprite = [this, &populateParticleSprite](RenderScreenSpaceSprite &sprite, double xPercent, double yPercent)
 	{
-		populateParticleDrawCall(drawCall, xPercent, yPercent, RainTextureWidth, RainTextureHeight, this->rainTextureID);
+		populateParticleSprite(sprite, xPercent, yPercent, RainTextureWidth, RainTextureHeight, this->rainTextureID);
 	};
 
-	auto populateSnowDrawCall = [this, &populateParticleDrawCall](RenderDrawCall &drawCall, double xPercent, double yPercent, int sizeIndex)
+	auto populateSnowSprite = [this, &populateParticleSprite](RenderScreenSpaceSprite &sprite, double xPercent, double yPercent, int sizeIndex)
 	{
 		const int textureWidth = GetSnowTextureWidth(sizeIndex);
 		const int textureHeight = GetSnowTextureHeight(sizeIndex);
 		const ObjectTextureID textureID = this->snowTextureIDs[sizeIndex];
-		populateParticleDrawCall(drawCall, xPercent, yPercent, textureWidth, textureHeight, textureID);
+		populateParticleSprite(sprite, xPercent, yPercent, textureWidth, textureHeight, textureID);
 	};
 
 	if (weatherInst.hasRain())
@@ -550,15 +424,15 @@ void RenderWeatherManager::update(const WeatherInstance &weatherInst, const Rend
 		const BufferView<const WeatherParticle> rainParticles = rainInst.particles;
 		const int rainParticleCount = rainParticles.getCount();
 
-		if (this->rainDrawCalls.getCount() != rainParticleCount)
+		if (this->rainSprites.getCount() != rainParticleCount)
 		{
-			this->rainDrawCalls.init(rainParticleCount);
+			this->rainSprites.init(rainParticleCount);
 		}
 
 		for (int i = 0; i < rainParticleCount; i++)
 		{
 			const WeatherParticle &rainParticle = rainInst.particles[i];
-			populateRainDrawCall(this->rainDrawCalls[i], rainParticle.xPercent, rainParticle.yPercent);
+			populateRainSprite(this->rainSprites[i], rainParticle.xPercent, rainParticle.yPercent);
 		}
 	}
 
@@ -568,9 +442,9 @@ void RenderWeatherManager::update(const WeatherInstance &weatherInst, const Rend
 		const BufferView<const WeatherParticle> snowParticles = snowInst.particles;
 		const int snowParticleCount = snowParticles.getCount();
 
-		if (this->snowDrawCalls.getCount() != snowParticleCount)
+		if (this->snowSprites.getCount() != snowParticleCount)
 		{
-			this->snowDrawCalls.init(snowParticleCount);
+			this->snowSprites.init(snowParticleCount);
 		}
 
 		constexpr int fastSnowParticleCount = ArenaWeatherUtils::SNOWFLAKE_FAST_COUNT;
@@ -583,7 +457,7 @@ void RenderWeatherManager::update(const WeatherInstance &weatherInst, const Rend
 		for (int i = 0; i < fastSnowParticleCount; i++)
 		{
 			const WeatherParticle &snowParticle = snowInst.particles[i];
-			populateSnowDrawCall(this->snowDrawCalls[i], snowParticle.xPercent, snowParticle.yPercent, 0);
+			populateSnowSprite(this->snowSprites[i], snowParticle.xPercent, snowParticle.yPercent, 0);
 		}
 
 		constexpr int mediumSnowParticleStart = fastSnowParticleEnd;
@@ -591,7 +465,7 @@ void RenderWeatherManager::update(const WeatherInstance &weatherInst, const Rend
 		for (int i = mediumSnowParticleStart; i < mediumSnowParticleEnd; i++)
 		{
 			const WeatherParticle &snowParticle = snowInst.particles[i];
-			populateSnowDrawCall(this->snowDrawCalls[i], snowParticle.xPercent, snowParticle.yPercent, 1);
+			populateSnowSprite(this->snowSprites[i], snowParticle.xPercent, snowParticle.yPercent, 1);
 		}
 
 		constexpr int slowSnowParticleStart = mediumSnowParticleEnd;
@@ -599,7 +473,7 @@ void RenderWeatherManager::update(const WeatherInstance &weatherInst, const Rend
 		for (int i = slowSnowParticleStart; i < slowSnowParticleEnd; i++)
 		{
 			const WeatherParticle &snowParticle = snowInst.particles[i];
-			populateSnowDrawCall(this->snowDrawCalls[i], snowParticle.xPercent, snowParticle.yPercent, 2);
+			populateSnowSprite(this->snowSprites[i], snowParticle.xPercent, snowParticle.yPercent, 2);
 		}
 	}
 
@@ -628,7 +502,7 @@ void RenderWeatherManager::update(const WeatherInstance &weatherInst, const Rend
 
 void RenderWeatherManager::unloadScene()
 {
-	this->rainDrawCalls.clear();
-	this->snowDrawCalls.clear();
+	this->rainSprites.clear();
+	this->snowSprites.clear();
 	this->fogDrawCall.clear();
 }
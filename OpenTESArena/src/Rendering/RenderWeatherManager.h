@@ -2,6 +2,7 @@
 #define RENDER_WEATHER_MANAGER_H
 
 #include "RenderDrawCall.h"
+#include "RenderScreenSpaceSprite.h"
 #include "RenderTextureUtils.h"
 
 #include "components/utilities/Buffer.h"
@@ -14,16 +15,12 @@ struct RenderCamera;
 class RenderWeatherManager
 {
 private:
-	VertexBufferID particleVertexBufferID;
-	AttributeBufferID particleNormalBufferID;
-	AttributeBufferID particleTexCoordBufferID;
-	IndexBufferID particleIndexBufferID;
-
+	// Rain and snow are blitted in screen space after the 3D scene instead of going through the mesh pipeline.
 	ObjectTextureID rainTextureID;
-	Buffer<RenderDrawCall> rainDrawCalls;
+	Buffer<RenderScreenSpaceSprite> rainSprites;
 
 	ObjectTextureID snowTextureIDs[3]; // Each snowflake size has its own texture.
-	Buffer<RenderDrawCall> snowDrawCalls;
+	Buffer<RenderScreenSpaceSprite> snowSprites;
 
 	VertexBufferID fogVertexBufferID;
 	AttributeBufferID fogNormalBufferID;
@@ -35,7 +32,7 @@ private:
 	bool initMeshes(Renderer &renderer);
 	bool initTextures(Renderer &renderer);
 
-	void freeParticleBuffers(Renderer &renderer);
+	void freeParticleTextures(Renderer &renderer);
 	void freeFogBuffers(Renderer &renderer);
 public:
 	RenderWeatherManager();
@@ -43,8 +40,8 @@ public:
 	bool init(Renderer &renderer);
 	void shutdown(Renderer &renderer);
 
-	BufferView<const RenderDrawCall> getRainDrawCalls() const;
-	BufferView<const RenderDrawCall> getSnowDrawCalls() const;
+	BufferView<const RenderScreenSpaceSprite> getRainSprites() const;
+	BufferView<const RenderScreenSpaceSprite> getSnowSprites() const;
 	const RenderDrawCall &getFogDrawCall() const;
 
 	void loadScene();
@@ -8,6 +8,7 @@
 #include "Renderer.h"
 #include "RenderFrameSettings.h"
 #include "RenderInitSettings.h"
+#include "RendererUtils.h"
 #include "SdlUiRenderer.h"
 #include "SoftwareRenderer.h"
 #include "../Assets/TextureManager.h"
@@ -21,6 +22,7 @@
 #include "../Utilities/Platform.h"
 
 #include "components/debug/Debug.h"
+#include "components/utilities/JobSystem.h"
 #include "components/utilities/String.h"
 
 namespace
@@ -109,12 +111,16 @@ Renderer::ProfilerData::ProfilerData()
 	this->visTriangleCount = -1;
 	this->objectTextureCount = -1;
 	this->objectTextureByteCount = -1;
+	this->geometryByteCount = -1;
 	this->totalLightCount = -1;
 	this->frameTime = 0.0;
+	this->waitTime = 0.0;
+	this->latency = 0.0;
 }
 
 void Renderer::ProfilerData::init(int width, int height, int threadCount, int drawCallCount, int sceneTriangleCount,
-	int visTriangleCount, int objectTextureCount, int64_t objectTextureByteCount, int totalLightCount, double frameTime)
+	int visTriangleCount, int objectTextureCount, int64_t objectTextureByteCount, int64_t geometryByteCount,
+	int totalLightCount, double frameTime, double waitTime, double latency)
 {
 	this->width = width;
 	this->height = height;
@@ -124,8 +130,11 @@ void Renderer::ProfilerData::init(int width, int height, int threadCount, int dr
 	this->visTriangleCount = visTriangleCount;
 	this->objectTextureCount = objectTextureCount;
 	this->objectTextureByteCount = objectTextureByteCount;
+	this->geometryByteCount = geometryByteCount;
 	this->totalLightCount = totalLightCount;
 	this->frameTime = frameTime;
+	this->waitTime = waitTime;
+	this->latency = latency;
 }
 
 Renderer::Renderer()
@@ -136,12 +145,31 @@ Renderer::Renderer()
 	this->renderer = nullptr;
 	this->letterboxMode = 0;
 	this->fullGameWindow = false;
+	this->jobSystem = nullptr;
+	this->gameWorldThreadQuit = false;
+	this->gameWorldFrameBusy = false;
+	this->gameWorldFrameSubmitted = false;
+	this->gameWorldFrameTime = 0.0;
+	this->gameWorldWaitTime = 0.0;
 }
 
 Renderer::~Renderer()
 {
 	DebugLog("Closing.");
 
+	if (this->gameWorldThread.joinable())
+	{
+		this->waitForGameWorldFrame();
+
+		{
+			std::lock_guard<std::mutex> lock(this->gameWorldMutex);
+			this->gameWorldThreadQuit = true;
+		}
+
+		this->gameWorldCondition.notify_all();
+		this->gameWorldThread.join();
+	}
+
 	if (this->renderer2D)
 	{
 		this->renderer2D->shutdown();
@@ -478,7 +506,7 @@ Texture Renderer::createTexture(uint32_t format, int access, int w, int h)
 
 bool Renderer::init(int width, int height, WindowMode windowMode, int letterboxMode, bool fullGameWindow,
 	const ResolutionScaleFunc &resolutionScaleFunc, RendererSystemType2D systemType2D, RendererSystemType3D systemType3D,
-	int renderThreadsMode)
+	int renderThreadsMode, JobSystem &jobSystem)
 {
 	DebugLog("Initializing.");
 	const int result = SDL_Init(SDL_INIT_VIDEO); // Required for SDL_GetDesktopDisplayMode() to work for exclusive fullscreen.
@@ -597,9 +625,13 @@ bool Renderer::init(int width, int height, WindowMode windowMode, int letterboxM
 		"Couldn't create game world texture (" + std::string(SDL_GetError()) + ").");
 
 	RenderInitSettings initSettings;
-	initSettings.init(renderWidth, renderHeight, renderThreadsMode);
+	initSettings.init(renderWidth, renderHeight, renderThreadsMode, &jobSystem);
+	this->jobSystem = &jobSystem;
 	this->renderer3D->init(initSettings);
 
+	this->gameWorldFrameBuffer.init(renderWidth * renderHeight);
+	this->gameWorldThread = std::thread(&Renderer::runGameWorldThread, this);
+
 	return true;
 }
 
@@ -621,6 +653,9 @@ void Renderer::resize(int width, int height, double resolutionScale, bool fullGa
 	// Rebuild the 3D renderer if initialized.
 	if (this->renderer3D->isInited())
 	{
+		// The in-flight frame no longer matches the frame buffer.
+		this->discardGameWorldFrame();
+
 		const Int2 viewDims = this->getViewDimensions();
 		const int renderWidth = Renderer::makeRendererDimension(viewDims.x, resolutionScale);
 		const int renderHeight = Renderer::makeRendererDimension(viewDims.y, resolutionScale);
@@ -630,6 +665,7 @@ void Renderer::resize(int width, int height, double resolutionScale, bool fullGa
 		DebugAssertMsg(this->gameWorldTexture.get() != nullptr, "Couldn't recreate game world texture (" + std::string(SDL_GetError()) + ").");
 
 		this->renderer3D->resize(renderWidth, renderHeight);
+		this->gameWorldFrameBuffer.init(renderWidth * renderHeight);
 	}
 }
 
@@ -711,73 +747,87 @@ void Renderer::setClipRect(const SDL_Rect *rect)
 void Renderer::setRenderThreadsMode(int mode)
 {
 	DebugAssert(this->renderer3D->isInited());
-	DebugNotImplementedMsg("setRenderThreadsMode");
-	//this->renderer3D->setRenderThreadsMode(mode); // @todo: figure out if this should be in RenderFrameSettings and obtained via Options
+
+	// Per-frame thread counts come from RenderFrameSettings; only the shared worker pool needs resizing. The
+	// game world thread can't be running jobs while the pool restarts.
+	this->discardGameWorldFrame();
+	this->jobSystem->setWorkerCount(RendererUtils::getJobWorkersFromMode(mode));
 }
 
-bool Renderer::tryCreateVertexBuffer(int vertexCount, int componentsPerVertex, VertexBufferID *outID)
+bool Renderer::tryCreateVertexBuffer(int vertexCount, int componentsPerVertex, VertexAttributeFormat format, VertexBufferID *outID)
 {
 	DebugAssert(this->renderer3D->isInited());
-	return this->renderer3D->tryCreateVertexBuffer(vertexCount, componentsPerVertex, outID);
+	this->waitForGameWorldFrame();
+	return this->renderer3D->tryCreateVertexBuffer(vertexCount, componentsPerVertex, format, outID);
 }
 
-bool Renderer::tryCreateAttributeBuffer(int vertexCount, int componentsPerVertex, AttributeBufferID *outID)
+bool Renderer::tryCreateAttributeBuffer(int vertexCount, int componentsPerVertex, VertexAttributeFormat format, AttributeBufferID *outID)
 {
 	DebugAssert(this->renderer3D->isInited());
-	return this->renderer3D->tryCreateAttributeBuffer(vertexCount, componentsPerVertex, outID);
+	this->waitForGameWorldFrame();
+	return this->renderer3D->tryCreateAttributeBuffer(vertexCount, componentsPerVertex, format, outID);
 }
 
 bool Renderer::tryCreateIndexBuffer(int indexCount, IndexBufferID *outID)
 {
 	DebugAssert(this->renderer3D->isInited());
+	this->waitForGameWorldFrame();
 	return this->renderer3D->tryCreateIndexBuffer(indexCount, outID);
 }
 
 void Renderer::populateVertexBuffer(VertexBufferID id, BufferView<const double> vertices)
 {
 	DebugAssert(this->renderer3D->isInited());
+	this->waitForGameWorldFrame();
 	this->renderer3D->populateVertexBuffer(id, vertices);
 }
 
 void Renderer::populateAttributeBuffer(AttributeBufferID id, BufferView<const double> attributes)
 {
 	DebugAssert(this->renderer3D->isInited());
+	this->waitForGameWorldFrame();
 	this->renderer3D->populateAttributeBuffer(id, attributes);
 }
 
 void Renderer::populateIndexBuffer(IndexBufferID id, BufferView<const int32_t> indices)
 {
 	DebugAssert(this->renderer3D->isInited());
+	this->waitForGameWorldFrame();
 	this->renderer3D->populateIndexBuffer(id, indices);
 }
 
 void Renderer::freeVertexBuffer(VertexBufferID id)
 {
 	DebugAssert(this->renderer3D->isInited());
+	this->waitForGameWorldFrame();
 	this->renderer3D->freeVertexBuffer(id);
 }
 
 void Renderer::freeAttributeBuffer(AttributeBufferID id)
 {
 	DebugAssert(this->renderer3D->isInited());
+	this->waitForGameWorldFrame();
 	this->renderer3D->freeAttributeBuffer(id);
 }
 
 void Renderer::freeIndexBuffer(IndexBufferID id)
 {
 	DebugAssert(this->renderer3D->isInited());
+	this->waitForGameWorldFrame();
 	this->renderer3D->freeIndexBuffer(id);
 }
 
 bool Renderer::tryCreateObjectTexture(int width, int height, int bytesPerTexel, ObjectTextureID *outID)
 {
 	DebugAssert(this->renderer3D->isInited());
+	this->waitForGameWorldFrame();
 	return this->renderer3D->tryCreateObjectTexture(width, height, bytesPerTexel, outID);
 }
 
 bool Renderer::tryCreateObjectTexture(const TextureBuilder &textureBuilder, ObjectTextureID *outID)
 {
 	DebugAssert(this->renderer3D->isInited());
+	this->waitForGameWorldFrame();
 	return this->renderer3D->tryCreateObjectTexture(textureBuilder, outID);
 }
 
@@ -816,6 +866,7 @@ std::optional<Int2> Renderer::tryGetUiTextureDims(UiTextureID id) const
 LockedTexture Renderer::lockObjectTexture(ObjectTextureID id)
 {
 	DebugAssert(this->renderer3D->isInited());
+	this->waitForGameWorldFrame();
 	return this->renderer3D->lockObjectTexture(id);
 }
 
@@ -827,6 +878,7 @@ uint32_t *Renderer::lockUiTexture(UiTextureID textureID)
 void Renderer::unlockObjectTexture(ObjectTextureID id)
 {
 	DebugAssert(this->renderer3D->isInited());
+	this->waitForGameWorldFrame();
 	this->renderer3D->unlockObjectTexture(id);
 }
 
@@ -838,6 +890,7 @@ void Renderer::unlockUiTexture(UiTextureID textureID)
 void Renderer::freeObjectTexture(ObjectTextureID id)
 {
 	DebugAssert(this->renderer3D->isInited());
+	this->waitForGameWorldFrame();
 	this->renderer3D->freeObjectTexture(id);
 }
 
@@ -849,6 +902,7 @@ void Renderer::freeUiTexture(UiTextureID id)
 bool Renderer::tryCreateLight(RenderLightID *outID)
 {
 	DebugAssert(this->renderer3D->isInited());
+	this->waitForGameWorldFrame();
 	return this->renderer3D->tryCreateLight(outID);
 }
 
@@ -867,18 +921,21 @@ void Renderer::getLightRadii(RenderLightID id, double *outStartRadius, double *o
 void Renderer::setLightPosition(RenderLightID id, const Double3 &worldPoint)
 {
 	DebugAssert(this->renderer3D->isInited());
+	this->waitForGameWorldFrame();
 	this->renderer3D->setLightPosition(id, worldPoint);
 }
 
 void Renderer::setLightRadius(RenderLightID id, double startRadius, double endRadius)
 {
 	DebugAssert(this->renderer3D->isInited());
+	this->waitForGameWorldFrame();
 	this->renderer3D->setLightRadius(id, startRadius, endRadius);
 }
 
 void Renderer::freeLight(RenderLightID id)
 {
 	DebugAssert(this->renderer3D->isInited());
+	this->waitForGameWorldFrame();
 	this->renderer3D->freeLight(id);
 }
 
@@ -960,41 +1017,125 @@ void Renderer::fillOriginalRect(const Color &color, int x, int y, int w, int h)
 	SDL_RenderFillRect(this->renderer, &rectSdl);
 }
 
-void Renderer::submitFrame(const RenderCamera &camera, BufferView<const RenderDrawCall> voxelDrawCalls,
-	double ambientPercent, ObjectTextureID paletteTextureID, ObjectTextureID lightTableTextureID, int renderThreadsMode)
+void Renderer::runGameWorldThread()
 {
-	DebugAssert(this->renderer3D->isInited());
+	std::unique_lock<std::mutex> lock(this->gameWorldMutex);
+	while (true)
+	{
+		this->gameWorldCondition.wait(lock, [this]()
+		{
+			return this->gameWorldThreadQuit || this->gameWorldFrameBusy;
+		});
 
-	const Int2 renderDims(this->gameWorldTexture.getWidth(), this->gameWorldTexture.getHeight());
+		if (this->gameWorldThreadQuit)
+		{
+			break;
+		}
 
-	RenderFrameSettings renderFrameSettings;
-	renderFrameSettings.init(ambientPercent, paletteTextureID, lightTableTextureID, renderDims.x, renderDims.y, renderThreadsMode);
+		// The snapshot isn't touched by the game thread while the frame is busy.
+		lock.unlock();
 
-	uint32_t *outputBuffer;
-	int gameWorldPitch;
-	int status = SDL_LockTexture(this->gameWorldTexture.get(), nullptr,
-		reinterpret_cast<void**>(&outputBuffer), &gameWorldPitch);
-	DebugAssertMsg(status == 0, "Couldn't lock game world texture for scene rendering (" + std::string(SDL_GetError()) + ").");
+		const auto startTime = std::chrono::high_resolution_clock::now();
+		this->renderer3D->submitFrame(this->gameWorldCamera, this->gameWorldDrawCalls, this->gameWorldScreenSpaceSprites,
+			this->gameWorldFrameSettings, this->gameWorldFrameBuffer.begin());
+		const auto endTime = std::chrono::high_resolution_clock::now();
+
+		lock.lock();
+		this->gameWorldFrameTime = static_cast<double>((endTime - startTime).count()) / static_cast<double>(std::nano::den);
+		this->gameWorldFrameBusy = false;
+		this->gameWorldCondition.notify_all();
+	}
+}
+
+void Renderer::waitForGameWorldFrame()
+{
+	std::unique_lock<std::mutex> lock(this->gameWorldMutex);
+	if (!this->gameWorldFrameBusy)
+	{
+		return;
+	}
 
-	// Render the game world (no UI).
 	const auto startTime = std::chrono::high_resolution_clock::now();
-	this->renderer3D->submitFrame(camera, voxelDrawCalls, renderFrameSettings, outputBuffer);
+	this->gameWorldCondition.wait(lock, [this]()
+	{
+		return !this->gameWorldFrameBusy;
+	});
+
 	const auto endTime = std::chrono::high_resolution_clock::now();
-	const double frameTime = static_cast<double>((endTime - startTime).count()) / static_cast<double>(std::nano::den);
+	this->gameWorldWaitTime += static_cast<double>((endTime - startTime).count()) / static_cast<double>(std::nano::den);
+}
+
+void Renderer::uploadGameWorldFrame()
+{
+	DebugAssert(this->gameWorldFrameSubmitted);
+
+	const int width = this->gameWorldFrameSettings.renderWidth;
+	const int pitch = width * static_cast<int>(sizeof(uint32_t));
+	const int status = SDL_UpdateTexture(this->gameWorldTexture.get(), nullptr, this->gameWorldFrameBuffer.begin(), pitch);
+	DebugAssertMsg(status == 0, "Couldn't update game world texture (" + std::string(SDL_GetError()) + ").");
+
+	const double latency = static_cast<double>((std::chrono::high_resolution_clock::now() - this->gameWorldSubmitTime).count()) /
+		static_cast<double>(std::nano::den);
 
 	// Update profiler stats.
 	const RendererSystem3D::ProfilerData swProfilerData = this->renderer3D->getProfilerData();
 	this->profilerData.init(swProfilerData.width, swProfilerData.height, swProfilerData.threadCount,
 		swProfilerData.drawCallCount, swProfilerData.sceneTriangleCount, swProfilerData.visTriangleCount,
-		swProfilerData.textureCount, swProfilerData.textureByteCount, swProfilerData.totalLightCount, frameTime);
+		swProfilerData.textureCount, swProfilerData.textureByteCount, swProfilerData.geometryByteCount,
+		swProfilerData.totalLightCount, this->gameWorldFrameTime, this->gameWorldWaitTime, latency);
+
+	this->gameWorldWaitTime = 0.0;
+	this->gameWorldFrameSubmitted = false;
+}
+
+void Renderer::submitFrame(const RenderCamera &camera, BufferView<const RenderDrawCall> voxelDrawCalls,
+	BufferView<const RenderScreenSpaceSprite> screenSpaceSprites, double ambientPercent, ObjectTextureID paletteTextureID,
+	ObjectTextureID lightTableTextureID, int renderThreadsMode)
+{
+	DebugAssert(this->renderer3D->isInited());
+
+	// Show the frame the render thread was working on while this one was simulated.
+	const bool hasPrevFrame = this->gameWorldFrameSubmitted;
+	if (hasPrevFrame)
+	{
+		this->waitForGameWorldFrame();
+		this->uploadGameWorldFrame();
+	}
+
+	const Int2 renderDims(this->gameWorldTexture.getWidth(), this->gameWorldTexture.getHeight());
+	this->gameWorldCamera = camera;
+	this->gameWorldDrawCalls.assign(voxelDrawCalls.begin(), voxelDrawCalls.end());
+	this->gameWorldScreenSpaceSprites.assign(screenSpaceSprites.begin(), screenSpaceSprites.end());
+	this->gameWorldFrameSettings.init(ambientPercent, paletteTextureID, lightTableTextureID, renderDims.x, renderDims.y, renderThreadsMode);
+	this->gameWorldSubmitTime = std::chrono::high_resolution_clock::now();
+	this->gameWorldFrameSubmitted = true;
+
+	{
+		std::lock_guard<std::mutex> lock(this->gameWorldMutex);
+		this->gameWorldFrameBusy = true;
+	}
 
-	// Update the game world texture with the new pixels and copy to the native frame buffer (stretching if needed).
-	SDL_UnlockTexture(this->gameWorldTexture.get());
+	this->gameWorldCondition.notify_all();
 
+	if (!hasPrevFrame)
+	{
+		// Nothing older to show (first frame of a scene, etc.), so this frame can't be overlapped.
+		this->waitForGameWorldFrame();
+		this->uploadGameWorldFrame();
+	}
+
+	// Copy to the native frame buffer (stretching if needed).
 	const Int2 viewDims = this->getViewDimensions();
 	this->draw(this->gameWorldTexture, 0, 0, viewDims.x, viewDims.y);
 }
 
+void Renderer::discardGameWorldFrame()
+{
+	this->waitForGameWorldFrame();
+	this->gameWorldWaitTime = 0.0;
+	this->gameWorldFrameSubmitted = false;
+}
+
 void Renderer::draw(const Texture &texture, int x, int y, int w, int h)
 {
 	SDL_SetRenderTarget(this->renderer, this->nativeTexture.get());
@@ -1,23 +1,33 @@
 #ifndef RENDERER_H
 #define RENDERER_H
 
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <thread>
 #include <vector>
 
 #include "SDL.h"
 
+#include "RenderCamera.h"
+#include "RenderDrawCall.h"
 #include "RendererSystem2D.h"
 #include "RendererSystem3D.h"
 #include "RendererSystemType.h"
+#include "RenderFrameSettings.h"
+#include "RenderScreenSpaceSprite.h"
 #include "../Assets/TextureUtils.h"
 #include "../UI/Texture.h"
 
+#include "components/utilities/Buffer.h"
 #include "components/utilities/BufferView.h"
 
 class Color;
+class JobSystem;
 class Rect;
 class Surface;
 class TextureManager;
@@ -63,16 +73,21 @@ public:
 		// Textures.
 		int objectTextureCount;
 		int64_t objectTextureByteCount;
+
+		int64_t geometryByteCount; // Vertex, attribute, and index buffers.
 		
 		// Lights.
 		int totalLightCount;
 
 		double frameTime;
+		double waitTime; // Time the game thread was blocked on the render thread.
+		double latency; // Time from a frame being submitted to it being displayed.
 
 		ProfilerData();
 
 		void init(int width, int height, int threadCount, int drawCallCount, int sceneTriangleCount, int visTriangleCount,
-			int objectTextureCount, int64_t objectTextureByteCount, int totalLightCount, double frameTime);
+			int objectTextureCount, int64_t objectTextureByteCount, int64_t geometryByteCount, int totalLightCount,
+			double frameTime, double waitTime, double latency);
 	};
 
 	using ResolutionScaleFunc = std::function<double()>;
@@ -88,11 +103,41 @@ private:
 	int letterboxMode; // Determines aspect ratio of the original UI (16:10, 4:3, etc.).
 	bool fullGameWindow; // Determines height of 3D frame buffer.
 
+	JobSystem *jobSystem; // Owned by the game, shared with the 3D renderer.
+
+	// The game world is rasterized on its own thread so the game thread can simulate the next frame at the
+	// same time. The render thread only reads 3D renderer resources, so anything that changes them waits for
+	// the in-flight frame first.
+	std::thread gameWorldThread;
+	std::mutex gameWorldMutex;
+	std::condition_variable gameWorldCondition;
+	bool gameWorldThreadQuit;
+	bool gameWorldFrameBusy; // Render thread is rasterizing the snapshot.
+	bool gameWorldFrameSubmitted; // A snapshot was handed off and its pixels haven't been shown yet.
+
+	// Snapshot of the frame being rasterized, owned by the render thread while it's busy.
+	RenderCamera gameWorldCamera;
+	std::vector<RenderDrawCall> gameWorldDrawCalls;
+	std::vector<RenderScreenSpaceSprite> gameWorldScreenSpaceSprites;
+	RenderFrameSettings gameWorldFrameSettings;
+	Buffer<uint32_t> gameWorldFrameBuffer;
+	double gameWorldFrameTime;
+	double gameWorldWaitTime;
+	std::chrono::high_resolution_clock::time_point gameWorldSubmitTime;
+
 	// Helper method for making a renderer context.
 	static SDL_Renderer *createRenderer(SDL_Window *window);
 
 	// Generates a renderer dimension while avoiding pitfalls of numeric imprecision.
 	static int makeRendererDimension(int value, double resolutionScale);
+
+	void runGameWorldThread();
+
+	// Blocks until the render thread is done with the in-flight game world frame, if any.
+	void waitForGameWorldFrame();
+
+	// Copies the finished game world frame to the game world texture.
+	void uploadGameWorldFrame();
 public:
 	// Only defined so members are initialized for Game ctor exception handling.
 	Renderer();
@@ -153,7 +198,7 @@ public:
 
 	bool init(int width, int height, WindowMode windowMode, int letterboxMode, bool fullGameWindow,
 		const ResolutionScaleFunc &resolutionScaleFunc, RendererSystemType2D systemType2D,
-		RendererSystemType3D systemType3D, int renderThreadsMode);
+		RendererSystemType3D systemType3D, int renderThreadsMode, JobSystem &jobSystem);
 
 	// Resizes the renderer dimensions.
 	void resize(int width, int height, double resolutionScale, bool fullGameWindow);
@@ -181,8 +226,8 @@ public:
 	void setRenderThreadsMode(int mode);
 
 	// Geometry management functions.
-	bool tryCreateVertexBuffer(int vertexCount, int componentsPerVertex, VertexBufferID *outID);
-	bool tryCreateAttributeBuffer(int vertexCount, int componentsPerVertex, AttributeBufferID *outID);
+	bool tryCreateVertexBuffer(int vertexCount, int componentsPerVertex, VertexAttributeFormat format, VertexBufferID *outID);
+	bool tryCreateAttributeBuffer(int vertexCount, int componentsPerVertex, VertexAttributeFormat format, AttributeBufferID *outID);
 	bool tryCreateIndexBuffer(int indexCount, IndexBufferID *outID);
 	void populateVertexBuffer(VertexBufferID id, BufferView<const double> vertices);
 	void populateAttributeBuffer(AttributeBufferID id, BufferView<const double> attributes);
@@ -236,10 +281,15 @@ public:
 	void fillRect(const Color &color, int x, int y, int w, int h);
 	void fillOriginalRect(const Color &color, int x, int y, int w, int h);
 
-	// Runs the 3D renderer which draws the world onto the native frame buffer.
+	// Hands the world to the 3D renderer's thread and draws the previously submitted frame onto the native
+	// frame buffer, so the game world on screen is one frame behind the simulation.
 	void submitFrame(const RenderCamera &camera, BufferView<const RenderDrawCall> voxelDrawCalls,
-		double ambientPercent, ObjectTextureID paletteTextureID, ObjectTextureID lightTableTextureID,
-		int renderThreadsMode);
+		BufferView<const RenderScreenSpaceSprite> screenSpaceSprites, double ambientPercent,
+		ObjectTextureID paletteTextureID, ObjectTextureID lightTableTextureID, int renderThreadsMode);
+
+	// Drops the in-flight game world frame so the next submitted one is shown immediately instead, i.e. so
+	// the old scene isn't displayed for a frame after a scene change.
+	void discardGameWorldFrame();
 
 	// Draw methods for the native and original frame buffers.
 	void draw(const Texture &texture, int x, int y, int w, int h);
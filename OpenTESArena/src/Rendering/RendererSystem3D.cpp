@@ -1,7 +1,7 @@
 #include "RendererSystem3D.h"
 
 RendererSystem3D::ProfilerData::ProfilerData(int width, int height, int threadCount, int drawCallCount, int sceneTriangleCount,
-	int visTriangleCount, int textureCount, int64_t textureByteCount, int totalLightCount)
+	int visTriangleCount, int textureCount, int64_t textureByteCount, int64_t geometryByteCount, int totalLightCount)
 {
 	this->width = width;
 	this->height = height;
@@ -11,6 +11,7 @@ RendererSystem3D::ProfilerData::ProfilerData(int width, int height, int threadCo
 	this->visTriangleCount = visTriangleCount;
 	this->textureCount = textureCount;
 	this->textureByteCount = textureByteCount;
+	this->geometryByteCount = geometryByteCount;
 	this->totalLightCount = totalLightCount;
 }
 
@@ -21,6 +21,7 @@ struct RenderCamera;
 struct RenderDrawCall;
 struct RenderFrameSettings;
 struct RenderInitSettings;
+struct RenderScreenSpaceSprite;
 
 class RendererSystem3D
 {
@@ -34,10 +35,12 @@ public:
 		int sceneTriangleCount, visTriangleCount;
 		int textureCount;
 		int64_t textureByteCount;
+		int64_t geometryByteCount; // Vertex, attribute, and index buffers.
 		int totalLightCount;
 
 		ProfilerData(int width, int height, int threadCount, int drawCallCount, int sceneTriangleCount,
-			int visTriangleCount, int textureCount, int64_t textureByteCount, int totalLightCount);
+			int visTriangleCount, int textureCount, int64_t textureByteCount, int64_t geometryByteCount,
+			int totalLightCount);
 	};
 
 	virtual ~RendererSystem3D();
@@ -50,8 +53,8 @@ public:
 	virtual void resize(int width, int height) = 0;
 
 	// Geometry management functions.
-	virtual bool tryCreateVertexBuffer(int vertexCount, int componentsPerVertex, VertexBufferID *outID) = 0;
-	virtual bool tryCreateAttributeBuffer(int vertexCount, int componentsPerVertex, AttributeBufferID *outID) = 0;
+	virtual bool tryCreateVertexBuffer(int vertexCount, int componentsPerVertex, VertexAttributeFormat format, VertexBufferID *outID) = 0;
+	virtual bool tryCreateAttributeBuffer(int vertexCount, int componentsPerVertex, VertexAttributeFormat format, AttributeBufferID *outID) = 0;
 	virtual bool tryCreateIndexBuffer(int indexCount, IndexBufferID *outID) = 0;
 	virtual void populateVertexBuffer(VertexBufferID id, BufferView<const double> vertices) = 0;
 	virtual void populateAttributeBuffer(AttributeBufferID id, BufferView<const double> attributes) = 0;
@@ -82,9 +85,10 @@ public:
 	virtual ProfilerData getProfilerData() const = 0;
 	
 	// Begins rendering a frame. Currently this is a blocking call and it should be safe to present the frame
-	// upon returning from this.
+	// upon returning from this. Screen-space sprites are drawn in order on top of the 3D scene.
 	virtual void submitFrame(const RenderCamera &camera, BufferView<const RenderDrawCall> drawCalls,
-		const RenderFrameSettings &settings, uint32_t *outputBuffer) = 0;
+		BufferView<const RenderScreenSpaceSprite> screenSpaceSprites, const RenderFrameSettings &settings,
+		uint32_t *outputBuffer) = 0;
 
 	// Presents the finished frame to the screen. This may just be a copy to the screen frame buffer that
 	// is then taken care of by the top-level rendering manager, since UI must be drawn afterwards.
@@ -1,11 +1,13 @@
 #include <algorithm>
 #include <cmath>
+#include <iterator>
 #include <tuple>
 
 #include "ArenaRenderUtils.h"
 #include "RenderCamera.h"
 #include "RendererUtils.h"
 #include "../Game/CardinalDirection.h"
+#include "../Math/BoundingBox.h"
 #include "../Math/Constants.h"
 #include "../Utilities/Platform.h"
 #include "../Voxels/VoxelChunk.h"
@@ -62,6 +64,11 @@ int RendererUtils::getRenderThreadsFromMode(int mode)
 	}
 }
 
+int RendererUtils::getJobWorkersFromMode(int mode)
+{
+	return RendererUtils::getRenderThreadsFromMode(mode) - 1;
+}
+
 bool RendererUtils::isChasmEmissive(ArenaTypes::ChasmType chasmType)
 {
 	switch (chasmType)
@@ -102,6 +109,59 @@ Double3 RendererUtils::clipSpaceToNDC(const Double4 &point)
 	return Double3(point.x * wRecip, point.y * wRecip, point.z * wRecip);
 }
 
+VisibilityType RendererUtils::getBoundingBoxVisibilityType(const BoundingBox3D &bbox, const RenderCamera &camera)
+{
+	// Plane normals point into the frustum.
+	const Double3 planePoints[] =
+	{
+		camera.worldPoint + (camera.forward * RendererUtils::NEAR_PLANE),
+		camera.worldPoint,
+		camera.worldPoint,
+		camera.worldPoint,
+		camera.worldPoint
+	};
+
+	const Double3 planeNormals[] =
+	{
+		camera.forward,
+		camera.leftFrustumNormal,
+		camera.rightFrustumNormal,
+		camera.bottomFrustumNormal,
+		camera.topFrustumNormal
+	};
+
+	static_assert(std::size(planePoints) == std::size(planeNormals));
+
+	bool isPartial = false;
+	for (int i = 0; i < static_cast<int>(std::size(planeNormals)); i++)
+	{
+		const Double3 &planePoint = planePoints[i];
+		const Double3 &planeNormal = planeNormals[i];
+
+		// Corners furthest along and against the plane normal.
+		const Double3 positiveCorner(
+			(planeNormal.x >= 0.0) ? bbox.max.x : bbox.min.x,
+			(planeNormal.y >= 0.0) ? bbox.max.y : bbox.min.y,
+			(planeNormal.z >= 0.0) ? bbox.max.z : bbox.min.z);
+		const Double3 negativeCorner(
+			(planeNormal.x >= 0.0) ? bbox.min.x : bbox.max.x,
+			(planeNormal.y >= 0.0) ? bbox.min.y : bbox.max.y,
+			(planeNormal.z >= 0.0) ? bbox.min.z : bbox.max.z);
+
+		if ((positiveCorner - planePoint).dot(planeNormal) < 0.0)
+		{
+			return VisibilityType::Outside;
+		}
+
+		if ((negativeCorner - planePoint).dot(planeNormal) < 0.0)
+		{
+			isPartial = true;
+		}
+	}
+
+	return isPartial ? VisibilityType::Partial : VisibilityType::Inside;
+}
+
 Double3 RendererUtils::ndcToScreenSpace(const Double3 &point, double yShear, double frameWidth, double frameHeight)
 {
 	const Double3 screenSpacePoint(
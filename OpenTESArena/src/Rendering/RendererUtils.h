@@ -7,8 +7,10 @@
 #include "../Math/Vector3.h"
 #include "../Utilities/Color.h"
 #include "../Utilities/Palette.h"
+#include "VisibilityType.h"
 #include "../Voxels/VoxelUtils.h"
 
+struct BoundingBox3D;
 struct RenderCamera;
 
 namespace RendererUtils
@@ -22,6 +24,10 @@ namespace RendererUtils
 	// Gets the number of render threads to use based on the given mode.
 	int getRenderThreadsFromMode(int mode);
 
+	// Gets the number of job system workers for the given mode. One fewer than the thread count since a
+	// thread waiting on jobs runs them too.
+	int getJobWorkersFromMode(int mode);
+
 	// Returns whether the chasm type is emissive and ignores ambient shading.
 	bool isChasmEmissive(ArenaTypes::ChasmType chasmType);
 
@@ -44,6 +50,9 @@ namespace RendererUtils
 	// Converts a point in homogeneous coordinates to normalized device coordinates by dividing by W.
 	Double3 clipSpaceToNDC(const Double4 &point);
 
+	// Tests the bounding box against the camera's near plane and four side planes.
+	VisibilityType getBoundingBoxVisibilityType(const BoundingBox3D &bbox, const RenderCamera &camera);
+
 	// Converts a point in normalized device coordinates to screen space (pixel coordinates with fractions in
 	// the decimals; the space expected by pixel shading). In other 3D engines this extra step might not be needed
 	// but I think I'm doing something different, can't remember.
@@ -252,6 +252,17 @@ void SdlUiRenderer::draw(const RenderElement *elements, int count, RenderSpace r
 		return newRect;
 	};
 
+	// Only needed for native render space, and it's the same for every element.
+	int renderWidth = 0;
+	int renderHeight = 0;
+	if (renderSpace == RenderSpace::Native)
+	{
+		if (SDL_GetRendererOutputSize(this->renderer, &renderWidth, &renderHeight) != 0)
+		{
+			DebugCrash("Couldn't get renderer output size.");
+		}
+	}
+
 	for (int i = 0; i < count; i++)
 	{
 		const RenderElement &element = elements[i];
@@ -277,12 +288,6 @@ void SdlUiRenderer::draw(const RenderElement *elements, int count, RenderSpace r
 		}
 		else if (renderSpace == RenderSpace::Native)
 		{
-			int renderWidth, renderHeight;
-			if (SDL_GetRendererOutputSize(this->renderer, &renderWidth, &renderHeight) != 0)
-			{
-				DebugCrash("Couldn't get renderer output size.");
-			}
-
 			nativeRect.x = static_cast<int>(std::round(static_cast<double>(element.x) * renderWidth));
 			nativeRect.y = static_cast<int>(std::round(static_cast<double>(element.y) * renderHeight));
 			nativeRect.w = static_cast<int>(std::round(static_cast<double>(element.width) * renderWidth)); // @todo: dimensions should honor pixel centers, right?
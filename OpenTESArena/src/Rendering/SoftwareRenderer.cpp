@@ -3,6 +3,7 @@
 #include <cstring>
 #include <deque>
 #include <limits>
+#include <vector>
 
 #include "ArenaRenderUtils.h"
 #include "LegacyRendererUtils.h"
@@ -11,6 +12,7 @@
 #include "RendererUtils.h"
 #include "RenderFrameSettings.h"
 #include "RenderInitSettings.h"
+#include "RenderScreenSpaceSprite.h"
 #include "SoftwareRenderer.h"
 #include "../Assets/TextureBuilder.h"
 #include "../Math/Constants.h"
@@ -21,10 +23,54 @@
 #include "../World/ChunkUtils.h"
 
 #include "components/debug/Debug.h"
+#include "components/utilities/JobSystem.h"
 
 // Internal geometry types/functions.
 namespace swGeometry
 {
+	// Compact vertex attribute encoding.
+	constexpr double FIXED_POINT_SCALE = RenderGeometryUtils::FIXED_POINT_SCALE;
+	constexpr double FIXED_POINT_SCALE_RECIP = 1.0 / FIXED_POINT_SCALE;
+	constexpr double SNORM16_SCALE = 32767.0;
+	constexpr double SNORM16_SCALE_RECIP = 1.0 / SNORM16_SCALE;
+	constexpr int OCTAHEDRAL_COMPONENTS_PER_VERTEX = 2;
+
+	// Maps a unit vector onto an octahedron unfolded into [-1, 1] on both axes.
+	Double2 EncodeOctahedral(const Double3 &normal)
+	{
+		const double l1Norm = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+		if (l1Norm <= 0.0)
+		{
+			return Double2::Zero;
+		}
+
+		const double x = normal.x / l1Norm;
+		const double y = normal.y / l1Norm;
+		const double z = normal.z / l1Norm;
+		if (z >= 0.0)
+		{
+			return Double2(x, y);
+		}
+
+		return Double2(
+			(1.0 - std::abs(y)) * ((x >= 0.0) ? 1.0 : -1.0),
+			(1.0 - std::abs(x)) * ((y >= 0.0) ? 1.0 : -1.0));
+	}
+
+	Double3 DecodeOctahedral(const Double2 &encoded)
+	{
+		const double z = 1.0 - std::abs(encoded.x) - std::abs(encoded.y);
+		double x = encoded.x;
+		double y = encoded.y;
+		if (z < 0.0)
+		{
+			x = (1.0 - std::abs(encoded.y)) * ((encoded.x >= 0.0) ? 1.0 : -1.0);
+			y = (1.0 - std::abs(encoded.x)) * ((encoded.y >= 0.0) ? 1.0 : -1.0);
+		}
+
+		return Double3(x, y, z).normalized();
+	}
+
 	struct ClippingPlane
 	{
 		Double3 point;
@@ -383,9 +429,9 @@ namespace swGeometry
 		const Double4 modelPositionXYZW(modelPosition, 0.0);
 		const Double4 preScaleTranslationXYZW(preScaleTranslation, 1.0);
 
-		const double *verticesPtr = vertexBuffer.vertices.begin();
-		const double *normalsPtr = normalBuffer.attributes.begin();
-		const double *texCoordsPtr = texCoordBuffer.attributes.begin();
+		const SoftwareRenderer::VertexAttributeData &vertices = vertexBuffer.vertices;
+		const SoftwareRenderer::VertexAttributeData &normals = normalBuffer.attributes;
+		const SoftwareRenderer::VertexAttributeData &texCoords = texCoordBuffer.attributes;
 		const int32_t *indicesPtr = indexBuffer.indices.begin();
 		const int triangleCount = indexBuffer.indices.getCount() / 3;
 		for (int i = 0; i < triangleCount; i++)
@@ -394,43 +440,13 @@ namespace swGeometry
 			const int32_t index0 = indicesPtr[indexBufferBase];
 			const int32_t index1 = indicesPtr[indexBufferBase + 1];
 			const int32_t index2 = indicesPtr[indexBufferBase + 2];
-			const int32_t v0Index = index0 * 3;
-			const int32_t v1Index = index1 * 3;
-			const int32_t v2Index = index2 * 3;
-			const int32_t normal0Index = v0Index;
-			const int32_t normal1Index = v1Index;
-			const int32_t normal2Index = v2Index;
-
-			const Double4 unshadedV0(
-				*(verticesPtr + v0Index),
-				*(verticesPtr + v0Index + 1),
-				*(verticesPtr + v0Index + 2),
-				1.0);
-			const Double4 unshadedV1(
-				*(verticesPtr + v1Index),
-				*(verticesPtr + v1Index + 1),
-				*(verticesPtr + v1Index + 2),
-				1.0);
-			const Double4 unshadedV2(
-				*(verticesPtr + v2Index),
-				*(verticesPtr + v2Index + 1),
-				*(verticesPtr + v2Index + 2),
-				1.0);
-			const Double4 unshadedNormal0(
-				*(normalsPtr + normal0Index),
-				*(normalsPtr + normal0Index + 1),
-				*(normalsPtr + normal0Index + 2),
-				0.0);
-			const Double4 unshadedNormal1(
-				*(normalsPtr + normal1Index),
-				*(normalsPtr + normal1Index + 1),
-				*(normalsPtr + normal1Index + 2),
-				0.0);
-			const Double4 unshadedNormal2(
-				*(normalsPtr + normal2Index),
-				*(normalsPtr + normal2Index + 1),
-				*(normalsPtr + normal2Index + 2),
-				0.0);
+
+			const Double4 unshadedV0(vertices.getDouble3(index0), 1.0);
+			const Double4 unshadedV1(vertices.getDouble3(index1), 1.0);
+			const Double4 unshadedV2(vertices.getDouble3(index2), 1.0);
+			const Double4 unshadedNormal0(normals.getDouble3(index0), 0.0);
+			const Double4 unshadedNormal1(normals.getDouble3(index1), 0.0);
+			const Double4 unshadedNormal2(normals.getDouble3(index2), 0.0);
 
 			Double4 shadedV0, shadedV1, shadedV2;
 			Double4 shadedNormal0, shadedNormal1, shadedNormal2;
@@ -503,15 +519,9 @@ namespace swGeometry
 			const Double3 shadedNormal0XYZ(shadedNormal0.x, shadedNormal0.y, shadedNormal0.z);
 			const Double3 shadedNormal1XYZ(shadedNormal1.x, shadedNormal1.y, shadedNormal1.z);
 			const Double3 shadedNormal2XYZ(shadedNormal2.x, shadedNormal2.y, shadedNormal2.z);
-			const Double2 uv0(
-				*(texCoordsPtr + (index0 * 2)),
-				*(texCoordsPtr + (index0 * 2) + 1));
-			const Double2 uv1(
-				*(texCoordsPtr + (index1 * 2)),
-				*(texCoordsPtr + (index1 * 2) + 1));
-			const Double2 uv2(
-				*(texCoordsPtr + (index2 * 2)),
-				*(texCoordsPtr + (index2 * 2) + 1));
+			const Double2 uv0 = texCoords.getDouble2(index0);
+			const Double2 uv1 = texCoords.getDouble2(index1);
+			const Double2 uv2 = texCoords.getDouble2(index2);
 
 			// Discard back-facing.
 			const Double3 v0ToEye = eye - shadedV0XYZ;
@@ -1275,6 +1285,106 @@ namespace swRender
 			}
 		}
 	}
+
+	// Blits alpha-tested sprites into the rows [startY, endY) of the frame buffer, in submission order. No depth
+	// test; these are always in front of the 3D scene.
+	void DrawScreenSpaceSpritesInRows(BufferView<const RenderScreenSpaceSprite> sprites, int startY, int endY,
+		const SoftwareRenderer::ObjectTexturePool &textures, const SoftwareRenderer::ObjectTexture &paletteTexture,
+		const SoftwareRenderer::ObjectTexture &lightTableTexture, BufferView2D<uint8_t> &paletteIndexBuffer,
+		BufferView2D<uint32_t> &colorBuffer)
+	{
+		const int frameBufferWidth = colorBuffer.getWidth();
+		const int frameBufferHeight = colorBuffer.getHeight();
+		const double frameBufferWidthReal = static_cast<double>(frameBufferWidth);
+		const double frameBufferHeightReal = static_cast<double>(frameBufferHeight);
+		uint8_t *paletteIndexBufferPtr = paletteIndexBuffer.begin();
+		uint32_t *colorBufferPtr = colorBuffer.begin();
+		const uint32_t *paletteColors = paletteTexture.texels32Bit;
+
+		// Same as a per-mesh light percent of 1, the brightest row of the light table.
+		const uint8_t *lightTableTexels = lightTableTexture.texels8Bit;
+
+		for (const RenderScreenSpaceSprite &sprite : sprites)
+		{
+			const SoftwareRenderer::ObjectTexture &texture = textures.get(sprite.textureID);
+
+			const double spriteStartXReal = sprite.xPercent * frameBufferWidthReal;
+			const double spriteStartYReal = sprite.yPercent * frameBufferHeightReal;
+			const double spriteWidthReal = sprite.widthPercent * frameBufferWidthReal;
+			const double spriteHeightReal = sprite.heightPercent * frameBufferHeightReal;
+			if ((spriteWidthReal <= 0.0) || (spriteHeightReal <= 0.0))
+			{
+				continue;
+			}
+
+			const int spriteStartX = static_cast<int>(std::ceil(spriteStartXReal - 0.50));
+			const int spriteEndX = static_cast<int>(std::ceil(spriteStartXReal + spriteWidthReal - 0.50));
+			const int spriteStartY = static_cast<int>(std::ceil(spriteStartYReal - 0.50));
+			const int spriteEndY = static_cast<int>(std::ceil(spriteStartYReal + spriteHeightReal - 0.50));
+			const int xStart = std::clamp(spriteStartX, 0, frameBufferWidth);
+			const int xEnd = std::clamp(spriteEndX, 0, frameBufferWidth);
+			const int yStart = std::clamp(spriteStartY, startY, endY);
+			const int yEnd = std::clamp(spriteEndY, startY, endY);
+
+			for (int y = yStart; y < yEnd; y++)
+			{
+				const double v = ((static_cast<double>(y) + 0.50) - spriteStartYReal) / spriteHeightReal;
+				const int texelY = std::clamp(static_cast<int>(v * texture.heightReal), 0, texture.height - 1);
+				const uint8_t *texelRow = texture.texels8Bit + (texelY * texture.width);
+
+				for (int x = xStart; x < xEnd; x++)
+				{
+					const double u = ((static_cast<double>(x) + 0.50) - spriteStartXReal) / spriteWidthReal;
+					const int texelX = std::clamp(static_cast<int>(u * texture.widthReal), 0, texture.width - 1);
+					const uint8_t texel = texelRow[texelX];
+
+					const bool isTransparent = texel == 0;
+					if (isTransparent)
+					{
+						continue;
+					}
+
+					const uint8_t shadedTexel = lightTableTexels[texel];
+					const int pixelIndex = x + (y * frameBufferWidth);
+					paletteIndexBufferPtr[pixelIndex] = shadedTexel;
+					colorBufferPtr[pixelIndex] = paletteColors[shadedTexel];
+				}
+			}
+		}
+	}
+
+	// Splits the frame buffer into horizontal bands and draws the sprites in each band as its own job.
+	void DrawScreenSpaceSprites(BufferView<const RenderScreenSpaceSprite> sprites, int threadCount, JobSystem &jobSystem,
+		const SoftwareRenderer::ObjectTexturePool &textures, const SoftwareRenderer::ObjectTexture &paletteTexture,
+		const SoftwareRenderer::ObjectTexture &lightTableTexture, BufferView2D<uint8_t> &paletteIndexBuffer,
+		BufferView2D<uint32_t> &colorBuffer)
+	{
+		if (sprites.getCount() == 0)
+		{
+			return;
+		}
+
+		const int frameBufferHeight = colorBuffer.getHeight();
+		const int bandCount = std::clamp(threadCount, 1, std::max(frameBufferHeight, 1));
+		const int rowsPerBand = (frameBufferHeight + bandCount - 1) / bandCount;
+
+		auto drawBand = [&](int bandIndex)
+		{
+			const int startY = std::min(bandIndex * rowsPerBand, frameBufferHeight);
+			const int endY = std::min(startY + rowsPerBand, frameBufferHeight);
+			DrawScreenSpaceSpritesInRows(sprites, startY, endY, textures, paletteTexture, lightTableTexture,
+				paletteIndexBuffer, colorBuffer);
+		};
+
+		// Bands don't overlap so no synchronization is needed.
+		jobSystem.parallelFor(bandCount, 1, [&drawBand](int begin, int end)
+		{
+			for (int i = begin; i < end; i++)
+			{
+				drawBand(i);
+			}
+		});
+	}
 }
 
 SoftwareRenderer::ObjectTexture::ObjectTexture()
@@ -1324,16 +1434,161 @@ void SoftwareRenderer::ObjectTexture::clear()
 	this->texels.clear();
 }
 
-void SoftwareRenderer::VertexBuffer::init(int vertexCount, int componentsPerVertex)
+SoftwareRenderer::VertexAttributeData::VertexAttributeData()
 {
-	const int valueCount = vertexCount * componentsPerVertex;
-	this->vertices.init(valueCount);
+	this->format = static_cast<VertexAttributeFormat>(-1);
+	this->vertexCount = 0;
+	this->componentsPerVertex = 0;
 }
 
-void SoftwareRenderer::AttributeBuffer::init(int vertexCount, int componentsPerVertex)
+void SoftwareRenderer::VertexAttributeData::init(int vertexCount, int componentsPerVertex, VertexAttributeFormat format)
 {
+	this->format = format;
+	this->vertexCount = vertexCount;
+	this->componentsPerVertex = componentsPerVertex;
+
 	const int valueCount = vertexCount * componentsPerVertex;
-	this->attributes.init(valueCount);
+	switch (format)
+	{
+	case VertexAttributeFormat::Float64:
+		this->float64s.init(valueCount);
+		break;
+	case VertexAttributeFormat::Float32:
+		this->float32s.init(valueCount);
+		break;
+	case VertexAttributeFormat::Int16:
+		this->int16s.init(valueCount);
+		break;
+	case VertexAttributeFormat::OctahedralInt16:
+		DebugAssert(componentsPerVertex == 3);
+		this->int16s.init(vertexCount * swGeometry::OCTAHEDRAL_COMPONENTS_PER_VERTEX);
+		break;
+	default:
+		DebugNotImplementedMsg(std::to_string(static_cast<int>(format)));
+		break;
+	}
+}
+
+bool SoftwareRenderer::VertexAttributeData::populate(BufferView<const double> values)
+{
+	if (values.getCount() != (this->vertexCount * this->componentsPerVertex))
+	{
+		return false;
+	}
+
+	switch (this->format)
+	{
+	case VertexAttributeFormat::Float64:
+		std::copy(values.begin(), values.end(), this->float64s.begin());
+		break;
+	case VertexAttributeFormat::Float32:
+		std::transform(values.begin(), values.end(), this->float32s.begin(),
+			[](double value)
+		{
+			return static_cast<float>(value);
+		});
+		break;
+	case VertexAttributeFormat::Int16:
+	{
+		bool isOutOfRange = false;
+		std::transform(values.begin(), values.end(), this->int16s.begin(),
+			[&isOutOfRange](double value)
+		{
+			const double fixedPointValue = std::round(value * swGeometry::FIXED_POINT_SCALE);
+			isOutOfRange |= (fixedPointValue < std::numeric_limits<int16_t>::min()) || (fixedPointValue > std::numeric_limits<int16_t>::max());
+			return static_cast<int16_t>(std::clamp(fixedPointValue,
+				static_cast<double>(std::numeric_limits<int16_t>::min()), static_cast<double>(std::numeric_limits<int16_t>::max())));
+		});
+
+		if (isOutOfRange)
+		{
+			DebugLogWarning("Values out of 16-bit fixed-point range were clamped.");
+		}
+
+		break;
+	}
+	case VertexAttributeFormat::OctahedralInt16:
+		for (int i = 0; i < this->vertexCount; i++)
+		{
+			const int srcIndex = i * this->componentsPerVertex;
+			const Double3 normal(values[srcIndex], values[srcIndex + 1], values[srcIndex + 2]);
+			const Double2 encoded = swGeometry::EncodeOctahedral(normal);
+			const int dstIndex = i * swGeometry::OCTAHEDRAL_COMPONENTS_PER_VERTEX;
+			this->int16s.set(dstIndex, static_cast<int16_t>(std::round(encoded.x * swGeometry::SNORM16_SCALE)));
+			this->int16s.set(dstIndex + 1, static_cast<int16_t>(std::round(encoded.y * swGeometry::SNORM16_SCALE)));
+		}
+
+		break;
+	default:
+		DebugNotImplementedMsg(std::to_string(static_cast<int>(this->format)));
+		break;
+	}
+
+	return true;
+}
+
+int SoftwareRenderer::VertexAttributeData::getByteCount() const
+{
+	return (this->float64s.getCount() * static_cast<int>(sizeof(double))) +
+		(this->float32s.getCount() * static_cast<int>(sizeof(float))) +
+		(this->int16s.getCount() * static_cast<int>(sizeof(int16_t)));
+}
+
+Double2 SoftwareRenderer::VertexAttributeData::getDouble2(int vertexIndex) const
+{
+	DebugAssert(this->componentsPerVertex == 2);
+	const int index = vertexIndex * 2;
+	switch (this->format)
+	{
+	case VertexAttributeFormat::Float64:
+		return Double2(this->float64s[index], this->float64s[index + 1]);
+	case VertexAttributeFormat::Float32:
+		return Double2(this->float32s[index], this->float32s[index + 1]);
+	case VertexAttributeFormat::Int16:
+		return Double2(
+			static_cast<double>(this->int16s[index]) * swGeometry::FIXED_POINT_SCALE_RECIP,
+			static_cast<double>(this->int16s[index + 1]) * swGeometry::FIXED_POINT_SCALE_RECIP);
+	default:
+		DebugUnhandledReturnMsg(Double2, std::to_string(static_cast<int>(this->format)));
+	}
+}
+
+Double3 SoftwareRenderer::VertexAttributeData::getDouble3(int vertexIndex) const
+{
+	DebugAssert(this->componentsPerVertex == 3);
+	const int index = vertexIndex * 3;
+	switch (this->format)
+	{
+	case VertexAttributeFormat::Float64:
+		return Double3(this->float64s[index], this->float64s[index + 1], this->float64s[index + 2]);
+	case VertexAttributeFormat::Float32:
+		return Double3(this->float32s[index], this->float32s[index + 1], this->float32s[index + 2]);
+	case VertexAttributeFormat::Int16:
+		return Double3(
+			static_cast<double>(this->int16s[index]) * swGeometry::FIXED_POINT_SCALE_RECIP,
+			static_cast<double>(this->int16s[index + 1]) * swGeometry::FIXED_POINT_SCALE_RECIP,
+			static_cast<double>(this->int16s[index + 2]) * swGeometry::FIXED_POINT_SCALE_RECIP);
+	case VertexAttributeFormat::OctahedralInt16:
+	{
+		const int encodedIndex = vertexIndex * swGeometry::OCTAHEDRAL_COMPONENTS_PER_VERTEX;
+		const Double2 encoded(
+			static_cast<double>(this->int16s[encodedIndex]) * swGeometry::SNORM16_SCALE_RECIP,
+			static_cast<double>(this->int16s[encodedIndex + 1]) * swGeometry::SNORM16_SCALE_RECIP);
+		return swGeometry::DecodeOctahedral(encoded);
+	}
+	default:
+		DebugUnhandledReturnMsg(Double3, std::to_string(static_cast<int>(this->format)));
+	}
+}
+
+void SoftwareRenderer::VertexBuffer::init(int vertexCount, int componentsPerVertex, VertexAttributeFormat format)
+{
+	this->vertices.init(vertexCount, componentsPerVertex, format);
+}
+
+void SoftwareRenderer::AttributeBuffer::init(int vertexCount, int componentsPerVertex, VertexAttributeFormat format)
+{
+	this->attributes.init(vertexCount, componentsPerVertex, format);
 }
 
 void SoftwareRenderer::IndexBuffer::init(int indexCount)
@@ -1356,7 +1611,7 @@ void SoftwareRenderer::Light::init(const Double3 &worldPoint, double startRadius
 
 SoftwareRenderer::SoftwareRenderer()
 {
-
+	this->jobSystem = nullptr;
 }
 
 SoftwareRenderer::~SoftwareRenderer()
@@ -1366,8 +1621,10 @@ SoftwareRenderer::~SoftwareRenderer()
 
 void SoftwareRenderer::init(const RenderInitSettings &settings)
 {
+	DebugAssert(settings.jobSystem != nullptr);
 	this->paletteIndexBuffer.init(settings.width, settings.height);
 	this->depthBuffer.init(settings.width, settings.height);
+	this->jobSystem = settings.jobSystem;
 }
 
 void SoftwareRenderer::shutdown()
@@ -1395,7 +1652,7 @@ void SoftwareRenderer::resize(int width, int height)
 	this->depthBuffer.fill(std::numeric_limits<double>::infinity());
 }
 
-bool SoftwareRenderer::tryCreateVertexBuffer(int vertexCount, int componentsPerVertex, VertexBufferID *outID)
+bool SoftwareRenderer::tryCreateVertexBuffer(int vertexCount, int componentsPerVertex, VertexAttributeFormat format, VertexBufferID *outID)
 {
 	DebugAssert(vertexCount > 0);
 	DebugAssert(componentsPerVertex >= 2);
@@ -1407,11 +1664,11 @@ bool SoftwareRenderer::tryCreateVertexBuffer(int vertexCount, int componentsPerV
 	}
 
 	VertexBuffer &buffer = this->vertexBuffers.get(*outID);
-	buffer.init(vertexCount, componentsPerVertex);
+	buffer.init(vertexCount, componentsPerVertex, format);
 	return true;
 }
 
-bool SoftwareRenderer::tryCreateAttributeBuffer(int vertexCount, int componentsPerVertex, AttributeBufferID *outID)
+bool SoftwareRenderer::tryCreateAttributeBuffer(int vertexCount, int componentsPerVertex, VertexAttributeFormat format, AttributeBufferID *outID)
 {
 	DebugAssert(vertexCount > 0);
 	DebugAssert(componentsPerVertex >= 2);
@@ -1423,7 +1680,7 @@ bool SoftwareRenderer::tryCreateAttributeBuffer(int vertexCount, int componentsP
 	}
 
 	AttributeBuffer &buffer = this->attributeBuffers.get(*outID);
-	buffer.init(vertexCount, componentsPerVertex);
+	buffer.init(vertexCount, componentsPerVertex, format);
 	return true;
 }
 
@@ -1446,35 +1703,23 @@ bool SoftwareRenderer::tryCreateIndexBuffer(int indexCount, IndexBufferID *outID
 void SoftwareRenderer::populateVertexBuffer(VertexBufferID id, BufferView<const double> vertices)
 {
 	VertexBuffer &buffer = this->vertexBuffers.get(id);
-	const int srcCount = vertices.getCount();
-	const int dstCount = buffer.vertices.getCount();
-	if (srcCount != dstCount)
+	VertexAttributeData &dstData = buffer.vertices;
+	if (!dstData.populate(vertices))
 	{
 		DebugLogError("Mismatched vertex buffer sizes for ID " + std::to_string(id) + ": " +
-			std::to_string(srcCount) + " != " + std::to_string(dstCount));
-		return;
+			std::to_string(vertices.getCount()) + " != " + std::to_string(dstData.vertexCount * dstData.componentsPerVertex));
 	}
-
-	const auto srcBegin = vertices.begin();
-	const auto srcEnd = srcBegin + srcCount;
-	std::copy(srcBegin, srcEnd, buffer.vertices.begin());
 }
 
 void SoftwareRenderer::populateAttributeBuffer(AttributeBufferID id, BufferView<const double> attributes)
 {
 	AttributeBuffer &buffer = this->attributeBuffers.get(id);
-	const int srcCount = attributes.getCount();
-	const int dstCount = buffer.attributes.getCount();
-	if (srcCount != dstCount)
+	VertexAttributeData &dstData = buffer.attributes;
+	if (!dstData.populate(attributes))
 	{
 		DebugLogError("Mismatched attribute buffer sizes for ID " + std::to_string(id) + ": " +
-			std::to_string(srcCount) + " != " + std::to_string(dstCount));
-		return;
+			std::to_string(attributes.getCount()) + " != " + std::to_string(dstData.vertexCount * dstData.componentsPerVertex));
 	}
-
-	const auto srcBegin = attributes.begin();
-	const auto srcEnd = srcBegin + srcCount;
-	std::copy(srcBegin, srcEnd, buffer.attributes.begin());
 }
 
 void SoftwareRenderer::populateIndexBuffer(IndexBufferID id, BufferView<const int32_t> indices)
@@ -1647,14 +1892,43 @@ RendererSystem3D::ProfilerData SoftwareRenderer::getProfilerData() const
 		}
 	}
 
+	int64_t geometryByteCount = 0;
+	for (int i = 0; i < this->vertexBuffers.getTotalCount(); i++)
+	{
+		const VertexBuffer *vertexBufferPtr = this->vertexBuffers.tryGet(static_cast<VertexBufferID>(i));
+		if (vertexBufferPtr != nullptr)
+		{
+			geometryByteCount += vertexBufferPtr->vertices.getByteCount();
+		}
+	}
+
+	for (int i = 0; i < this->attributeBuffers.getTotalCount(); i++)
+	{
+		const AttributeBuffer *attributeBufferPtr = this->attributeBuffers.tryGet(static_cast<AttributeBufferID>(i));
+		if (attributeBufferPtr != nullptr)
+		{
+			geometryByteCount += attributeBufferPtr->attributes.getByteCount();
+		}
+	}
+
+	for (int i = 0; i < this->indexBuffers.getTotalCount(); i++)
+	{
+		const IndexBuffer *indexBufferPtr = this->indexBuffers.tryGet(static_cast<IndexBufferID>(i));
+		if (indexBufferPtr != nullptr)
+		{
+			geometryByteCount += indexBufferPtr->indices.getCount() * static_cast<int64_t>(sizeof(int32_t));
+		}
+	}
+
 	const int totalLightCount = this->lights.getUsedCount();
 
 	return ProfilerData(renderWidth, renderHeight, threadCount, drawCallCount, sceneTriangleCount,
-		visTriangleCount, textureCount, textureByteCount, totalLightCount);
+		visTriangleCount, textureCount, textureByteCount, geometryByteCount, totalLightCount);
 }
 
 void SoftwareRenderer::submitFrame(const RenderCamera &camera, BufferView<const RenderDrawCall> drawCalls,
-	const RenderFrameSettings &settings, uint32_t *outputBuffer)
+	BufferView<const RenderScreenSpaceSprite> screenSpaceSprites, const RenderFrameSettings &settings,
+	uint32_t *outputBuffer)
 {
 	const int frameBufferWidth = this->paletteIndexBuffer.getWidth();
 	const int frameBufferHeight = this->paletteIndexBuffer.getHeight();
@@ -1724,6 +1998,10 @@ void SoftwareRenderer::submitFrame(const RenderCamera &camera, BufferView<const
 			ambientPercent, lightsView, pixelShaderType, pixelShaderParam0, this->objectTextures, paletteTexture, lightTableTexture,
 			camera, paletteIndexBufferView, depthBufferView, colorBufferView);
 	}
+
+	const int threadCount = RendererUtils::getRenderThreadsFromMode(settings.renderThreadsMode);
+	swRender::DrawScreenSpaceSprites(screenSpaceSprites, threadCount, *this->jobSystem, this->objectTextures, paletteTexture,
+		lightTableTexture, paletteIndexBufferView, colorBufferView);
 }
 
 void SoftwareRenderer::present()
@@ -23,6 +23,8 @@
 #include "components/utilities/BufferView3D.h"
 #include "components/utilities/RecyclablePool.h"
 
+class JobSystem;
+
 class SoftwareRenderer : public RendererSystem3D
 {
 public:
@@ -43,18 +45,37 @@ public:
 
 	using ObjectTexturePool = RecyclablePool<ObjectTexture, ObjectTextureID>;
 
+	// Per-vertex components stored in one of the compact formats and decoded in the vertex stage.
+	struct VertexAttributeData
+	{
+		Buffer<double> float64s;
+		Buffer<float> float32s;
+		Buffer<int16_t> int16s;
+		VertexAttributeFormat format;
+		int vertexCount;
+		int componentsPerVertex; // Before encoding.
+
+		VertexAttributeData();
+
+		void init(int vertexCount, int componentsPerVertex, VertexAttributeFormat format);
+		bool populate(BufferView<const double> values);
+		int getByteCount() const;
+		Double2 getDouble2(int vertexIndex) const;
+		Double3 getDouble3(int vertexIndex) const;
+	};
+
 	struct VertexBuffer
 	{
-		Buffer<double> vertices;
+		VertexAttributeData vertices;
 
-		void init(int vertexCount, int componentsPerVertex);
+		void init(int vertexCount, int componentsPerVertex, VertexAttributeFormat format);
 	};
 
 	struct AttributeBuffer
 	{
-		Buffer<double> attributes;
+		VertexAttributeData attributes;
 
-		void init(int vertexCount, int componentsPerVertex);
+		void init(int vertexCount, int componentsPerVertex, VertexAttributeFormat format);
 	};
 
 	struct IndexBuffer
@@ -86,6 +107,7 @@ private:
 	IndexBufferPool indexBuffers;
 	ObjectTexturePool objectTextures;
 	LightPool lights;
+	JobSystem *jobSystem;
 public:
 	SoftwareRenderer();
 	~SoftwareRenderer() override;
@@ -96,8 +118,8 @@ public:
 
 	void resize(int width, int height) override;
 
-	bool tryCreateVertexBuffer(int vertexCount, int componentsPerVertex, VertexBufferID *outID) override;
-	bool tryCreateAttributeBuffer(int vertexCount, int componentsPerVertex, AttributeBufferID *outID) override;
+	bool tryCreateVertexBuffer(int vertexCount, int componentsPerVertex, VertexAttributeFormat format, VertexBufferID *outID) override;
+	bool tryCreateAttributeBuffer(int vertexCount, int componentsPerVertex, VertexAttributeFormat format, AttributeBufferID *outID) override;
 	bool tryCreateIndexBuffer(int indexCount, IndexBufferID *outID) override;
 	void populateVertexBuffer(VertexBufferID id, BufferView<const double> vertices) override;
 	void populateAttributeBuffer(AttributeBufferID id, BufferView<const double> attributes) override;
@@ -123,7 +145,8 @@ public:
 	ProfilerData getProfilerData() const override;
 
 	void submitFrame(const RenderCamera &camera, BufferView<const RenderDrawCall> drawCalls,
-		const RenderFrameSettings &settings, uint32_t *outputBuffer) override;
+		BufferView<const RenderScreenSpaceSprite> screenSpaceSprites, const RenderFrameSettings &settings,
+		uint32_t *outputBuffer) override;
 	void present() override;
 };
 
@@ -9,6 +9,7 @@
 
 FontDefinition::FontDefinition()
 {
+	this->asciiCharIDs.fill(-1);
 	this->characterHeight = -1;
 }
 
@@ -49,6 +50,12 @@ bool FontDefinition::init(const char *filename)
 
 		const CharID charID = static_cast<CharID>(i);
 		this->charIDs.emplace(std::move(lookupStr), charID);
+
+		const unsigned char asciiIndex = static_cast<unsigned char>(c);
+		if (asciiIndex < this->asciiCharIDs.size())
+		{
+			this->asciiCharIDs[asciiIndex] = charID;
+		}
 	}
 
 	return true;
@@ -104,6 +111,24 @@ bool FontDefinition::tryGetCharacterID(const char *c, CharID *outID) const
 	}
 }
 
+bool FontDefinition::tryGetCharacterID(char c, CharID *outID) const
+{
+	const unsigned char asciiIndex = static_cast<unsigned char>(c);
+	if (asciiIndex >= this->asciiCharIDs.size())
+	{
+		return false;
+	}
+
+	const CharID charID = this->asciiCharIDs[asciiIndex];
+	if (charID < 0)
+	{
+		return false;
+	}
+
+	*outID = charID;
+	return true;
+}
+
 const FontDefinition::Character &FontDefinition::getCharacter(CharID id) const
 {
 	DebugAssert(id >= 0);
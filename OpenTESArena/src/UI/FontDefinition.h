@@ -1,6 +1,7 @@
 #ifndef FONT_DEFINITION_H
 #define FONT_DEFINITION_H
 
+#include <array>
 #include <string>
 #include <unordered_map>
 
@@ -20,6 +21,7 @@ public:
 private:
 	Buffer<Character> characters;
 	std::unordered_map<std::string, CharID> charIDs;
+	std::array<CharID, 128> asciiCharIDs; // Direct look-up for ASCII, -1 if not in the font.
 	std::string name;
 	int characterHeight;
 
@@ -39,6 +41,9 @@ public:
 	// Attempts to get the character ID associated with the given UTF-8 character.
 	bool tryGetCharacterID(const char *c, CharID *outID) const;
 
+	// Faster look-up for a single ASCII character, used when laying out text.
+	bool tryGetCharacterID(char c, CharID *outID) const;
+
 	const Character &getCharacter(CharID id) const;
 };
 
@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <cmath>
 
 #include "SDL.h"
 
@@ -93,9 +94,13 @@ TextBox::InitInfo TextBox::InitInfo::makeWithXY(const std::string_view &text, in
 	return InitInfo::makeWithXY(text, x, y, fontName, textColor, alignment, shadow, lineSpacing, fontLibrary);
 }
 
+TextBox::LineLayout::LineLayout(const std::string_view &text, Buffer<FontDefinition::CharID> &&charIDs, const Int2 &offset)
+	: text(text), charIDs(std::move(charIDs)), offset(offset) { }
+
 TextBox::TextBox()
 {
 	this->dirty = false;
+	this->allLinesDirty = false;
 }
 
 bool TextBox::init(const Rect &rect, const Properties &properties, Renderer &renderer)
@@ -114,7 +119,11 @@ bool TextBox::init(const Rect &rect, const Properties &properties, Renderer &ren
 	}
 	
 	this->textureRef.init(textureID, renderer);
+	this->texels.init(textureWidth, textureHeight);
+	this->texels.fill(0);
+	this->lineLayouts.clear();
 	this->dirty = true;
+	this->allLinesDirty = true;
 	return true;
 }
 
@@ -152,6 +161,12 @@ UiTextureID TextBox::getTextureID()
 
 void TextBox::setText(const std::string_view &text)
 {
+	// Some text is set every frame whether or not it changed.
+	if (text == this->text)
+	{
+		return;
+	}
+
 	this->text = std::string(text);
 	this->dirty = true;
 }
@@ -160,12 +175,19 @@ void TextBox::addOverrideColor(int charIndex, const Color &overrideColor)
 {
 	this->colorOverrideInfo.add(charIndex, overrideColor);
 	this->dirty = true;
+	this->allLinesDirty = true;
 }
 
 void TextBox::clearOverrideColors()
 {
+	if (this->colorOverrideInfo.getEntryCount() == 0)
+	{
+		return;
+	}
+
 	this->colorOverrideInfo.clear();
 	this->dirty = true;
+	this->allLinesDirty = true;
 }
 
 void TextBox::updateTexture()
@@ -175,36 +197,123 @@ void TextBox::updateTexture()
 		return;
 	}
 
-	uint32_t *texels = this->textureRef.lockTexels();
-	if (texels == nullptr)
-	{
-		DebugLogError("Couldn't lock text box UI texture for updating.");
-		return;
-	}
-
 	// Stored for convenience of redrawing the texture. Couldn't immediately find a better way to do this.
 	// - Maybe try a FontDefinitionRef in the future.
 	const FontLibrary *fontLibrary = this->properties.fontLibrary;
 	DebugAssert(fontLibrary != nullptr);
 
 	const FontDefinition &fontDef = fontLibrary->getDefinition(this->properties.fontDefIndex);
+	const std::optional<TextRenderUtils::TextShadowInfo> &shadowInfo = this->properties.shadowInfo;
 
 	const int width = this->textureRef.getWidth();
 	const int height = this->textureRef.getHeight();
-	BufferView2D<uint32_t> textureView(texels, width, height);
-
-	// Clear texture.
-	textureView.fill(0);
 
+	// Lay out the new text and find which rows of the texture it changes compared to the last update.
+	std::vector<LineLayout> newLineLayouts;
 	if (!this->text.empty())
 	{
 		const Buffer<std::string_view> textLines = TextRenderUtils::getTextLines(this->text);
-		const TextRenderUtils::ColorOverrideInfo *colorOverrideInfoPtr = (this->colorOverrideInfo.getEntryCount() > 0) ? &this->colorOverrideInfo : nullptr;
-		const TextRenderUtils::TextShadowInfo *shadowInfoPtr = this->properties.shadowInfo.has_value() ? &(*this->properties.shadowInfo) : nullptr;
-		TextRenderUtils::drawTextLines(textLines, fontDef, 0, 0, this->properties.defaultColor, this->properties.alignment,
-			this->properties.lineSpacing, colorOverrideInfoPtr, shadowInfoPtr, textureView);
+		const Buffer<Int2> offsets = TextRenderUtils::makeAlignmentOffsets(textLines, width, height,
+			this->properties.alignment, fontDef, shadowInfo, this->properties.lineSpacing);
+
+		newLineLayouts.reserve(textLines.getCount());
+		for (int i = 0; i < textLines.getCount(); i++)
+		{
+			const std::string_view &textLine = textLines.get(i);
+			const Int2 &offset = offsets.get(i);
+			const bool canReuseCharIDs = (i < static_cast<int>(this->lineLayouts.size())) && (this->lineLayouts[i].text == textLine);
+			Buffer<FontDefinition::CharID> charIDs = canReuseCharIDs ?
+				std::move(this->lineLayouts[i].charIDs) : TextRenderUtils::getLineFontCharIDs(textLine, fontDef);
+			newLineLayouts.emplace_back(LineLayout(textLine, std::move(charIDs), offset));
+		}
 	}
 
-	this->textureRef.unlockTexels();
+	// Lines are drawn across their full character height plus any shadow, which starts above the line if
+	// its offset is negative.
+	const int shadowOffsetY = shadowInfo.has_value() ? shadowInfo->offsetY : 0;
+	const int lineTopOffsetY = std::min(shadowOffsetY, 0);
+	const int lineHeight = fontDef.getCharacterHeight() + std::abs(shadowOffsetY);
+	int dirtyStartY = height;
+	int dirtyEndY = 0;
+	auto addDirtyRows = [lineTopOffsetY, lineHeight, &dirtyStartY, &dirtyEndY](int y)
+	{
+		const int lineStartY = y + lineTopOffsetY;
+		dirtyStartY = std::min(dirtyStartY, lineStartY);
+		dirtyEndY = std::max(dirtyEndY, lineStartY + lineHeight);
+	};
+
+	const int oldLineCount = static_cast<int>(this->lineLayouts.size());
+	const int newLineCount = static_cast<int>(newLineLayouts.size());
+	if (this->allLinesDirty)
+	{
+		dirtyStartY = 0;
+		dirtyEndY = height;
+	}
+	else
+	{
+		for (int i = 0; i < std::max(oldLineCount, newLineCount); i++)
+		{
+			const LineLayout *oldLineLayout = (i < oldLineCount) ? &this->lineLayouts[i] : nullptr;
+			const LineLayout *newLineLayout = (i < newLineCount) ? &newLineLayouts[i] : nullptr;
+			const bool isLineUnchanged = (oldLineLayout != nullptr) && (newLineLayout != nullptr) &&
+				(oldLineLayout->text == newLineLayout->text) && (oldLineLayout->offset == newLineLayout->offset);
+			if (isLineUnchanged)
+			{
+				continue;
+			}
+
+			if (oldLineLayout != nullptr)
+			{
+				addDirtyRows(oldLineLayout->offset.y);
+			}
+
+			if (newLineLayout != nullptr)
+			{
+				addDirtyRows(newLineLayout->offset.y);
+			}
+		}
+	}
+
+	dirtyStartY = std::max(dirtyStartY, 0);
+	dirtyEndY = std::min(dirtyEndY, height);
+	this->lineLayouts = std::move(newLineLayouts);
 	this->dirty = false;
+	this->allLinesDirty = false;
+
+	if (dirtyStartY >= dirtyEndY)
+	{
+		return;
+	}
+
+	// Clear and redraw only the dirty rows. Lines partially in those rows are drawn clipped to them so
+	// pixels outside are left as they were.
+	const int dirtyHeight = dirtyEndY - dirtyStartY;
+	BufferView2D<uint32_t> dirtyView(this->texels.begin(), width, height, 0, dirtyStartY, width, dirtyHeight);
+	dirtyView.fill(0);
+
+	const TextRenderUtils::ColorOverrideInfo *colorOverrideInfoPtr = (this->colorOverrideInfo.getEntryCount() > 0) ? &this->colorOverrideInfo : nullptr;
+	const TextRenderUtils::TextShadowInfo *shadowInfoPtr = shadowInfo.has_value() ? &(*shadowInfo) : nullptr;
+	for (const LineLayout &lineLayout : this->lineLayouts)
+	{
+		const int lineStartY = lineLayout.offset.y + lineTopOffsetY;
+		const int lineEndY = lineStartY + lineHeight;
+		if ((lineEndY <= dirtyStartY) || (lineStartY >= dirtyEndY))
+		{
+			continue;
+		}
+
+		const BufferView<const FontDefinition::CharID> charIdsView(lineLayout.charIDs);
+		TextRenderUtils::drawTextLine(charIdsView, fontDef, lineLayout.offset.x, lineLayout.offset.y - dirtyStartY,
+			this->properties.defaultColor, colorOverrideInfoPtr, shadowInfoPtr, dirtyView);
+	}
+
+	uint32_t *dstTexels = this->textureRef.lockTexels();
+	if (dstTexels == nullptr)
+	{
+		DebugLogError("Couldn't lock text box UI texture for updating.");
+		return;
+	}
+
+	std::copy(this->texels.begin(), this->texels.end(), dstTexels);
+	this->textureRef.unlockTexels();
 }
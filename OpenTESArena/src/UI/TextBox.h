@@ -11,6 +11,8 @@
 #include "../Rendering/RenderTextureUtils.h"
 #include "../Utilities/Color.h"
 
+#include "components/utilities/Buffer2D.h"
+
 class FontLibrary;
 class Renderer;
 
@@ -58,14 +60,27 @@ public:
 			const Color &textColor, TextAlignment alignment, const FontLibrary &fontLibrary);
 	};
 private:
+	// A line of text as it was last drawn to the texture, so unchanged lines aren't redrawn.
+	struct LineLayout
+	{
+		std::string text;
+		Buffer<FontDefinition::CharID> charIDs;
+		Int2 offset; // Top-left corner in the texture.
+
+		LineLayout(const std::string_view &text, Buffer<FontDefinition::CharID> &&charIDs, const Int2 &offset);
+	};
+
 	Rect rect; // Screen position and render dimensions (NOT texture dimensions).
 	Properties properties;
 	std::string text;
 	TextRenderUtils::ColorOverrideInfo colorOverrideInfo;
 	ScopedUiTextureRef textureRef; // Output texture for rendering.
+	Buffer2D<uint32_t> texels; // CPU copy of the texture since locked texels are write-only with undefined contents.
+	std::vector<LineLayout> lineLayouts;
 	bool dirty;
+	bool allLinesDirty; // Set when something affecting every line changes, like color overrides.
 
-	// Redraws the underlying texture for display.
+	// Redraws the rows covered by changed lines, then uploads the whole texture.
 	void updateTexture();
 public:
 	TextBox();
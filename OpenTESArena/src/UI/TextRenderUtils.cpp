@@ -120,7 +120,7 @@ Buffer<std::string_view> TextRenderUtils::getTextLines(const std::string_view &t
 Buffer<FontDefinition::CharID> TextRenderUtils::getLineFontCharIDs(const std::string_view &line, const FontDefinition &fontDef)
 {
 	FontDefinition::CharID fallbackCharID;
-	if (!fontDef.tryGetCharacterID("?", &fallbackCharID))
+	if (!fontDef.tryGetCharacterID('?', &fallbackCharID))
 	{
 		DebugCrash("Couldn't get fallback font character ID from font \"" + fontDef.getName() + "\".");
 	}
@@ -132,11 +132,10 @@ Buffer<FontDefinition::CharID> TextRenderUtils::getLineFontCharIDs(const std::st
 	for (int i = 0; i < lineLength; i++)
 	{
 		const char c = line[i];
-		const std::string charUtf8(1, c);
 		FontDefinition::CharID charID;
-		if (!fontDef.tryGetCharacterID(charUtf8.c_str(), &charID))
+		if (!fontDef.tryGetCharacterID(c, &charID))
 		{
-			DebugLogWarning("Couldn't get font character ID for \"" + charUtf8 + "\".");
+			DebugLogWarning("Couldn't get font character ID for \"" + std::string(1, c) + "\".");
 			charID = fallbackCharID;
 		}
 
@@ -303,21 +302,21 @@ Buffer<Int2> TextRenderUtils::makeAlignmentOffsets(BufferView<const std::string_
 void TextRenderUtils::drawChar(const FontDefinition::Character &fontChar, int dstX, int dstY, const Color &textColor,
 	BufferView2D<uint32_t> &outBuffer)
 {
-	// @todo: clip loop ranges instead of checking in loop.
-	for (int y = dstY; y < (dstY + fontChar.getHeight()); y++)
+	const int startX = std::max(dstX, 0);
+	const int endX = std::min(dstX + fontChar.getWidth(), outBuffer.getWidth());
+	const int startY = std::max(dstY, 0);
+	const int endY = std::min(dstY + fontChar.getHeight(), outBuffer.getHeight());
+	const uint32_t dstPixel = textColor.toARGB();
+	for (int y = startY; y < endY; y++)
 	{
-		for (int x = dstX; x < (dstX + fontChar.getWidth()); x++)
+		const int srcY = y - dstY;
+		for (int x = startX; x < endX; x++)
 		{
-			if ((x >= 0) && (x < outBuffer.getWidth()) && (y >= 0) && (y < outBuffer.getHeight()))
+			const int srcX = x - dstX;
+			const bool srcPixelIsColored = fontChar.get(srcX, srcY);
+			if (srcPixelIsColored)
 			{
-				const int srcX = x - dstX;
-				const int srcY = y - dstY;
-				const bool srcPixelIsColored = fontChar.get(srcX, srcY);
-				if (srcPixelIsColored)
-				{
-					const uint32_t dstPixel = textColor.toARGB();
-					outBuffer.set(x, y, dstPixel);
-				}
+				outBuffer.set(x, y, dstPixel);
 			}
 		}
 	}
@@ -6,22 +6,75 @@
 
 #include "components/debug/Debug.h"
 
+namespace
+{
+	// Appends the grid's IDs as (run length, ID) pairs of little-endian 16-bit values.
+	void WriteCompactDefIdRuns(const Buffer3D<VoxelDefinitionRegistry::CompactDefID> &ids, std::vector<uint8_t> &outBytes)
+	{
+		constexpr int maxRunLength = std::numeric_limits<uint16_t>::max();
+		auto writeUint16 = [&outBytes](uint16_t value)
+		{
+			outBytes.emplace_back(static_cast<uint8_t>(value & 0xFF));
+			outBytes.emplace_back(static_cast<uint8_t>(value >> 8));
+		};
+
+		const VoxelDefinitionRegistry::CompactDefID *begin = ids.begin();
+		const VoxelDefinitionRegistry::CompactDefID *end = ids.end();
+		const VoxelDefinitionRegistry::CompactDefID *runBegin = begin;
+		while (runBegin != end)
+		{
+			const VoxelDefinitionRegistry::CompactDefID id = *runBegin;
+			const VoxelDefinitionRegistry::CompactDefID *runEnd = runBegin + 1;
+			while ((runEnd != end) && (*runEnd == id) && ((runEnd - runBegin) < maxRunLength))
+			{
+				runEnd++;
+			}
+
+			writeUint16(static_cast<uint16_t>(runEnd - runBegin));
+			writeUint16(id);
+			runBegin = runEnd;
+		}
+	}
+
+	// Fills the grid from run-length encoded bytes starting at the given offset, returning the offset after them.
+	int ReadCompactDefIdRuns(const std::vector<uint8_t> &bytes, int byteOffset, Buffer3D<VoxelDefinitionRegistry::CompactDefID> &outIDs)
+	{
+		auto readUint16 = [&bytes](int offset)
+		{
+			return static_cast<uint16_t>(bytes[offset] | (bytes[offset + 1] << 8));
+		};
+
+		VoxelDefinitionRegistry::CompactDefID *dst = outIDs.begin();
+		VoxelDefinitionRegistry::CompactDefID *dstEnd = outIDs.end();
+		while (dst != dstEnd)
+		{
+			DebugAssert((byteOffset + 4) <= static_cast<int>(bytes.size()));
+			const int runLength = readUint16(byteOffset);
+			const VoxelDefinitionRegistry::CompactDefID id = readUint16(byteOffset + 2);
+			byteOffset += 4;
+
+			DebugAssert(runLength <= (dstEnd - dst));
+			std::fill(dst, dst + runLength, id);
+			dst += runLength;
+		}
+
+		return byteOffset;
+	}
+}
+
 VoxelChunk::VoxelChunk()
 {
+	this->defRegistry = nullptr;
 	this->floorReplacementMeshDefID = -1;
 	this->floorReplacementTextureDefID = -1;
 	this->floorReplacementTraitsDefID = -1;
 	this->floorReplacementChasmDefID = -1;
 }
 
-void VoxelChunk::init(const ChunkInt2 &position, int height)
+void VoxelChunk::init(const ChunkInt2 &position, int height, const VoxelDefinitionRegistry &defRegistry)
 {
 	Chunk::init(position, height);
-
-	// Let the first voxel definition (air) be usable immediately. All default voxel IDs can safely point to it.
-	this->meshDefs.emplace_back(VoxelMeshDefinition());
-	this->textureDefs.emplace_back(VoxelTextureDefinition());
-	this->traitsDefs.emplace_back(VoxelTraitsDefinition());
+	this->defRegistry = &defRegistry;
 
 	// Set all voxels to air.
 	this->meshDefIDs.init(Chunk::WIDTH, height, Chunk::DEPTH);
@@ -38,37 +91,155 @@ void VoxelChunk::init(const ChunkInt2 &position, int height)
 	this->dirtyMeshDefPositions.reserve(Chunk::WIDTH * height * Chunk::DEPTH);
 }
 
+void VoxelChunk::initFromSnapshot(VoxelChunkSnapshot &&snapshot, const VoxelDefinitionRegistry &defRegistry)
+{
+	this->init(snapshot.position, snapshot.height, defRegistry);
+
+	int byteOffset = 0;
+	byteOffset = ReadCompactDefIdRuns(snapshot.compressedDefIDs, byteOffset, this->meshDefIDs);
+	byteOffset = ReadCompactDefIdRuns(snapshot.compressedDefIDs, byteOffset, this->textureDefIDs);
+	byteOffset = ReadCompactDefIdRuns(snapshot.compressedDefIDs, byteOffset, this->traitsDefIDs);
+	DebugAssert(byteOffset == static_cast<int>(snapshot.compressedDefIDs.size()));
+
+	this->floorReplacementMeshDefID = snapshot.floorReplacementMeshDefID;
+	this->floorReplacementTextureDefID = snapshot.floorReplacementTextureDefID;
+	this->floorReplacementTraitsDefID = snapshot.floorReplacementTraitsDefID;
+	this->floorReplacementChasmDefID = snapshot.floorReplacementChasmDefID;
+
+	this->transitionDefs = std::move(snapshot.transitionDefs);
+	this->triggerDefs = std::move(snapshot.triggerDefs);
+	this->lockDefs = std::move(snapshot.lockDefs);
+	this->buildingNames = std::move(snapshot.buildingNames);
+	this->transitionDefIndices = std::move(snapshot.transitionDefIndices);
+	this->triggerDefIndices = std::move(snapshot.triggerDefIndices);
+	this->lockDefIndices = std::move(snapshot.lockDefIndices);
+	this->buildingNameIndices = std::move(snapshot.buildingNameIndices);
+	this->doorDefIndices = std::move(snapshot.doorDefIndices);
+	this->chasmDefIndices = std::move(snapshot.chasmDefIndices);
+	this->doorAnimInsts = std::move(snapshot.doorAnimInsts);
+	this->fadeAnimInsts = std::move(snapshot.fadeAnimInsts);
+	this->chasmWallInsts = std::move(snapshot.chasmWallInsts);
+	this->doorVisInsts = std::move(snapshot.doorVisInsts);
+	this->triggerInsts = std::move(snapshot.triggerInsts);
+
+	for (WEInt z = 0; z < Chunk::DEPTH; z++)
+	{
+		for (int y = 0; y < this->getHeight(); y++)
+		{
+			for (SNInt x = 0; x < Chunk::WIDTH; x++)
+			{
+				if (this->meshDefIDs.get(x, y, z) != VoxelChunk::AIR_MESH_DEF_ID)
+				{
+					this->setMeshDefDirty(x, y, z);
+				}
+			}
+		}
+	}
+
+	for (const VoxelDoorAnimationInstance &animInst : this->doorAnimInsts)
+	{
+		this->setDoorAnimInstDirty(animInst.x, animInst.y, animInst.z);
+	}
+
+	for (const VoxelFadeAnimationInstance &animInst : this->fadeAnimInsts)
+	{
+		this->setFadeAnimInstDirty(animInst.x, animInst.y, animInst.z);
+	}
+
+	// Chasm walls on the chunk edge depend on neighbors that might have changed since the snapshot.
+	for (const VoxelChasmWallInstance &chasmWallInst : this->chasmWallInsts)
+	{
+		this->setChasmWallInstDirty(chasmWallInst.x, chasmWallInst.y, chasmWallInst.z);
+	}
+
+	for (const VoxelDoorVisibilityInstance &doorVisInst : this->doorVisInsts)
+	{
+		this->setDoorVisInstDirty(doorVisInst.x, doorVisInst.y, doorVisInst.z);
+	}
+}
+
+void VoxelChunk::saveSnapshot(VoxelChunkSnapshot &outSnapshot)
+{
+	outSnapshot.position = this->getPosition();
+	outSnapshot.height = this->getHeight();
+
+	outSnapshot.compressedDefIDs.clear();
+	WriteCompactDefIdRuns(this->meshDefIDs, outSnapshot.compressedDefIDs);
+	WriteCompactDefIdRuns(this->textureDefIDs, outSnapshot.compressedDefIDs);
+	WriteCompactDefIdRuns(this->traitsDefIDs, outSnapshot.compressedDefIDs);
+	outSnapshot.compressedDefIDs.shrink_to_fit();
+
+	outSnapshot.floorReplacementMeshDefID = this->floorReplacementMeshDefID;
+	outSnapshot.floorReplacementTextureDefID = this->floorReplacementTextureDefID;
+	outSnapshot.floorReplacementTraitsDefID = this->floorReplacementTraitsDefID;
+	outSnapshot.floorReplacementChasmDefID = this->floorReplacementChasmDefID;
+
+	outSnapshot.transitionDefs = std::move(this->transitionDefs);
+	outSnapshot.triggerDefs = std::move(this->triggerDefs);
+	outSnapshot.lockDefs = std::move(this->lockDefs);
+	outSnapshot.buildingNames = std::move(this->buildingNames);
+	outSnapshot.transitionDefIndices = std::move(this->transitionDefIndices);
+	outSnapshot.triggerDefIndices = std::move(this->triggerDefIndices);
+	outSnapshot.lockDefIndices = std::move(this->lockDefIndices);
+	outSnapshot.buildingNameIndices = std::move(this->buildingNameIndices);
+	outSnapshot.doorDefIndices = std::move(this->doorDefIndices);
+	outSnapshot.chasmDefIndices = std::move(this->chasmDefIndices);
+	outSnapshot.doorAnimInsts = std::move(this->doorAnimInsts);
+	outSnapshot.fadeAnimInsts = std::move(this->fadeAnimInsts);
+	outSnapshot.chasmWallInsts = std::move(this->chasmWallInsts);
+	outSnapshot.doorVisInsts = std::move(this->doorVisInsts);
+	outSnapshot.triggerInsts = std::move(this->triggerInsts);
+}
+
 void VoxelChunk::getAdjacentMeshDefIDs(const VoxelInt3 &voxel, VoxelMeshDefID *outNorthID, VoxelMeshDefID *outEastID,
 	VoxelMeshDefID *outSouthID, VoxelMeshDefID *outWestID)
 {
-	this->getAdjacentIDsInternal(voxel, this->meshDefIDs, VoxelChunk::AIR_MESH_DEF_ID, outNorthID, outEastID, outSouthID, outWestID);
+	VoxelDefinitionRegistry::CompactDefID northID, eastID, southID, westID;
+	this->getAdjacentIDsInternal(voxel, this->meshDefIDs, static_cast<VoxelDefinitionRegistry::CompactDefID>(VoxelChunk::AIR_MESH_DEF_ID),
+		&northID, &eastID, &southID, &westID);
+	*outNorthID = northID;
+	*outEastID = eastID;
+	*outSouthID = southID;
+	*outWestID = westID;
 }
 
 void VoxelChunk::getAdjacentTextureDefIDs(const VoxelInt3 &voxel, VoxelTextureDefID *outNorthID, VoxelTextureDefID *outEastID,
 	VoxelTextureDefID *outSouthID, VoxelTextureDefID *outWestID)
 {
-	this->getAdjacentIDsInternal(voxel, this->textureDefIDs, VoxelChunk::AIR_TEXTURE_DEF_ID, outNorthID, outEastID, outSouthID, outWestID);
+	VoxelDefinitionRegistry::CompactDefID northID, eastID, southID, westID;
+	this->getAdjacentIDsInternal(voxel, this->textureDefIDs, static_cast<VoxelDefinitionRegistry::CompactDefID>(VoxelChunk::AIR_TEXTURE_DEF_ID),
+		&northID, &eastID, &southID, &westID);
+	*outNorthID = northID;
+	*outEastID = eastID;
+	*outSouthID = southID;
+	*outWestID = westID;
 }
 
 void VoxelChunk::getAdjacentTraitsDefIDs(const VoxelInt3 &voxel, VoxelTraitsDefID *outNorthID, VoxelTraitsDefID *outEastID,
 	VoxelTraitsDefID *outSouthID, VoxelTraitsDefID *outWestID)
 {
-	this->getAdjacentIDsInternal(voxel, this->traitsDefIDs, VoxelChunk::AIR_TRAITS_DEF_ID, outNorthID, outEastID, outSouthID, outWestID);
+	VoxelDefinitionRegistry::CompactDefID northID, eastID, southID, westID;
+	this->getAdjacentIDsInternal(voxel, this->traitsDefIDs, static_cast<VoxelDefinitionRegistry::CompactDefID>(VoxelChunk::AIR_TRAITS_DEF_ID),
+		&northID, &eastID, &southID, &westID);
+	*outNorthID = northID;
+	*outEastID = eastID;
+	*outSouthID = southID;
+	*outWestID = westID;
 }
 
 int VoxelChunk::getMeshDefCount() const
 {
-	return static_cast<int>(this->meshDefs.size());
+	return this->defRegistry->getMeshDefCount();
 }
 
 int VoxelChunk::getTextureDefCount() const
 {
-	return static_cast<int>(this->textureDefs.size());
+	return this->defRegistry->getTextureDefCount();
 }
 
 int VoxelChunk::getTraitsDefCount() const
 {
-	return static_cast<int>(this->traitsDefs.size());
+	return this->defRegistry->getTraitsDefCount();
 }
 
 int VoxelChunk::getTransitionDefCount() const
@@ -93,30 +264,27 @@ int VoxelChunk::getBuildingNameDefCount() const
 
 int VoxelChunk::getDoorDefCount() const
 {
-	return static_cast<int>(this->doorDefs.size());
+	return this->defRegistry->getDoorDefCount();
 }
 
 int VoxelChunk::getChasmDefCount() const
 {
-	return static_cast<int>(this->chasmDefs.size());
+	return this->defRegistry->getChasmDefCount();
 }
 
 const VoxelMeshDefinition &VoxelChunk::getMeshDef(VoxelMeshDefID id) const
 {
-	DebugAssertIndex(this->meshDefs, id);
-	return this->meshDefs[id];
+	return this->defRegistry->getMeshDef(id);
 }
 
 const VoxelTextureDefinition &VoxelChunk::getTextureDef(VoxelTextureDefID id) const
 {
-	DebugAssertIndex(this->textureDefs, id);
-	return this->textureDefs[id];
+	return this->defRegistry->getTextureDef(id);
 }
 
 const VoxelTraitsDefinition &VoxelChunk::getTraitsDef(VoxelTraitsDefID id) const
 {
-	DebugAssertIndex(this->traitsDefs, id);
-	return this->traitsDefs[id];
+	return this->defRegistry->getTraitsDef(id);
 }
 
 const TransitionDefinition &VoxelChunk::getTransitionDef(TransitionDefID id) const
@@ -145,14 +313,22 @@ const std::string &VoxelChunk::getBuildingName(BuildingNameID id) const
 
 const DoorDefinition &VoxelChunk::getDoorDef(DoorDefID id) const
 {
-	DebugAssertIndex(this->doorDefs, id);
-	return this->doorDefs[id];
+	return this->defRegistry->getDoorDef(id);
+}
+
+SoundID VoxelChunk::getDoorOpenSoundID(DoorDefID id) const
+{
+	return this->defRegistry->getDoorOpenSoundID(id);
+}
+
+SoundID VoxelChunk::getDoorCloseSoundID(DoorDefID id) const
+{
+	return this->defRegistry->getDoorCloseSoundID(id);
 }
 
 const ChasmDefinition &VoxelChunk::getChasmDef(ChasmDefID id) const
 {
-	DebugAssertIndex(this->chasmDefs, id);
-	return this->chasmDefs[id];
+	return this->defRegistry->getChasmDef(id);
 }
 
 VoxelChunk::VoxelMeshDefID VoxelChunk::getMeshDefID(SNInt x, int y, WEInt z) const
@@ -265,7 +441,7 @@ bool VoxelChunk::tryGetDoorDefID(SNInt x, int y, WEInt z, DoorDefID *outID) cons
 	if (iter != this->doorDefIndices.end())
 	{
 		const DoorDefID id = iter->second;
-		DebugAssertIndex(this->doorDefs, id);
+		DebugAssert(id < this->defRegistry->getDoorDefCount());
 		*outID = id;
 		return true;
 	}
@@ -281,7 +457,7 @@ bool VoxelChunk::tryGetChasmDefID(SNInt x, int y, WEInt z, ChasmDefID *outID) co
 	if (iter != this->chasmDefIndices.end())
 	{
 		const ChasmDefID id = iter->second;
-		DebugAssertIndex(this->chasmDefs, id);
+		DebugAssert(id < this->defRegistry->getChasmDefCount());
 		*outID = id;
 		return true;
 	}
@@ -419,18 +595,21 @@ bool VoxelChunk::tryGetTriggerInstIndex(SNInt x, int y, WEInt z, int *outIndex)
 
 void VoxelChunk::setMeshDefID(SNInt x, int y, WEInt z, VoxelMeshDefID id)
 {
-	this->meshDefIDs.set(x, y, z, id);
+	DebugAssert((id >= 0) && (id < VoxelDefinitionRegistry::MAX_COMPACT_DEF_COUNT));
+	this->meshDefIDs.set(x, y, z, static_cast<VoxelDefinitionRegistry::CompactDefID>(id));
 	this->setMeshDefDirty(x, y, z);
 }
 
 void VoxelChunk::setTextureDefID(SNInt x, int y, WEInt z, VoxelTextureDefID id)
 {
-	this->textureDefIDs.set(x, y, z, id);
+	DebugAssert((id >= 0) && (id < VoxelDefinitionRegistry::MAX_COMPACT_DEF_COUNT));
+	this->textureDefIDs.set(x, y, z, static_cast<VoxelDefinitionRegistry::CompactDefID>(id));
 }
 
 void VoxelChunk::setTraitsDefID(SNInt x, int y, WEInt z, VoxelTraitsDefID id)
 {
-	this->traitsDefIDs.set(x, y, z, id);
+	DebugAssert((id >= 0) && (id < VoxelDefinitionRegistry::MAX_COMPACT_DEF_COUNT));
+	this->traitsDefIDs.set(x, y, z, static_cast<VoxelDefinitionRegistry::CompactDefID>(id));
 }
 
 void VoxelChunk::setFloorReplacementMeshDefID(VoxelMeshDefID id)
@@ -453,27 +632,6 @@ void VoxelChunk::setFloorReplacementChasmDefID(ChasmDefID id)
 	this->floorReplacementChasmDefID = id;
 }
 
-VoxelChunk::VoxelMeshDefID VoxelChunk::addMeshDef(VoxelMeshDefinition &&voxelMeshDef)
-{
-	const VoxelMeshDefID id = static_cast<VoxelMeshDefID>(this->meshDefs.size());
-	this->meshDefs.emplace_back(std::move(voxelMeshDef));
-	return id;
-}
-
-VoxelChunk::VoxelTextureDefID VoxelChunk::addTextureDef(VoxelTextureDefinition &&voxelTextureDef)
-{
-	const VoxelTextureDefID id = static_cast<VoxelTextureDefID>(this->textureDefs.size());
-	this->textureDefs.emplace_back(std::move(voxelTextureDef));
-	return id;
-}
-
-VoxelChunk::VoxelTraitsDefID VoxelChunk::addTraitsDef(VoxelTraitsDefinition &&voxelTraitsDef)
-{
-	const VoxelTraitsDefID id = static_cast<VoxelTraitsDefID>(this->traitsDefs.size());
-	this->traitsDefs.emplace_back(std::move(voxelTraitsDef));
-	return id;
-}
-
 VoxelChunk::TransitionDefID VoxelChunk::addTransitionDef(TransitionDefinition &&transition)
 {
 	const TransitionDefID id = static_cast<int>(this->transitionDefs.size());
@@ -502,20 +660,6 @@ VoxelChunk::BuildingNameID VoxelChunk::addBuildingName(std::string &&buildingNam
 	return id;
 }
 
-VoxelChunk::DoorDefID VoxelChunk::addDoorDef(DoorDefinition &&door)
-{
-	const DoorDefID id = static_cast<int>(this->doorDefs.size());
-	this->doorDefs.emplace_back(std::move(door));
-	return id;
-}
-
-VoxelChunk::ChasmDefID VoxelChunk::addChasmDef(ChasmDefinition &&chasm)
-{
-	const ChasmDefID id = static_cast<int>(this->chasmDefs.size());
-	this->chasmDefs.emplace_back(std::move(chasm));
-	return id;
-}
-
 void VoxelChunk::addTransitionDefPosition(VoxelChunk::TransitionDefID id, const VoxelInt3 &voxel)
 {
 	DebugAssert(this->transitionDefIndices.find(voxel) == this->transitionDefIndices.end());
@@ -644,15 +788,11 @@ void VoxelChunk::setChasmWallInstDirty(SNInt x, int y, WEInt z)
 void VoxelChunk::clear()
 {
 	Chunk::clear();
-	this->meshDefs.clear();
-	this->textureDefs.clear();
-	this->traitsDefs.clear();
+	this->defRegistry = nullptr;
 	this->transitionDefs.clear();
 	this->triggerDefs.clear();
 	this->lockDefs.clear();
 	this->buildingNames.clear();
-	this->doorDefs.clear();
-	this->chasmDefs.clear();
 	this->meshDefIDs.clear();
 	this->textureDefIDs.clear();
 	this->traitsDefIDs.clear();
@@ -724,7 +864,7 @@ void VoxelChunk::update(double dt, const CoordDouble3 &playerCoord, double ceili
 					if (closeSoundDef.closeType == DoorDefinition::CloseType::OnClosing)
 					{
 						const WorldDouble3 absoluteSoundPosition = VoxelUtils::coordToWorldPoint(voxelCoord);
-						audioManager.playSound(closeSoundDef.soundFilename, absoluteSoundPosition);
+						audioManager.playSound(this->getDoorCloseSoundID(doorDefID), absoluteSoundPosition);
 					}
 				}
 			}
@@ -744,7 +884,7 @@ void VoxelChunk::update(double dt, const CoordDouble3 &playerCoord, double ceili
 			{
 				const CoordDouble3 soundCoord(chunkPos, VoxelUtils::getVoxelCenter(voxel, ceilingScale));
 				const WorldDouble3 absoluteSoundPosition = VoxelUtils::coordToWorldPoint(soundCoord);
-				audioManager.playSound(closeSoundDef.soundFilename, absoluteSoundPosition);
+				audioManager.playSound(this->getDoorCloseSoundID(doorDefID), absoluteSoundPosition);
 			}
 
 			this->doorAnimInsts.erase(this->doorAnimInsts.begin() + i);
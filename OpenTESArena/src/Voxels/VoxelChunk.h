@@ -12,6 +12,8 @@
 #include "ChasmDefinition.h"
 #include "DoorDefinition.h"
 #include "VoxelChasmWallInstance.h"
+#include "VoxelChunkSnapshotCache.h"
+#include "VoxelDefinitionRegistry.h"
 #include "VoxelDirtyType.h"
 #include "VoxelDoorAnimationInstance.h"
 #include "VoxelDoorVisibilityInstance.h"
@@ -38,31 +40,29 @@ class AudioManager;
 class VoxelChunk final : public Chunk
 {
 public:
-	using VoxelMeshDefID = int;
-	using VoxelTextureDefID = int;
-	using VoxelTraitsDefID = int;
+	using VoxelMeshDefID = VoxelDefinitionRegistry::VoxelMeshDefID;
+	using VoxelTextureDefID = VoxelDefinitionRegistry::VoxelTextureDefID;
+	using VoxelTraitsDefID = VoxelDefinitionRegistry::VoxelTraitsDefID;
 	using TransitionDefID = int;
 	using TriggerDefID = int;
 	using LockDefID = int;
 	using BuildingNameID = int;
-	using DoorDefID = int;
-	using ChasmDefID = int;
+	using DoorDefID = VoxelDefinitionRegistry::DoorDefID;
+	using ChasmDefID = VoxelDefinitionRegistry::ChasmDefID;
 private:
+	// Mesh, texture, traits, door, and chasm definitions shared with other chunks.
+	const VoxelDefinitionRegistry *defRegistry;
+
 	// Definitions pointed to by voxel IDs.
-	std::vector<VoxelMeshDefinition> meshDefs;
-	std::vector<VoxelTextureDefinition> textureDefs;
-	std::vector<VoxelTraitsDefinition> traitsDefs;
 	std::vector<TransitionDefinition> transitionDefs;
 	std::vector<VoxelTriggerDefinition> triggerDefs;
 	std::vector<LockDefinition> lockDefs;
 	std::vector<std::string> buildingNames;
-	std::vector<DoorDefinition> doorDefs;
-	std::vector<ChasmDefinition> chasmDefs;
 
 	// Indices into definitions for actual voxels in-game.
-	Buffer3D<VoxelMeshDefID> meshDefIDs;
-	Buffer3D<VoxelTextureDefID> textureDefIDs;
-	Buffer3D<VoxelTraitsDefID> traitsDefIDs;
+	Buffer3D<VoxelDefinitionRegistry::CompactDefID> meshDefIDs;
+	Buffer3D<VoxelDefinitionRegistry::CompactDefID> textureDefIDs;
+	Buffer3D<VoxelDefinitionRegistry::CompactDefID> traitsDefIDs;
 	VoxelMeshDefID floorReplacementMeshDefID;
 	VoxelTextureDefID floorReplacementTextureDefID;
 	VoxelTraitsDefID floorReplacementTraitsDefID;
@@ -111,13 +111,20 @@ private:
 	void setFadeAnimInstDirty(SNInt x, int y, WEInt z);
 	void setChasmWallInstDirty(SNInt x, int y, WEInt z);
 public:
-	static constexpr VoxelMeshDefID AIR_MESH_DEF_ID = 0;
-	static constexpr VoxelTextureDefID AIR_TEXTURE_DEF_ID = 0;
-	static constexpr VoxelTraitsDefID AIR_TRAITS_DEF_ID = 0;
+	static constexpr VoxelMeshDefID AIR_MESH_DEF_ID = VoxelDefinitionRegistry::AIR_MESH_DEF_ID;
+	static constexpr VoxelTextureDefID AIR_TEXTURE_DEF_ID = VoxelDefinitionRegistry::AIR_TEXTURE_DEF_ID;
+	static constexpr VoxelTraitsDefID AIR_TRAITS_DEF_ID = VoxelDefinitionRegistry::AIR_TRAITS_DEF_ID;
 
 	VoxelChunk();
 
-	void init(const ChunkInt2 &position, int height);
+	void init(const ChunkInt2 &position, int height, const VoxelDefinitionRegistry &defRegistry);
+
+	// Initializes the chunk from a previously saved snapshot instead of level definitions. All restored
+	// voxels are marked dirty so dependent chunk managers see them like a freshly populated chunk.
+	void initFromSnapshot(VoxelChunkSnapshot &&snapshot, const VoxelDefinitionRegistry &defRegistry);
+
+	// Moves the chunk's state into a snapshot for caching. The chunk should be cleared afterwards.
+	void saveSnapshot(VoxelChunkSnapshot &outSnapshot);
 
 	int getMeshDefCount() const;
 	int getTextureDefCount() const;
@@ -138,6 +145,8 @@ public:
 	const LockDefinition &getLockDef(LockDefID id) const;
 	const std::string &getBuildingName(BuildingNameID id) const;
 	const DoorDefinition &getDoorDef(DoorDefID id) const;
+	SoundID getDoorOpenSoundID(DoorDefID id) const;
+	SoundID getDoorCloseSoundID(DoorDefID id) const;
 	const ChasmDefinition &getChasmDef(ChasmDefID id) const;
 
 	VoxelMeshDefID getMeshDefID(SNInt x, int y, WEInt z) const;
@@ -180,15 +189,10 @@ public:
 	void setFloorReplacementTraitsDefID(VoxelTraitsDefID id);
 	void setFloorReplacementChasmDefID(ChasmDefID id);
 
-	VoxelMeshDefID addMeshDef(VoxelMeshDefinition &&meshDef);
-	VoxelTextureDefID addTextureDef(VoxelTextureDefinition &&textureDef);
-	VoxelTraitsDefID addTraitsDef(VoxelTraitsDefinition &&traitsDef);
 	TransitionDefID addTransitionDef(TransitionDefinition &&transition);
 	TriggerDefID addTriggerDef(VoxelTriggerDefinition &&trigger);
 	LockDefID addLockDef(LockDefinition &&lock);
 	BuildingNameID addBuildingName(std::string &&buildingName);
-	DoorDefID addDoorDef(DoorDefinition &&door);
-	ChasmDefID addChasmDef(ChasmDefinition &&chasm);
 
 	void addTransitionDefPosition(TransitionDefID id, const VoxelInt3 &voxel);
 	void addTriggerDefPosition(TriggerDefID id, const VoxelInt3 &voxel);
@@ -14,22 +14,23 @@
 
 namespace
 {
-	VoxelChunk::VoxelMeshDefID LevelVoxelMeshDefIdToChunkVoxelMeshDefID(LevelDefinition::VoxelMeshDefID levelVoxelDefID)
+	// Level info definition IDs are offset by where that level info definition's voxel definitions start in the registry.
+	VoxelChunk::VoxelMeshDefID LevelVoxelMeshDefIdToChunkVoxelMeshDefID(LevelDefinition::VoxelMeshDefID levelVoxelDefID,
+		const VoxelDefinitionRegistry::LevelInfoMapping &levelInfoMapping)
 	{
-		// Chunks have an air definition at ID 0.
-		return static_cast<VoxelChunk::VoxelMeshDefID>(levelVoxelDefID + 1);
+		return static_cast<VoxelChunk::VoxelMeshDefID>(levelInfoMapping.meshDefOffset + levelVoxelDefID);
 	}
 
-	VoxelChunk::VoxelTextureDefID LevelVoxelTextureDefIdToChunkVoxelTextureDefID(LevelDefinition::VoxelTextureDefID levelVoxelDefID)
+	VoxelChunk::VoxelTextureDefID LevelVoxelTextureDefIdToChunkVoxelTextureDefID(LevelDefinition::VoxelTextureDefID levelVoxelDefID,
+		const VoxelDefinitionRegistry::LevelInfoMapping &levelInfoMapping)
 	{
-		// Chunks have an air definition at ID 0.
-		return static_cast<VoxelChunk::VoxelTextureDefID>(levelVoxelDefID + 1);
+		return static_cast<VoxelChunk::VoxelTextureDefID>(levelInfoMapping.textureDefOffset + levelVoxelDefID);
 	}
 
-	VoxelChunk::VoxelTraitsDefID LevelVoxelTraitsDefIdToChunkVoxelTraitsDefID(LevelDefinition::VoxelTraitsDefID levelVoxelDefID)
+	VoxelChunk::VoxelTraitsDefID LevelVoxelTraitsDefIdToChunkVoxelTraitsDefID(LevelDefinition::VoxelTraitsDefID levelVoxelDefID,
+		const VoxelDefinitionRegistry::LevelInfoMapping &levelInfoMapping)
 	{
-		// Chunks have an air definition at ID 0.
-		return static_cast<VoxelChunk::VoxelTraitsDefID>(levelVoxelDefID + 1);
+		return static_cast<VoxelChunk::VoxelTraitsDefID>(levelInfoMapping.traitsDefOffset + levelVoxelDefID);
 	}
 }
 
@@ -76,39 +77,17 @@ void VoxelChunkManager::getAdjacentVoxelTraitsDefIDs(const CoordInt3 &coord, std
 }
 
 void VoxelChunkManager::populateChunkVoxelDefs(VoxelChunk &chunk, const LevelDefinition &levelDefinition,
-	const LevelInfoDefinition &levelInfoDefinition)
+	const VoxelDefinitionRegistry::LevelInfoMapping &levelInfoMapping)
 {
-	for (int i = 0; i < levelInfoDefinition.getVoxelMeshDefCount(); i++)
-	{
-		VoxelMeshDefinition voxelMeshDef = levelInfoDefinition.getVoxelMeshDef(i);
-		chunk.addMeshDef(std::move(voxelMeshDef));
-	}
-
-	for (int i = 0; i < levelInfoDefinition.getVoxelTextureDefCount(); i++)
-	{
-		VoxelTextureDefinition voxelTextureDef = levelInfoDefinition.getVoxelTextureDef(i);
-		chunk.addTextureDef(std::move(voxelTextureDef));
-	}
-
-	for (int i = 0; i < levelInfoDefinition.getVoxelTraitsDefCount(); i++)
-	{
-		VoxelTraitsDefinition voxelTraitsDef = levelInfoDefinition.getVoxelTraitsDef(i);
-		chunk.addTraitsDef(std::move(voxelTraitsDef));
-	}
-
-	// Add floor replacement definitions and IDs.
+	// Point floor replacement IDs at the level's shared definitions.
 	const LevelDefinition::VoxelMeshDefID levelFloorReplacementVoxelMeshDefID = levelDefinition.getFloorReplacementMeshDefID();
 	const LevelDefinition::VoxelTextureDefID levelFloorReplacementVoxelTextureDefID = levelDefinition.getFloorReplacementTextureDefID();
 	const LevelDefinition::VoxelTraitsDefID levelFloorReplacementVoxelTraitsDefID = levelDefinition.getFloorReplacementTraitsDefID();
 	const LevelDefinition::ChasmDefID levelFloorReplacementChasmDefID = levelDefinition.getFloorReplacementChasmDefID();
-	VoxelMeshDefinition floorReplacementMeshDef = levelInfoDefinition.getVoxelMeshDef(levelFloorReplacementVoxelMeshDefID);
-	VoxelTextureDefinition floorReplacementTextureDef = levelInfoDefinition.getVoxelTextureDef(levelFloorReplacementVoxelTextureDefID);
-	VoxelTraitsDefinition floorReplacementTraitsDef = levelInfoDefinition.getVoxelTraitsDef(levelFloorReplacementVoxelTraitsDefID);
-	ChasmDefinition floorReplacementChasmDef = levelInfoDefinition.getChasmDef(levelFloorReplacementChasmDefID);
-	const VoxelChunk::VoxelMeshDefID floorReplacementVoxelMeshDefID = chunk.addMeshDef(std::move(floorReplacementMeshDef));
-	const VoxelChunk::VoxelTextureDefID floorReplacementVoxelTextureDefID = chunk.addTextureDef(std::move(floorReplacementTextureDef));
-	const VoxelChunk::VoxelTraitsDefID floorReplacementVoxelTraitsDefID = chunk.addTraitsDef(std::move(floorReplacementTraitsDef));
-	const VoxelChunk::ChasmDefID floorReplacementChasmDefID = chunk.addChasmDef(std::move(floorReplacementChasmDef));
+	const VoxelChunk::VoxelMeshDefID floorReplacementVoxelMeshDefID = LevelVoxelMeshDefIdToChunkVoxelMeshDefID(levelFloorReplacementVoxelMeshDefID, levelInfoMapping);
+	const VoxelChunk::VoxelTextureDefID floorReplacementVoxelTextureDefID = LevelVoxelTextureDefIdToChunkVoxelTextureDefID(levelFloorReplacementVoxelTextureDefID, levelInfoMapping);
+	const VoxelChunk::VoxelTraitsDefID floorReplacementVoxelTraitsDefID = LevelVoxelTraitsDefIdToChunkVoxelTraitsDefID(levelFloorReplacementVoxelTraitsDefID, levelInfoMapping);
+	const VoxelChunk::ChasmDefID floorReplacementChasmDefID = levelInfoMapping.chasmDefOffset + levelFloorReplacementChasmDefID;
 	chunk.setFloorReplacementMeshDefID(floorReplacementVoxelMeshDefID);
 	chunk.setFloorReplacementTextureDefID(floorReplacementVoxelTextureDefID);
 	chunk.setFloorReplacementTraitsDefID(floorReplacementVoxelTraitsDefID);
@@ -116,7 +95,7 @@ void VoxelChunkManager::populateChunkVoxelDefs(VoxelChunk &chunk, const LevelDef
 }
 
 void VoxelChunkManager::populateChunkVoxels(VoxelChunk &chunk, const LevelDefinition &levelDefinition,
-	const WorldInt2 &levelOffset)
+	const VoxelDefinitionRegistry::LevelInfoMapping &levelInfoMapping, const WorldInt2 &levelOffset)
 {
 	SNInt startX, endX;
 	int startY, endY;
@@ -135,9 +114,9 @@ void VoxelChunkManager::populateChunkVoxels(VoxelChunk &chunk, const LevelDefini
 				const LevelDefinition::VoxelMeshDefID levelVoxelMeshDefID = levelDefinition.getVoxelMeshID(x, y, z);
 				const LevelDefinition::VoxelTextureDefID levelVoxelTextureDefID = levelDefinition.getVoxelTextureID(x, y, z);
 				const LevelDefinition::VoxelTraitsDefID levelVoxelTraitsDefID = levelDefinition.getVoxelTraitsID(x, y, z);
-				const VoxelChunk::VoxelMeshDefID voxelMeshDefID = LevelVoxelMeshDefIdToChunkVoxelMeshDefID(levelVoxelMeshDefID);
-				const VoxelChunk::VoxelTextureDefID voxelTextureDefID = LevelVoxelTextureDefIdToChunkVoxelTextureDefID(levelVoxelTextureDefID);
-				const VoxelChunk::VoxelTraitsDefID voxelTraitsDefID = LevelVoxelTraitsDefIdToChunkVoxelTraitsDefID(levelVoxelTraitsDefID);
+				const VoxelChunk::VoxelMeshDefID voxelMeshDefID = LevelVoxelMeshDefIdToChunkVoxelMeshDefID(levelVoxelMeshDefID, levelInfoMapping);
+				const VoxelChunk::VoxelTextureDefID voxelTextureDefID = LevelVoxelTextureDefIdToChunkVoxelTextureDefID(levelVoxelTextureDefID, levelInfoMapping);
+				const VoxelChunk::VoxelTraitsDefID voxelTraitsDefID = LevelVoxelTraitsDefIdToChunkVoxelTraitsDefID(levelVoxelTraitsDefID, levelInfoMapping);
 				chunk.setMeshDefID(chunkVoxel.x, chunkVoxel.y, chunkVoxel.z, voxelMeshDefID);
 				chunk.setTextureDefID(chunkVoxel.x, chunkVoxel.y, chunkVoxel.z, voxelTextureDefID);
 				chunk.setTraitsDefID(chunkVoxel.x, chunkVoxel.y, chunkVoxel.z, voxelTraitsDefID);
@@ -147,7 +126,8 @@ void VoxelChunkManager::populateChunkVoxels(VoxelChunk &chunk, const LevelDefini
 }
 
 void VoxelChunkManager::populateChunkDecorators(VoxelChunk &chunk, const LevelDefinition &levelDefinition,
-	const LevelInfoDefinition &levelInfoDefinition, const WorldInt2 &levelOffset)
+	const LevelInfoDefinition &levelInfoDefinition, const VoxelDefinitionRegistry::LevelInfoMapping &levelInfoMapping,
+	const WorldInt2 &levelOffset)
 {
 	SNInt startX, endX;
 	int startY, endY;
@@ -244,46 +224,32 @@ void VoxelChunkManager::populateChunkDecorators(VoxelChunk &chunk, const LevelDe
 		}
 	}
 
-	// Add door definitions.
+	// Add door definition positions. The definitions themselves are shared in the registry.
 	for (int i = 0; i < levelDefinition.getDoorPlacementDefCount(); i++)
 	{
 		const LevelDefinition::DoorPlacementDef &placementDef = levelDefinition.getDoorPlacementDef(i);
-		const DoorDefinition &doorDef = levelInfoDefinition.getDoorDef(placementDef.id);
-
-		std::optional<VoxelChunk::DoorDefID> doorDefID;
+		const VoxelChunk::DoorDefID doorDefID = levelInfoMapping.doorDefOffset + placementDef.id;
 		for (const WorldInt3 &position : placementDef.positions)
 		{
 			if (ChunkUtils::IsInWritingRange(position, startX, endX, startY, endY, startZ, endZ))
 			{
-				if (!doorDefID.has_value())
-				{
-					doorDefID = chunk.addDoorDef(DoorDefinition(doorDef));
-				}
-
 				const VoxelInt3 voxel = ChunkUtils::MakeChunkVoxelFromLevel(position, startX, startY, startZ);
-				chunk.addDoorDefPosition(*doorDefID, voxel);
+				chunk.addDoorDefPosition(doorDefID, voxel);
 			}
 		}
 	}
 
-	// Add chasm definitions.
+	// Add chasm definition positions.
 	for (int i = 0; i < levelDefinition.getChasmPlacementDefCount(); i++)
 	{
 		const LevelDefinition::ChasmPlacementDef &placementDef = levelDefinition.getChasmPlacementDef(i);
-		const ChasmDefinition &chasmDef = levelInfoDefinition.getChasmDef(placementDef.id);
-
-		std::optional<VoxelChunk::ChasmDefID> chasmDefID;
+		const VoxelChunk::ChasmDefID chasmDefID = levelInfoMapping.chasmDefOffset + placementDef.id;
 		for (const WorldInt3 &position : placementDef.positions)
 		{
 			if (ChunkUtils::IsInWritingRange(position, startX, endX, startY, endY, startZ, endZ))
 			{
-				if (!chasmDefID.has_value())
-				{
-					chasmDefID = chunk.addChasmDef(ChasmDefinition(chasmDef));
-				}
-
 				const VoxelInt3 voxel = ChunkUtils::MakeChunkVoxelFromLevel(position, startX, startY, startZ);
-				chunk.addChasmDefPosition(*chasmDefID, voxel);
+				chunk.addChasmDefPosition(chasmDefID, voxel);
 			}
 		}
 	}
@@ -426,24 +392,28 @@ void VoxelChunkManager::populateChunkDoorVisibilityInsts(VoxelChunk &chunk)
 }
 
 void VoxelChunkManager::populateChunk(int index, const ChunkInt2 &chunkPos, const LevelDefinition &levelDef,
-	const LevelInfoDefinition &levelInfoDef, const MapSubDefinition &mapSubDef)
+	const LevelInfoDefinition &levelInfoDef, const MapSubDefinition &mapSubDef, AudioManager &audioManager)
 {
 	VoxelChunk &chunk = this->getChunkAtIndex(index);
 	const SNInt levelWidth = levelDef.getWidth();
 	const int levelHeight = levelDef.getHeight();
 	const WEInt levelDepth = levelDef.getDepth();
 
+	// Voxel definitions are shared with any other chunks from the same level info definition.
+	const VoxelDefinitionRegistry::LevelInfoMapping levelInfoMapping = this->defRegistry.getOrAddLevelInfoDefs(levelInfoDef,
+		audioManager);
+
 	// Populate all or part of the chunk from a level definition depending on the world type.
 	const MapType mapType = mapSubDef.type;
 	if (mapType == MapType::Interior)
 	{
-		chunk.init(chunkPos, levelHeight);
-		this->populateChunkVoxelDefs(chunk, levelDef, levelInfoDef);
+		chunk.init(chunkPos, levelHeight, this->defRegistry);
+		this->populateChunkVoxelDefs(chunk, levelDef, levelInfoMapping);
 
 		// @todo: populate chunk entirely from default empty chunk (fast copy).
 		// - probably get from MapDefinitionInterior eventually.
-		constexpr VoxelChunk::VoxelMeshDefID floorVoxelMeshDefID = 2;
-		const VoxelChunk::VoxelMeshDefID ceilingVoxelMeshDefID = [&levelInfoDef]()
+		constexpr LevelDefinition::VoxelMeshDefID levelFloorVoxelDefID = 1;
+		const std::optional<LevelDefinition::VoxelMeshDefID> levelCeilingVoxelDefID = [&levelInfoDef]() -> std::optional<LevelDefinition::VoxelMeshDefID>
 		{
 			for (int i = 0; i < levelInfoDef.getVoxelTraitsDefCount(); i++)
 			{
@@ -451,19 +421,25 @@ void VoxelChunkManager::populateChunk(int index, const ChunkInt2 &chunkPos, cons
 				const VoxelTraitsDefinition &voxelTraitsDef = levelInfoDef.getVoxelTraitsDef(i);
 				if (voxelTraitsDef.type == ArenaTypes::VoxelType::Ceiling)
 				{
-					return LevelVoxelMeshDefIdToChunkVoxelMeshDefID(i); // @todo: this is probably brittle; can't assume mesh def ID -> traits def ID mapping.
+					return i; // @todo: this is probably brittle; can't assume mesh def ID -> traits def ID mapping.
 				}
 			}
 
 			// No ceiling found, use air instead.
-			return VoxelChunk::AIR_MESH_DEF_ID;
+			return std::nullopt;
 		}();
 
-		constexpr VoxelChunk::VoxelTextureDefID floorVoxelTextureDefID = floorVoxelMeshDefID; // @todo: this is probably brittle; can't assume mesh def ID -> texture def ID mapping.
-		const VoxelChunk::VoxelTextureDefID ceilingVoxelTextureDefID = ceilingVoxelMeshDefID; // @todo: this is probably brittle; can't assume mesh def ID -> texture def ID mapping.
+		// @todo: this is probably brittle; can't assume mesh def ID -> texture/traits def ID mapping.
+		const VoxelChunk::VoxelMeshDefID floorVoxelMeshDefID = LevelVoxelMeshDefIdToChunkVoxelMeshDefID(levelFloorVoxelDefID, levelInfoMapping);
+		const VoxelChunk::VoxelTextureDefID floorVoxelTextureDefID = LevelVoxelTextureDefIdToChunkVoxelTextureDefID(levelFloorVoxelDefID, levelInfoMapping);
+		const VoxelChunk::VoxelTraitsDefID floorVoxelTraitsDefID = LevelVoxelTraitsDefIdToChunkVoxelTraitsDefID(levelFloorVoxelDefID, levelInfoMapping);
 
-		constexpr VoxelChunk::VoxelTraitsDefID floorVoxelTraitsDefID = floorVoxelMeshDefID; // @todo: this is probably brittle; can't assume mesh def ID -> traits def ID mapping.
-		const VoxelChunk::VoxelTraitsDefID ceilingVoxelTraitsDefID = ceilingVoxelMeshDefID; // @todo: this is probably brittle; can't assume mesh def ID -> traits def ID mapping.
+		const VoxelChunk::VoxelMeshDefID ceilingVoxelMeshDefID = levelCeilingVoxelDefID.has_value() ?
+			LevelVoxelMeshDefIdToChunkVoxelMeshDefID(*levelCeilingVoxelDefID, levelInfoMapping) : VoxelChunk::AIR_MESH_DEF_ID;
+		const VoxelChunk::VoxelTextureDefID ceilingVoxelTextureDefID = levelCeilingVoxelDefID.has_value() ?
+			LevelVoxelTextureDefIdToChunkVoxelTextureDefID(*levelCeilingVoxelDefID, levelInfoMapping) : VoxelChunk::AIR_TEXTURE_DEF_ID;
+		const VoxelChunk::VoxelTraitsDefID ceilingVoxelTraitsDefID = levelCeilingVoxelDefID.has_value() ?
+			LevelVoxelTraitsDefIdToChunkVoxelTraitsDefID(*levelCeilingVoxelDefID, levelInfoMapping) : VoxelChunk::AIR_TRAITS_DEF_ID;
 
 		const int chunkHeight = chunk.getHeight();
 		for (WEInt z = 0; z < Chunk::DEPTH; z++)
@@ -487,16 +463,16 @@ void VoxelChunkManager::populateChunk(int index, const ChunkInt2 &chunkPos, cons
 		{
 			// Populate chunk from the part of the level it overlaps.
 			const WorldInt2 levelOffset = chunkPos * ChunkUtils::CHUNK_DIM;
-			this->populateChunkVoxels(chunk, levelDef, levelOffset);
-			this->populateChunkDecorators(chunk, levelDef, levelInfoDef, levelOffset);
+			this->populateChunkVoxels(chunk, levelDef, levelInfoMapping, levelOffset);
+			this->populateChunkDecorators(chunk, levelDef, levelInfoDef, levelInfoMapping, levelOffset);
 			this->populateChunkChasmInsts(chunk);
 			this->populateChunkDoorVisibilityInsts(chunk);
 		}
 	}
 	else if (mapType == MapType::City)
 	{
-		chunk.init(chunkPos, levelHeight);
-		this->populateChunkVoxelDefs(chunk, levelDef, levelInfoDef);
+		chunk.init(chunkPos, levelHeight, this->defRegistry);
+		this->populateChunkVoxelDefs(chunk, levelDef, levelInfoMapping);
 
 		// Chunks outside the level are wrapped but only have floor voxels.		
 		for (WEInt z = 0; z < Chunk::DEPTH; z++)
@@ -524,9 +500,9 @@ void VoxelChunkManager::populateChunk(int index, const ChunkInt2 &chunkPos, cons
 				const LevelDefinition::VoxelMeshDefID levelVoxelMeshDefID = levelDef.getVoxelMeshID(wrappedLevelVoxel.x, 0, wrappedLevelVoxel.y);
 				const LevelDefinition::VoxelTextureDefID levelVoxelTextureDefID = levelDef.getVoxelTextureID(wrappedLevelVoxel.x, 0, wrappedLevelVoxel.y);
 				const LevelDefinition::VoxelTraitsDefID levelVoxelTraitsDefID = levelDef.getVoxelTraitsID(wrappedLevelVoxel.x, 0, wrappedLevelVoxel.y);
-				const VoxelChunk::VoxelMeshDefID voxelMeshDefID = LevelVoxelMeshDefIdToChunkVoxelMeshDefID(levelVoxelMeshDefID);
-				const VoxelChunk::VoxelTextureDefID voxelTextureDefID = LevelVoxelTextureDefIdToChunkVoxelTextureDefID(levelVoxelTextureDefID);
-				const VoxelChunk::VoxelTraitsDefID voxelTraitsDefID = LevelVoxelTraitsDefIdToChunkVoxelTraitsDefID(levelVoxelTraitsDefID);
+				const VoxelChunk::VoxelMeshDefID voxelMeshDefID = LevelVoxelMeshDefIdToChunkVoxelMeshDefID(levelVoxelMeshDefID, levelInfoMapping);
+				const VoxelChunk::VoxelTextureDefID voxelTextureDefID = LevelVoxelTextureDefIdToChunkVoxelTextureDefID(levelVoxelTextureDefID, levelInfoMapping);
+				const VoxelChunk::VoxelTraitsDefID voxelTraitsDefID = LevelVoxelTraitsDefIdToChunkVoxelTraitsDefID(levelVoxelTraitsDefID, levelInfoMapping);
 				chunk.setMeshDefID(x, 0, z, voxelMeshDefID);
 				chunk.setTextureDefID(x, 0, z, voxelTextureDefID);
 				chunk.setTraitsDefID(x, 0, z, voxelTraitsDefID);
@@ -537,23 +513,23 @@ void VoxelChunkManager::populateChunk(int index, const ChunkInt2 &chunkPos, cons
 		{
 			// Populate chunk from the part of the level it overlaps.
 			const WorldInt2 levelOffset = chunkPos * ChunkUtils::CHUNK_DIM;
-			this->populateChunkVoxels(chunk, levelDef, levelOffset);
-			this->populateChunkDecorators(chunk, levelDef, levelInfoDef, levelOffset);
+			this->populateChunkVoxels(chunk, levelDef, levelInfoMapping, levelOffset);
+			this->populateChunkDecorators(chunk, levelDef, levelInfoDef, levelInfoMapping, levelOffset);
 			this->populateChunkChasmInsts(chunk);
 			this->populateChunkDoorVisibilityInsts(chunk);
 		}
 	}
 	else if (mapType == MapType::Wilderness)
 	{
-		chunk.init(chunkPos, levelHeight);
-		this->populateChunkVoxelDefs(chunk, levelDef, levelInfoDef);
+		chunk.init(chunkPos, levelHeight, this->defRegistry);
+		this->populateChunkVoxelDefs(chunk, levelDef, levelInfoMapping);
 
 		// Copy level definition directly into chunk.
 		DebugAssert(levelWidth == Chunk::WIDTH);
 		DebugAssert(levelDepth == Chunk::DEPTH);
 		const WorldInt2 levelOffset = WorldInt2::Zero;
-		this->populateChunkVoxels(chunk, levelDef, levelOffset);
-		this->populateChunkDecorators(chunk, levelDef, levelInfoDef, levelOffset);
+		this->populateChunkVoxels(chunk, levelDef, levelInfoMapping, levelOffset);
+		this->populateChunkDecorators(chunk, levelDef, levelInfoDef, levelInfoMapping, levelOffset);
 
 		// Load building names for the given chunk. The wilderness might use the same level definition in
 		// multiple places, so the building names have to be generated separately.
@@ -686,14 +662,34 @@ void VoxelChunkManager::updateChunkDoorVisibilityInsts(VoxelChunk &chunk, const
 	}
 }
 
+const VoxelDefinitionRegistry &VoxelChunkManager::getDefRegistry() const
+{
+	return this->defRegistry;
+}
+
+const VoxelChunkSnapshotCache &VoxelChunkManager::getSnapshotCache() const
+{
+	return this->snapshotCache;
+}
+
+bool VoxelChunkManager::wasChunkRestored(const ChunkInt2 &position) const
+{
+	return std::find(this->restoredChunkPositions.begin(), this->restoredChunkPositions.end(), position) !=
+		this->restoredChunkPositions.end();
+}
+
 void VoxelChunkManager::update(double dt, BufferView<const ChunkInt2> newChunkPositions, BufferView<const ChunkInt2> freedChunkPositions,
 	const CoordDouble3 &playerCoord, const LevelDefinition *activeLevelDef, const LevelInfoDefinition *activeLevelInfoDef,
 	const MapSubDefinition &mapSubDef, BufferView<const LevelDefinition> levelDefs, BufferView<const int> levelInfoDefIndices,
-	BufferView<const LevelInfoDefinition> levelInfoDefs, double ceilingScale, AudioManager &audioManager)
+	BufferView<const LevelInfoDefinition> levelInfoDefs, double ceilingScale, int chunkCacheSize, AudioManager &audioManager)
 {
+	this->snapshotCache.setMaxEntryCount(chunkCacheSize);
+	this->restoredChunkPositions.clear();
+
 	for (const ChunkInt2 &chunkPos : freedChunkPositions)
 	{
 		const int chunkIndex = this->getChunkIndex(chunkPos);
+		this->snapshotCache.store(this->getChunkAtIndex(chunkIndex));
 		this->recycleChunk(chunkIndex);
 	}
 
@@ -702,6 +698,13 @@ void VoxelChunkManager::update(double dt, BufferView<const ChunkInt2> newChunkPo
 	{
 		const int spawnIndex = this->spawnChunk();
 
+		// Revisited chunks keep any changes like opened doors and faded voxels.
+		if (this->snapshotCache.tryRestore(chunkPos, this->defRegistry, this->getChunkAtIndex(spawnIndex)))
+		{
+			this->restoredChunkPositions.emplace_back(chunkPos);
+			continue;
+		}
+
 		// Default to the active level def unless it's the wilderness which relies on this chunk coordinate.
 		const LevelDefinition *levelDefPtr = activeLevelDef;
 		const LevelInfoDefinition *levelInfoDefPtr = activeLevelInfoDef;
@@ -715,7 +718,7 @@ void VoxelChunkManager::update(double dt, BufferView<const ChunkInt2> newChunkPo
 			levelInfoDefPtr = &levelInfoDefs[levelInfoDefIndex];
 		}
 
-		this->populateChunk(spawnIndex, chunkPos, *levelDefPtr, *levelInfoDefPtr, mapSubDef);
+		this->populateChunk(spawnIndex, chunkPos, *levelDefPtr, *levelInfoDefPtr, mapSubDef, audioManager);
 	}
 
 	// Free any unneeded chunks for memory savings in case the chunk distance was once large
@@ -827,3 +830,11 @@ void VoxelChunkManager::cleanUp()
 		chunkPtr->clearDirtyVoxels();
 	}
 }
+
+void VoxelChunkManager::clear()
+{
+	this->recycleAllChunks();
+	this->snapshotCache.clear();
+	this->restoredChunkPositions.clear();
+	this->defRegistry.clear();
+}
@@ -6,6 +6,8 @@
 #include <vector>
 
 #include "VoxelChunk.h"
+#include "VoxelChunkSnapshotCache.h"
+#include "VoxelDefinitionRegistry.h"
 #include "../World/Coord.h"
 #include "../World/SpecializedChunkManager.h"
 
@@ -17,6 +19,10 @@ struct MapSubDefinition;
 class VoxelChunkManager final : public SpecializedChunkManager<VoxelChunk>
 {
 private:
+	VoxelDefinitionRegistry defRegistry; // Shared by all active chunks.
+	VoxelChunkSnapshotCache snapshotCache; // Recently freed chunks, restored instead of repopulated.
+	std::vector<ChunkInt2> restoredChunkPositions; // Chunks restored from a snapshot in the latest update.
+
 	void getAdjacentVoxelMeshDefIDs(const CoordInt3 &coord, std::optional<int> *outNorthChunkIndex,
 		std::optional<int> *outEastChunkIndex, std::optional<int> *outSouthChunkIndex, std::optional<int> *outWestChunkIndex,
 		VoxelChunk::VoxelMeshDefID *outNorthID, VoxelChunk::VoxelMeshDefID *outEastID, VoxelChunk::VoxelMeshDefID *outSouthID,
@@ -30,18 +36,19 @@ private:
 		VoxelChunk::VoxelTraitsDefID *outNorthID, VoxelChunk::VoxelTraitsDefID *outEastID, VoxelChunk::VoxelTraitsDefID *outSouthID,
 		VoxelChunk::VoxelTraitsDefID *outWestID);
 
-	// Helper function for setting the chunk's voxel definitions.
+	// Helper function for setting the chunk's floor replacement voxel IDs.
 	void populateChunkVoxelDefs(VoxelChunk &chunk, const LevelDefinition &levelDefinition,
-		const LevelInfoDefinition &levelInfoDefinition);
+		const VoxelDefinitionRegistry::LevelInfoMapping &levelInfoMapping);
 
 	// Helper function for setting the chunk's voxels for the given level. This might not touch all voxels
 	// in the chunk because it does not fully overlap the level.
 	void populateChunkVoxels(VoxelChunk &chunk, const LevelDefinition &levelDefinition,
-		const WorldInt2 &levelOffset);
+		const VoxelDefinitionRegistry::LevelInfoMapping &levelInfoMapping, const WorldInt2 &levelOffset);
 
 	// Helper function for setting the chunk's secondary voxel data (transitions, triggers, etc.).
 	void populateChunkDecorators(VoxelChunk &chunk, const LevelDefinition &levelDefinition,
-		const LevelInfoDefinition &levelInfoDefinition, const WorldInt2 &levelOffset);
+		const LevelInfoDefinition &levelInfoDefinition, const VoxelDefinitionRegistry::LevelInfoMapping &levelInfoMapping,
+		const WorldInt2 &levelOffset);
 
 	// Helper function for setting a wild chunk's building names.
 	void populateWildChunkBuildingNames(VoxelChunk &chunk, const MapGeneration::WildChunkBuildingNameInfo &buildingNameInfo,
@@ -56,7 +63,7 @@ private:
 
 	// Fills the chunk with the data required based on its position and the world type.
 	void populateChunk(int index, const ChunkInt2 &chunkPos, const LevelDefinition &levelDef, const LevelInfoDefinition &levelInfoDef,
-		const MapSubDefinition &mapSubDef);
+		const MapSubDefinition &mapSubDef, AudioManager &audioManager);
 
 	// Updates a chasm (context-sensitive voxel) that may be affected by adjacent chunks.
 	void updateChasmWallInst(VoxelChunk &chunk, SNInt x, int y, WEInt z);
@@ -64,14 +71,24 @@ private:
 	// Updates door visibilities for a chunk; some of which might be on the chunk's perimeter that are affected by adjacent chunks.
 	void updateChunkDoorVisibilityInsts(VoxelChunk &chunk, const CoordDouble3 &playerCoord);
 public:
+	const VoxelDefinitionRegistry &getDefRegistry() const;
+	const VoxelChunkSnapshotCache &getSnapshotCache() const;
+
+	// Whether the chunk was restored from a snapshot in the latest update rather than populated from level
+	// definitions. Other chunk managers with their own snapshots use this to stay consistent with voxels.
+	bool wasChunkRestored(const ChunkInt2 &position) const;
+
 	void update(double dt, BufferView<const ChunkInt2> newChunkPositions, BufferView<const ChunkInt2> freedChunkPositions,
 		const CoordDouble3 &playerCoord, const LevelDefinition *activeLevelDef, const LevelInfoDefinition *activeLevelInfoDef,
 		const MapSubDefinition &mapSubDef, BufferView<const LevelDefinition> levelDefs,
 		BufferView<const int> levelInfoDefIndices, BufferView<const LevelInfoDefinition> levelInfoDefs,
-		double ceilingScale, AudioManager &audioManager);
+		double ceilingScale, int chunkCacheSize, AudioManager &audioManager);
 
 	// Run at the end of a frame to reset certain frame data like dirty voxels.
 	void cleanUp();
+
+	// Recycles all chunks, cached chunk snapshots, and their shared voxel definitions, i.e. when changing scenes.
+	void clear();
 };
 
 #endif
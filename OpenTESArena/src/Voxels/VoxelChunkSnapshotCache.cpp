@@ -0,0 +1,155 @@
+#include <algorithm>
+
+#include "VoxelChunk.h"
+#include "VoxelChunkSnapshotCache.h"
+
+#include "components/debug/Debug.h"
+
+VoxelChunkSnapshot::VoxelChunkSnapshot()
+{
+	this->height = 0;
+	this->floorReplacementMeshDefID = -1;
+	this->floorReplacementTextureDefID = -1;
+	this->floorReplacementTraitsDefID = -1;
+	this->floorReplacementChasmDefID = -1;
+}
+
+VoxelChunkSnapshotCache::Entry::Entry()
+{
+	this->lastUsedTick = 0;
+}
+
+VoxelChunkSnapshotCache::VoxelChunkSnapshotCache()
+{
+	this->maxEntryCount = 0;
+	this->currentTick = 0;
+	this->hitCount = 0;
+	this->missCount = 0;
+}
+
+int VoxelChunkSnapshotCache::findEntryIndex(const ChunkInt2 &position) const
+{
+	const auto iter = std::find_if(this->entries.begin(), this->entries.end(),
+		[&position](const Entry &entry)
+	{
+		return entry.snapshot.position == position;
+	});
+
+	if (iter == this->entries.end())
+	{
+		return -1;
+	}
+
+	return static_cast<int>(std::distance(this->entries.begin(), iter));
+}
+
+void VoxelChunkSnapshotCache::evictLeastRecentlyUsed()
+{
+	DebugAssert(!this->entries.empty());
+	const auto iter = std::min_element(this->entries.begin(), this->entries.end(),
+		[](const Entry &a, const Entry &b)
+	{
+		return a.lastUsedTick < b.lastUsedTick;
+	});
+
+	this->entries.erase(iter);
+}
+
+int VoxelChunkSnapshotCache::getEntryCount() const
+{
+	return static_cast<int>(this->entries.size());
+}
+
+int VoxelChunkSnapshotCache::getMaxEntryCount() const
+{
+	return this->maxEntryCount;
+}
+
+int VoxelChunkSnapshotCache::getHitCount() const
+{
+	return this->hitCount;
+}
+
+int VoxelChunkSnapshotCache::getMissCount() const
+{
+	return this->missCount;
+}
+
+int VoxelChunkSnapshotCache::getCompressedByteCount() const
+{
+	int byteCount = 0;
+	for (const Entry &entry : this->entries)
+	{
+		byteCount += static_cast<int>(entry.snapshot.compressedDefIDs.size());
+	}
+
+	return byteCount;
+}
+
+void VoxelChunkSnapshotCache::setMaxEntryCount(int count)
+{
+	DebugAssert(count >= 0);
+	this->maxEntryCount = count;
+
+	while (static_cast<int>(this->entries.size()) > this->maxEntryCount)
+	{
+		this->evictLeastRecentlyUsed();
+	}
+}
+
+void VoxelChunkSnapshotCache::store(VoxelChunk &chunk)
+{
+	if (this->maxEntryCount == 0)
+	{
+		return;
+	}
+
+	const ChunkInt2 &position = chunk.getPosition();
+	int entryIndex = this->findEntryIndex(position);
+	if (entryIndex < 0)
+	{
+		if (static_cast<int>(this->entries.size()) >= this->maxEntryCount)
+		{
+			this->evictLeastRecentlyUsed();
+		}
+
+		this->entries.emplace_back(Entry());
+		entryIndex = static_cast<int>(this->entries.size()) - 1;
+	}
+
+	Entry &entry = this->entries[entryIndex];
+	entry.snapshot = VoxelChunkSnapshot();
+	chunk.saveSnapshot(entry.snapshot);
+	entry.lastUsedTick = this->currentTick;
+	this->currentTick++;
+}
+
+bool VoxelChunkSnapshotCache::tryRestore(const ChunkInt2 &position, const VoxelDefinitionRegistry &defRegistry, VoxelChunk &outChunk)
+{
+	if (this->maxEntryCount == 0)
+	{
+		return false;
+	}
+
+	const int entryIndex = this->findEntryIndex(position);
+	if (entryIndex < 0)
+	{
+		this->missCount++;
+		return false;
+	}
+
+	// The chunk owns its state again until it's stored on the next unload.
+	Entry &entry = this->entries[entryIndex];
+	outChunk.initFromSnapshot(std::move(entry.snapshot), defRegistry);
+	this->entries.erase(this->entries.begin() + entryIndex);
+	this->hitCount++;
+	return true;
+}
+
+void VoxelChunkSnapshotCache::clear()
+{
+	this->entries.clear();
+	this->currentTick = 0;
+	this->hitCount = 0;
+	this->missCount = 0;
+}
@@ -0,0 +1,96 @@
+#ifndef VOXEL_CHUNK_SNAPSHOT_CACHE_H
+#define VOXEL_CHUNK_SNAPSHOT_CACHE_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "VoxelChasmWallInstance.h"
+#include "VoxelDoorAnimationInstance.h"
+#include "VoxelDoorVisibilityInstance.h"
+#include "VoxelFadeAnimationInstance.h"
+#include "VoxelTriggerDefinition.h"
+#include "VoxelTriggerInstance.h"
+#include "../World/Coord.h"
+#include "../World/LockDefinition.h"
+#include "../World/TransitionDefinition.h"
+
+class VoxelChunk;
+class VoxelDefinitionRegistry;
+
+// State of a voxel chunk that left the active chunk area. The dense voxel ID grids are run-length
+// encoded since they are mostly long runs of air, floor, and wall; sparse state is kept as-is.
+struct VoxelChunkSnapshot
+{
+	ChunkInt2 position;
+	int height;
+	std::vector<uint8_t> compressedDefIDs; // Mesh, texture, then traits def IDs.
+	int floorReplacementMeshDefID;
+	int floorReplacementTextureDefID;
+	int floorReplacementTraitsDefID;
+	int floorReplacementChasmDefID;
+
+	std::vector<TransitionDefinition> transitionDefs;
+	std::vector<VoxelTriggerDefinition> triggerDefs;
+	std::vector<LockDefinition> lockDefs;
+	std::vector<std::string> buildingNames;
+	std::unordered_map<VoxelInt3, int> transitionDefIndices;
+	std::unordered_map<VoxelInt3, int> triggerDefIndices;
+	std::unordered_map<VoxelInt3, int> lockDefIndices;
+	std::unordered_map<VoxelInt3, int> buildingNameIndices;
+	std::unordered_map<VoxelInt3, int> doorDefIndices;
+	std::unordered_map<VoxelInt3, int> chasmDefIndices;
+
+	std::vector<VoxelDoorAnimationInstance> doorAnimInsts;
+	std::vector<VoxelFadeAnimationInstance> fadeAnimInsts;
+	std::vector<VoxelChasmWallInstance> chasmWallInsts;
+	std::vector<VoxelDoorVisibilityInstance> doorVisInsts;
+	std::vector<VoxelTriggerInstance> triggerInsts;
+
+	VoxelChunkSnapshot();
+};
+
+// Bounded least-recently-used cache of voxel chunk snapshots for the active scene. Re-entering a cached
+// chunk restores it instead of regenerating it from level definitions, so changes made to it persist.
+class VoxelChunkSnapshotCache
+{
+private:
+	struct Entry
+	{
+		VoxelChunkSnapshot snapshot;
+		int64_t lastUsedTick;
+
+		Entry();
+	};
+
+	std::vector<Entry> entries;
+	int maxEntryCount;
+	int64_t currentTick;
+	int hitCount, missCount;
+
+	int findEntryIndex(const ChunkInt2 &position) const;
+	void evictLeastRecentlyUsed();
+public:
+	VoxelChunkSnapshotCache();
+
+	int getEntryCount() const;
+	int getMaxEntryCount() const;
+	int getHitCount() const;
+	int getMissCount() const;
+	int getCompressedByteCount() const;
+
+	// Evicts the least recently used snapshots if there are more than the new max. Zero disables caching.
+	void setMaxEntryCount(int count);
+
+	// Moves the chunk's state into a snapshot. The chunk should be recycled afterwards.
+	void store(VoxelChunk &chunk);
+
+	// Initializes the chunk from its snapshot if one is cached, counting a hit or miss.
+	bool tryRestore(const ChunkInt2 &position, const VoxelDefinitionRegistry &defRegistry, VoxelChunk &outChunk);
+
+	// Clears snapshots and counters, i.e. when the scene changes and voxel definition IDs are invalidated.
+	void clear();
+};
+
+#endif
@@ -0,0 +1,186 @@
+#include <algorithm>
+#include <string>
+
+#include "VoxelDefinitionRegistry.h"
+#include "../Audio/AudioManager.h"
+#include "../World/LevelInfoDefinition.h"
+
+#include "components/debug/Debug.h"
+
+VoxelDefinitionRegistry::LevelInfoMapping::LevelInfoMapping()
+{
+	this->levelInfoDef = nullptr;
+	this->meshDefOffset = -1;
+	this->textureDefOffset = -1;
+	this->traitsDefOffset = -1;
+	this->doorDefOffset = -1;
+	this->chasmDefOffset = -1;
+}
+
+void VoxelDefinitionRegistry::LevelInfoMapping::init(const LevelInfoDefinition *levelInfoDef, int meshDefOffset,
+	int textureDefOffset, int traitsDefOffset, int doorDefOffset, int chasmDefOffset)
+{
+	this->levelInfoDef = levelInfoDef;
+	this->meshDefOffset = meshDefOffset;
+	this->textureDefOffset = textureDefOffset;
+	this->traitsDefOffset = traitsDefOffset;
+	this->doorDefOffset = doorDefOffset;
+	this->chasmDefOffset = chasmDefOffset;
+}
+
+VoxelDefinitionRegistry::VoxelDefinitionRegistry()
+{
+	this->addAirDefs();
+}
+
+void VoxelDefinitionRegistry::addAirDefs()
+{
+	// Let the first voxel definition (air) be usable immediately. All default voxel IDs can safely point to it.
+	this->meshDefs.emplace_back(VoxelMeshDefinition());
+	this->textureDefs.emplace_back(VoxelTextureDefinition());
+	this->traitsDefs.emplace_back(VoxelTraitsDefinition());
+}
+
+int VoxelDefinitionRegistry::getMeshDefCount() const
+{
+	return static_cast<int>(this->meshDefs.size());
+}
+
+int VoxelDefinitionRegistry::getTextureDefCount() const
+{
+	return static_cast<int>(this->textureDefs.size());
+}
+
+int VoxelDefinitionRegistry::getTraitsDefCount() const
+{
+	return static_cast<int>(this->traitsDefs.size());
+}
+
+int VoxelDefinitionRegistry::getDoorDefCount() const
+{
+	return static_cast<int>(this->doorDefs.size());
+}
+
+int VoxelDefinitionRegistry::getChasmDefCount() const
+{
+	return static_cast<int>(this->chasmDefs.size());
+}
+
+const VoxelMeshDefinition &VoxelDefinitionRegistry::getMeshDef(VoxelMeshDefID id) const
+{
+	DebugAssertIndex(this->meshDefs, id);
+	return this->meshDefs[id];
+}
+
+const VoxelTextureDefinition &VoxelDefinitionRegistry::getTextureDef(VoxelTextureDefID id) const
+{
+	DebugAssertIndex(this->textureDefs, id);
+	return this->textureDefs[id];
+}
+
+const VoxelTraitsDefinition &VoxelDefinitionRegistry::getTraitsDef(VoxelTraitsDefID id) const
+{
+	DebugAssertIndex(this->traitsDefs, id);
+	return this->traitsDefs[id];
+}
+
+const DoorDefinition &VoxelDefinitionRegistry::getDoorDef(DoorDefID id) const
+{
+	DebugAssertIndex(this->doorDefs, id);
+	return this->doorDefs[id];
+}
+
+SoundID VoxelDefinitionRegistry::getDoorOpenSoundID(DoorDefID id) const
+{
+	DebugAssertIndex(this->doorOpenSoundIDs, id);
+	return this->doorOpenSoundIDs[id];
+}
+
+SoundID VoxelDefinitionRegistry::getDoorCloseSoundID(DoorDefID id) const
+{
+	DebugAssertIndex(this->doorCloseSoundIDs, id);
+	return this->doorCloseSoundIDs[id];
+}
+
+const ChasmDefinition &VoxelDefinitionRegistry::getChasmDef(ChasmDefID id) const
+{
+	DebugAssertIndex(this->chasmDefs, id);
+	return this->chasmDefs[id];
+}
+
+VoxelDefinitionRegistry::LevelInfoMapping VoxelDefinitionRegistry::getOrAddLevelInfoDefs(const LevelInfoDefinition &levelInfoDef,
+	AudioManager &audioManager)
+{
+	const auto iter = std::find_if(this->levelInfoMappings.begin(), this->levelInfoMappings.end(),
+		[&levelInfoDef](const LevelInfoMapping &mapping)
+	{
+		return mapping.levelInfoDef == &levelInfoDef;
+	});
+
+	if (iter != this->levelInfoMappings.end())
+	{
+		return *iter;
+	}
+
+	const int meshDefOffset = this->getMeshDefCount();
+	const int textureDefOffset = this->getTextureDefCount();
+	const int traitsDefOffset = this->getTraitsDefCount();
+	const int doorDefOffset = this->getDoorDefCount();
+	const int chasmDefOffset = this->getChasmDefCount();
+
+	const int newMeshDefCount = meshDefOffset + levelInfoDef.getVoxelMeshDefCount();
+	const int newTextureDefCount = textureDefOffset + levelInfoDef.getVoxelTextureDefCount();
+	const int newTraitsDefCount = traitsDefOffset + levelInfoDef.getVoxelTraitsDefCount();
+	if ((newMeshDefCount > MAX_COMPACT_DEF_COUNT) || (newTextureDefCount > MAX_COMPACT_DEF_COUNT) ||
+		(newTraitsDefCount > MAX_COMPACT_DEF_COUNT))
+	{
+		DebugCrash("Too many voxel definitions for compact IDs (mesh: " + std::to_string(newMeshDefCount) +
+			", texture: " + std::to_string(newTextureDefCount) + ", traits: " + std::to_string(newTraitsDefCount) + ").");
+	}
+
+	for (int i = 0; i < levelInfoDef.getVoxelMeshDefCount(); i++)
+	{
+		this->meshDefs.emplace_back(levelInfoDef.getVoxelMeshDef(i));
+	}
+
+	for (int i = 0; i < levelInfoDef.getVoxelTextureDefCount(); i++)
+	{
+		this->textureDefs.emplace_back(levelInfoDef.getVoxelTextureDef(i));
+	}
+
+	for (int i = 0; i < levelInfoDef.getVoxelTraitsDefCount(); i++)
+	{
+		this->traitsDefs.emplace_back(levelInfoDef.getVoxelTraitsDef(i));
+	}
+
+	for (int i = 0; i < levelInfoDef.getDoorDefCount(); i++)
+	{
+		const DoorDefinition &doorDef = levelInfoDef.getDoorDef(i);
+		this->doorDefs.emplace_back(doorDef);
+		this->doorOpenSoundIDs.emplace_back(audioManager.getSoundID(doorDef.getOpenSound().soundFilename));
+		this->doorCloseSoundIDs.emplace_back(audioManager.getSoundID(doorDef.getCloseSound().soundFilename));
+	}
+
+	for (int i = 0; i < levelInfoDef.getChasmDefCount(); i++)
+	{
+		this->chasmDefs.emplace_back(levelInfoDef.getChasmDef(i));
+	}
+
+	LevelInfoMapping mapping;
+	mapping.init(&levelInfoDef, meshDefOffset, textureDefOffset, traitsDefOffset, doorDefOffset, chasmDefOffset);
+	this->levelInfoMappings.emplace_back(std::move(mapping));
+	return this->levelInfoMappings.back();
+}
+
+void VoxelDefinitionRegistry::clear()
+{
+	this->meshDefs.clear();
+	this->textureDefs.clear();
+	this->traitsDefs.clear();
+	this->doorDefs.clear();
+	this->doorOpenSoundIDs.clear();
+	this->doorCloseSoundIDs.clear();
+	this->chasmDefs.clear();
+	this->levelInfoMappings.clear();
+	this->addAirDefs();
+}
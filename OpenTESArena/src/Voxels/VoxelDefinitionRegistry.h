@@ -0,0 +1,90 @@
+#ifndef VOXEL_DEFINITION_REGISTRY_H
+#define VOXEL_DEFINITION_REGISTRY_H
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "ChasmDefinition.h"
+#include "DoorDefinition.h"
+#include "VoxelMeshDefinition.h"
+#include "VoxelTextureDefinition.h"
+#include "VoxelTraitsDefinition.h"
+#include "../Audio/SoundUtils.h"
+
+class AudioManager;
+class LevelInfoDefinition;
+
+// Voxel definitions shared by all voxel chunks in the active scene. A level info definition's voxel
+// definitions are only added once regardless of how many chunks are populated from it, and chunks
+// store compact IDs into here instead of their own copies.
+
+class VoxelDefinitionRegistry
+{
+public:
+	using VoxelMeshDefID = int;
+	using VoxelTextureDefID = int;
+	using VoxelTraitsDefID = int;
+	using DoorDefID = int;
+	using ChasmDefID = int;
+
+	// Per-voxel storage type for mesh/texture/traits IDs.
+	using CompactDefID = uint16_t;
+	static constexpr int MAX_COMPACT_DEF_COUNT = static_cast<int>(std::numeric_limits<CompactDefID>::max()) + 1;
+
+	// Where a level info definition's voxel definitions start in the registry. A level info def ID
+	// plus its offset is the registry ID.
+	struct LevelInfoMapping
+	{
+		const LevelInfoDefinition *levelInfoDef;
+		int meshDefOffset;
+		int textureDefOffset;
+		int traitsDefOffset;
+		int doorDefOffset;
+		int chasmDefOffset;
+
+		LevelInfoMapping();
+
+		void init(const LevelInfoDefinition *levelInfoDef, int meshDefOffset, int textureDefOffset,
+			int traitsDefOffset, int doorDefOffset, int chasmDefOffset);
+	};
+private:
+	std::vector<VoxelMeshDefinition> meshDefs;
+	std::vector<VoxelTextureDefinition> textureDefs;
+	std::vector<VoxelTraitsDefinition> traitsDefs;
+	std::vector<DoorDefinition> doorDefs;
+	std::vector<SoundID> doorOpenSoundIDs, doorCloseSoundIDs; // Resolved when the door definitions are added.
+	std::vector<ChasmDefinition> chasmDefs;
+	std::vector<LevelInfoMapping> levelInfoMappings;
+
+	void addAirDefs();
+public:
+	static constexpr VoxelMeshDefID AIR_MESH_DEF_ID = 0;
+	static constexpr VoxelTextureDefID AIR_TEXTURE_DEF_ID = 0;
+	static constexpr VoxelTraitsDefID AIR_TRAITS_DEF_ID = 0;
+
+	VoxelDefinitionRegistry();
+
+	int getMeshDefCount() const;
+	int getTextureDefCount() const;
+	int getTraitsDefCount() const;
+	int getDoorDefCount() const;
+	int getChasmDefCount() const;
+
+	const VoxelMeshDefinition &getMeshDef(VoxelMeshDefID id) const;
+	const VoxelTextureDefinition &getTextureDef(VoxelTextureDefID id) const;
+	const VoxelTraitsDefinition &getTraitsDef(VoxelTraitsDefID id) const;
+	const DoorDefinition &getDoorDef(DoorDefID id) const;
+	SoundID getDoorOpenSoundID(DoorDefID id) const;
+	SoundID getDoorCloseSoundID(DoorDefID id) const;
+	const ChasmDefinition &getChasmDef(ChasmDefID id) const;
+
+	// Gets the ID offsets for the level info definition's voxel definitions, adding them if this is the
+	// first chunk to use them. Door sounds are interned at that point so playing them is an ID lookup.
+	LevelInfoMapping getOrAddLevelInfoDefs(const LevelInfoDefinition &levelInfoDef, AudioManager &audioManager);
+
+	// Clears all definitions except air. Chunks referencing the registry must be cleared first.
+	void clear();
+};
+
+#endif
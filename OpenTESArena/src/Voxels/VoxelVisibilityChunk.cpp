@@ -1,30 +1,238 @@
+#include "VoxelChunk.h"
 #include "VoxelVisibilityChunk.h"
 #include "../Rendering/RenderCamera.h"
+#include "../Rendering/RendererUtils.h"
+
+#include "components/debug/Debug.h"
+
+namespace
+{
+	// Horizontal padding for quadtree nodes so voxel geometry that leaves its voxel (swinging doors, etc.)
+	// isn't culled too early.
+	constexpr double TreeNodePadding = 1.0;
+
+	// Arena interiors have their walls on the main floor above the ground voxels.
+	constexpr int OccluderVoxelY = 1;
+
+	bool IsOccluderVoxel(SNInt x, WEInt z, const VoxelChunk &voxelChunk)
+	{
+		if (voxelChunk.getHeight() <= OccluderVoxelY)
+		{
+			return false;
+		}
+
+		const VoxelChunk::VoxelTraitsDefID traitsDefID = voxelChunk.getTraitsDefID(x, OccluderVoxelY, z);
+		const VoxelTraitsDefinition &traitsDef = voxelChunk.getTraitsDef(traitsDefID);
+		return traitsDef.type == ArenaTypes::VoxelType::Wall;
+	}
+}
+
+VoxelVisibilityChunk::VoxelVisibilityChunk()
+{
+	this->insideFrustumCount = 0;
+}
 
 void VoxelVisibilityChunk::init(const ChunkInt2 &position, int height, double ceilingScale)
 {
 	Chunk::init(position, height);
 
+	const double chunkHeightReal = static_cast<double>(height) * ceilingScale;
 	const CoordDouble3 chunkMinCoord(position, VoxelDouble3::Zero);
-	const CoordDouble3 chunkMaxCoord(position, VoxelDouble3(static_cast<SNDouble>(Chunk::WIDTH), static_cast<double>(height) * ceilingScale, static_cast<WEDouble>(Chunk::DEPTH)));
+	const CoordDouble3 chunkMaxCoord(position, VoxelDouble3(static_cast<SNDouble>(Chunk::WIDTH), chunkHeightReal, static_cast<WEDouble>(Chunk::DEPTH)));
 	const WorldDouble3 chunkMinPoint = VoxelUtils::coordToWorldPoint(chunkMinCoord);
 	const WorldDouble3 chunkMaxPoint = VoxelUtils::coordToWorldPoint(chunkMaxCoord);
 	this->bbox.init(chunkMinPoint, chunkMaxPoint);
 
+	const int treeNodeCount = VoxelVisibilityChunk::getNodeOffsetAtLevel(TREE_LEVEL_COUNT);
+	this->treeBBoxes.init(treeNodeCount);
+	this->treeNodeResults.init(treeNodeCount);
+	this->treeNodeResults.fill(TreeNodeResult::None);
+	for (int level = 0; level < TREE_LEVEL_COUNT; level++)
+	{
+		const int levelNodeOffset = VoxelVisibilityChunk::getNodeOffsetAtLevel(level);
+		const int levelDim = 1 << level;
+		const int nodeVoxelDim = Chunk::WIDTH / levelDim;
+		for (WEInt z = 0; z < levelDim; z++)
+		{
+			for (SNInt x = 0; x < levelDim; x++)
+			{
+				const VoxelDouble3 nodeMinVoxel(
+					static_cast<SNDouble>(x * nodeVoxelDim) - TreeNodePadding,
+					0.0,
+					static_cast<WEDouble>(z * nodeVoxelDim) - TreeNodePadding);
+				const VoxelDouble3 nodeMaxVoxel(
+					static_cast<SNDouble>((x + 1) * nodeVoxelDim) + TreeNodePadding,
+					chunkHeightReal,
+					static_cast<WEDouble>((z + 1) * nodeVoxelDim) + TreeNodePadding);
+				const WorldDouble3 nodeMinPoint = VoxelUtils::coordToWorldPoint(CoordDouble3(position, nodeMinVoxel));
+				const WorldDouble3 nodeMaxPoint = VoxelUtils::coordToWorldPoint(CoordDouble3(position, nodeMaxVoxel));
+
+				BoundingBox3D &nodeBBox = this->treeBBoxes.get(levelNodeOffset + x + (z * levelDim));
+				nodeBBox.init(nodeMinPoint, nodeMaxPoint);
+			}
+		}
+	}
+
 	this->insideFrustumTests.init(Chunk::WIDTH, height, Chunk::DEPTH);
 	this->insideFrustumTests.fill(false);
+	this->insideFrustumCount = 0;
+
+	this->occluderColumns.init(Chunk::WIDTH, Chunk::DEPTH);
+	this->occluderColumns.fill(false);
+	this->reachableColumns.init(Chunk::WIDTH, Chunk::DEPTH);
+	this->reachableColumns.fill(false);
+}
+
+void VoxelVisibilityChunk::initOccluders(const VoxelChunk &voxelChunk)
+{
+	for (WEInt z = 0; z < Chunk::DEPTH; z++)
+	{
+		for (SNInt x = 0; x < Chunk::WIDTH; x++)
+		{
+			this->updateOccluder(x, z, voxelChunk);
+		}
+	}
+}
+
+void VoxelVisibilityChunk::updateOccluder(SNInt x, WEInt z, const VoxelChunk &voxelChunk)
+{
+	this->occluderColumns.set(x, z, IsOccluderVoxel(x, z, voxelChunk));
+}
+
+void VoxelVisibilityChunk::fillNode(int level, int nodeX, int nodeZ, bool isInsideFrustum)
+{
+	const int nodeVoxelDim = Chunk::WIDTH >> level;
+	const SNInt startX = nodeX * nodeVoxelDim;
+	const WEInt startZ = nodeZ * nodeVoxelDim;
+	const int height = this->insideFrustumTests.getHeight();
+	for (WEInt z = startZ; z < (startZ + nodeVoxelDim); z++)
+	{
+		for (int y = 0; y < height; y++)
+		{
+			for (SNInt x = startX; x < (startX + nodeVoxelDim); x++)
+			{
+				this->insideFrustumTests.set(x, y, z, isInsideFrustum);
+			}
+		}
+	}
+
+	if (isInsideFrustum)
+	{
+		this->insideFrustumCount += nodeVoxelDim * nodeVoxelDim * height;
+	}
+}
+
+void VoxelVisibilityChunk::updateNode(int level, int nodeX, int nodeZ, bool canReuseResult, const RenderCamera &camera)
+{
+	const int levelDim = 1 << level;
+	const int nodeIndex = VoxelVisibilityChunk::getNodeOffsetAtLevel(level) + nodeX + (nodeZ * levelDim);
+	const BoundingBox3D &nodeBBox = this->treeBBoxes.get(nodeIndex);
+	const VisibilityType visibilityType = RendererUtils::getBoundingBoxVisibilityType(nodeBBox, camera);
+
+	TreeNodeResult result;
+	if (visibilityType == VisibilityType::Outside)
+	{
+		result = TreeNodeResult::Outside;
+	}
+	else if ((visibilityType == VisibilityType::Inside) || (level == LEAF_LEVEL_INDEX))
+	{
+		// Partially-visible leaves are treated as inside.
+		result = TreeNodeResult::Inside;
+	}
+	else
+	{
+		DebugAssert(visibilityType == VisibilityType::Partial);
+		result = TreeNodeResult::Partial;
+	}
+
+	TreeNodeResult &prevResult = this->treeNodeResults.get(nodeIndex);
+	if (!canReuseResult)
+	{
+		prevResult = TreeNodeResult::None;
+	}
+
+	if (result == TreeNodeResult::Partial)
+	{
+		// Children only still hold their own results if this node didn't fill over them.
+		const bool canReuseChildResults = prevResult == TreeNodeResult::Partial;
+		prevResult = TreeNodeResult::Partial;
+
+		const int childLevel = level + 1;
+		const int childNodeX = nodeX * 2;
+		const int childNodeZ = nodeZ * 2;
+		this->updateNode(childLevel, childNodeX, childNodeZ, canReuseChildResults, camera);
+		this->updateNode(childLevel, childNodeX + 1, childNodeZ, canReuseChildResults, camera);
+		this->updateNode(childLevel, childNodeX, childNodeZ + 1, canReuseChildResults, camera);
+		this->updateNode(childLevel, childNodeX + 1, childNodeZ + 1, canReuseChildResults, camera);
+		return;
+	}
+
+	const bool isInsideFrustum = result == TreeNodeResult::Inside;
+	if (result != prevResult)
+	{
+		this->fillNode(level, nodeX, nodeZ, isInsideFrustum);
+		prevResult = result;
+	}
+	else if (isInsideFrustum)
+	{
+		const int nodeVoxelDim = Chunk::WIDTH >> level;
+		this->insideFrustumCount += nodeVoxelDim * nodeVoxelDim * this->insideFrustumTests.getHeight();
+	}
+}
+
+void VoxelVisibilityChunk::invalidateColumnNodes(SNInt x, WEInt z)
+{
+	for (int level = 0; level < TREE_LEVEL_COUNT; level++)
+	{
+		const int levelDim = 1 << level;
+		const int nodeVoxelDim = Chunk::WIDTH >> level;
+		const int nodeIndex = VoxelVisibilityChunk::getNodeOffsetAtLevel(level) + (x / nodeVoxelDim) + ((z / nodeVoxelDim) * levelDim);
+		TreeNodeResult &result = this->treeNodeResults.get(nodeIndex);
+		if (result != TreeNodeResult::Partial)
+		{
+			result = TreeNodeResult::None;
+		}
+	}
 }
 
 void VoxelVisibilityChunk::update(const RenderCamera &camera)
 {
-	// @todo: test voxels for visibility
+	this->insideFrustumCount = 0;
+	this->updateNode(0, 0, 0, true, camera);
+}
+
+void VoxelVisibilityChunk::cullUnreachableColumns()
+{
+	const int height = this->insideFrustumTests.getHeight();
+	for (WEInt z = 0; z < Chunk::DEPTH; z++)
+	{
+		for (SNInt x = 0; x < Chunk::WIDTH; x++)
+		{
+			// Columns are either entirely inside or outside the frustum.
+			if (this->reachableColumns.get(x, z) || !this->insideFrustumTests.get(x, 0, z))
+			{
+				continue;
+			}
+
+			for (int y = 0; y < height; y++)
+			{
+				this->insideFrustumTests.set(x, y, z, false);
+			}
 
-	this->insideFrustumTests.fill(true);
+			this->insideFrustumCount -= height;
+			this->invalidateColumnNodes(x, z);
+		}
+	}
 }
 
 void VoxelVisibilityChunk::clear()
 {
 	Chunk::clear();
 	this->bbox.clear();
+	this->treeBBoxes.clear();
+	this->treeNodeResults.clear();
 	this->insideFrustumTests.clear();
+	this->insideFrustumCount = 0;
+	this->occluderColumns.clear();
+	this->reachableColumns.clear();
 }
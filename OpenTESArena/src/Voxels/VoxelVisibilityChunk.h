@@ -1,28 +1,85 @@
 #ifndef VOXEL_VISIBILITY_CHUNK_H
 #define VOXEL_VISIBILITY_CHUNK_H
 
+#include <cstdint>
+
 #include "../Math/BoundingBox.h"
 #include "../World/Chunk.h"
 
+#include "components/utilities/Buffer.h"
+#include "components/utilities/Buffer2D.h"
 #include "components/utilities/Buffer3D.h"
 
+class VoxelChunk;
+
 struct RenderCamera;
 
 struct VoxelVisibilityChunk final : public Chunk
 {
+	// Quadtree over the chunk's XZ area. Level 0 is the whole chunk and the last level has one leaf per voxel column.
+	static_assert(Chunk::WIDTH == Chunk::DEPTH);
+	static_assert(MathUtils::isPowerOf2(Chunk::WIDTH));
+	static constexpr int TREE_LEVEL_COUNT = Bytes::getSetBitCount(Chunk::WIDTH - 1) + 1; // log2(width) + 1
+	static constexpr int LEAF_LEVEL_INDEX = TREE_LEVEL_COUNT - 1;
+
 	BoundingBox3D bbox; // Contains the entire chunk.
-	// @todo: mipmapped bounding boxes for each quadtree level; all are the same Y size
-	// - each bounding box should have a set of voxel indices it covers
-	
+
+	// Frustum result last written by each quadtree node, so nodes whose result hasn't changed skip rewriting
+	// their voxels. Nodes below a filled node are stale until it becomes partial again.
+	enum class TreeNodeResult : uint8_t
+	{
+		None, // Voxels don't reflect this node (never filled, or overwritten since).
+		Outside,
+		Inside,
+		Partial // Children hold the results.
+	};
+
+	// Bounding boxes of every quadtree node, one level after another. All span the chunk's full height.
+	Buffer<BoundingBox3D> treeBBoxes;
+	Buffer<TreeNodeResult> treeNodeResults;
+
 	Buffer3D<bool> insideFrustumTests;
+	int insideFrustumCount; // Number of voxels inside the frustum as of the last update.
+
+	// Columns whose main floor voxel blocks line of sight in interiors. Doors and see-through voxels are portals.
+	Buffer2D<bool> occluderColumns;
+	Buffer2D<bool> reachableColumns; // Columns reached by portal traversal this frame.
 	
 	// @todo: a "visibleToEyeTests" Buffer3D which would check occlusion too. Cares about ceilingScale-corrected corners and opaque faces. Projects into camera space?
 	// - this could potentially get very complicated (i.e. each occlusion test could check a 3D tile of voxels instead of just one...)
 
+	VoxelVisibilityChunk();
+
+	static constexpr int getNodeCountAtLevel(int level)
+	{
+		return 1 << (level * 2);
+	}
+
+	// Index of the level's first node in the tree bounding boxes.
+	static constexpr int getNodeOffsetAtLevel(int level)
+	{
+		return (getNodeCountAtLevel(level) - 1) / 3;
+	}
+
 	void init(const ChunkInt2 &position, int height, double ceilingScale);
 
+	void initOccluders(const VoxelChunk &voxelChunk);
+	void updateOccluder(SNInt x, WEInt z, const VoxelChunk &voxelChunk);
+
 	void update(const RenderCamera &camera);
+
+	// Removes columns inside the frustum that portal traversal didn't reach.
+	void cullUnreachableColumns();
+
 	void clear();
+private:
+	// Sets the inside frustum result for every voxel covered by the node.
+	void fillNode(int level, int nodeX, int nodeZ, bool isInsideFrustum);
+
+	void updateNode(int level, int nodeX, int nodeZ, bool canReuseResult, const RenderCamera &camera);
+
+	// Forces the nodes covering a column to be refilled next update.
+	void invalidateColumnNodes(SNInt x, WEInt z);
 };
 
 #endif
@@ -1,8 +1,92 @@
+#include <algorithm>
+
 #include "VoxelChunkManager.h"
 #include "VoxelVisibilityChunkManager.h"
+#include "../Rendering/RenderCamera.h"
+
+VoxelVisibilityChunkManager::VoxelVisibilityChunkManager()
+{
+	this->visibleVoxelCount = 0;
+	this->culledVoxelCount = 0;
+}
+
+void VoxelVisibilityChunkManager::cullUnreachableColumns(const RenderCamera &camera)
+{
+	VoxelVisibilityChunk *cameraChunk = this->tryGetChunkAtPosition(camera.chunk);
+	if (cameraChunk == nullptr)
+	{
+		return;
+	}
+
+	for (ChunkPtr &chunkPtr : this->activeChunks)
+	{
+		chunkPtr->reachableColumns.fill(false);
+	}
+
+	const VoxelInt3 cameraVoxel = VoxelUtils::pointToVoxel(camera.chunkPoint);
+	const SNInt cameraX = std::clamp(cameraVoxel.x, 0, Chunk::WIDTH - 1);
+	const WEInt cameraZ = std::clamp(cameraVoxel.z, 0, Chunk::DEPTH - 1);
+
+	this->traversalColumns.clear();
+	this->traversalColumns.push_back({ cameraChunk, cameraX, cameraZ });
+	cameraChunk->reachableColumns.set(cameraX, cameraZ, true);
+
+	const VoxelInt2 directions[] = { VoxelUtils::North, VoxelUtils::East, VoxelUtils::South, VoxelUtils::West };
+
+	// Breadth-first; every column on a straight line of sight from the camera is 4-connected to it.
+	for (size_t i = 0; i < this->traversalColumns.size(); i++)
+	{
+		const TraversalColumn column = this->traversalColumns[i];
+		const bool isCameraColumn = i == 0;
+		if (!isCameraColumn && column.chunk->occluderColumns.get(column.x, column.z))
+		{
+			// Wall faces are visible but nothing behind them.
+			continue;
+		}
+
+		const ChunkInt2 &chunkPos = column.chunk->getPosition();
+		const CoordInt3 coord(chunkPos, VoxelInt3(column.x, 0, column.z));
+		for (const VoxelInt2 &direction : directions)
+		{
+			const CoordInt3 adjacentCoord = VoxelUtils::getAdjacentCoordXZ(coord, direction);
+			VoxelVisibilityChunk *adjacentChunk = (adjacentCoord.chunk == chunkPos) ?
+				column.chunk : this->tryGetChunkAtPosition(adjacentCoord.chunk);
+			if (adjacentChunk == nullptr)
+			{
+				continue;
+			}
+
+			const SNInt adjacentX = adjacentCoord.voxel.x;
+			const WEInt adjacentZ = adjacentCoord.voxel.z;
+			if (adjacentChunk->reachableColumns.get(adjacentX, adjacentZ) ||
+				!adjacentChunk->insideFrustumTests.get(adjacentX, 0, adjacentZ))
+			{
+				continue;
+			}
+
+			adjacentChunk->reachableColumns.set(adjacentX, adjacentZ, true);
+			this->traversalColumns.push_back({ adjacentChunk, adjacentX, adjacentZ });
+		}
+	}
+
+	for (ChunkPtr &chunkPtr : this->activeChunks)
+	{
+		chunkPtr->cullUnreachableColumns();
+	}
+}
+
+int VoxelVisibilityChunkManager::getVisibleVoxelCount() const
+{
+	return this->visibleVoxelCount;
+}
+
+int VoxelVisibilityChunkManager::getCulledVoxelCount() const
+{
+	return this->culledVoxelCount;
+}
 
 void VoxelVisibilityChunkManager::update(BufferView<const ChunkInt2> newChunkPositions, BufferView<const ChunkInt2> freedChunkPositions,
-	const RenderCamera &camera, double ceilingScale, const VoxelChunkManager &voxelChunkManager)
+	const RenderCamera &camera, double ceilingScale, bool isInterior, const VoxelChunkManager &voxelChunkManager)
 {
 	for (const ChunkInt2 &chunkPos : freedChunkPositions)
 	{
@@ -17,12 +101,35 @@ void VoxelVisibilityChunkManager::update(BufferView<const ChunkInt2> newChunkPos
 		const int spawnIndex = this->spawnChunk();
 		VoxelVisibilityChunk &visChunk = this->getChunkAtIndex(spawnIndex);
 		visChunk.init(chunkPos, voxelChunk.getHeight(), ceilingScale);
+		visChunk.initOccluders(voxelChunk);
 	}
 
 	this->chunkPool.clear();
 
+	this->visibleVoxelCount = 0;
+	this->culledVoxelCount = 0;
+
 	for (ChunkPtr &chunkPtr : this->activeChunks)
 	{
+		const VoxelChunk &voxelChunk = voxelChunkManager.getChunkAtPosition(chunkPtr->getPosition());
+		for (const VoxelInt3 &voxel : voxelChunk.getDirtyMeshDefPositions())
+		{
+			chunkPtr->updateOccluder(voxel.x, voxel.z, voxelChunk);
+		}
+
 		chunkPtr->update(camera);
 	}
+
+	if (isInterior)
+	{
+		this->cullUnreachableColumns(camera);
+	}
+
+	for (const ChunkPtr &chunkPtr : this->activeChunks)
+	{
+		const Buffer3D<bool> &insideFrustumTests = chunkPtr->insideFrustumTests;
+		const int chunkVoxelCount = insideFrustumTests.getWidth() * insideFrustumTests.getHeight() * insideFrustumTests.getDepth();
+		this->visibleVoxelCount += chunkPtr->insideFrustumCount;
+		this->culledVoxelCount += chunkVoxelCount - chunkPtr->insideFrustumCount;
+	}
 }
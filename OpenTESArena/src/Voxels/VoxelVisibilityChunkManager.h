@@ -1,6 +1,8 @@
 #ifndef VOXEL_VISIBILITY_CHUNK_MANAGER_H
 #define VOXEL_VISIBILITY_CHUNK_MANAGER_H
 
+#include <vector>
+
 #include "VoxelVisibilityChunk.h"
 #include "../World/SpecializedChunkManager.h"
 
@@ -12,9 +14,28 @@ struct RenderCamera;
 
 class VoxelVisibilityChunkManager final : public SpecializedChunkManager<VoxelVisibilityChunk>
 {
+private:
+	struct TraversalColumn
+	{
+		VoxelVisibilityChunk *chunk;
+		SNInt x;
+		WEInt z;
+	};
+
+	int visibleVoxelCount, culledVoxelCount; // Totals across active chunks as of the last update.
+	std::vector<TraversalColumn> traversalColumns; // Reused each frame.
+
+	// Flood fills from the camera's column through non-occluding columns inside the frustum. Anything
+	// not reached can't be seen in an enclosed interior.
+	void cullUnreachableColumns(const RenderCamera &camera);
 public:
+	VoxelVisibilityChunkManager();
+
+	int getVisibleVoxelCount() const;
+	int getCulledVoxelCount() const;
+
 	void update(BufferView<const ChunkInt2> newChunkPositions, BufferView<const ChunkInt2> freedChunkPositions,
-		const RenderCamera &camera, double ceilingScale, const VoxelChunkManager &voxelChunkManager);
+		const RenderCamera &camera, double ceilingScale, bool isInterior, const VoxelChunkManager &voxelChunkManager);
 };
 
 #endif
@@ -1,9 +1,15 @@
 #include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <cstdlib>
 #include <ctime>
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <mutex>
+#include <thread>
 
 #include "Debug.h"
 #include "../utilities/Directory.h"
@@ -11,9 +17,8 @@
 
 namespace
 {
-	std::tm GetCalendarDateTime()
+	std::tm GetCalendarDateTime(std::chrono::system_clock::time_point clock)
 	{
-		const auto clock = std::chrono::system_clock::now();
 		const std::time_t clockAsTime = std::chrono::system_clock::to_time_t(clock);
 
 		std::tm tm;
@@ -48,6 +53,31 @@ namespace
 
 		return DebugMessageTypeNames[index].second;
 	}
+
+	// Same as Debug::getShorterPath() but points into the given string instead of allocating.
+	const char *GetShorterPathPtr(const char *__file__)
+	{
+		const char *lastSeparator = nullptr;
+		const char *secondLastSeparator = nullptr;
+		for (const char *c = __file__; *c != '\0'; c++)
+		{
+			if ((*c == '/') || (*c == '\\'))
+			{
+				secondLastSeparator = lastSeparator;
+				lastSeparator = c;
+			}
+		}
+
+		return (secondLastSeparator != nullptr) ? (secondLastSeparator + 1) : __file__;
+	}
+
+	// Small sequential ID for the calling thread so log lines are easy to tell apart.
+	int GetThreadLogID()
+	{
+		static std::atomic<int> nextID(0);
+		thread_local const int id = nextID.fetch_add(1);
+		return id;
+	}
 }
 
 namespace Log
@@ -56,6 +86,184 @@ namespace Log
 
 	char pathBuffer[1024];
 	std::ofstream stream;
+	std::mutex mutex; // Guards the outputs and taking messages off the queue.
+
+	// A message waiting for the flusher thread. Slots are reused so their text keeps its capacity.
+	struct Message
+	{
+		std::atomic<size_t> sequence;
+		DebugMessageType type;
+		const char *filePath; // Points into a __FILE__ literal.
+		int lineNumber;
+		int threadID;
+		std::chrono::system_clock::time_point time;
+		std::string text;
+	};
+
+	// Bounded multi-producer queue. Each slot's sequence number says whether it's free for the
+	// producer at that position or ready for the consumer, so producers never take a lock.
+	constexpr size_t QUEUE_CAPACITY = 8192; // Must be a power of two.
+	Message queue[QUEUE_CAPACITY];
+	std::atomic<size_t> enqueuePos;
+	size_t dequeuePos; // Guarded by the mutex.
+	std::atomic<int> droppedCount; // Messages lost because the queue was full.
+
+	// The flusher thread writes queued messages to disk. Until it's running (and after shutdown),
+	// messages are written on the calling thread.
+	std::atomic<bool> isAsync(false);
+	std::thread flusherThread;
+	std::mutex flusherMutex;
+	std::condition_variable flusherCondition;
+	bool flusherQuit = false; // Guarded by the flusher mutex.
+	constexpr std::chrono::milliseconds FLUSH_INTERVAL(50);
+
+	// Bursts of the same message from one call site are cut off after a few repeats per window.
+	constexpr int MAX_REPEATS_PER_WINDOW = 5;
+	constexpr std::chrono::seconds REPEAT_WINDOW(1);
+
+	struct RepeatState
+	{
+		size_t hash;
+		const char *filePath; // Call site of the message being counted.
+		int lineNumber;
+		std::chrono::steady_clock::time_point windowStart;
+		int count; // Times the message was seen in the current window.
+		int suppressedCount;
+	};
+
+	thread_local RepeatState repeatState = { 0, nullptr, 0, std::chrono::steady_clock::time_point(), 0, 0 };
+
+	void AppendFormatted(DebugMessageType type, const char *filePath, int lineNumber, int threadID,
+		std::chrono::system_clock::time_point time, const std::string &text, std::string &outStr)
+	{
+		const std::tm tm = GetCalendarDateTime(time);
+		const auto millisecondsSinceEpoch = std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch());
+		char prefixBuffer[64];
+		std::snprintf(prefixBuffer, std::size(prefixBuffer), "[%02d:%02d:%02d.%03d][T%d]", tm.tm_hour, tm.tm_min, tm.tm_sec,
+			static_cast<int>(millisecondsSinceEpoch.count() % 1000), threadID);
+
+		outStr += prefixBuffer;
+		outStr += '[';
+		outStr += filePath;
+		outStr += '(';
+		outStr += std::to_string(lineNumber);
+		outStr += ")] ";
+		outStr += GetDebugMessageTypeString(type);
+		outStr += text;
+		outStr += '\n';
+	}
+
+	// Must be called with the mutex held.
+	void WriteOutput(const std::string &outputStr)
+	{
+		std::cerr << outputStr;
+		Log::stream << outputStr;
+	}
+
+	bool TryEnqueue(DebugMessageType type, const char *filePath, int lineNumber, const std::string &text)
+	{
+		size_t pos = Log::enqueuePos.load(std::memory_order_relaxed);
+		Message *message;
+		while (true)
+		{
+			message = &Log::queue[pos & (QUEUE_CAPACITY - 1)];
+			const size_t sequence = message->sequence.load(std::memory_order_acquire);
+			const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+			if (diff == 0)
+			{
+				if (Log::enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if (diff < 0)
+			{
+				// Full.
+				return false;
+			}
+			else
+			{
+				pos = Log::enqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+
+		message->type = type;
+		message->filePath = filePath;
+		message->lineNumber = lineNumber;
+		message->threadID = GetThreadLogID();
+		message->time = std::chrono::system_clock::now();
+		message->text.assign(text);
+		message->sequence.store(pos + 1, std::memory_order_release);
+
+		// Wake the flusher early when a burst fills half the queue.
+		if ((pos & ((QUEUE_CAPACITY / 2) - 1)) == 0)
+		{
+			Log::flusherCondition.notify_one();
+		}
+
+		return true;
+	}
+
+	// Reports how many repeats of the counted message were cut off, attributed to its call site.
+	void FlushSuppressedRepeats(RepeatState &state)
+	{
+		if (state.suppressedCount > 0)
+		{
+			const std::string suppressedMessage = "Suppressed " + std::to_string(state.suppressedCount) + " repeat(s) of a message.";
+			if (!TryEnqueue(DebugMessageType::Status, state.filePath, state.lineNumber, suppressedMessage))
+			{
+				Log::droppedCount++;
+			}
+
+			state.suppressedCount = 0;
+		}
+	}
+
+	// Writes every ready message. Must be called with the mutex held.
+	void DrainQueue()
+	{
+		std::string outputStr;
+		while (true)
+		{
+			Message &message = Log::queue[Log::dequeuePos & (QUEUE_CAPACITY - 1)];
+			const size_t sequence = message.sequence.load(std::memory_order_acquire);
+			if (sequence != (Log::dequeuePos + 1))
+			{
+				// Empty, or the next producer hasn't finished writing its message.
+				break;
+			}
+
+			AppendFormatted(message.type, message.filePath, message.lineNumber, message.threadID, message.time,
+				message.text, outputStr);
+			message.sequence.store(Log::dequeuePos + QUEUE_CAPACITY, std::memory_order_release);
+			Log::dequeuePos++;
+		}
+
+		const int droppedCount = Log::droppedCount.exchange(0);
+		if (droppedCount > 0)
+		{
+			AppendFormatted(DebugMessageType::Warning, GetShorterPathPtr(__FILE__), __LINE__, GetThreadLogID(),
+				std::chrono::system_clock::now(), std::to_string(droppedCount) + " log message(s) dropped, queue was full.", outputStr);
+		}
+
+		if (!outputStr.empty())
+		{
+			WriteOutput(outputStr);
+			Log::stream.flush();
+		}
+	}
+
+	void FlusherProc()
+	{
+		std::unique_lock<std::mutex> flusherLock(Log::flusherMutex);
+		while (!Log::flusherQuit)
+		{
+			Log::flusherCondition.wait_for(flusherLock, FLUSH_INTERVAL);
+
+			std::lock_guard<std::mutex> lock(Log::mutex);
+			DrainQueue();
+		}
+	}
 }
 
 bool Debug::init(const char *logDirectory)
@@ -77,7 +285,7 @@ bool Debug::init(const char *logDirectory)
 		Directory::deleteOldestFile(logDirectory);
 	}
 
-	const std::tm tm = GetCalendarDateTime();
+	const std::tm tm = GetCalendarDateTime(std::chrono::system_clock::now());
 	char timeStrBuffer[256];
 	std::strftime(timeStrBuffer, std::size(timeStrBuffer), "%H`%M`%S %z %m-%d-%Y", &tm);
 	std::snprintf(Log::pathBuffer, std::size(Log::pathBuffer), "%slog %s.txt", logDirectory, timeStrBuffer);
@@ -89,15 +297,60 @@ bool Debug::init(const char *logDirectory)
 		return false;
 	}
 
+	for (size_t i = 0; i < Log::QUEUE_CAPACITY; i++)
+	{
+		Log::queue[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	Log::enqueuePos.store(0, std::memory_order_relaxed);
+	Log::dequeuePos = 0;
+	Log::droppedCount.store(0);
+	Log::flusherQuit = false;
+	Log::flusherThread = std::thread(Log::FlusherProc);
+	Log::isAsync.store(true, std::memory_order_release);
+
+	// Make sure queued messages reach the file even if something calls exit() directly.
+	static bool isExitHandlerRegistered = false;
+	if (!isExitHandlerRegistered)
+	{
+		std::atexit([]() { Debug::shutdown(); });
+		isExitHandlerRegistered = true;
+	}
+
 	return true;
 }
 
 void Debug::shutdown()
 {
+	if (Log::flusherThread.joinable())
+	{
+		Log::isAsync.store(false, std::memory_order_release);
+
+		{
+			std::lock_guard<std::mutex> flusherLock(Log::flusherMutex);
+			Log::flusherQuit = true;
+		}
+
+		Log::flusherCondition.notify_all();
+		Log::flusherThread.join();
+	}
+
+	// Only this thread's count is reachable here; other threads report theirs on their next message.
+	Log::FlushSuppressedRepeats(Log::repeatState);
+
+	std::lock_guard<std::mutex> lock(Log::mutex);
+	Log::DrainQueue();
 	Log::stream.close();
 	std::fill(std::begin(Log::pathBuffer), std::end(Log::pathBuffer), '\0');
 }
 
+void Debug::flush()
+{
+	std::lock_guard<std::mutex> lock(Log::mutex);
+	Log::DrainQueue();
+	std::cerr.flush();
+}
+
 std::string Debug::getShorterPath(const char *__file__)
 {
 	// Replace back-slashes with forward slashes, then split.
@@ -118,34 +371,72 @@ std::string Debug::getShorterPath(const char *__file__)
 	return shortPath;
 }
 
-void Debug::write(DebugMessageType type, const std::string &filePath, int lineNumber, const std::string &message)
+void Debug::write(DebugMessageType type, const char *__file__, int lineNumber, const std::string &message)
 {
-	const std::string &messageTypeStr = GetDebugMessageTypeString(type);
-	const std::string lineNumberStr = std::to_string(lineNumber);
-	const std::string outputStr = "[" + filePath + "(" + lineNumberStr + ")] " + messageTypeStr + message + '\n';
-	std::cerr << outputStr;
-	Log::stream << outputStr;
+	const char *filePath = GetShorterPathPtr(__file__);
+
+	if (!Log::isAsync.load(std::memory_order_acquire))
+	{
+		std::string outputStr;
+		Log::AppendFormatted(type, filePath, lineNumber, GetThreadLogID(), std::chrono::system_clock::now(), message, outputStr);
+
+		std::lock_guard<std::mutex> lock(Log::mutex);
+		Log::WriteOutput(outputStr);
+		return;
+	}
+
+	// Rate-limit the same message repeating from the same call site on this thread.
+	Log::RepeatState &repeatState = Log::repeatState;
+	const size_t hash = std::hash<std::string>()(message) ^ (std::hash<const void*>()(__file__) + static_cast<size_t>(lineNumber));
+	const auto now = std::chrono::steady_clock::now();
+	if ((hash == repeatState.hash) && ((now - repeatState.windowStart) < Log::REPEAT_WINDOW))
+	{
+		repeatState.count++;
+		if (repeatState.count > Log::MAX_REPEATS_PER_WINDOW)
+		{
+			repeatState.suppressedCount++;
+			return;
+		}
+	}
+	else
+	{
+		Log::FlushSuppressedRepeats(repeatState);
+
+		repeatState.hash = hash;
+		repeatState.filePath = filePath;
+		repeatState.lineNumber = lineNumber;
+		repeatState.windowStart = now;
+		repeatState.count = 1;
+	}
+
+	if (!Log::TryEnqueue(type, filePath, lineNumber, message))
+	{
+		Log::droppedCount++;
+	}
 }
 
 void Debug::log(const char *__file__, int lineNumber, const std::string &message)
 {
-	Debug::write(DebugMessageType::Status, Debug::getShorterPath(__file__), lineNumber, message);
+	Debug::write(DebugMessageType::Status, __file__, lineNumber, message);
 }
 
 void Debug::logWarning(const char *__file__, int lineNumber, const std::string &message)
 {
-	Debug::write(DebugMessageType::Warning, Debug::getShorterPath(__file__), lineNumber, message);
+	Debug::write(DebugMessageType::Warning, __file__, lineNumber, message);
 }
 
 void Debug::logError(const char *__file__, int lineNumber, const std::string &message)
 {
-	Debug::write(DebugMessageType::Error, Debug::getShorterPath(__file__), lineNumber, message);
+	Debug::write(DebugMessageType::Error, __file__, lineNumber, message);
 }
 
 void Debug::crash(const char *__file__, int lineNumber, const std::string &message)
 {
 	Debug::logError(__file__, lineNumber, message);
 
+	// The reason has to be visible before waiting on the user.
+	Debug::flush();
+
 #if defined(__APPLE__) && defined(__MACH__)
 	// @todo: implement proper logging alternative to SDL message box.
 	// macOS .apps close immediately even with getchar(), so a message box is needed.
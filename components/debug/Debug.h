@@ -21,12 +21,16 @@ private:
 	Debug() = delete;
 	~Debug() = delete;
 
-	// Writes a debug message to the console with the file path and line number.
-	static void write(DebugMessageType type, const std::string &filePath, int lineNumber, const std::string &message);
+	// Queues a debug message for the console and log file with the file path and line number. Messages
+	// are written by a background thread so the caller never waits on disk.
+	static void write(DebugMessageType type, const char *__file__, int lineNumber, const std::string &message);
 public:
 	static bool init(const char *logDirectory);
 	static void shutdown();
 
+	// Writes any queued messages immediately. Blocks on disk, so only for crashes and shutdown.
+	static void flush();
+
 	// Shortens the __FILE__ macro so it only includes a couple parent folders.
 	static std::string getShorterPath(const char *__file__);
 
@@ -1,8 +1,12 @@
 #ifndef ALLOCATOR_H
 #define ALLOCATOR_H
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <string>
 #include <type_traits>
+#include <vector>
 
 #include "Buffer.h"
 #include "BufferView.h"
@@ -28,7 +32,7 @@ private:
 	{
 		DebugAssert(this->data.isValid());
 		constexpr size_t alignment = alignof(T);
-		const size_t curAddress = reinterpret_cast<uintptr_t>(this->data.get()) + this->index;
+		const size_t curAddress = reinterpret_cast<uintptr_t>(this->data.begin()) + this->index;
 		const size_t modulo = curAddress % alignment;
 		return (modulo != 0) ? static_cast<int>(alignment - modulo) : 0;
 	}
@@ -87,7 +91,7 @@ public:
 		DebugAssert(this->canAlloc<T>(count));
 
 		this->index += this->getAlignmentByteCount<T>();
-		T *ptr = reinterpret_cast<T*>(this->data.get() + this->index);
+		T *ptr = reinterpret_cast<T*>(this->data.begin() + this->index);
 		for (int i = 0; i < count; i++)
 		{
 			*(ptr + i) = defaultValue;
@@ -116,4 +120,169 @@ public:
 	}
 };
 
+// Bump allocator for data that only lives until the end of the current frame. Nothing is freed individually;
+// reset() reclaims everything at once. If a frame needs more than the current block, extra blocks are added
+// and then merged into one big enough block on reset so later frames don't have to grow again.
+// Not thread-safe; meant to be owned by the thread that resets it.
+
+class FrameArena
+{
+private:
+	static constexpr size_t DEFAULT_BLOCK_BYTE_COUNT = 256 * 1024;
+
+	std::vector<Buffer<std::byte>> blocks; // The last block is the one being allocated from.
+	size_t offset; // Bytes used in the last block.
+	int allocationCount, prevAllocationCount;
+	size_t byteCount, prevByteCount;
+
+	void addBlock(size_t minByteCount)
+	{
+		const size_t blockByteCount = std::max(minByteCount, DEFAULT_BLOCK_BYTE_COUNT);
+		this->blocks.emplace_back(Buffer<std::byte>(static_cast<int>(blockByteCount)));
+		this->offset = 0;
+	}
+public:
+	FrameArena()
+	{
+		this->offset = 0;
+		this->allocationCount = 0;
+		this->prevAllocationCount = 0;
+		this->byteCount = 0;
+		this->prevByteCount = 0;
+	}
+
+	FrameArena(const FrameArena&) = delete;
+	FrameArena &operator=(const FrameArena&) = delete;
+
+	void *allocate(size_t size, size_t alignment)
+	{
+		DebugAssert(alignment > 0);
+		DebugAssert((alignment & (alignment - 1)) == 0);
+
+		if (this->blocks.empty())
+		{
+			this->addBlock(size + alignment);
+		}
+
+		Buffer<std::byte> *block = &this->blocks.back();
+		uintptr_t address = reinterpret_cast<uintptr_t>(block->begin()) + this->offset;
+		uintptr_t alignedAddress = (address + (alignment - 1)) & ~(static_cast<uintptr_t>(alignment) - 1);
+		if ((alignedAddress - address + size) > (static_cast<size_t>(block->getCount()) - this->offset))
+		{
+			this->addBlock(size + alignment);
+			block = &this->blocks.back();
+			address = reinterpret_cast<uintptr_t>(block->begin());
+			alignedAddress = (address + (alignment - 1)) & ~(static_cast<uintptr_t>(alignment) - 1);
+		}
+
+		this->offset = (alignedAddress - reinterpret_cast<uintptr_t>(block->begin())) + size;
+		this->allocationCount++;
+		this->byteCount += size;
+		return reinterpret_cast<void*>(alignedAddress);
+	}
+
+	// Invalidates everything allocated since the last reset. Intended to be called once at the end of a frame.
+	void reset()
+	{
+		if (this->blocks.size() > 1)
+		{
+			size_t totalByteCount = 0;
+			for (const Buffer<std::byte> &block : this->blocks)
+			{
+				totalByteCount += static_cast<size_t>(block.getCount());
+			}
+
+			this->blocks.clear();
+			this->addBlock(totalByteCount);
+		}
+
+		this->offset = 0;
+		this->prevAllocationCount = this->allocationCount;
+		this->prevByteCount = this->byteCount;
+		this->allocationCount = 0;
+		this->byteCount = 0;
+	}
+
+	// Allocation stats for the last completed frame.
+	int getPrevAllocationCount() const
+	{
+		return this->prevAllocationCount;
+	}
+
+	size_t getPrevByteCount() const
+	{
+		return this->prevByteCount;
+	}
+
+	size_t getCapacity() const
+	{
+		size_t capacity = 0;
+		for (const Buffer<std::byte> &block : this->blocks)
+		{
+			capacity += static_cast<size_t>(block.getCount());
+		}
+
+		return capacity;
+	}
+};
+
+// STL allocator adapter for putting containers in a frame arena. Deallocation does nothing, so containers
+// using it must not outlive the arena's next reset.
+template <typename T>
+class FrameAllocator
+{
+private:
+	FrameArena *arena;
+
+	template <typename U>
+	friend class FrameAllocator;
+public:
+	using value_type = T;
+
+	FrameAllocator(FrameArena &arena)
+	{
+		this->arena = &arena;
+	}
+
+	template <typename U>
+	FrameAllocator(const FrameAllocator<U> &other)
+	{
+		this->arena = other.arena;
+	}
+
+	FrameArena *getArena() const
+	{
+		return this->arena;
+	}
+
+	T *allocate(size_t count)
+	{
+		return static_cast<T*>(this->arena->allocate(count * sizeof(T), alignof(T)));
+	}
+
+	void deallocate(T *ptr, size_t count)
+	{
+		// Reclaimed when the arena resets.
+		static_cast<void>(ptr);
+		static_cast<void>(count);
+	}
+
+	template <typename U>
+	bool operator==(const FrameAllocator<U> &other) const
+	{
+		return this->arena == other.arena;
+	}
+
+	template <typename U>
+	bool operator!=(const FrameAllocator<U> &other) const
+	{
+		return this->arena != other.arena;
+	}
+};
+
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+using FrameString = std::basic_string<char, std::char_traits<char>, FrameAllocator<char>>;
+
 #endif
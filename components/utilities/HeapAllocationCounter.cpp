@@ -0,0 +1,138 @@
+#include <cstdlib>
+#include <new>
+
+#include "HeapAllocationCounter.h"
+
+#ifdef HAVE_HEAP_ALLOCATION_COUNTER
+
+namespace
+{
+	thread_local uint64_t ThreadAllocationCount = 0;
+
+	void *AllocateCounted(std::size_t size)
+	{
+		ThreadAllocationCount++;
+
+		void *ptr = std::malloc((size > 0) ? size : 1);
+		if (ptr == nullptr)
+		{
+			throw std::bad_alloc();
+		}
+
+		return ptr;
+	}
+
+	void *AllocateCountedAligned(std::size_t size, std::align_val_t alignment)
+	{
+		ThreadAllocationCount++;
+
+		const std::size_t alignmentValue = static_cast<std::size_t>(alignment);
+#ifdef _WIN32
+		void *ptr = _aligned_malloc((size > 0) ? size : 1, alignmentValue);
+#else
+		// aligned_alloc() wants the size to be a multiple of the alignment.
+		const std::size_t alignedSize = (((size > 0) ? size : 1) + alignmentValue - 1) & ~(alignmentValue - 1);
+		void *ptr = std::aligned_alloc(alignmentValue, alignedSize);
+#endif
+		if (ptr == nullptr)
+		{
+			throw std::bad_alloc();
+		}
+
+		return ptr;
+	}
+
+	void FreeAligned(void *ptr)
+	{
+#ifdef _WIN32
+		_aligned_free(ptr);
+#else
+		std::free(ptr);
+#endif
+	}
+}
+
+// The nothrow forms go through these by default.
+void *operator new(std::size_t size)
+{
+	return AllocateCounted(size);
+}
+
+void *operator new[](std::size_t size)
+{
+	return AllocateCounted(size);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+	return AllocateCountedAligned(size, alignment);
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment)
+{
+	return AllocateCountedAligned(size, alignment);
+}
+
+void operator delete(void *ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t) noexcept
+{
+	FreeAligned(ptr);
+}
+
+void operator delete[](void *ptr, std::align_val_t) noexcept
+{
+	FreeAligned(ptr);
+}
+
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept
+{
+	FreeAligned(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t, std::align_val_t) noexcept
+{
+	FreeAligned(ptr);
+}
+
+bool HeapAllocationCounter::isEnabled()
+{
+	return true;
+}
+
+uint64_t HeapAllocationCounter::getThreadAllocationCount()
+{
+	return ThreadAllocationCount;
+}
+
+#else
+
+bool HeapAllocationCounter::isEnabled()
+{
+	return false;
+}
+
+uint64_t HeapAllocationCounter::getThreadAllocationCount()
+{
+	return 0;
+}
+
+#endif
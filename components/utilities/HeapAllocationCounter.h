@@ -0,0 +1,19 @@
+#ifndef HEAP_ALLOCATION_COUNTER_H
+#define HEAP_ALLOCATION_COUNTER_H
+
+#include <cstdint>
+
+// Counts operator new calls made by the calling thread, for spotting per-frame heap churn. Only active in
+// builds configured with OTA_PROFILE_HEAP_ALLOCATIONS, which replace the global operator new/delete with
+// counting versions that forward to the C allocator. Other builds keep the standard allocator.
+
+namespace HeapAllocationCounter
+{
+	// Whether this build counts heap allocations at all.
+	bool isEnabled();
+
+	// Total heap allocations made by the calling thread so far. Always zero when not enabled.
+	uint64_t getThreadAllocationCount();
+}
+
+#endif
@@ -0,0 +1,464 @@
+#include <algorithm>
+
+#include "JobSystem.h"
+
+#include "../debug/Debug.h"
+
+namespace
+{
+	// Lets a job scheduled from inside a worker go straight to that worker's own queue.
+	thread_local const JobSystem *CurrentJobSystem = nullptr;
+	thread_local int CurrentWorkerIndex = -1;
+
+	int GetCurrentWorkerIndex(const JobSystem *jobSystem)
+	{
+		return (CurrentJobSystem == jobSystem) ? CurrentWorkerIndex : -1;
+	}
+
+	void WakeSleepers(std::mutex &sleepMutex, std::condition_variable &condition, bool notifyAll)
+	{
+		// Taking the lock guarantees a sleeper that already counted itself is inside wait() and will hear it.
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex);
+		}
+
+		if (notifyAll)
+		{
+			condition.notify_all();
+		}
+		else
+		{
+			condition.notify_one();
+		}
+	}
+}
+
+JobState::JobState()
+	: pendingCount(0), done(false)
+{
+	this->mainThreadOnly = false;
+}
+
+JobHandle::JobHandle(std::shared_ptr<JobState> &&state)
+	: state(std::move(state)) { }
+
+bool JobHandle::isValid() const
+{
+	return this->state != nullptr;
+}
+
+bool JobHandle::isDone() const
+{
+	return (this->state == nullptr) || this->state->done;
+}
+
+JobSystem::Worker::Worker()
+	: busyNanoseconds(0) { }
+
+JobSystem::JobSystem()
+	: queuedJobCount(0), queuedMainThreadJobCount(0), sleepingWorkerCount(0), sleepingWaiterCount(0)
+{
+	this->quit = false;
+}
+
+JobSystem::~JobSystem()
+{
+	this->stopWorkers();
+}
+
+void JobSystem::init(int workerCount)
+{
+	DebugLog("Initializing with " + std::to_string(workerCount) + " worker thread" + ((workerCount != 1) ? "s" : "") + ".");
+	this->mainThreadID = std::this_thread::get_id();
+	this->startWorkers(workerCount);
+}
+
+void JobSystem::setWorkerCount(int workerCount)
+{
+	if (workerCount == this->getWorkerCount())
+	{
+		return;
+	}
+
+	DebugLog("Changing to " + std::to_string(workerCount) + " worker thread" + ((workerCount != 1) ? "s" : "") + ".");
+	this->stopWorkers();
+	this->startWorkers(workerCount);
+}
+
+int JobSystem::getWorkerCount() const
+{
+	return this->workers.getCount();
+}
+
+void JobSystem::startWorkers(int workerCount)
+{
+	DebugAssert(workerCount >= 0);
+	DebugAssert(!this->workers.isValid());
+
+	this->quit = false;
+	this->utilizationSampleTime = std::chrono::high_resolution_clock::now();
+
+	if (workerCount > 0)
+	{
+		this->workers.init(workerCount);
+		for (int i = 0; i < workerCount; i++)
+		{
+			this->workers[i].thread = std::thread(&JobSystem::runWorker, this, i);
+		}
+	}
+}
+
+void JobSystem::stopWorkers()
+{
+	{
+		std::lock_guard<std::mutex> lock(this->sleepMutex);
+		this->quit = true;
+	}
+
+	this->workerCondition.notify_all();
+
+	// Workers drain the queues before exiting.
+	for (Worker &worker : this->workers)
+	{
+		if (worker.thread.joinable())
+		{
+			worker.thread.join();
+		}
+	}
+
+	this->workers.clear();
+
+	// Nobody is left to take jobs from threads outside the pool if there were no workers.
+	std::shared_ptr<JobState> state;
+	while ((state = this->tryPopJob(-1)) != nullptr)
+	{
+		this->execute(std::move(state));
+	}
+}
+
+void JobSystem::runWorker(int workerIndex)
+{
+	CurrentJobSystem = this;
+	CurrentWorkerIndex = workerIndex;
+
+	Worker &worker = this->workers[workerIndex];
+	while (true)
+	{
+		std::shared_ptr<JobState> state = this->tryPopJob(workerIndex);
+		if (state != nullptr)
+		{
+			const auto startTime = std::chrono::high_resolution_clock::now();
+			this->execute(std::move(state));
+			const auto endTime = std::chrono::high_resolution_clock::now();
+			worker.busyNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count();
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(this->sleepMutex);
+		if (this->quit && (this->queuedJobCount <= 0))
+		{
+			break;
+		}
+
+		this->sleepingWorkerCount++;
+		this->workerCondition.wait(lock, [this]()
+		{
+			return this->quit || (this->queuedJobCount > 0);
+		});
+
+		this->sleepingWorkerCount--;
+	}
+
+	CurrentJobSystem = nullptr;
+	CurrentWorkerIndex = -1;
+}
+
+std::shared_ptr<JobState> JobSystem::tryPopJob(int workerIndex)
+{
+	std::shared_ptr<JobState> state;
+
+	// Newest job from our own queue first since its data is most likely still in cache.
+	if (workerIndex >= 0)
+	{
+		Worker &worker = this->workers[workerIndex];
+		std::lock_guard<std::mutex> lock(worker.mutex);
+		if (!worker.jobs.empty())
+		{
+			state = std::move(worker.jobs.back());
+			worker.jobs.pop_back();
+		}
+	}
+
+	if (state == nullptr)
+	{
+		std::lock_guard<std::mutex> lock(this->sharedMutex);
+		if (!this->sharedJobs.empty())
+		{
+			state = std::move(this->sharedJobs.front());
+			this->sharedJobs.pop_front();
+		}
+	}
+
+	// Steal the oldest job from someone else, starting with the next worker over to spread out contention.
+	const int workerCount = this->workers.getCount();
+	for (int i = 0; (state == nullptr) && (i < workerCount); i++)
+	{
+		const int victimIndex = (workerIndex + 1 + i) % workerCount;
+		if (victimIndex == workerIndex)
+		{
+			continue;
+		}
+
+		Worker &victim = this->workers[victimIndex];
+		std::lock_guard<std::mutex> lock(victim.mutex);
+		if (!victim.jobs.empty())
+		{
+			state = std::move(victim.jobs.front());
+			victim.jobs.pop_front();
+		}
+	}
+
+	if (state != nullptr)
+	{
+		this->queuedJobCount--;
+	}
+
+	return state;
+}
+
+std::shared_ptr<JobState> JobSystem::tryPopMainThreadJob()
+{
+	std::shared_ptr<JobState> state;
+
+	std::lock_guard<std::mutex> lock(this->mainThreadMutex);
+	if (!this->mainThreadJobs.empty())
+	{
+		state = std::move(this->mainThreadJobs.front());
+		this->mainThreadJobs.pop_front();
+		this->queuedMainThreadJobCount--;
+	}
+
+	return state;
+}
+
+JobHandle JobSystem::scheduleInternal(Job &&func, BufferView<const JobHandle> dependencies, bool mainThreadOnly)
+{
+	DebugAssert(func);
+
+	std::shared_ptr<JobState> state = std::make_shared<JobState>();
+	state->func = std::move(func);
+	state->mainThreadOnly = mainThreadOnly;
+
+	// Held at one until every dependency is registered so an early finisher can't release it halfway.
+	state->pendingCount = 1;
+
+	for (const JobHandle &dependency : dependencies)
+	{
+		JobState *dependencyState = dependency.state.get();
+		if (dependencyState == nullptr)
+		{
+			continue;
+		}
+
+		std::lock_guard<std::mutex> lock(dependencyState->continuationMutex);
+		if (!dependencyState->done)
+		{
+			state->pendingCount++;
+			dependencyState->continuations.emplace_back(state);
+		}
+	}
+
+	JobHandle handle(std::shared_ptr<JobState>{ state });
+	this->release(std::move(state));
+	return handle;
+}
+
+void JobSystem::enqueue(std::shared_ptr<JobState> &&state)
+{
+	if (state->mainThreadOnly)
+	{
+		{
+			std::lock_guard<std::mutex> lock(this->mainThreadMutex);
+			this->mainThreadJobs.emplace_back(std::move(state));
+		}
+
+		this->queuedMainThreadJobCount++;
+	}
+	else
+	{
+		const int workerIndex = GetCurrentWorkerIndex(this);
+		if (workerIndex >= 0)
+		{
+			Worker &worker = this->workers[workerIndex];
+			std::lock_guard<std::mutex> lock(worker.mutex);
+			worker.jobs.emplace_back(std::move(state));
+		}
+		else
+		{
+			std::lock_guard<std::mutex> lock(this->sharedMutex);
+			this->sharedJobs.emplace_back(std::move(state));
+		}
+
+		this->queuedJobCount++;
+
+		if (this->sleepingWorkerCount > 0)
+		{
+			WakeSleepers(this->sleepMutex, this->workerCondition, false);
+		}
+	}
+
+	// Waiting threads can help with the new job.
+	if (this->sleepingWaiterCount > 0)
+	{
+		WakeSleepers(this->sleepMutex, this->waiterCondition, true);
+	}
+}
+
+void JobSystem::release(std::shared_ptr<JobState> &&state)
+{
+	if (state->pendingCount.fetch_sub(1) == 1)
+	{
+		this->enqueue(std::move(state));
+	}
+}
+
+void JobSystem::execute(std::shared_ptr<JobState> &&state)
+{
+	state->func();
+	state->func = nullptr; // Free captures now instead of when the last handle goes away.
+
+	std::vector<std::shared_ptr<JobState>> continuations;
+	{
+		std::lock_guard<std::mutex> lock(state->continuationMutex);
+		state->done = true;
+		continuations = std::move(state->continuations);
+	}
+
+	for (std::shared_ptr<JobState> &continuation : continuations)
+	{
+		this->release(std::move(continuation));
+	}
+
+	if (this->sleepingWaiterCount > 0)
+	{
+		WakeSleepers(this->sleepMutex, this->waiterCondition, true);
+	}
+}
+
+void JobSystem::sampleWorkerUtilization(BufferView<double> outPercents)
+{
+	DebugAssert(outPercents.getCount() == this->workers.getCount());
+
+	const auto now = std::chrono::high_resolution_clock::now();
+	const int64_t elapsedNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(now - this->utilizationSampleTime).count();
+	this->utilizationSampleTime = now;
+
+	for (int i = 0; i < this->workers.getCount(); i++)
+	{
+		const int64_t busyNanoseconds = this->workers[i].busyNanoseconds.exchange(0);
+		const double percent = (elapsedNanoseconds > 0) ?
+			(static_cast<double>(busyNanoseconds) / static_cast<double>(elapsedNanoseconds)) : 0.0;
+		outPercents.set(i, std::clamp(percent, 0.0, 1.0));
+	}
+}
+
+JobHandle JobSystem::schedule(Job &&func, BufferView<const JobHandle> dependencies)
+{
+	return this->scheduleInternal(std::move(func), dependencies, false);
+}
+
+JobHandle JobSystem::schedule(Job &&func)
+{
+	return this->scheduleInternal(std::move(func), BufferView<const JobHandle>(), false);
+}
+
+JobHandle JobSystem::scheduleMainThread(Job &&func, BufferView<const JobHandle> dependencies)
+{
+	return this->scheduleInternal(std::move(func), dependencies, true);
+}
+
+JobHandle JobSystem::scheduleMainThread(Job &&func)
+{
+	return this->scheduleInternal(std::move(func), BufferView<const JobHandle>(), true);
+}
+
+void JobSystem::runMainThreadJobs()
+{
+	DebugAssert(std::this_thread::get_id() == this->mainThreadID);
+
+	std::shared_ptr<JobState> state;
+	while ((state = this->tryPopMainThreadJob()) != nullptr)
+	{
+		this->execute(std::move(state));
+	}
+}
+
+void JobSystem::wait(const JobHandle &handle)
+{
+	const bool isMainThread = std::this_thread::get_id() == this->mainThreadID;
+	const int workerIndex = GetCurrentWorkerIndex(this);
+
+	while (!handle.isDone())
+	{
+		std::shared_ptr<JobState> state = isMainThread ? this->tryPopMainThreadJob() : nullptr;
+		if (state == nullptr)
+		{
+			state = this->tryPopJob(workerIndex);
+		}
+
+		if (state != nullptr)
+		{
+			this->execute(std::move(state));
+			continue;
+		}
+
+		// The job is running elsewhere or still blocked on dependencies.
+		std::unique_lock<std::mutex> lock(this->sleepMutex);
+		this->sleepingWaiterCount++;
+		this->waiterCondition.wait(lock, [this, &handle, isMainThread]()
+		{
+			return handle.isDone() || (this->queuedJobCount > 0) || (isMainThread && (this->queuedMainThreadJobCount > 0));
+		});
+
+		this->sleepingWaiterCount--;
+	}
+}
+
+void JobSystem::wait(BufferView<const JobHandle> handles)
+{
+	for (const JobHandle &handle : handles)
+	{
+		this->wait(handle);
+	}
+}
+
+void JobSystem::parallelFor(int count, int batchSize, const std::function<void(int begin, int end)> &func)
+{
+	if (count <= 0)
+	{
+		return;
+	}
+
+	batchSize = std::max(batchSize, 1);
+	const int batchCount = (count + batchSize - 1) / batchSize;
+	if ((batchCount == 1) || (this->workers.getCount() == 0))
+	{
+		func(0, count);
+		return;
+	}
+
+	std::vector<JobHandle> handles;
+	handles.reserve(batchCount - 1);
+	for (int i = 1; i < batchCount; i++)
+	{
+		const int begin = i * batchSize;
+		const int end = std::min(begin + batchSize, count);
+		handles.emplace_back(this->schedule([&func, begin, end]()
+		{
+			func(begin, end);
+		}));
+	}
+
+	func(0, std::min(batchSize, count));
+	this->wait(BufferView<const JobHandle>(handles));
+}
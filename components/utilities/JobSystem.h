@@ -0,0 +1,141 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Buffer.h"
+#include "BufferView.h"
+
+// Shared pool of worker threads for running small pieces of work in parallel instead of each feature
+// spawning its own threads. Each worker has its own queue and steals from the others when it runs dry.
+// Threads that wait on a job help run queued jobs in the meantime, so a pool with zero workers still
+// completes everything on the waiting thread.
+
+using Job = std::function<void()>;
+
+struct JobState
+{
+	Job func;
+	std::atomic<int> pendingCount; // Unfinished dependencies, plus one while being scheduled.
+	std::atomic<bool> done;
+	bool mainThreadOnly;
+
+	std::mutex continuationMutex;
+	std::vector<std::shared_ptr<JobState>> continuations; // Jobs waiting on this one.
+
+	JobState();
+};
+
+// Reference to a scheduled job for waiting on it or making other jobs depend on it. A default-constructed
+// handle counts as already finished.
+class JobHandle
+{
+private:
+	std::shared_ptr<JobState> state;
+public:
+	JobHandle() = default;
+	JobHandle(std::shared_ptr<JobState> &&state);
+
+	bool isValid() const;
+	bool isDone() const;
+
+	friend class JobSystem;
+};
+
+class JobSystem
+{
+private:
+	struct Worker
+	{
+		std::thread thread;
+		std::mutex mutex;
+		std::deque<std::shared_ptr<JobState>> jobs; // Owner pops from the back, thieves from the front.
+		std::atomic<int64_t> busyNanoseconds;
+
+		Worker();
+	};
+
+	Buffer<Worker> workers;
+
+	// Jobs scheduled from threads outside the pool. Any worker or waiting thread can take them.
+	std::mutex sharedMutex;
+	std::deque<std::shared_ptr<JobState>> sharedJobs;
+
+	// Jobs that can only run on the thread that initialized the pool.
+	std::mutex mainThreadMutex;
+	std::deque<std::shared_ptr<JobState>> mainThreadJobs;
+	std::thread::id mainThreadID;
+
+	// Sleeping workers and waiting threads are only signaled when someone is actually asleep.
+	std::mutex sleepMutex;
+	std::condition_variable workerCondition, waiterCondition;
+	std::atomic<int> queuedJobCount, queuedMainThreadJobCount;
+	std::atomic<int> sleepingWorkerCount, sleepingWaiterCount;
+	bool quit;
+
+	std::chrono::time_point<std::chrono::high_resolution_clock> utilizationSampleTime;
+
+	void runWorker(int workerIndex);
+
+	// Takes a job for the given worker, or for a thread outside the pool if the index is negative.
+	std::shared_ptr<JobState> tryPopJob(int workerIndex);
+	std::shared_ptr<JobState> tryPopMainThreadJob();
+
+	JobHandle scheduleInternal(Job &&func, BufferView<const JobHandle> dependencies, bool mainThreadOnly);
+	void enqueue(std::shared_ptr<JobState> &&state);
+	void release(std::shared_ptr<JobState> &&state);
+	void execute(std::shared_ptr<JobState> &&state);
+
+	void startWorkers(int workerCount);
+	void stopWorkers();
+public:
+	JobSystem();
+	JobSystem(const JobSystem&) = delete;
+	JobSystem(JobSystem&&) = delete;
+	~JobSystem();
+
+	JobSystem &operator=(const JobSystem&) = delete;
+	JobSystem &operator=(JobSystem&&) = delete;
+
+	// Must be called from the thread that will run main-thread jobs.
+	void init(int workerCount);
+
+	// Restarts the pool with a different number of workers. Waits for queued jobs to finish first.
+	void setWorkerCount(int workerCount);
+
+	int getWorkerCount() const;
+
+	// Writes each worker's busy fraction in [0, 1] since the previous call.
+	void sampleWorkerUtilization(BufferView<double> outPercents);
+
+	// Queues a job to run once all of its dependencies are done.
+	JobHandle schedule(Job &&func, BufferView<const JobHandle> dependencies);
+	JobHandle schedule(Job &&func);
+
+	// Queues a job that only runs on the main thread, either in runMainThreadJobs() or while the main
+	// thread waits on something.
+	JobHandle scheduleMainThread(Job &&func, BufferView<const JobHandle> dependencies);
+	JobHandle scheduleMainThread(Job &&func);
+
+	// Runs any queued main-thread jobs. Intended to be called once per frame.
+	void runMainThreadJobs();
+
+	// Blocks until the job is done, running other queued jobs while waiting.
+	void wait(const JobHandle &handle);
+	void wait(BufferView<const JobHandle> handles);
+
+	// Splits [0, count) into batches of the given size and runs them in parallel, returning once they are
+	// all done. The calling thread takes the first batch.
+	void parallelFor(int count, int batchSize, const std::function<void(int begin, int end)> &func);
+};
+
+#endif
@@ -0,0 +1,389 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "CompressionTestUtils.h"
+#include "TestUtils.h"
+
+#include "OpenTESArena/src/Assets/AssetCache.h"
+#include "OpenTESArena/src/Assets/MIFFile.h"
+#include "OpenTESArena/src/Assets/MIFUtils.h"
+#include "OpenTESArena/src/Math/Random.h"
+
+// Writes and reads cache entries in a temporary folder, and decodes synthetic .MIF files shaped like the game's
+// city blocks so the cached path can be compared against decoding without any game data.
+
+namespace
+{
+	// City block .MIFs are one level of this many voxels on each side.
+	constexpr int CITY_BLOCK_DIM = 20;
+
+	constexpr char TEST_ENTRY_NAME[] = "Test.bin";
+
+	std::string MakeCacheFolderPath()
+	{
+		const std::filesystem::path path = std::filesystem::temp_directory_path() / "otesa_tests_cache";
+		std::filesystem::remove_all(path);
+		return path.string();
+	}
+
+	std::vector<uint8_t> MakePayload(int seed, int size)
+	{
+		Random random(seed);
+		std::vector<uint8_t> payload(size);
+		for (uint8_t &value : payload)
+		{
+			value = static_cast<uint8_t>(random.next(256));
+		}
+
+		return payload;
+	}
+
+	BufferView<const uint8_t> MakeView(const std::vector<uint8_t> &data)
+	{
+		return BufferView<const uint8_t>(data.data(), static_cast<int>(data.size()));
+	}
+
+	BufferView<const std::byte> MakeByteView(const std::vector<uint8_t> &data)
+	{
+		return BufferView<const std::byte>(reinterpret_cast<const std::byte*>(data.data()), static_cast<int>(data.size()));
+	}
+
+	bool TryReadEntry(uint64_t sourceHash, std::vector<uint8_t> *outData)
+	{
+		Buffer<uint8_t> data;
+		if (!AssetCache::tryRead(TEST_ENTRY_NAME, sourceHash, &data))
+		{
+			return false;
+		}
+
+		outData->assign(data.begin(), data.end());
+		return true;
+	}
+
+	void AppendLE16(int value, std::vector<uint8_t> &data)
+	{
+		data.push_back(static_cast<uint8_t>(value & 0xFF));
+		data.push_back(static_cast<uint8_t>((value >> 8) & 0xFF));
+	}
+
+	void AppendTag(const char *tag, std::vector<uint8_t> &data)
+	{
+		data.insert(data.end(), tag, tag + 4);
+	}
+
+	// Voxel map with mostly repeated IDs like a real block, so it compresses the same way.
+	std::vector<uint8_t> MakeVoxelMap(Random &random)
+	{
+		std::vector<uint8_t> map;
+		for (int i = 0; i < (CITY_BLOCK_DIM * CITY_BLOCK_DIM); i++)
+		{
+			const int voxelID = (random.next(4) == 0) ? (random.next(64) << 8) : 0;
+			AppendLE16(voxelID, map);
+		}
+
+		return map;
+	}
+
+	void AppendMapTag(const char *tag, const std::vector<uint8_t> &map, std::vector<uint8_t> &data)
+	{
+		const std::vector<uint8_t> compressed = CompressionTestUtils::encodeType08(
+			CompressionTestUtils::findTokens(map, CompressionTestUtils::TYPE08_MAX_MATCH_LENGTH));
+
+		// The compressed size includes the uncompressed size after it.
+		AppendTag(tag, data);
+		AppendLE16(static_cast<int>(compressed.size()) + 2, data);
+		AppendLE16(static_cast<int>(map.size()), data);
+		data.insert(data.end(), compressed.begin(), compressed.end());
+	}
+
+	// A one-level .MIF with FLOR, MAP1, and MAP2 tags.
+	std::vector<uint8_t> MakeCityBlockMif(int seed)
+	{
+		Random random(seed);
+		std::vector<uint8_t> mif;
+		AppendTag("MHDR", mif);
+
+		constexpr int headerSize = 61;
+		AppendLE16(headerSize, mif);
+		std::vector<uint8_t> header(headerSize, 0);
+		for (int i = 0; i < 8; i++)
+		{
+			// Start X and Y.
+			header[2 + (i * 2)] = static_cast<uint8_t>(random.next(256));
+		}
+
+		header[18] = 0; // Starting level.
+		header[19] = 1; // Level count.
+		header[21] = CITY_BLOCK_DIM; // Map width.
+		header[23] = CITY_BLOCK_DIM; // Map height.
+		mif.insert(mif.end(), header.begin(), header.end());
+
+		std::vector<uint8_t> tags;
+		AppendMapTag("FLOR", MakeVoxelMap(random), tags);
+		AppendMapTag("MAP1", MakeVoxelMap(random), tags);
+		AppendMapTag("MAP2", MakeVoxelMap(random), tags);
+
+		AppendTag("LEVL", mif);
+		AppendLE16(static_cast<int>(tags.size()), mif);
+		mif.insert(mif.end(), tags.begin(), tags.end());
+		return mif;
+	}
+
+	bool AreMapsEqual(BufferView2D<const ArenaTypes::VoxelID> a, BufferView2D<const ArenaTypes::VoxelID> b)
+	{
+		if ((a.getWidth() != b.getWidth()) || (a.getHeight() != b.getHeight()))
+		{
+			return false;
+		}
+
+		for (int y = 0; y < a.getHeight(); y++)
+		{
+			for (int x = 0; x < a.getWidth(); x++)
+			{
+				if (a.get(x, y) != b.get(x, y))
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	bool AreMifsEqual(const MIFFile &a, const MIFFile &b)
+	{
+		if ((a.getFilename() != b.getFilename()) || (a.getWidth() != b.getWidth()) ||
+			(a.getDepth() != b.getDepth()) || (a.getStartingLevelIndex() != b.getStartingLevelIndex()) ||
+			(a.getLevelCount() != b.getLevelCount()))
+		{
+			return false;
+		}
+
+		for (int i = 0; i < a.getStartPointCount(); i++)
+		{
+			if (a.getStartPoint(i) != b.getStartPoint(i))
+			{
+				return false;
+			}
+		}
+
+		for (int i = 0; i < a.getLevelCount(); i++)
+		{
+			const MIFLevel &levelA = a.getLevel(i);
+			const MIFLevel &levelB = b.getLevel(i);
+			if (!AreMapsEqual(levelA.getFLOR(), levelB.getFLOR()) || !AreMapsEqual(levelA.getMAP1(), levelB.getMAP1()) ||
+				!AreMapsEqual(levelA.getMAP2(), levelB.getMAP2()))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	int GetCityBlockMifCount()
+	{
+		int count = 0;
+		for (int i = 0; i < MIFUtils::getCityBlockCodeCount(); i++)
+		{
+			count += MIFUtils::getCityBlockVariations(i) * MIFUtils::getCityBlockRotationCount();
+		}
+
+		return count;
+	}
+}
+
+TEST_CASE(AssetCacheReadsWhatWasWritten)
+{
+	const std::string folderPath = MakeCacheFolderPath();
+	AssetCache::init(folderPath);
+
+	const std::vector<uint8_t> payload = MakePayload(1, 5000);
+	const uint64_t sourceHash = AssetCache::hashBytes(MakeByteView(MakePayload(2, 100)));
+	AssetCache::write(TEST_ENTRY_NAME, sourceHash, MakeView(payload));
+
+	std::vector<uint8_t> data;
+	TEST_CHECK(TryReadEntry(sourceHash, &data));
+	TEST_CHECK(data == payload);
+
+	// Writing again replaces the entry.
+	const std::vector<uint8_t> newPayload = MakePayload(3, 100);
+	AssetCache::write(TEST_ENTRY_NAME, sourceHash, MakeView(newPayload));
+	TEST_CHECK(TryReadEntry(sourceHash, &data));
+	TEST_CHECK(data == newPayload);
+
+	AssetCache::init(std::string());
+	std::filesystem::remove_all(folderPath);
+}
+
+TEST_CASE(AssetCacheIgnoresBadEntries)
+{
+	const std::string folderPath = MakeCacheFolderPath();
+	const std::string entryPath = folderPath + "/" + TEST_ENTRY_NAME;
+	AssetCache::init(folderPath);
+
+	const std::vector<uint8_t> payload = MakePayload(4, 5000);
+	const uint64_t sourceHash = AssetCache::hashBytes(MakeByteView(payload));
+	AssetCache::write(TEST_ENTRY_NAME, sourceHash, MakeView(payload));
+
+	// Stale: the source data changed since it was written.
+	std::vector<uint8_t> data;
+	TEST_CHECK(!TryReadEntry(sourceHash + 1, &data));
+
+	// Corrupt: a flipped payload byte fails the checksum.
+	{
+		std::fstream fs(entryPath, std::ios::in | std::ios::out | std::ios::binary);
+		fs.seekg(-100, std::ios::end);
+		const char value = static_cast<char>(fs.get());
+		fs.seekp(-100, std::ios::end);
+		fs.put(static_cast<char>(value ^ 0x10));
+	}
+
+	TEST_CHECK(!TryReadEntry(sourceHash, &data));
+
+	// Truncated: the payload is cut short.
+	AssetCache::write(TEST_ENTRY_NAME, sourceHash, MakeView(payload));
+	TEST_CHECK(TryReadEntry(sourceHash, &data));
+	std::filesystem::resize_file(entryPath, std::filesystem::file_size(entryPath) - 1);
+	TEST_CHECK(!TryReadEntry(sourceHash, &data));
+
+	// Truncated inside the header.
+	std::filesystem::resize_file(entryPath, 10);
+	TEST_CHECK(!TryReadEntry(sourceHash, &data));
+
+	// Disabled: nothing is written or read.
+	AssetCache::init(std::string());
+	AssetCache::write(TEST_ENTRY_NAME, sourceHash, MakeView(payload));
+	TEST_CHECK(!TryReadEntry(sourceHash, &data));
+	TEST_CHECK(std::filesystem::file_size(entryPath) == 10);
+	std::filesystem::remove_all(folderPath);
+}
+
+TEST_CASE(AssetCacheMifMatchesDecoded)
+{
+	std::vector<uint8_t> cacheData;
+	std::vector<MIFFile> decodedMifs;
+	for (int i = 0; i < 8; i++)
+	{
+		const std::vector<uint8_t> src = MakeCityBlockMif(i);
+		MIFFile mif;
+		TEST_CHECK(mif.init(("BLOCK" + std::to_string(i) + ".MIF").c_str(), MakeByteView(src)));
+		TEST_CHECK(mif.getLevelCount() == 1);
+		TEST_CHECK(mif.getWidth() == CITY_BLOCK_DIM);
+		mif.writeCacheData(cacheData);
+		decodedMifs.emplace_back(std::move(mif));
+	}
+
+	const uint8_t *dataPtr = cacheData.data();
+	const uint8_t *dataEnd = dataPtr + cacheData.size();
+	for (const MIFFile &decodedMif : decodedMifs)
+	{
+		MIFFile mif;
+		TEST_CHECK(mif.initFromCacheData(&dataPtr, dataEnd));
+		TEST_CHECK(AreMifsEqual(mif, decodedMif));
+	}
+
+	TEST_CHECK(dataPtr == dataEnd);
+
+	// Cut short anywhere, the data is rejected instead of read past its end.
+	for (size_t size = 0; size < cacheData.size(); size += 97)
+	{
+		const uint8_t *truncatedPtr = cacheData.data();
+		const uint8_t *truncatedEnd = truncatedPtr + size;
+		bool success = true;
+		for (size_t i = 0; (i < decodedMifs.size()) && success; i++)
+		{
+			MIFFile mif;
+			success = mif.initFromCacheData(&truncatedPtr, truncatedEnd);
+		}
+
+		TEST_CHECK(!success);
+	}
+}
+
+BENCHMARK_CASE(AssetCacheCityBlockStartupBenchmark)
+{
+	// Same steps as loading the city block .MIFs at startup, minus reading the files. Cold decodes every .MIF
+	// and writes the cache; warm reads the cache instead.
+	const int mifCount = GetCityBlockMifCount();
+	std::vector<std::vector<uint8_t>> mifSrcs;
+	for (int i = 0; i < mifCount; i++)
+	{
+		mifSrcs.push_back(MakeCityBlockMif(i));
+	}
+
+	const std::string folderPath = MakeCacheFolderPath();
+	AssetCache::init(folderPath);
+
+	auto getSourceHash = [&mifSrcs]()
+	{
+		std::vector<uint64_t> mifHashes;
+		for (const std::vector<uint8_t> &mifSrc : mifSrcs)
+		{
+			mifHashes.push_back(AssetCache::hashBytes(MakeByteView(mifSrc)));
+		}
+
+		return AssetCache::hashBytes(BufferView<const std::byte>(reinterpret_cast<const std::byte*>(mifHashes.data()),
+			static_cast<int>(mifHashes.size() * sizeof(uint64_t))));
+	};
+
+	auto loadCold = [&mifSrcs, &getSourceHash]()
+	{
+		const uint64_t sourceHash = getSourceHash();
+		std::vector<MIFFile> mifs(mifSrcs.size());
+		std::vector<uint8_t> cacheData;
+		for (size_t i = 0; i < mifSrcs.size(); i++)
+		{
+			mifs[i].init("BLOCK.MIF", MakeByteView(mifSrcs[i]));
+			mifs[i].writeCacheData(cacheData);
+		}
+
+		AssetCache::write(TEST_ENTRY_NAME, sourceHash, MakeView(cacheData));
+	};
+
+	auto loadWarm = [&mifSrcs, &getSourceHash]()
+	{
+		const uint64_t sourceHash = getSourceHash();
+		Buffer<uint8_t> cacheData;
+		const bool success = AssetCache::tryRead(TEST_ENTRY_NAME, sourceHash, &cacheData);
+		TEST_CHECK(success);
+
+		const uint8_t *dataPtr = cacheData.begin();
+		std::vector<MIFFile> mifs(mifSrcs.size());
+		for (MIFFile &mif : mifs)
+		{
+			mif.initFromCacheData(&dataPtr, cacheData.end());
+		}
+	};
+
+	// The fastest of several runs is the least disturbed by the rest of the system.
+	constexpr int runCount = 50;
+	auto measure = [](const auto &loadFunc)
+	{
+		double bestMilliseconds = std::numeric_limits<double>::infinity();
+		for (int i = 0; i < runCount; i++)
+		{
+			const auto startTime = std::chrono::steady_clock::now();
+			loadFunc();
+			const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - startTime;
+			bestMilliseconds = std::min(bestMilliseconds, elapsed.count());
+		}
+
+		return bestMilliseconds;
+	};
+
+	const double coldMilliseconds = measure(loadCold);
+	const double warmMilliseconds = measure(loadWarm);
+	std::printf("  %d city block .MIFs: cold %.2fms, warm %.2fms (%.2fx)\n", mifCount, coldMilliseconds,
+		warmMilliseconds, coldMilliseconds / warmMilliseconds);
+
+	AssetCache::init(std::string());
+	std::filesystem::remove_all(folderPath);
+}
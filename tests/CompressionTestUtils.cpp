@@ -0,0 +1,372 @@
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "CompressionTestUtils.h"
+
+#include "OpenTESArena/src/Math/Random.h"
+
+namespace
+{
+	// LZHUF tree layout: 256 literals plus one symbol per match length, as leaves of a 627-node tree.
+	constexpr int HUFFMAN_SYMBOL_COUNT = 256 +
+		(CompressionTestUtils::TYPE08_MAX_MATCH_LENGTH - CompressionTestUtils::MIN_MATCH_LENGTH + 1);
+	constexpr int HUFFMAN_NODE_COUNT = (HUFFMAN_SYMBOL_COUNT * 2) - 1;
+	constexpr int HUFFMAN_ROOT = HUFFMAN_NODE_COUNT - 1;
+
+	// Upper six bits of an LZHUF match offset are prefix codes. These are how many of the 64 values use each
+	// code length from 3 to 8 bits, in increasing order.
+	constexpr std::array<int, 6> OFFSET_CODE_LENGTH_COUNTS = { 1, 3, 8, 12, 24, 16 };
+
+	class BitWriter
+	{
+	private:
+		std::vector<uint8_t> bytes;
+		int bitCount;
+	public:
+		BitWriter()
+		{
+			this->bitCount = 0;
+		}
+
+		void write(uint32_t value, int count)
+		{
+			for (int i = count - 1; i >= 0; i--)
+			{
+				if ((this->bitCount % 8) == 0)
+				{
+					this->bytes.push_back(0);
+				}
+
+				if (((value >> i) & 1) != 0)
+				{
+					this->bytes.back() |= 0x80 >> (this->bitCount % 8);
+				}
+
+				this->bitCount++;
+			}
+		}
+
+		std::vector<uint8_t> &getBytes()
+		{
+			return this->bytes;
+		}
+	};
+
+	// Mirrors the decoder's adaptive tree, including its 16-bit frequencies, so every symbol is coded with the
+	// tree the decoder will have at that point.
+	class HuffmanEncoder
+	{
+	private:
+		std::array<uint16_t, HUFFMAN_NODE_COUNT> freqs;
+		std::array<int, HUFFMAN_NODE_COUNT + HUFFMAN_SYMBOL_COUNT> parents;
+		std::array<int, HUFFMAN_NODE_COUNT> children;
+
+		void update(int symbol)
+		{
+			int node = this->parents[symbol + HUFFMAN_NODE_COUNT];
+			do
+			{
+				this->freqs[node]++;
+				const uint16_t freq = this->freqs[node];
+				int next = node + 1;
+				if ((next < HUFFMAN_NODE_COUNT) && (this->freqs[next] < freq))
+				{
+					while ((next < HUFFMAN_NODE_COUNT) && (this->freqs[next] < freq))
+					{
+						next++;
+					}
+
+					next--;
+					this->freqs[node] = this->freqs[next];
+					this->freqs[next] = freq;
+
+					const int nodeChild = this->children[node];
+					this->parents[nodeChild] = next;
+					if (nodeChild < HUFFMAN_NODE_COUNT)
+					{
+						this->parents[nodeChild + 1] = next;
+					}
+
+					const int nextChild = this->children[next];
+					this->children[next] = nodeChild;
+					this->parents[nextChild] = node;
+					if (nextChild < HUFFMAN_NODE_COUNT)
+					{
+						this->parents[nextChild + 1] = node;
+					}
+
+					this->children[node] = nextChild;
+					node = next;
+				}
+
+				node = this->parents[node];
+			} while (node != 0);
+		}
+	public:
+		HuffmanEncoder()
+		{
+			for (int i = 0; i < HUFFMAN_SYMBOL_COUNT; i++)
+			{
+				this->freqs[i] = 1;
+				this->children[i] = i + HUFFMAN_NODE_COUNT;
+				this->parents[i + HUFFMAN_NODE_COUNT] = i;
+			}
+
+			for (int i = 0, j = HUFFMAN_SYMBOL_COUNT; j <= HUFFMAN_ROOT; i += 2, j++)
+			{
+				this->freqs[j] = this->freqs[i] + this->freqs[i + 1];
+				this->children[j] = i;
+				this->parents[i] = j;
+				this->parents[i + 1] = j;
+			}
+
+			this->parents[HUFFMAN_ROOT] = 0;
+		}
+
+		void encode(int symbol, BitWriter &writer)
+		{
+			// Walk from the leaf to the root. Each node's side is the low bit of its index.
+			std::vector<int> bits;
+			int node = this->parents[symbol + HUFFMAN_NODE_COUNT];
+			do
+			{
+				bits.push_back(node & 1);
+				node = this->parents[node];
+			} while (node != HUFFMAN_ROOT);
+
+			for (auto iter = bits.rbegin(); iter != bits.rend(); ++iter)
+			{
+				writer.write(*iter, 1);
+			}
+
+			this->update(symbol);
+		}
+	};
+}
+
+std::array<CompressionTestUtils::OffsetCode, 64> CompressionTestUtils::makeOffsetCodes()
+{
+	std::array<OffsetCode, 64> codes;
+	int highBits = 0;
+	int prefix = 0;
+	for (int i = 0; i < static_cast<int>(OFFSET_CODE_LENGTH_COUNTS.size()); i++)
+	{
+		const int length = 3 + i;
+		for (int j = 0; j < OFFSET_CODE_LENGTH_COUNTS[i]; j++)
+		{
+			codes[highBits] = { length, prefix };
+			highBits++;
+			prefix += 1 << (8 - length);
+		}
+	}
+
+	return codes;
+}
+
+int CompressionTestUtils::getOutputLength(const std::vector<Token> &tokens)
+{
+	int length = 0;
+	for (const Token &token : tokens)
+	{
+		length += (token.length > 0) ? token.length : 1;
+	}
+
+	return length;
+}
+
+std::vector<CompressionTestUtils::Token> CompressionTestUtils::findTokens(const std::vector<uint8_t> &payload, int maxMatchLength)
+{
+	constexpr int HASH_SIZE = 1 << 15;
+	constexpr int MAX_CHAIN_STEPS = 64;
+	std::vector<int> heads(HASH_SIZE, -1);
+	std::vector<int> prevs(payload.size(), -1);
+	auto getHash = [&payload](int index)
+	{
+		return ((payload[index] << 10) ^ (payload[index + 1] << 5) ^ payload[index + 2]) & (HASH_SIZE - 1);
+	};
+
+	auto insert = [&heads, &prevs, &payload, &getHash](int index)
+	{
+		if ((index + MIN_MATCH_LENGTH) <= static_cast<int>(payload.size()))
+		{
+			const int hash = getHash(index);
+			prevs[index] = heads[hash];
+			heads[hash] = index;
+		}
+	};
+
+	const int payloadSize = static_cast<int>(payload.size());
+	std::vector<Token> tokens;
+	int index = 0;
+	while (index < payloadSize)
+	{
+		int bestLength = 0;
+		int bestDistance = 0;
+		if ((index + MIN_MATCH_LENGTH) <= payloadSize)
+		{
+			const int maxLength = std::min(maxMatchLength, payloadSize - index);
+			int candidate = heads[getHash(index)];
+			for (int step = 0; (candidate >= 0) && (step < MAX_CHAIN_STEPS); step++)
+			{
+				const int distance = index - candidate;
+				if (distance > HISTORY_SIZE)
+				{
+					break;
+				}
+
+				int length = 0;
+				while ((length < maxLength) && (payload[candidate + length] == payload[index + length]))
+				{
+					length++;
+				}
+
+				if (length > bestLength)
+				{
+					bestLength = length;
+					bestDistance = distance;
+				}
+
+				candidate = prevs[candidate];
+			}
+		}
+
+		if (bestLength >= MIN_MATCH_LENGTH)
+		{
+			tokens.push_back(Token { bestLength, bestDistance, 0 });
+			for (int i = 0; i < bestLength; i++)
+			{
+				insert(index + i);
+			}
+
+			index += bestLength;
+		}
+		else
+		{
+			tokens.push_back(Token { 0, 0, payload[index] });
+			insert(index);
+			index++;
+		}
+	}
+
+	return tokens;
+}
+
+std::vector<CompressionTestUtils::Token> CompressionTestUtils::makeRandomTokens(int seed, int tokenCount, int maxMatchLength)
+{
+	Random random(seed);
+	std::vector<Token> tokens;
+	for (int i = 0; i < tokenCount; i++)
+	{
+		if (random.next(3) == 0)
+		{
+			tokens.push_back(Token { 0, 0, static_cast<uint8_t>(random.next(256)) });
+		}
+		else
+		{
+			const int length = MIN_MATCH_LENGTH + random.next(maxMatchLength - MIN_MATCH_LENGTH + 1);
+			const int distanceType = random.next(4);
+			const int distance = (distanceType == 0) ? (1 + random.next(length)) :
+				((distanceType == 1) ? HISTORY_SIZE : (1 + random.next(HISTORY_SIZE)));
+			tokens.push_back(Token { length, distance, 0 });
+		}
+	}
+
+	return tokens;
+}
+
+std::vector<uint8_t> CompressionTestUtils::encodeType04(const std::vector<Token> &tokens)
+{
+	std::vector<uint8_t> bytes;
+	int position = 0;
+	size_t maskIndex = 0;
+	for (size_t i = 0; i < tokens.size(); i++)
+	{
+		const int bit = static_cast<int>(i % 8);
+		if (bit == 0)
+		{
+			maskIndex = bytes.size();
+			bytes.push_back(0);
+		}
+
+		const Token &token = tokens[i];
+		if (token.length == 0)
+		{
+			bytes[maskIndex] |= 1 << bit;
+			bytes.push_back(token.literal);
+			position++;
+		}
+		else
+		{
+			// The window position is stored 18 bytes back.
+			const int copypos = (position - token.distance - 18) & (HISTORY_SIZE - 1);
+			bytes.push_back(static_cast<uint8_t>(copypos & 0xFF));
+			bytes.push_back(static_cast<uint8_t>(((copypos >> 4) & 0xF0) | (token.length - MIN_MATCH_LENGTH)));
+			position += token.length;
+		}
+	}
+
+	return bytes;
+}
+
+std::vector<uint8_t> CompressionTestUtils::encodeType08(const std::vector<Token> &tokens)
+{
+	const std::array<OffsetCode, 64> offsetCodes = makeOffsetCodes();
+	HuffmanEncoder encoder;
+	BitWriter writer;
+	for (const Token &token : tokens)
+	{
+		if (token.length == 0)
+		{
+			encoder.encode(token.literal, writer);
+		}
+		else
+		{
+			encoder.encode(256 + token.length - MIN_MATCH_LENGTH, writer);
+
+			const int offset = token.distance - 1;
+			const OffsetCode &code = offsetCodes[offset >> 6];
+			writer.write(code.prefix >> (8 - code.length), code.length);
+			writer.write(offset & 0x3F, 6);
+		}
+	}
+
+	return std::move(writer.getBytes());
+}
+
+std::vector<uint8_t> CompressionTestUtils::encodeRLE(const std::vector<uint8_t> &payload)
+{
+	std::vector<uint8_t> bytes;
+	const int payloadSize = static_cast<int>(payload.size());
+	int index = 0;
+	while (index < payloadSize)
+	{
+		int runLength = 1;
+		while (((index + runLength) < payloadSize) && (runLength < 128) && (payload[index + runLength] == payload[index]))
+		{
+			runLength++;
+		}
+
+		if (runLength >= 2)
+		{
+			bytes.push_back(static_cast<uint8_t>(0x7F + runLength));
+			bytes.push_back(payload[index]);
+			index += runLength;
+		}
+		else
+		{
+			int literalCount = 1;
+			while (((index + literalCount) < payloadSize) && (literalCount < 128) &&
+				!(((index + literalCount + 1) < payloadSize) && (payload[index + literalCount] == payload[index + literalCount + 1])))
+			{
+				literalCount++;
+			}
+
+			bytes.push_back(static_cast<uint8_t>(literalCount - 1));
+			bytes.insert(bytes.end(), payload.begin() + index, payload.begin() + index + literalCount);
+			index += literalCount;
+		}
+	}
+
+	return bytes;
+}
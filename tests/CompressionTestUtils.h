@@ -0,0 +1,49 @@
+#ifndef COMPRESSION_TEST_UTILS_H
+#define COMPRESSION_TEST_UTILS_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Small LZSS (type 4), LZHUF (type 8), and RLE encoders producing input for the Arena decoders.
+
+namespace CompressionTestUtils
+{
+	constexpr int HISTORY_SIZE = 4096;
+	constexpr int MIN_MATCH_LENGTH = 3;
+	constexpr int TYPE04_MAX_MATCH_LENGTH = 18;
+	constexpr int TYPE08_MAX_MATCH_LENGTH = 60;
+
+	// Upper six bits of an LZHUF match offset are written as a prefix code.
+	struct OffsetCode
+	{
+		int length;
+		int prefix; // Code bits at the top of an 8-bit value.
+	};
+
+	// Prefix codes indexed by the upper six offset bits.
+	std::array<OffsetCode, 64> makeOffsetCodes();
+
+	// A literal byte, or a copy of earlier output some distance back (1 to the history size).
+	struct Token
+	{
+		int length; // 0 for a literal.
+		int distance;
+		uint8_t literal;
+	};
+
+	int getOutputLength(const std::vector<Token> &tokens);
+
+	// Greedy matching on three-byte hash chains. Only matches within the payload itself.
+	std::vector<Token> findTokens(const std::vector<uint8_t> &payload, int maxMatchLength);
+
+	// Arbitrary tokens, including copies from before the start of output (the space-filled history),
+	// self-overlapping runs, and the furthest distance.
+	std::vector<Token> makeRandomTokens(int seed, int tokenCount, int maxMatchLength);
+
+	std::vector<uint8_t> encodeType04(const std::vector<Token> &tokens);
+	std::vector<uint8_t> encodeType08(const std::vector<Token> &tokens);
+	std::vector<uint8_t> encodeRLE(const std::vector<uint8_t> &payload);
+}
+
+#endif
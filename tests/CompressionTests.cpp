@@ -0,0 +1,490 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "CompressionTestUtils.h"
+#include "TestUtils.h"
+
+#include "OpenTESArena/src/Assets/Compression.h"
+#include "OpenTESArena/src/Math/Random.h"
+
+// Checks the decoders against reference copies of the byte-at-a-time versions they replaced. Inputs are
+// encoded from known payloads, plus random token streams that reach into the initial history and wrap
+// around the window.
+
+namespace
+{
+	// Reference decoders, as they were before buffered bit reads and block copies. The offset tables are
+	// built from the prefix codes instead of being written out.
+	void ReferenceDecodeRLE(const uint8_t *src, int stopCount, BufferView<uint8_t> dst)
+	{
+		int i = 0;
+		int o = 0;
+
+		while (o < stopCount)
+		{
+			const uint8_t sample = src[i];
+			src++;
+
+			if ((sample & 0x80) != 0)
+			{
+				const uint8_t value = src[i];
+				src++;
+
+				const uint32_t count = static_cast<uint32_t>(sample) - 0x7F;
+
+				DebugAssert(o >= 0);
+				DebugAssert((o + static_cast<int>(count)) <= dst.getCount());
+				for (uint32_t j = 0; j < count; j++)
+				{
+					dst[o] = value;
+					o++;
+				}
+			}
+			else
+			{
+				const uint32_t count = static_cast<uint32_t>(sample) + 1;
+
+				DebugAssert(o >= 0);
+				DebugAssert((o + static_cast<int>(count)) <= dst.getCount());
+				for (uint32_t j = 0; j < count; j++)
+				{
+					dst[o] = src[i];
+					o++;
+					i++;
+				}
+			}
+		}
+	}
+
+	void ReferenceDecodeType04(const uint8_t *src, const uint8_t *srcend, BufferView<uint8_t> out)
+	{
+		auto dst = out.begin();
+
+		std::array<uint8_t, 4096> history;
+		history.fill(0x20);
+		int historypos = 0;
+
+		int bitcount = 0;
+		int mask = 0;
+		while (src != srcend)
+		{
+			if (!bitcount)
+			{
+				bitcount = 8;
+				mask = *(src++);
+			}
+			else
+			{
+				mask >>= 1;
+			}
+
+			if ((mask & 1))
+			{
+				DebugAssertMsg(src != srcend, "Unexpected end of image.");
+				DebugAssertMsg(dst != out.end(), "Decoded image overflow.");
+
+				history[historypos++ & 0x0FFF] = *src;
+				*(dst++) = *(src++);
+			}
+			else
+			{
+				DebugAssertMsg(std::distance(src, srcend) >= 2, "Unexpected end of image.");
+
+				uint8_t byte1 = *(src++);
+				uint8_t byte2 = *(src++);
+				int tocopy = (byte2 & 0x0F) + 3;
+				int copypos = (((byte2 & 0xF0) << 4) | byte1) + 18;
+
+				DebugAssertMsg(std::distance(dst, out.end()) >= tocopy, "Decoded image overflow.");
+
+				for (int i = 0; i < tocopy; i++)
+				{
+					*dst = history[copypos++ & 0x0FFF];
+					history[historypos++ & 0x0FFF] = *(dst++);
+				}
+			}
+
+			bitcount--;
+		}
+
+		std::fill(dst, out.end(), 0);
+	}
+
+	void ReferenceDecodeType08(const uint8_t *src, const uint8_t *srcend, BufferView<uint8_t> out)
+	{
+		std::array<uint8_t, 256> highOffsetBits;
+		std::array<uint8_t, 256> lowOffsetBitCount;
+		const std::array<CompressionTestUtils::OffsetCode, 64> offsetCodes = CompressionTestUtils::makeOffsetCodes();
+		for (int i = 0; i < static_cast<int>(offsetCodes.size()); i++)
+		{
+			const CompressionTestUtils::OffsetCode &code = offsetCodes[i];
+			const int count = 1 << (8 - code.length);
+			std::fill(highOffsetBits.begin() + code.prefix, highOffsetBits.begin() + code.prefix + count, static_cast<uint8_t>(i));
+			std::fill(lowOffsetBitCount.begin() + code.prefix, lowOffsetBitCount.begin() + code.prefix + count, static_cast<uint8_t>(code.length));
+		}
+
+		std::array<uint8_t, 4096> history;
+		history.fill(0x20);
+		int historypos = 0;
+
+		std::array<uint16_t, 941> NodeIdxMap;
+		std::iota(NodeIdxMap.begin(), NodeIdxMap.begin() + 626, 0);
+		std::for_each(NodeIdxMap.begin(), NodeIdxMap.begin() + 626,
+			[](uint16_t &val) { val = (val >> 1) + 314; }
+		);
+
+		NodeIdxMap[626] = 0;
+		std::iota(NodeIdxMap.begin() + 627, NodeIdxMap.end(), 0);
+
+		std::array<uint16_t, 627> NodeTree;
+		std::iota(NodeTree.begin(), NodeTree.begin() + 314, 627);
+		std::iota(NodeTree.begin() + 314, NodeTree.end(), 0);
+		std::for_each(NodeTree.begin() + 314, NodeTree.end(),
+			[](uint16_t &val) { val *= 2; }
+		);
+
+		std::array<uint16_t, 627> NodeFreq;
+		std::fill(NodeFreq.begin(), NodeFreq.begin() + 314, 1);
+		{
+			auto iter = NodeFreq.begin();
+			std::for_each(NodeFreq.begin() + 314, NodeFreq.begin() + 627,
+				[&iter](uint16_t &val)
+			{
+				val = *(iter++);
+				val += *(iter++);
+			});
+		}
+
+		uint16_t bitmask = 0;
+		uint8_t validbits = 0;
+
+		auto dst = out.begin();
+		while (dst != out.end())
+		{
+			uint16_t node = NodeTree[626];
+			while (node < 627)
+			{
+				while (validbits < 9)
+				{
+					if (src != srcend)
+					{
+						bitmask |= *(src++) << (8 - validbits);
+					}
+
+					validbits += 8;
+				}
+
+				node = NodeTree.at(node + ((bitmask >> 15) & 1));
+				bitmask <<= 1;
+				validbits--;
+			}
+
+			uint16_t freqidx = NodeIdxMap.at(node);
+			do {
+				NodeFreq.at(freqidx) += 1;
+				uint16_t freq = NodeFreq[freqidx];
+				uint16_t nextidx = freqidx + 1;
+				if (nextidx < NodeFreq.size() && NodeFreq[nextidx] < freq)
+				{
+					do {
+						nextidx++;
+					} while (nextidx < NodeFreq.size() && NodeFreq[nextidx] < freq);
+					nextidx--;
+
+					NodeFreq[freqidx] = NodeFreq[nextidx];
+					NodeFreq[nextidx] = freq;
+
+					std::iter_swap(NodeTree.begin() + freqidx, NodeTree.begin() + nextidx);
+
+					uint16_t mapidx = NodeTree[nextidx];
+					NodeIdxMap.at(mapidx) = nextidx;
+					if (mapidx < 627)
+					{
+						NodeIdxMap[mapidx + 1] = nextidx;
+					}
+
+					mapidx = NodeTree[freqidx];
+					NodeIdxMap.at(mapidx) = freqidx;
+					if (mapidx < 627)
+					{
+						NodeIdxMap[mapidx + 1] = freqidx;
+					}
+
+					freqidx = nextidx;
+				}
+				freqidx = NodeIdxMap[freqidx];
+			} while (freqidx != 0);
+
+			uint16_t codeword = node - 627;
+			if (codeword < 256)
+			{
+				uint8_t codewordByte = static_cast<uint8_t>(codeword);
+				history[historypos++ & 0x0FFF] = codewordByte;
+				*(dst++) = codewordByte;
+			}
+			else
+			{
+				while (validbits < 9)
+				{
+					if (src != srcend)
+					{
+						bitmask |= *(src++) << (8 - validbits);
+					}
+
+					validbits += 8;
+				}
+
+				uint8_t tableidx = bitmask >> 8;
+				bitmask <<= 8;
+				validbits -= 8;
+
+				uint16_t offsetHigh = highOffsetBits[tableidx] << 6;
+				uint16_t bitcount = lowOffsetBitCount[tableidx] - 2;
+				uint16_t offsetLow = tableidx;
+				for (uint16_t i = 0; i < bitcount; i++)
+				{
+					while (validbits < 9)
+					{
+						if (src != srcend)
+						{
+							bitmask |= *(src++) << (8 - validbits);
+						}
+
+						validbits += 8;
+					}
+
+					offsetLow = (offsetLow << 1) | ((bitmask >> 15) & 1);
+					bitmask <<= 1;
+					validbits--;
+				}
+
+				uint16_t copypos = historypos - (offsetHigh | (offsetLow & 0x003F)) - 1;
+				uint16_t tocopy = codeword - 256 + 3;
+				for (uint16_t i = 0; i < tocopy; i++)
+				{
+					*dst = history[copypos++ & 0x0FFF];
+					history[historypos++ & 0x0FFF] = *(dst++);
+				}
+			}
+		}
+	}
+
+	// Texture-like palette indices: flat areas, gradients, and a little dithering noise.
+	std::vector<uint8_t> MakeTexturePayload(int seed, int width, int height)
+	{
+		Random random(seed);
+		std::vector<uint8_t> payload(width * height);
+		for (int y = 0; y < height; y++)
+		{
+			for (int x = 0; x < width; x++)
+			{
+				const bool isFlat = ((x / 16) + (y / 16)) % 3 == 0;
+				const int gradient = ((x + y) / 4) % 32;
+				const int noise = (random.next(8) == 0) ? random.next(4) : 0;
+				payload[x + (y * width)] = static_cast<uint8_t>(isFlat ? 0 : (96 + gradient + noise));
+			}
+		}
+
+		return payload;
+	}
+
+	// Known payloads covering long runs, text, incompressible bytes, and repeats further apart than the window.
+	std::vector<std::vector<uint8_t>> MakePayloads()
+	{
+		std::vector<std::vector<uint8_t>> payloads;
+		payloads.push_back(MakeTexturePayload(1, 64, 64));
+		payloads.push_back(MakeTexturePayload(2, 320, 200));
+		payloads.push_back(std::vector<uint8_t>(10000, 0x7A));
+
+		const std::string text = "The Elder Scrolls: Arena. Adventurers, the Imperial Province awaits your return. ";
+		std::vector<uint8_t> textPayload;
+		for (int i = 0; i < 100; i++)
+		{
+			textPayload.insert(textPayload.end(), text.begin(), text.end());
+			textPayload.push_back(static_cast<uint8_t>('0' + (i % 10)));
+		}
+
+		payloads.push_back(std::move(textPayload));
+
+		Random random(3);
+		std::vector<uint8_t> noisePayload(5000);
+		for (uint8_t &value : noisePayload)
+		{
+			value = static_cast<uint8_t>(random.next(256));
+		}
+
+		// The same noise again just within and then just past the window.
+		std::vector<uint8_t> repeatPayload = noisePayload;
+		repeatPayload.resize(CompressionTestUtils::HISTORY_SIZE - 100);
+		repeatPayload.insert(repeatPayload.end(), noisePayload.begin(), noisePayload.begin() + 1000);
+		repeatPayload.insert(repeatPayload.end(), noisePayload.begin(), noisePayload.end());
+
+		payloads.push_back(std::move(noisePayload));
+		payloads.push_back(std::move(repeatPayload));
+		payloads.push_back(std::vector<uint8_t> { 0x42 });
+		return payloads;
+	}
+
+	using DecodeFunc = void(*)(const uint8_t *src, const uint8_t *srcend, BufferView<uint8_t> out);
+
+	std::vector<uint8_t> Decode(DecodeFunc decodeFunc, const std::vector<uint8_t> &src, int outLength)
+	{
+		std::vector<uint8_t> out(outLength, 0xCD);
+		decodeFunc(src.data(), src.data() + src.size(), BufferView<uint8_t>(out.data(), outLength));
+		return out;
+	}
+
+	void DecodeType04(const uint8_t *src, const uint8_t *srcend, BufferView<uint8_t> out)
+	{
+		Compression::decodeType04(src, srcend, out);
+	}
+
+	void DecodeType08(const uint8_t *src, const uint8_t *srcend, BufferView<uint8_t> out)
+	{
+		Compression::decodeType08(src, srcend, out);
+	}
+}
+
+TEST_CASE(CompressionDecodesKnownType04)
+{
+	// "ABC" as literals, then one match of six bytes from the start (window position 0, stored as 0xFEE).
+	const std::vector<uint8_t> src = { 0x07, 'A', 'B', 'C', 0xEE, 0xF3 };
+	const std::vector<uint8_t> expected = { 'A', 'B', 'C', 'A', 'B', 'C', 'A', 'B', 'C', 0, 0 };
+	TEST_CHECK(Decode(DecodeType04, src, 11) == expected);
+	TEST_CHECK(Decode(ReferenceDecodeType04, src, 11) == expected);
+}
+
+TEST_CASE(CompressionType04MatchesReference)
+{
+	for (const std::vector<uint8_t> &payload : MakePayloads())
+	{
+		const std::vector<uint8_t> src = CompressionTestUtils::encodeType04(CompressionTestUtils::findTokens(payload, CompressionTestUtils::TYPE04_MAX_MATCH_LENGTH));
+		const int length = static_cast<int>(payload.size());
+		TEST_CHECK(Decode(DecodeType04, src, length) == payload);
+		TEST_CHECK(Decode(ReferenceDecodeType04, src, length) == payload);
+	}
+
+	for (int seed = 1; seed <= 20; seed++)
+	{
+		const std::vector<CompressionTestUtils::Token> tokens = CompressionTestUtils::makeRandomTokens(seed, 3000, CompressionTestUtils::TYPE04_MAX_MATCH_LENGTH);
+		const std::vector<uint8_t> src = CompressionTestUtils::encodeType04(tokens);
+		const int length = CompressionTestUtils::getOutputLength(tokens);
+		TEST_CHECK(Decode(DecodeType04, src, length) == Decode(ReferenceDecodeType04, src, length));
+	}
+}
+
+TEST_CASE(CompressionType08MatchesReference)
+{
+	for (const std::vector<uint8_t> &payload : MakePayloads())
+	{
+		const std::vector<uint8_t> src = CompressionTestUtils::encodeType08(CompressionTestUtils::findTokens(payload, CompressionTestUtils::TYPE08_MAX_MATCH_LENGTH));
+		const int length = static_cast<int>(payload.size());
+		TEST_CHECK(Decode(DecodeType08, src, length) == payload);
+		TEST_CHECK(Decode(ReferenceDecodeType08, src, length) == payload);
+	}
+
+	for (int seed = 1; seed <= 20; seed++)
+	{
+		const std::vector<CompressionTestUtils::Token> tokens = CompressionTestUtils::makeRandomTokens(seed, 3000, CompressionTestUtils::TYPE08_MAX_MATCH_LENGTH);
+		const std::vector<uint8_t> src = CompressionTestUtils::encodeType08(tokens);
+		const int length = CompressionTestUtils::getOutputLength(tokens);
+		TEST_CHECK(Decode(DecodeType08, src, length) == Decode(ReferenceDecodeType08, src, length));
+	}
+}
+
+TEST_CASE(CompressionType08StopsAtEndOfOutput)
+{
+	// A match running past the end of output is cut short instead of writing past it.
+	const std::vector<CompressionTestUtils::Token> tokens = { CompressionTestUtils::Token { 0, 0, 'x' }, CompressionTestUtils::Token { CompressionTestUtils::TYPE08_MAX_MATCH_LENGTH, 1, 0 } };
+	const std::vector<uint8_t> src = CompressionTestUtils::encodeType08(tokens);
+	TEST_CHECK(Decode(DecodeType08, src, 10) == std::vector<uint8_t>(10, 'x'));
+}
+
+TEST_CASE(CompressionRLEMatchesReference)
+{
+	for (const std::vector<uint8_t> &payload : MakePayloads())
+	{
+		const std::vector<uint8_t> src = CompressionTestUtils::encodeRLE(payload);
+		const int length = static_cast<int>(payload.size());
+		std::vector<uint8_t> out(length), referenceOut(length);
+		Compression::decodeRLE(src.data(), length, BufferView<uint8_t>(out.data(), length));
+		ReferenceDecodeRLE(src.data(), length, BufferView<uint8_t>(referenceOut.data(), length));
+		TEST_CHECK(out == payload);
+		TEST_CHECK(referenceOut == payload);
+	}
+}
+
+BENCHMARK_CASE(CompressionDecodeBenchmark)
+{
+	// Roughly the size of a level's worth of textures and voxel data, decoded repeatedly.
+	std::vector<std::vector<uint8_t>> payloads;
+	for (int i = 0; i < 32; i++)
+	{
+		payloads.push_back(MakeTexturePayload(100 + i, 128, 128));
+	}
+
+	struct Format
+	{
+		const char *name;
+		DecodeFunc decodeFunc;
+		DecodeFunc referenceDecodeFunc;
+		std::vector<std::vector<uint8_t>> sources;
+	};
+
+	std::array<Format, 2> formats =
+	{
+		Format { "Type 4", DecodeType04, ReferenceDecodeType04, { } },
+		Format { "Type 8", DecodeType08, ReferenceDecodeType08, { } }
+	};
+
+	for (const std::vector<uint8_t> &payload : payloads)
+	{
+		formats[0].sources.push_back(CompressionTestUtils::encodeType04(CompressionTestUtils::findTokens(payload, CompressionTestUtils::TYPE04_MAX_MATCH_LENGTH)));
+		formats[1].sources.push_back(CompressionTestUtils::encodeType08(CompressionTestUtils::findTokens(payload, CompressionTestUtils::TYPE08_MAX_MATCH_LENGTH)));
+	}
+
+	// Each pass decodes every payload once. The fastest of several passes is the least disturbed by the rest of
+	// the system.
+	constexpr int passCount = 200;
+	auto measure = [&payloads](const Format &format, DecodeFunc decodeFunc)
+	{
+		std::vector<uint8_t> out;
+		double bestSeconds = std::numeric_limits<double>::infinity();
+		for (int i = 0; i < passCount; i++)
+		{
+			const auto startTime = std::chrono::steady_clock::now();
+			for (size_t j = 0; j < payloads.size(); j++)
+			{
+				const std::vector<uint8_t> &src = format.sources[j];
+				out.resize(payloads[j].size());
+				decodeFunc(src.data(), src.data() + src.size(), BufferView<uint8_t>(out.data(), static_cast<int>(out.size())));
+			}
+
+			const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+			bestSeconds = std::min(bestSeconds, seconds);
+		}
+
+		double megabytes = 0.0;
+		for (const std::vector<uint8_t> &payload : payloads)
+		{
+			megabytes += static_cast<double>(payload.size()) / (1024.0 * 1024.0);
+		}
+
+		return megabytes / bestSeconds;
+	};
+
+	for (const Format &format : formats)
+	{
+		const double referenceRate = measure(format, format.referenceDecodeFunc);
+		const double rate = measure(format, format.decodeFunc);
+		std::printf("  %s: %.1f MB/s (reference %.1f MB/s, %.2fx)\n", format.name, rate, referenceRate,
+			rate / referenceRate);
+	}
+}
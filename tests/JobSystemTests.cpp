@@ -0,0 +1,328 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "TestUtils.h"
+
+#include "components/utilities/JobSystem.h"
+
+// Runs the job system with different worker counts, including none, where everything happens on the waiting
+// thread. The thread running the tests is the job system's main thread.
+
+namespace
+{
+	constexpr std::array<int, 3> WORKER_COUNTS = { 0, 1, 3 };
+
+	// Order in which jobs ran, shared between threads.
+	class RunOrder
+	{
+	private:
+		std::atomic<int> nextIndex;
+	public:
+		RunOrder()
+			: nextIndex(0) { }
+
+		int next()
+		{
+			return this->nextIndex++;
+		}
+	};
+}
+
+TEST_CASE(JobSystemParallelForCoversRangeOnce)
+{
+	constexpr std::array<int, 6> counts = { 0, 1, 7, 64, 100, 1000 };
+	constexpr std::array<int, 5> batchSizes = { 0, 1, 3, 64, 2000 };
+
+	for (const int workerCount : WORKER_COUNTS)
+	{
+		JobSystem jobSystem;
+		jobSystem.init(workerCount);
+
+		for (const int count : counts)
+		{
+			for (const int batchSize : batchSizes)
+			{
+				std::vector<std::atomic<int>> visitCounts(std::max(count, 1));
+				std::atomic<int> badBatchCount(0);
+				std::atomic<int> batchCount(0);
+				jobSystem.parallelFor(count, batchSize, [&](int begin, int end)
+				{
+					// Batches start on a batch boundary, aren't empty, and don't run past the end.
+					const int expectedSize = std::max(batchSize, 1);
+					const bool isWholeRange = (workerCount == 0) && (begin == 0) && (end == count);
+					if ((begin < 0) || (end > count) || (begin >= end) ||
+						(!isWholeRange && (((begin % expectedSize) != 0) || ((end - begin) > expectedSize))))
+					{
+						badBatchCount++;
+						return;
+					}
+
+					for (int i = begin; i < end; i++)
+					{
+						visitCounts[i]++;
+					}
+
+					batchCount++;
+				});
+
+				TEST_CHECK(badBatchCount == 0);
+				for (int i = 0; i < count; i++)
+				{
+					TEST_CHECK(visitCounts[i] == 1);
+				}
+
+				if (count == 0)
+				{
+					TEST_CHECK(batchCount == 0);
+				}
+			}
+		}
+	}
+}
+
+TEST_CASE(JobSystemRunsDependenciesFirst)
+{
+	for (const int workerCount : WORKER_COUNTS)
+	{
+		JobSystem jobSystem;
+		jobSystem.init(workerCount);
+
+		for (int i = 0; i < 200; i++)
+		{
+			// Diamond: B and C need A, D needs B and C. D also depends on an empty handle and on A again.
+			RunOrder runOrder;
+			int orderA = -1, orderB = -1, orderC = -1, orderD = -1;
+			const JobHandle handleA = jobSystem.schedule([&]() { orderA = runOrder.next(); });
+			const JobHandle handleB = jobSystem.schedule([&]() { orderB = runOrder.next(); }, BufferView<const JobHandle>(&handleA, 1));
+			const JobHandle handleC = jobSystem.schedule([&]() { orderC = runOrder.next(); }, BufferView<const JobHandle>(&handleA, 1));
+			const std::array<JobHandle, 4> dependenciesD = { handleB, JobHandle(), handleC, handleA };
+			const JobHandle handleD = jobSystem.schedule([&]() { orderD = runOrder.next(); }, dependenciesD);
+
+			jobSystem.wait(handleD);
+			TEST_CHECK(handleA.isDone() && handleB.isDone() && handleC.isDone() && handleD.isDone());
+			TEST_CHECK(orderA == 0);
+			TEST_CHECK((orderB > orderA) && (orderC > orderA));
+			TEST_CHECK((orderD > orderB) && (orderD > orderC));
+			TEST_CHECK(orderD == 3);
+		}
+
+		// Depending on jobs that already finished doesn't hold anything up.
+		const JobHandle finishedHandle = jobSystem.schedule([]() { });
+		jobSystem.wait(finishedHandle);
+		bool ran = false;
+		const JobHandle handle = jobSystem.schedule([&ran]() { ran = true; }, BufferView<const JobHandle>(&finishedHandle, 1));
+		jobSystem.wait(handle);
+		TEST_CHECK(ran);
+
+		// A long chain, each link scheduled before the one it depends on has run.
+		constexpr int chainLength = 1000;
+		RunOrder runOrder;
+		std::vector<int> orders(chainLength, -1);
+		JobHandle previousHandle;
+		for (int j = 0; j < chainLength; j++)
+		{
+			previousHandle = jobSystem.schedule([&orders, &runOrder, j]() { orders[j] = runOrder.next(); },
+				BufferView<const JobHandle>(&previousHandle, 1));
+		}
+
+		jobSystem.wait(previousHandle);
+		for (int j = 0; j < chainLength; j++)
+		{
+			TEST_CHECK(orders[j] == j);
+		}
+	}
+}
+
+TEST_CASE(JobSystemRunsMainThreadJobsOnMainThread)
+{
+	const std::thread::id mainThreadID = std::this_thread::get_id();
+
+	for (const int workerCount : WORKER_COUNTS)
+	{
+		JobSystem jobSystem;
+		jobSystem.init(workerCount);
+
+		std::atomic<int> wrongThreadCount(0);
+		std::atomic<int> mainThreadRunCount(0);
+		auto mainThreadJob = [&]()
+		{
+			if (std::this_thread::get_id() != mainThreadID)
+			{
+				wrongThreadCount++;
+			}
+
+			mainThreadRunCount++;
+		};
+
+		// Queued main-thread jobs only run when the main thread asks for them.
+		constexpr int jobCount = 20;
+		for (int i = 0; i < jobCount; i++)
+		{
+			jobSystem.scheduleMainThread(mainThreadJob);
+		}
+
+		TEST_CHECK(mainThreadRunCount == 0);
+		jobSystem.runMainThreadJobs();
+		TEST_CHECK(mainThreadRunCount == jobCount);
+
+		// Scheduled from workers, and mixed with worker jobs in both directions of a dependency. Waiting on the
+		// main thread runs them.
+		std::mutex handlesMutex;
+		std::vector<JobHandle> innerHandles;
+		std::vector<JobHandle> handles;
+		for (int i = 0; i < jobCount; i++)
+		{
+			const JobHandle workerHandle = jobSystem.schedule([&]()
+			{
+				const JobHandle innerHandle = jobSystem.scheduleMainThread(mainThreadJob);
+				std::lock_guard<std::mutex> lock(handlesMutex);
+				innerHandles.emplace_back(innerHandle);
+			});
+
+			const JobHandle mainThreadHandle = jobSystem.scheduleMainThread(mainThreadJob,
+				BufferView<const JobHandle>(&workerHandle, 1));
+			handles.emplace_back(jobSystem.schedule([]() { }, BufferView<const JobHandle>(&mainThreadHandle, 1)));
+		}
+
+		jobSystem.wait(handles);
+		jobSystem.wait(innerHandles);
+		TEST_CHECK(mainThreadRunCount == (jobCount * 3));
+		TEST_CHECK(wrongThreadCount == 0);
+	}
+}
+
+TEST_CASE(JobSystemChangesWorkerCount)
+{
+	JobSystem jobSystem;
+	jobSystem.init(2);
+	TEST_CHECK(jobSystem.getWorkerCount() == 2);
+
+	constexpr std::array<int, 5> newWorkerCounts = { 4, 0, 1, 0, 3 };
+	for (const int workerCount : newWorkerCounts)
+	{
+		// Jobs queued before the change finish before it returns.
+		constexpr int jobCount = 100;
+		std::atomic<int> runCount(0);
+		std::vector<JobHandle> handles;
+		for (int i = 0; i < jobCount; i++)
+		{
+			handles.emplace_back(jobSystem.schedule([&runCount]()
+			{
+				std::this_thread::sleep_for(std::chrono::microseconds(10));
+				runCount++;
+			}));
+		}
+
+		jobSystem.setWorkerCount(workerCount);
+		TEST_CHECK(jobSystem.getWorkerCount() == workerCount);
+		TEST_CHECK(runCount == jobCount);
+		for (const JobHandle &handle : handles)
+		{
+			TEST_CHECK(handle.isDone());
+		}
+
+		// The resized pool still runs everything.
+		std::atomic<int> sum(0);
+		jobSystem.parallelFor(1000, 10, [&sum](int begin, int end)
+		{
+			for (int i = begin; i < end; i++)
+			{
+				sum += i;
+			}
+		});
+
+		TEST_CHECK(sum == ((999 * 1000) / 2));
+
+		std::vector<double> utilizations(workerCount);
+		jobSystem.sampleWorkerUtilization(BufferView<double>(utilizations.data(), workerCount));
+		for (const double utilization : utilizations)
+		{
+			TEST_CHECK((utilization >= 0.0) && (utilization <= 1.0));
+		}
+	}
+
+	// The same count leaves the pool running as it is.
+	std::atomic<int> runCount(0);
+	const JobHandle handle = jobSystem.schedule([&runCount]() { runCount++; });
+	jobSystem.setWorkerCount(3);
+	TEST_CHECK(jobSystem.getWorkerCount() == 3);
+	jobSystem.wait(handle);
+	TEST_CHECK(runCount == 1);
+}
+
+BENCHMARK_CASE(JobSystemSchedulingOverhead)
+{
+	// Cost per job of scheduling and waiting on empty jobs, so it's all overhead. The fastest of several runs is
+	// the least disturbed by the rest of the system.
+	constexpr int jobCount = 20000;
+	constexpr int runCount = 20;
+	auto measure = [](const auto &runFunc)
+	{
+		double bestNanoseconds = std::numeric_limits<double>::infinity();
+		for (int i = 0; i < runCount; i++)
+		{
+			const auto startTime = std::chrono::steady_clock::now();
+			runFunc();
+			const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - startTime;
+			bestNanoseconds = std::min(bestNanoseconds, elapsed.count());
+		}
+
+		return bestNanoseconds / static_cast<double>(jobCount);
+	};
+
+	// With no workers, parallelFor() runs the whole range in one call.
+	std::vector<int> workerCounts = { 0, 1 };
+	const int hardwareWorkerCount = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+	if (hardwareWorkerCount > 1)
+	{
+		workerCounts.emplace_back(hardwareWorkerCount);
+	}
+
+	for (const int workerCount : workerCounts)
+	{
+		JobSystem jobSystem;
+		jobSystem.init(workerCount);
+
+		std::vector<JobHandle> handles(jobCount);
+		const double independentNanoseconds = measure([&jobSystem, &handles]()
+		{
+			for (JobHandle &handle : handles)
+			{
+				handle = jobSystem.schedule([]() { });
+			}
+
+			jobSystem.wait(BufferView<const JobHandle>(handles));
+		});
+
+		const double chainNanoseconds = measure([&jobSystem]()
+		{
+			JobHandle previousHandle;
+			for (int i = 0; i < jobCount; i++)
+			{
+				previousHandle = jobSystem.schedule([]() { }, BufferView<const JobHandle>(&previousHandle, 1));
+			}
+
+			jobSystem.wait(previousHandle);
+		});
+
+		std::atomic<int> sink(0);
+		const double parallelForNanoseconds = measure([&jobSystem, &sink]()
+		{
+			jobSystem.parallelFor(jobCount, 1, [&sink](int begin, int end)
+			{
+				sink.fetch_add(end - begin, std::memory_order_relaxed);
+			});
+		});
+
+		std::printf("  %d worker%s: %.1fns per independent job, %.1fns per chained job, "
+			"%.1fns per parallelFor index in batches of 1\n", workerCount, (workerCount != 1) ? "s" : "",
+			independentNanoseconds, chainNanoseconds, parallelForNanoseconds);
+	}
+}
@@ -0,0 +1,309 @@
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "TestUtils.h"
+
+#include "OpenTESArena/src/Audio/MusicStream.h"
+
+// Drives MusicStream with a simulated output consuming audio in real-time steps, so no OpenAL device or
+// MIDI files are needed. Each frame of a fake song is tagged with its song and frame index, so the played
+// frames show exactly where songs started, looped, or were cut off.
+
+namespace
+{
+	constexpr int SAMPLE_RATE = 44100;
+
+	uint32_t MakeFrameTag(int songIndex, int frameIndex)
+	{
+		return (static_cast<uint32_t>(songIndex + 1) << 24) | static_cast<uint32_t>(frameIndex);
+	}
+
+	class FakeSong final : public MidiSong
+	{
+	private:
+		int songIndex;
+		int frameCount;
+		int position;
+	public:
+		FakeSong(int songIndex, int frameCount)
+		{
+			this->songIndex = songIndex;
+			this->frameCount = frameCount;
+			this->position = 0;
+		}
+
+		void getFormat(int *sampleRate) override
+		{
+			*sampleRate = SAMPLE_RATE;
+		}
+
+		size_t read(char *buffer, size_t count) override
+		{
+			const int framesToRead = std::min(static_cast<int>(count), this->frameCount - this->position);
+			for (int i = 0; i < framesToRead; i++)
+			{
+				const uint32_t tag = MakeFrameTag(this->songIndex, this->position + i);
+				std::memcpy(buffer + (i * MusicStream::FRAME_SIZE), &tag, sizeof(tag));
+			}
+
+			this->position += framesToRead;
+			return static_cast<size_t>(framesToRead);
+		}
+
+		bool seek(size_t offset) override
+		{
+			this->position = static_cast<int>(offset);
+			return true;
+		}
+	};
+
+	class FakeOutput final : public MusicStreamOutput
+	{
+	private:
+		std::deque<std::vector<uint32_t>> buffers;
+		int processedCount;
+		int playedFrameCount; // Of the oldest unprocessed buffer.
+		bool playing;
+	public:
+		std::vector<uint32_t> playedFrames;
+
+		FakeOutput()
+		{
+			this->processedCount = 0;
+			this->playedFrameCount = 0;
+			this->playing = false;
+		}
+
+		int getQueuedBufferCount() override
+		{
+			return static_cast<int>(this->buffers.size());
+		}
+
+		int getProcessedBufferCount() override
+		{
+			return this->processedCount;
+		}
+
+		int getPlayedFrameCount() override
+		{
+			return this->playedFrameCount;
+		}
+
+		bool isPlaying() override
+		{
+			return this->playing;
+		}
+
+		void queueBuffer(BufferView<const char> pcm, int sampleRate) override
+		{
+			TEST_CHECK(sampleRate == SAMPLE_RATE);
+			TEST_CHECK(pcm.getCount() == (MusicStream::BUFFER_FRAMES * MusicStream::FRAME_SIZE));
+
+			std::vector<uint32_t> frames(pcm.getCount() / MusicStream::FRAME_SIZE);
+			std::memcpy(frames.data(), pcm.begin(), pcm.getCount());
+			this->buffers.push_back(std::move(frames));
+		}
+
+		void unqueueProcessedBuffers() override
+		{
+			for (; this->processedCount > 0; this->processedCount--)
+			{
+				this->buffers.pop_front();
+			}
+		}
+
+		void play() override
+		{
+			this->playing = !this->buffers.empty();
+		}
+
+		void stop() override
+		{
+			this->buffers.clear();
+			this->processedCount = 0;
+			this->playedFrameCount = 0;
+			this->playing = false;
+		}
+
+		// Plays the given number of frames. Stops like an OpenAL source if the queue runs dry.
+		void advance(int frameCount)
+		{
+			while (this->playing && (frameCount > 0))
+			{
+				if (this->processedCount == static_cast<int>(this->buffers.size()))
+				{
+					this->playing = false;
+					break;
+				}
+
+				const std::vector<uint32_t> &buffer = this->buffers[this->processedCount];
+				const int framesToPlay = std::min(frameCount, static_cast<int>(buffer.size()) - this->playedFrameCount);
+				this->playedFrames.insert(this->playedFrames.end(), buffer.begin() + this->playedFrameCount,
+					buffer.begin() + this->playedFrameCount + framesToPlay);
+				this->playedFrameCount += framesToPlay;
+				frameCount -= framesToPlay;
+
+				if (this->playedFrameCount == static_cast<int>(buffer.size()))
+				{
+					this->processedCount++;
+					this->playedFrameCount = 0;
+				}
+			}
+		}
+	};
+
+	// Opens fake songs by filename. Lengths deliberately aren't multiples of the buffer or prerender size.
+	MusicStream::SongOpenFunc MakeSongOpenFunc(const std::unordered_map<std::string, int> &songFrameCounts)
+	{
+		return [songFrameCounts](const std::string &filename) -> MidiSongPtr
+		{
+			const auto iter = songFrameCounts.find(filename);
+			if (iter == songFrameCounts.end())
+			{
+				return nullptr;
+			}
+
+			const int songIndex = filename[0] - 'a';
+			return std::make_unique<FakeSong>(songIndex, iter->second);
+		};
+	}
+
+	// Updates the stream once per half buffer of playback, like the background thread waking on time.
+	void RunStream(MusicStream &stream, FakeOutput &output, int frameCount)
+	{
+		constexpr int stepFrames = MusicStream::BUFFER_FRAMES / 2;
+		for (int i = 0; i < frameCount; i += stepFrames)
+		{
+			stream.update();
+			output.advance(stepFrames);
+		}
+	}
+
+	// Index of the first played frame that doesn't continue the expected song sequence, or -1 if none.
+	int FindDiscontinuity(const std::vector<uint32_t> &frames, int firstFrame, int songIndex, int songFrameCount)
+	{
+		for (int i = firstFrame; i < static_cast<int>(frames.size()); i++)
+		{
+			const int frameIndex = (i - firstFrame) % songFrameCount;
+			if (frames[i] != MakeFrameTag(songIndex, frameIndex))
+			{
+				return i;
+			}
+		}
+
+		return -1;
+	}
+}
+
+TEST_CASE(MusicStreamLoopsWithoutGaps)
+{
+	const int songFrames = (MusicStream::BUFFER_FRAMES * 3) + 1234;
+	FakeOutput output;
+	MusicStream stream(output, MakeSongOpenFunc({ { "a", songFrames } }));
+	stream.setNextSong("a", true, true);
+
+	RunStream(stream, output, songFrames * 4);
+
+	TEST_CHECK(stream.getUnderrunCount() == 0);
+	TEST_CHECK(static_cast<int>(output.playedFrames.size()) > (songFrames * 3));
+	TEST_CHECK(FindDiscontinuity(output.playedFrames, 0, 0, songFrames) == -1);
+}
+
+TEST_CASE(MusicStreamContinuesIntoNextSongPastPrerender)
+{
+	// The main song's start is decoded ahead of time, and playback must carry on from the song itself once
+	// those frames run out partway through a buffer instead of treating it as the end of the song.
+	const int optSongFrames = (MusicStream::BUFFER_FRAMES * 2) + 5000;
+	const int mainSongFrames = (MusicStream::MAX_PRERENDER_FRAMES * 3) + 777;
+	FakeOutput output;
+	MusicStream stream(output, MakeSongOpenFunc({ { "a", optSongFrames }, { "b", mainSongFrames } }));
+	stream.setNextSong("a", false, true);
+	stream.setNextSong("b", true, false);
+
+	RunStream(stream, output, optSongFrames + (mainSongFrames * 2));
+
+	TEST_CHECK(stream.getUnderrunCount() == 0);
+	TEST_CHECK(static_cast<int>(output.playedFrames.size()) > (optSongFrames + mainSongFrames));
+	TEST_CHECK(FindDiscontinuity(output.playedFrames, 0, 0, optSongFrames) == optSongFrames);
+	TEST_CHECK(FindDiscontinuity(output.playedFrames, optSongFrames, 1, mainSongFrames) == -1);
+}
+
+TEST_CASE(MusicStreamReplacesCurrentSong)
+{
+	const int songFrames = MusicStream::BUFFER_FRAMES * 8;
+	FakeOutput output;
+	MusicStream stream(output, MakeSongOpenFunc({ { "a", songFrames }, { "b", songFrames } }));
+	stream.setNextSong("a", true, true);
+	RunStream(stream, output, MusicStream::BUFFER_FRAMES * 2);
+
+	const int switchFrame = static_cast<int>(output.playedFrames.size());
+	stream.setNextSong("b", true, true);
+	RunStream(stream, output, songFrames);
+
+	// The old song's queued buffers are dropped so the new one starts right away.
+	TEST_CHECK(stream.getUnderrunCount() == 0);
+	TEST_CHECK(FindDiscontinuity(output.playedFrames, 0, 0, songFrames) == switchFrame);
+	TEST_CHECK(FindDiscontinuity(output.playedFrames, switchFrame, 1, songFrames) == -1);
+}
+
+TEST_CASE(MusicStreamStopsAndRestarts)
+{
+	const int songFrames = MusicStream::BUFFER_FRAMES * 8;
+	FakeOutput output;
+	MusicStream stream(output, MakeSongOpenFunc({ { "a", songFrames } }));
+	stream.setNextSong("a", true, true);
+	RunStream(stream, output, MusicStream::BUFFER_FRAMES * 2);
+
+	stream.stopSong();
+	stream.update();
+	TEST_CHECK(!output.isPlaying());
+	TEST_CHECK(output.getQueuedBufferCount() == 0);
+
+	// Nothing is queued until the next request.
+	RunStream(stream, output, MusicStream::BUFFER_FRAMES * 2);
+	TEST_CHECK(output.getQueuedBufferCount() == 0);
+
+	const int restartFrame = static_cast<int>(output.playedFrames.size());
+	stream.setNextSong("a", true, true);
+	RunStream(stream, output, MusicStream::BUFFER_FRAMES * 2);
+	TEST_CHECK(FindDiscontinuity(output.playedFrames, restartFrame, 0, songFrames) == -1);
+	TEST_CHECK(stream.getUnderrunCount() == 0);
+}
+
+TEST_CASE(MusicStreamCountsUnderruns)
+{
+	// Playing more than the whole queue between updates starves the output.
+	const int songFrames = MusicStream::BUFFER_FRAMES * 64;
+	FakeOutput output;
+	MusicStream stream(output, MakeSongOpenFunc({ { "a", songFrames } }));
+	stream.setNextSong("a", true, true);
+
+	for (int i = 0; i < 4; i++)
+	{
+		stream.update();
+		output.advance(MusicStream::BUFFER_FRAMES * (MusicStream::BUFFER_COUNT + 1));
+	}
+
+	TEST_CHECK(stream.getUnderrunCount() == 3);
+}
+
+TEST_CASE(MusicStreamEndsNonLoopingSong)
+{
+	const int songFrames = MusicStream::BUFFER_FRAMES + 100;
+	FakeOutput output;
+	MusicStream stream(output, MakeSongOpenFunc({ { "a", songFrames } }));
+	stream.setNextSong("a", false, true);
+
+	RunStream(stream, output, MusicStream::BUFFER_FRAMES * 8);
+
+	// The last buffer is padded with silence, then the output stops without counting an underrun.
+	TEST_CHECK(stream.getUnderrunCount() == 0);
+	TEST_CHECK(!output.isPlaying());
+	TEST_CHECK(static_cast<int>(output.playedFrames.size()) == (MusicStream::BUFFER_FRAMES * 2));
+	TEST_CHECK(FindDiscontinuity(output.playedFrames, 0, 0, songFrames) == songFrames);
+	TEST_CHECK(output.playedFrames.back() == 0);
+}
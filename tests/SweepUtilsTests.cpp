@@ -0,0 +1,202 @@
+#include <array>
+#include <cmath>
+#include <string>
+
+#include "TestUtils.h"
+
+#include "OpenTESArena/src/Collision/SweepUtils.h"
+#include "OpenTESArena/src/Math/Random.h"
+#include "OpenTESArena/src/Voxels/VoxelUtils.h"
+#include "OpenTESArena/src/World/ChunkUtils.h"
+
+// Moves a footprint through a synthetic voxel grid the same way the player moves, at frame times up to 250 ms.
+// The grid straddles a chunk corner so sweeps also cross chunk boundaries. Anything outside the grid is solid.
+
+namespace
+{
+	// Same as the player's footprint.
+	constexpr double HALF_WIDTH = 0.15;
+
+	constexpr double MAX_DELTA_TIME = 0.25;
+
+	// Fast enough to cross the whole room in one frame.
+	constexpr double MAX_SPEED = 60.0;
+
+	constexpr int VOXEL_Y = 1;
+
+	// Rows are X (south), columns are Z (west). '#' is a wall.
+	const std::array<std::string, 14> GRID_ROWS =
+	{
+		"##############",
+		"#............#",
+		"#..#.....##..#",
+		"#..#......#..#",
+		"#............#",
+		"#.....#......#",
+		"#....###.....#",
+		"#.....#......#",
+		"#............#",
+		"#.##.........#",
+		"#..#....#.#..#",
+		"#.......#.#..#",
+		"#............#",
+		"##############"
+	};
+
+	const WorldInt2 GRID_ORIGIN(ChunkUtils::CHUNK_DIM - 6, ChunkUtils::CHUNK_DIM - 6);
+
+	bool IsWall(SNInt worldX, WEInt worldZ)
+	{
+		const int row = worldX - GRID_ORIGIN.x;
+		const int column = worldZ - GRID_ORIGIN.y;
+		if ((row < 0) || (row >= static_cast<int>(GRID_ROWS.size())) ||
+			(column < 0) || (column >= static_cast<int>(GRID_ROWS[row].size())))
+		{
+			return true;
+		}
+
+		return GRID_ROWS[row][column] == '#';
+	}
+
+	bool IsCollider(const CoordInt3 &coord)
+	{
+		const WorldInt3 worldVoxel = VoxelUtils::coordToWorldVoxel(coord);
+		return (worldVoxel.y == VOXEL_Y) && IsWall(worldVoxel.x, worldVoxel.z);
+	}
+
+	CoordDouble3 MakeCoord(double gridX, double gridZ)
+	{
+		const WorldDouble3 point(GRID_ORIGIN.x + gridX, static_cast<double>(VOXEL_Y) + 0.50, GRID_ORIGIN.y + gridZ);
+		return VoxelUtils::worldPointToCoord(point);
+	}
+
+	// Whether any area of the footprint is inside a wall. Touching a wall's side doesn't count.
+	bool IsInsideWall(const CoordDouble3 &coord)
+	{
+		const WorldDouble3 point = VoxelUtils::coordToWorldPoint(coord);
+		const SNInt minX = static_cast<SNInt>(std::floor(point.x - HALF_WIDTH));
+		const SNInt maxX = static_cast<SNInt>(std::floor(point.x + HALF_WIDTH));
+		const WEInt minZ = static_cast<WEInt>(std::floor(point.z - HALF_WIDTH));
+		const WEInt maxZ = static_cast<WEInt>(std::floor(point.z + HALF_WIDTH));
+		for (WEInt z = minZ; z <= maxZ; z++)
+		{
+			for (SNInt x = minX; x <= maxX; x++)
+			{
+				const bool overlapsX = ((point.x + HALF_WIDTH) > x) && ((point.x - HALF_WIDTH) < (x + 1));
+				const bool overlapsZ = ((point.z + HALF_WIDTH) > z) && ((point.z - HALF_WIDTH) < (z + 1));
+				if (overlapsX && overlapsZ && IsWall(x, z))
+				{
+					return true;
+				}
+			}
+		}
+
+		return false;
+	}
+
+	// Steps the footprint like one player tick.
+	CoordDouble3 Move(const CoordDouble3 &coord, VoxelDouble2 *velocity, double dt)
+	{
+		const VoxelDouble2 delta = *velocity * dt;
+		return SweepUtils::slideSquare(coord, HALF_WIDTH, delta, VOXEL_Y, IsCollider, velocity);
+	}
+}
+
+TEST_CASE(SweepNeverEntersWalls)
+{
+	// Random velocities and frame times, with the same seeds every run.
+	for (int seed = 1; seed <= 8; seed++)
+	{
+		Random random(seed);
+		CoordDouble3 coord = MakeCoord(1.50, 1.50);
+		VoxelDouble2 velocity = VoxelDouble2::Zero;
+		for (int i = 0; i < 5000; i++)
+		{
+			if ((i % 4) == 0)
+			{
+				const double angle = random.nextReal() * 2.0 * 3.14159265358979;
+				const double speed = random.nextReal() * MAX_SPEED;
+				velocity = VoxelDouble2(std::cos(angle), std::sin(angle)) * speed;
+			}
+
+			const double speedBefore = velocity.length();
+			const double dt = MAX_DELTA_TIME * (1.0 - random.nextReal());
+			coord = Move(coord, &velocity, dt);
+
+			// Sliding only ever takes speed away.
+			TEST_CHECK(velocity.length() <= (speedBefore + 1.0e-9));
+
+			if (IsInsideWall(coord))
+			{
+				TEST_CHECK(!IsInsideWall(coord));
+				break;
+			}
+		}
+	}
+}
+
+TEST_CASE(SweepPushesOutBySkin)
+{
+	// Run into the wall at X = 13 at full speed over and over. The footprint stops exactly the skin away from it
+	// and stays there instead of creeping closer each frame.
+	const double expectedX = 13.0 - HALF_WIDTH - SweepUtils::SKIN;
+	CoordDouble3 coord = MakeCoord(11.50, 12.50);
+	for (int i = 0; i < 100; i++)
+	{
+		VoxelDouble2 velocity(MAX_SPEED, 0.0);
+		coord = Move(coord, &velocity, MAX_DELTA_TIME);
+
+		const WorldDouble3 point = VoxelUtils::coordToWorldPoint(coord);
+		TEST_CHECK(std::abs((point.x - GRID_ORIGIN.x) - expectedX) < 1.0e-9);
+		TEST_CHECK(std::abs((point.z - GRID_ORIGIN.y) - 12.50) < 1.0e-9);
+		TEST_CHECK(velocity.x == 0.0);
+		TEST_CHECK(!IsInsideWall(coord));
+	}
+}
+
+TEST_CASE(SweepStopsInCorner)
+{
+	// Moving diagonally into the room's inside corner at X = 13, Z = 13 stops against both walls.
+	CoordDouble3 coord = MakeCoord(11.50, 11.50);
+	VoxelDouble2 velocity(MAX_SPEED, MAX_SPEED);
+	coord = Move(coord, &velocity, MAX_DELTA_TIME);
+
+	const double expected = 13.0 - HALF_WIDTH - SweepUtils::SKIN;
+	const WorldDouble3 point = VoxelUtils::coordToWorldPoint(coord);
+	TEST_CHECK(std::abs((point.x - GRID_ORIGIN.x) - expected) < 1.0e-9);
+	TEST_CHECK(std::abs((point.z - GRID_ORIGIN.y) - expected) < 1.0e-9);
+	TEST_CHECK(velocity.x == 0.0);
+	TEST_CHECK(velocity.y == 0.0);
+	TEST_CHECK(!IsInsideWall(coord));
+}
+
+TEST_CASE(SweepSlidesAlongWallAndAroundCorner)
+{
+	// Moving along the wall at X = 1 while pressing into it slides across the seams between its voxels without
+	// snagging, and the footprint keeps all of its sideways movement.
+	CoordDouble3 coord = MakeCoord(1.50, 4.50);
+	VoxelDouble2 velocity(-4.0, 4.0);
+	for (int i = 0; i < 4; i++)
+	{
+		coord = Move(coord, &velocity, MAX_DELTA_TIME);
+		TEST_CHECK(!IsInsideWall(coord));
+	}
+
+	const WorldDouble3 point = VoxelUtils::coordToWorldPoint(coord);
+	TEST_CHECK(std::abs((point.x - GRID_ORIGIN.x) - (1.0 + HALF_WIDTH + SweepUtils::SKIN)) < 1.0e-9);
+	TEST_CHECK(std::abs((point.z - GRID_ORIGIN.y) - 8.50) < 1.0e-9);
+	TEST_CHECK(velocity.x == 0.0);
+	TEST_CHECK(velocity.y == 4.0);
+
+	// Catch the side of the pillar at X = 5, Z = 6 while moving diagonally past it. The footprint slides along
+	// that side and comes out clear of the pillar's far corner.
+	coord = MakeCoord(4.70, 5.70);
+	velocity = VoxelDouble2(1.0, 8.0);
+	coord = Move(coord, &velocity, MAX_DELTA_TIME);
+	const WorldDouble3 cornerPoint = VoxelUtils::coordToWorldPoint(coord);
+	TEST_CHECK(!IsInsideWall(coord));
+	TEST_CHECK(velocity.x == 0.0);
+	TEST_CHECK(velocity.y == 8.0);
+	TEST_CHECK(std::abs((cornerPoint.x - GRID_ORIGIN.x) - (5.0 - HALF_WIDTH - SweepUtils::SKIN)) < 1.0e-9);
+	TEST_CHECK(std::abs((cornerPoint.z - GRID_ORIGIN.y) - 7.70) < 1.0e-9);
+}
@@ -0,0 +1,93 @@
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "TestUtils.h"
+
+// Usage: otesa_tests [--benchmarks | test name...]
+// With no arguments every test runs. Returns non-zero if any test failed.
+
+namespace
+{
+	struct TestEntry
+	{
+		const char *name;
+		TestUtils::TestFunc func;
+		bool isBenchmark;
+	};
+
+	// Function-local so registration from other translation units doesn't depend on initialization order.
+	std::vector<TestEntry> &GetTestEntries()
+	{
+		static std::vector<TestEntry> entries;
+		return entries;
+	}
+
+	int CurrentFailureCount = 0;
+}
+
+int TestUtils::registerTest(const char *name, TestFunc func, bool isBenchmark)
+{
+	std::vector<TestEntry> &entries = GetTestEntries();
+	entries.push_back(TestEntry { name, func, isBenchmark });
+	return static_cast<int>(entries.size());
+}
+
+void TestUtils::fail(const char *expression, const char *file, int line)
+{
+	std::printf("  %s(%d): check failed: %s\n", file, line, expression);
+	CurrentFailureCount++;
+}
+
+int main(int argc, char *argv[])
+{
+	const bool runBenchmarks = (argc == 2) && (std::strcmp(argv[1], "--benchmarks") == 0);
+	auto shouldRun = [argc, argv, runBenchmarks](const TestEntry &entry)
+	{
+		if (runBenchmarks)
+		{
+			return entry.isBenchmark;
+		}
+
+		if (argc == 1)
+		{
+			return !entry.isBenchmark;
+		}
+
+		for (int i = 1; i < argc; i++)
+		{
+			if (std::strcmp(argv[i], entry.name) == 0)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	};
+
+	int runCount = 0;
+	int failedCount = 0;
+	for (const TestEntry &entry : GetTestEntries())
+	{
+		if (!shouldRun(entry))
+		{
+			continue;
+		}
+
+		std::printf("%s\n", entry.name);
+		std::fflush(stdout);
+
+		CurrentFailureCount = 0;
+		entry.func();
+		runCount++;
+
+		if (CurrentFailureCount > 0)
+		{
+			std::printf("  FAILED\n");
+			failedCount++;
+		}
+	}
+
+	std::printf("%d run, %d failed.\n", runCount, failedCount);
+	return (failedCount == 0) ? 0 : 1;
+}
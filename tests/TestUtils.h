@@ -0,0 +1,30 @@
+#ifndef TEST_UTILS_H
+#define TEST_UTILS_H
+
+// Minimal test registry. Tests run by default; benchmarks only run when asked for since they just report
+// timings. Each test file registers its cases with TEST_CASE/BENCHMARK_CASE.
+
+namespace TestUtils
+{
+	using TestFunc = void(*)();
+
+	int registerTest(const char *name, TestFunc func, bool isBenchmark);
+
+	// Marks the running test as failed without stopping it.
+	void fail(const char *expression, const char *file, int line);
+}
+
+#define TEST_CASE(name) \
+	static void name(); \
+	static const int name##Registration = TestUtils::registerTest(#name, name, false); \
+	static void name()
+
+#define BENCHMARK_CASE(name) \
+	static void name(); \
+	static const int name##Registration = TestUtils::registerTest(#name, name, true); \
+	static void name()
+
+#define TEST_CHECK(expression) \
+	do { if (!(expression)) TestUtils::fail(#expression, __FILE__, __LINE__); } while (false)
+
+#endif